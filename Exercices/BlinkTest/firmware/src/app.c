@@ -55,6 +55,9 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 
 #include "app.h"
 #include "Mc32DriverLcd.h"
+#include "system/ports/sys_ports_fast.h"
+#include "system/ports/sys_ports_pins.h"
+#include "driver/tmr/drv_tmr_dispatch.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -95,8 +98,60 @@ APP_DATA appData;
 // *****************************************************************************
 
 
-/* TODO:  Add any necessary local functions.
-*/
+// Mesure du cot d'un toggle de LED0, appel gnrique contre
+// criture directe dans LATAINV. Le core timer compte  SYSCLK/2.
+static void APP_ToggleBenchmark(void)
+{
+    uint32_t start;
+    uint32_t i;
+
+    start = _CP0_GET_COUNT();
+    for (i = 0; i < APP_BENCH_NB_TOGGLES; i++)
+    {
+        SYS_PORTS_PinToggle(PORTS_ID_0, SYS_PIN_LED0_CHANNEL, SYS_PIN_LED0_BIT);
+    }
+    appData.toggleCyclesGeneric = ((_CP0_GET_COUNT() - start) * 2) / APP_BENCH_NB_TOGGLES;
+
+    start = _CP0_GET_COUNT();
+    for (i = 0; i < APP_BENCH_NB_TOGGLES; i++)
+    {
+        SYS_PORTS_FastPinToggle(SYS_PIN_LED0_CHANNEL, SYS_PIN_LED0_BIT);
+    }
+    appData.toggleCyclesFast = ((_CP0_GET_COUNT() - start) * 2) / APP_BENCH_NB_TOGGLES;
+}
+
+// Mesure du cot de DRV_TMR_CounterValueGet : fonction du mapping
+// (switch sur le handle), dispatch  la compilation sur handle constant
+// et appel direct de DRV_TMR0_CounterValueGet.
+static void APP_TmrDispatchBenchmark(void)
+{
+    volatile uint32_t sink;
+    uint32_t start;
+    uint32_t i;
+
+    start = _CP0_GET_COUNT();
+    for (i = 0; i < APP_BENCH_NB_CALLS; i++)
+    {
+        sink = (DRV_TMR_CounterValueGet)(APP_TMR_HANDLE);
+    }
+    appData.tmrCyclesMapping = ((_CP0_GET_COUNT() - start) * 2) / APP_BENCH_NB_CALLS;
+
+    start = _CP0_GET_COUNT();
+    for (i = 0; i < APP_BENCH_NB_CALLS; i++)
+    {
+        sink = DRV_TMR_CounterValueGet(APP_TMR_HANDLE);
+    }
+    appData.tmrCyclesDispatch = ((_CP0_GET_COUNT() - start) * 2) / APP_BENCH_NB_CALLS;
+
+    start = _CP0_GET_COUNT();
+    for (i = 0; i < APP_BENCH_NB_CALLS; i++)
+    {
+        sink = DRV_TMR0_CounterValueGet();
+    }
+    appData.tmrCyclesDirect = ((_CP0_GET_COUNT() - start) * 2) / APP_BENCH_NB_CALLS;
+
+    (void)sink;
+}
 
 
 // *****************************************************************************
@@ -146,19 +201,28 @@ void APP_Tasks ( void )
             lcd_init();
             printf_lcd("Blink test 1");
             lcd_bl_on();
+
+            // Cycles par toggle (boucle comprise) : gnrique / rapide
+            APP_ToggleBenchmark();
+            lcd_gotoxy(1,2);
+            printf_lcd("Tgl %lu / %lu cy", appData.toggleCyclesGeneric,
+                       appData.toggleCyclesFast);
+
+            // Cycles par lecture du timer : mapping / dispatch / direct
+            APP_TmrDispatchBenchmark();
+            lcd_gotoxy(1,3);
+            printf_lcd("Tmr %lu/%lu/%lu cy", appData.tmrCyclesMapping,
+                       appData.tmrCyclesDispatch, appData.tmrCyclesDirect);
             
             // Dmarage timer 0  100ms 
-            DRV_TMR0_Start();
+            DRV_TMR_Start(APP_TMR_HANDLE);
             //Premire entre en mode 
             appData.state = APP_STATE_SERVICE_TASKS;
        }
 
         case APP_STATE_SERVICE_TASKS:
         {
-            if (LED0_R == 0)
-                LED0_W = 1;
-            else
-                LED0_W = 0;
+            SYS_PORTS_FastPinToggle(SYS_PIN_LED0_CHANNEL, SYS_PIN_LED0_BIT);
             
             // Passage en attente
             appData.state = APP_STATE_WAIT;
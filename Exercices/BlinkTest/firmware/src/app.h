@@ -110,12 +110,28 @@ typedef enum
     Application strings and buffers are be defined outside this structure.
  */
 
+/* Nombre de toggles mesures (pair : LED0 revient a son etat) */
+#define APP_BENCH_NB_TOGGLES    1000
+
+/* Nombre d'appels mesures pour le timer */
+#define APP_BENCH_NB_CALLS      1000
+
+/* Handle constant du timer 0 (driver statique : handle = index) */
+#define APP_TMR_HANDLE          ((DRV_HANDLE)DRV_TMR_INDEX_0)
+
 typedef struct
 {
     /* The application's current state */
     APP_STATES state;
 
-    /* TODO: Define any additional data used by the application. */
+    /* Benchmark du toggle de LED0 : cycles CPU par toggle */
+    uint32_t toggleCyclesGeneric;
+    uint32_t toggleCyclesFast;
+
+    /* Benchmark de DRV_TMR_CounterValueGet : cycles CPU par appel */
+    uint32_t tmrCyclesMapping;
+    uint32_t tmrCyclesDispatch;
+    uint32_t tmrCyclesDirect;
 
 } APP_DATA;
 
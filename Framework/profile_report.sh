@@ -0,0 +1,71 @@
+#!/bin/sh
+# Compare les profils de la bibliotheque framework pour une app
+#   ./profile_report.sh <projet .X> [profils]      (defaut : O0 O2 Os O3lto)
+#
+# Pour chaque profil : reconstruit le projet (le pre-build reconstruit la
+# bibliotheque avec PROFILE), releve dans le .map "Total Program Memory
+# used", "Total Data Memory used" et la taille de la section .ramfunc
+# (fonctions HOT_RAMFUNC, comparee a HOT_RAMFUNC_BUDGET_BYTES), puis ajoute les mesures de cycles
+# relevees au debugger (S_hotProfile, S_regulStats, SYS_WDM_STATS, SYS_BOOT_REPORT...)
+# si reports/<app>_<profil>.cycles existe, une ligne "nom valeur" par mesure.
+# Resultat : reports/<app>.md
+#
+# MPLABX_DIR doit pointer sur l'installation MPLAB X (prjMakefilesGenerator)
+# et xc32-gcc doit etre dans le PATH.
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "usage : $0 <projet .X> [profils]" >&2
+    exit 1
+fi
+
+PRJ=$(cd "$1" && pwd)
+shift
+PROFILES=${*:-"O0 O2 Os O3lto"}
+NAME=$(basename "$PRJ" .X)
+HERE=$(cd "$(dirname "$0")" && pwd)
+REPORT_DIR=$HERE/reports
+MAP=$PRJ/dist/default/production/$NAME.X.production.map
+RAMFUNC_BUDGET=$(awk '/define HOT_RAMFUNC_BUDGET_BYTES/ { print $3 }' "$HERE/src/hotPath.h")
+
+mkdir -p "$REPORT_DIR"
+
+# Les Makefile-*.mk du projet suivent configurations.xml
+if [ -n "$MPLABX_DIR" ]; then
+    "$MPLABX_DIR/mplab_platform/bin/prjMakefilesGenerator.sh" "$PRJ@default"
+fi
+
+{
+    echo "# $NAME : profils de la bibliotheque framework"
+    echo
+    echo "| Profil | Programme (octets) | Donnees (octets) | ramfunc (octets, budget $RAMFUNC_BUDGET) | Cycles |"
+    echo "|--------|-------------------:|-----------------:|-----------------:|--------|"
+} > "$REPORT_DIR/$NAME.md"
+
+for p in $PROFILES; do
+    export PROFILE=$p
+    make -C "$PRJ" CONF=default clean build > "$REPORT_DIR/${NAME}_$p.log" 2>&1
+    cp "$MAP" "$REPORT_DIR/${NAME}_$p.map"
+
+    prog=$(awk -F: '/Total Program Memory used/ { split($2, a, " "); print a[2]; exit }' "$MAP")
+    data=$(awk -F: '/Total Data Memory used/ { split($2, a, " "); print a[2]; exit }' "$MAP")
+
+    # Section de sortie .ramfunc : ligne en debut de colonne, taille en 3e champ
+    ramfunc=0
+    for sz in $(awk '/^\.ramfunc[ \t]/ && $3 ~ /^0x/ { print $3 }' "$MAP"); do
+        ramfunc=$((ramfunc + sz))
+    done
+    if [ "$ramfunc" -gt "$RAMFUNC_BUDGET" ]; then
+        ramfunc="$ramfunc (depasse)"
+    fi
+
+    cycles="-"
+    if [ -f "$REPORT_DIR/${NAME}_$p.cycles" ]; then
+        cycles=$(awk '{ printf "%s%s=%s", sep, $1, $2; sep=", " }' "$REPORT_DIR/${NAME}_$p.cycles")
+    fi
+
+    echo "| $p | $prog | $data | $ramfunc | $cycles |" >> "$REPORT_DIR/$NAME.md"
+done
+
+cat "$REPORT_DIR/$NAME.md"
@@ -0,0 +1,196 @@
+/*******************************************************************************
+  Timer Driver Compile-Time Dispatch
+
+  File Name:
+    drv_tmr_dispatch.h
+
+  Summary:
+    Resolves dynamic DRV_TMR_* calls on constant handles to the static
+    DRV_TMRn_* functions.
+
+  Description:
+    drv_tmr_mapping.c routes each dynamic call to the static driver through a
+    switch on the handle, at run time. The macros below replace the dynamic
+    functions of the calling file: when the handle (or index) is a
+    compile-time constant naming a static instance, the call goes through the
+    const table drvTmrStaticApi[], built from DRV_TMR_STATIC_INSTANCE_TABLE
+    of the application's system_config.h :
+
+        DRV_TMR_STATIC_INSTANCE_TABLE(INST)     INST(0) INST(1) ...
+
+    Otherwise the function of drv_tmr_mapping.c is called, as before.
+
+    From -O1, the load from the const table is folded and the call is a
+    direct call to DRV_TMRn_* (inlined for the static inline ones), the same
+    code as calling the static function by hand. At -O0 one load from the
+    table remains before the call, and the switch of the mapping is skipped.
+
+  Remarks:
+    Static timer drivers open a single client and use the instance index as
+    handle, so a constant handle is simply (DRV_HANDLE)DRV_TMR_INDEX_n.
+
+    The alarm and gate functions have no static counterpart in the generated
+    drivers; they are not redirected.
+
+    The mapping itself can still be called through the function name in
+    parentheses, e.g. (DRV_TMR_Start)(handle).
+*******************************************************************************/
+
+#ifndef _DRV_TMR_DISPATCH_H
+#define _DRV_TMR_DISPATCH_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "driver/tmr/drv_tmr.h"
+#include "driver/tmr/drv_tmr_static.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Static Instance Table
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    void (*Initialize)(void);
+    void (*Deinitialize)(void);
+    SYS_STATUS (*Status)(void);
+    void (*Tasks)(void);
+    void (*Close)(void);
+    DRV_TMR_CLIENT_STATUS (*ClientStatus)(void);
+    void (*CounterValueSet)(uint32_t value);
+    uint32_t (*CounterValueGet)(void);
+    void (*CounterClear)(void);
+    bool (*Start)(void);
+    void (*Stop)(void);
+    DRV_TMR_OPERATION_MODE (*OperationModeGet)(void);
+    bool (*ClockSet)(DRV_TMR_CLK_SOURCES clockSource, TMR_PRESCALE prescale);
+    TMR_PRESCALE (*PrescalerGet)(void);
+    uint32_t (*CounterFrequencyGet)(void);
+    DRV_TMR_OPERATION_MODE (*DividerRangeGet)(DRV_TMR_DIVIDER_RANGE *pDivRange);
+
+} DRV_TMR_STATIC_API;
+
+#define _DRV_TMR_STATIC_API_ENTRY(n) \
+    [n] = { \
+        .Initialize          = DRV_TMR##n##_Initialize, \
+        .Deinitialize        = DRV_TMR##n##_DeInitialize, \
+        .Status              = DRV_TMR##n##_Status, \
+        .Tasks               = DRV_TMR##n##_Tasks, \
+        .Close               = DRV_TMR##n##_Close, \
+        .ClientStatus        = DRV_TMR##n##_ClientStatus, \
+        .CounterValueSet     = DRV_TMR##n##_CounterValueSet, \
+        .CounterValueGet     = DRV_TMR##n##_CounterValueGet, \
+        .CounterClear        = DRV_TMR##n##_CounterClear, \
+        .Start               = DRV_TMR##n##_Start, \
+        .Stop                = DRV_TMR##n##_Stop, \
+        .OperationModeGet    = DRV_TMR##n##_OperationModeGet, \
+        .ClockSet            = DRV_TMR##n##_ClockSet, \
+        .PrescalerGet        = DRV_TMR##n##_PrescalerGet, \
+        .CounterFrequencyGet = DRV_TMR##n##_CounterFrequencyGet, \
+        .DividerRangeGet     = DRV_TMR##n##_DividerRangeGet, \
+    },
+
+/* Visible in each file so that the compiler can fold the loads */
+static const DRV_TMR_STATIC_API drvTmrStaticApi[] =
+{
+    DRV_TMR_STATIC_INSTANCE_TABLE(_DRV_TMR_STATIC_API_ENTRY)
+};
+
+#define DRV_TMR_STATIC_INSTANCES_NUMBER \
+    (sizeof(drvTmrStaticApi) / sizeof(drvTmrStaticApi[0]))
+
+/* Constant handle or index of a static instance */
+#define _DRV_TMR_IS_STATIC(handle) \
+    (__builtin_constant_p(handle) && \
+     ((uintptr_t)(handle) < DRV_TMR_STATIC_INSTANCES_NUMBER))
+
+#define _DRV_TMR_API(handle) \
+    (&drvTmrStaticApi[(uintptr_t)(handle)])
+
+/* Statement expression : no unused value warning when the result of a
+   non-void function is dropped */
+#define _DRV_TMR_DISPATCH(handle, staticCall, dynamicCall) \
+    ({ _DRV_TMR_IS_STATIC(handle) ? _DRV_TMR_API(handle)->staticCall : (dynamicCall); })
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Driver System Interface
+// *****************************************************************************
+// *****************************************************************************
+
+#define DRV_TMR_Initialize(drvIndex, init) \
+    ({ _DRV_TMR_IS_STATIC(drvIndex) ? \
+        (_DRV_TMR_API(drvIndex)->Initialize(), (SYS_MODULE_OBJ)(drvIndex)) : \
+        (DRV_TMR_Initialize)((drvIndex), (init)); })
+
+#define DRV_TMR_Deinitialize(object) \
+    _DRV_TMR_DISPATCH(object, Deinitialize(), (DRV_TMR_Deinitialize)(object))
+
+#define DRV_TMR_Status(object) \
+    _DRV_TMR_DISPATCH(object, Status(), (DRV_TMR_Status)(object))
+
+#define DRV_TMR_Tasks(object) \
+    _DRV_TMR_DISPATCH(object, Tasks(), (DRV_TMR_Tasks)(object))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Driver Client Interface
+// *****************************************************************************
+// *****************************************************************************
+
+#define DRV_TMR_Open(index, intent) \
+    ({ _DRV_TMR_IS_STATIC(index) ? (DRV_HANDLE)(index) : \
+                                   (DRV_TMR_Open)((index), (intent)); })
+
+#define DRV_TMR_Close(handle) \
+    _DRV_TMR_DISPATCH(handle, Close(), (DRV_TMR_Close)(handle))
+
+#define DRV_TMR_ClientStatus(handle) \
+    _DRV_TMR_DISPATCH(handle, ClientStatus(), (DRV_TMR_ClientStatus)(handle))
+
+#define DRV_TMR_CounterValueSet(handle, counterPeriod) \
+    _DRV_TMR_DISPATCH(handle, CounterValueSet(counterPeriod), \
+                      (DRV_TMR_CounterValueSet)((handle), (counterPeriod)))
+
+#define DRV_TMR_CounterValueGet(handle) \
+    _DRV_TMR_DISPATCH(handle, CounterValueGet(), (DRV_TMR_CounterValueGet)(handle))
+
+#define DRV_TMR_CounterClear(handle) \
+    _DRV_TMR_DISPATCH(handle, CounterClear(), (DRV_TMR_CounterClear)(handle))
+
+#define DRV_TMR_Start(handle) \
+    _DRV_TMR_DISPATCH(handle, Start(), (DRV_TMR_Start)(handle))
+
+#define DRV_TMR_Stop(handle) \
+    _DRV_TMR_DISPATCH(handle, Stop(), (DRV_TMR_Stop)(handle))
+
+#define DRV_TMR_OperationModeGet(handle) \
+    _DRV_TMR_DISPATCH(handle, OperationModeGet(), (DRV_TMR_OperationModeGet)(handle))
+
+#define DRV_TMR_ClockSet(handle, clockSource, preScale) \
+    _DRV_TMR_DISPATCH(handle, ClockSet((clockSource), (preScale)), \
+                      (DRV_TMR_ClockSet)((handle), (clockSource), (preScale)))
+
+#define DRV_TMR_PrescalerGet(handle) \
+    _DRV_TMR_DISPATCH(handle, PrescalerGet(), (DRV_TMR_PrescalerGet)(handle))
+
+#define DRV_TMR_CounterFrequencyGet(handle) \
+    _DRV_TMR_DISPATCH(handle, CounterFrequencyGet(), (DRV_TMR_CounterFrequencyGet)(handle))
+
+#define DRV_TMR_DividerRangeGet(handle, pDivRange) \
+    _DRV_TMR_DISPATCH(handle, DividerRangeGet(pDivRange), \
+                      (DRV_TMR_DividerRangeGet)((handle), (pDivRange)))
+
+#endif // _DRV_TMR_DISPATCH_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,104 @@
+#ifndef HotPath_H
+#define HotPath_H
+/*--------------------------------------------------------*/
+// HotPath.h
+/*--------------------------------------------------------*/
+//	Description :	Placement en RAM des fonctions critiques
+//			        (ISR, boucles de regulation) et profilage,
+//			        commun a TP0 et TP1
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+//  Les fonctions marquees HOT_RAMFUNC sont copiees en RAM par le
+//  startup XC32 (section .ramfunc), qui programme aussi BMXDKPBA,
+//  BMXDUDBA et BMXDUPBA. Elles ne subissent plus les wait states
+//  flash ni les defauts du cache de prefetch.
+//
+//  Criteres de choix (une fonction marquee les remplit tous) :
+//  - executee dans une ISR a chaque evenement materiel ou a cadence
+//    fixe (Timer1/Timer4 1 ms, IC, CN, ADC, DMA, Timer5), ou appelee par
+//    une telle fonction
+//  - courte, sans appel a du code lourd reste en flash (printf, LCD,
+//    FFT) : un appel RAM -> flash est un saut long et paie les wait
+//    states qu'on voulait eviter
+//  - les donnees const (tables) restent en flash, lues par le cache
+//  Le handler __ISR lui-meme reste en flash (voir plus bas).
+//
+//  Verification : compiler avec HOT_PROFILE_ENABLE = 1 et
+//  HOT_RAMFUNC_ENABLE = 0, laisser tourner puis lire les S_hotProfile
+//  au debugger (reports/<app>_<profil>.cycles, voir
+//  Framework/profile_report.sh). On garde en RAM les plus grands
+//  totalTics (appels x duree) tant que la section .ramfunc du .map
+//  tient dans HOT_RAMFUNC_BUDGET_BYTES, colonne "ramfunc" du rapport.
+//
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+
+/*--------------------------------------------------------*/
+// Options de build
+/*--------------------------------------------------------*/
+
+// 1 = fonctions HOT_RAMFUNC executees depuis la RAM
+#ifndef HOT_RAMFUNC_ENABLE
+#define HOT_RAMFUNC_ENABLE      1
+#endif
+
+// 1 = mesure des fonctions candidates avec le core timer
+#ifndef HOT_PROFILE_ENABLE
+#define HOT_PROFILE_ENABLE      0
+#endif
+
+
+/*--------------------------------------------------------*/
+// Placement
+/*--------------------------------------------------------*/
+
+// Budget de la section .ramfunc : une page de la partition programme
+// en RAM du noyau (BMXDKPBA, granularite 2 Ko), controle par
+// profile_report.sh
+#define HOT_RAMFUNC_BUDGET_BYTES    2048
+
+// Le handler __ISR reste en flash (le vecteur ne peut pas sauter en
+// RAM), il appelle la callback placee en RAM (attribut far).
+#if (HOT_RAMFUNC_ENABLE == 1) && defined(__XC32)
+#include <sys/attribs.h>
+#define HOT_RAMFUNC             __ramfunc__
+#else
+#define HOT_RAMFUNC
+#endif
+
+
+/*--------------------------------------------------------*/
+// Profilage (en tics du core timer, SYS_CLK_FREQ / 2)
+/*--------------------------------------------------------*/
+
+typedef struct {
+    uint32_t nbCalls;       // nombre d'appels
+    uint32_t totalTics;     // duree cumulee
+    uint32_t maxTics;       // duree maximale observee
+} S_hotProfile;
+
+static inline void HOT_ProfileAdd(S_hotProfile *pProf, uint32_t nbTics)
+{
+    pProf->nbCalls++;
+    pProf->totalTics += nbTics;
+    if (nbTics > pProf->maxTics) {
+        pProf->maxTics = nbTics;
+    }
+}
+
+#if (HOT_PROFILE_ENABLE == 1)
+#define HOT_PROFILE_BEGIN()     uint32_t hotStartTics = _CP0_GET_COUNT()
+#define HOT_PROFILE_END(prof)   HOT_ProfileAdd(&(prof), _CP0_GET_COUNT() - hotStartTics)
+#else
+#define HOT_PROFILE_BEGIN()
+#define HOT_PROFILE_END(prof)
+#endif
+
+
+#endif
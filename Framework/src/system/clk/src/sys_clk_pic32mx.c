@@ -55,10 +55,33 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 // *****************************************************************************
 
+#include <xc.h>
 #include "system_config.h"
 #include "system_definitions.h"
 #include "peripheral/osc/plib_osc.h"
 #include "system/devcon/sys_devcon.h"
+#include "system/clk/sys_clk_static.h"
+#include "system/debug/sys_debug.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Variables
+// *****************************************************************************
+// *****************************************************************************
+
+/* Current system clock, PBDIV = 1 so it is also the peripheral bus clock */
+static volatile uint32_t sysClkCurrentFreq = SYS_CLK_FREQ;
+
+/* Drivers notified after a frequency change */
+static SYS_CLK_FREQ_CHANGE_CALLBACK sysClkCallbacks[SYS_CLK_FREQ_CHANGE_CALLBACKS_MAX];
+static uint8_t sysClkNbCallbacks = 0;
+static uint32_t sysClkNbRejected = 0;
+
+/* Duration of the last change in core timer ticks */
+static uint32_t sysClkSwitchTicks = 0;
+
+/* Right shift applied to SYS_CLK_FREQ for each PLLODIV code (/1 to /256) */
+static const uint8_t sysClkOdivShift[8] = { 0, 1, 2, 3, 4, 5, 6, 8 };
 
 // *****************************************************************************
 // *****************************************************************************
@@ -135,7 +158,7 @@ void SYS_CLK_Initialize( const SYS_CLK_INIT const * clkInit )
 
 inline uint32_t SYS_CLK_SystemFrequencyGet ( void )
 {
-    return SYS_CLK_FREQ;
+    return sysClkCurrentFreq;
 }
 
 //******************************************************************************
@@ -174,7 +197,7 @@ inline uint32_t SYS_CLK_SystemFrequencyGet ( void )
 
 inline uint32_t SYS_CLK_PeripheralFrequencyGet ( CLK_BUSES_PERIPHERAL peripheralBus )
 {
-    return SYS_CLK_BUS_PERIPHERAL_1;
+    return sysClkCurrentFreq;
 }
 
 
@@ -291,3 +314,125 @@ bool SYS_CLK_SecondaryOscillatorIsEnabled ( void )
 {
     return (PLIB_OSC_SecondaryIsEnabled(OSC_ID_0));
 }
+
+/******************************************************************************
+  Function:
+    bool SYS_CLK_SystemFrequencyScale ( uint32_t systemClockHz )
+
+  Summary:
+    Changes the system clock frequency at runtime.
+
+  Remarks:
+    For more details refer sys_clk_static.h.
+*/
+
+bool SYS_CLK_SystemFrequencyScale ( uint32_t systemClockHz )
+{
+    uint32_t startTicks;
+    uint32_t oldFreq = sysClkCurrentFreq;
+    uint8_t odiv;
+    uint8_t i;
+
+    /* Look for the PLL output divider giving the requested frequency */
+    for (odiv = 0; odiv < 8; odiv++)
+    {
+        if ((SYS_CLK_FREQ >> sysClkOdivShift[odiv]) == systemClockHz)
+        {
+            break;
+        }
+    }
+    if (odiv >= 8)
+    {
+        return false;
+    }
+
+    startTicks = _CP0_GET_COUNT();
+
+    /* Going up : more wait states before the clock rises */
+    if (systemClockHz > oldFreq)
+    {
+        SYS_DEVCON_PerformanceConfig(systemClockHz);
+    }
+
+    /* PLLODIV can be changed on the fly, no clock switch needed */
+    SYS_DEVCON_SystemUnlock ( );
+    OSCCONbits.PLLODIV = odiv;
+    SYS_DEVCON_SystemLock ( );
+    sysClkCurrentFreq = systemClockHz;
+
+    /* Going down : fewer wait states once the clock has fallen */
+    if (systemClockHz < oldFreq)
+    {
+        SYS_DEVCON_PerformanceConfig(systemClockHz);
+    }
+
+    /* Drivers re-derive their timings from the new clock */
+    for (i = 0; i < sysClkNbCallbacks; i++)
+    {
+        sysClkCallbacks[i](systemClockHz, systemClockHz);
+    }
+
+    sysClkSwitchTicks = _CP0_GET_COUNT() - startTicks;
+
+    return true;
+}
+
+/******************************************************************************
+  Function:
+    bool SYS_CLK_FrequencyChangeCallbackRegister
+        ( SYS_CLK_FREQ_CHANGE_CALLBACK callback )
+
+  Summary:
+    Registers a driver to be notified after each frequency change.
+
+  Remarks:
+    For more details refer sys_clk_static.h.
+*/
+
+bool SYS_CLK_FrequencyChangeCallbackRegister
+    ( SYS_CLK_FREQ_CHANGE_CALLBACK callback )
+{
+    if ((callback == NULL) || (sysClkNbCallbacks >= SYS_CLK_FREQ_CHANGE_CALLBACKS_MAX))
+    {
+        /* Table full: raise SYS_CLK_FREQ_CHANGE_CALLBACKS_MAX */
+        sysClkNbRejected++;
+        SYS_DEBUG_BreakPoint();
+        return false;
+    }
+    sysClkCallbacks[sysClkNbCallbacks] = callback;
+    sysClkNbCallbacks++;
+
+    return true;
+}
+
+/******************************************************************************
+  Function:
+    uint32_t SYS_CLK_SwitchTicksGet ( void )
+
+  Summary:
+    Duration of the last frequency change, callbacks included.
+
+  Remarks:
+    For more details refer sys_clk_static.h.
+*/
+
+uint32_t SYS_CLK_SwitchTicksGet ( void )
+{
+    return sysClkSwitchTicks;
+}
+
+/******************************************************************************
+  Function:
+    uint32_t SYS_CLK_CallbackRejectedCountGet ( void )
+
+  Summary:
+    Number of refused SYS_CLK_FrequencyChangeCallbackRegister calls.
+
+  Remarks:
+    For more details refer sys_clk_static.h.
+*/
+
+uint32_t SYS_CLK_CallbackRejectedCountGet ( void )
+{
+    return sysClkNbRejected;
+}
@@ -0,0 +1,154 @@
+/*******************************************************************************
+  System Clock Runtime Scaling Interface
+
+  File Name:
+    sys_clk_static.h
+
+  Summary:
+    Runtime system clock scaling for the static clock service.
+
+  Description:
+    The static clock service is configured once at boot for SYS_CLK_FREQ.
+    This interface lets the application lower or restore the system clock
+    at runtime by changing the PLL output divider. The flash wait states are
+    recomputed through SYS_DEVCON_PerformanceConfig and every registered
+    driver is notified so it can re-derive its clock dependent settings.
+
+  Remarks:
+    PBDIV is fixed to 1 in this configuration, the peripheral bus clock
+    always equals the system clock.
+*******************************************************************************/
+
+#ifndef _SYS_CLK_STATIC_H
+#define _SYS_CLK_STATIC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Maximum number of drivers notified on a frequency change, may be raised
+   in system_config.h (TP0 registers up to 6: ADC, TMR0, telemetry, flash log,
+   DDS, event trace) */
+#ifndef SYS_CLK_FREQ_CHANGE_CALLBACKS_MAX
+#define SYS_CLK_FREQ_CHANGE_CALLBACKS_MAX   8
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Frequency change callback
+
+  Summary:
+    Called after the system clock has been scaled.
+
+  Description:
+    The callback receives the new system and peripheral bus frequencies in
+    Hertz. It runs in the context of SYS_CLK_SystemFrequencyScale, with the
+    new clock already active.
+*/
+
+typedef void (*SYS_CLK_FREQ_CHANGE_CALLBACK)( uint32_t systemClockHz,
+                                              uint32_t peripheralClockHz );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_CLK_SystemFrequencyScale ( uint32_t systemClockHz )
+
+  Summary:
+    Changes the system clock frequency at runtime.
+
+  Description:
+    Selects the PLL output divider giving systemClockHz. When the frequency
+    rises the wait states are raised before the divider is changed, when it
+    falls they are lowered after, so the flash is never run too fast.
+    Registered callbacks are then called with the new frequencies.
+
+  Returns:
+    true if the frequency was applied, false if systemClockHz is not
+    SYS_CLK_FREQ divided by 1, 2, 4, 8, 16, 32, 64 or 256.
+
+  Remarks:
+    Only the divider is changed, a new PLL multiplier would need a full
+    clock switch and a PLL relock of unbounded duration.
+    Delays computed from SYS_CLK_FREQ at compile time become longer at a
+    lower frequency.
+*/
+
+bool SYS_CLK_SystemFrequencyScale ( uint32_t systemClockHz );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_CLK_FrequencyChangeCallbackRegister
+        ( SYS_CLK_FREQ_CHANGE_CALLBACK callback )
+
+  Summary:
+    Registers a driver to be notified after each frequency change.
+
+  Returns:
+    false if SYS_CLK_FREQ_CHANGE_CALLBACKS_MAX callbacks are already
+    registered.
+
+  Remarks:
+    The driver would then run with wrong timings after a frequency change:
+    callers must check the result. A refused registration halts on
+    SYS_DEBUG_BreakPoint when a debugger is attached and is counted, see
+    SYS_CLK_CallbackRejectedCountGet.
+*/
+
+bool SYS_CLK_FrequencyChangeCallbackRegister
+    ( SYS_CLK_FREQ_CHANGE_CALLBACK callback );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_CLK_SwitchTicksGet ( void )
+
+  Summary:
+    Duration of the last frequency change, callbacks included.
+
+  Returns:
+    Core timer ticks (SYSCLK / 2) counted during the last call to
+    SYS_CLK_SystemFrequencyScale. The core timer follows the system clock,
+    the count mixes the old and new rates.
+*/
+
+uint32_t SYS_CLK_SwitchTicksGet ( void );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_CLK_CallbackRejectedCountGet ( void )
+
+  Summary:
+    Number of refused SYS_CLK_FrequencyChangeCallbackRegister calls.
+
+  Returns:
+    0 when every registered driver is notified of a frequency change.
+*/
+
+uint32_t SYS_CLK_CallbackRejectedCountGet ( void );
+
+#endif // #ifndef _SYS_CLK_STATIC_H
+
+/*******************************************************************************
+ End of File
+*/
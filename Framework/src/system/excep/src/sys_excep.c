@@ -0,0 +1,231 @@
+/*******************************************************************************
+  MPLAB Harmony Exceptions Source File
+
+  File Name:
+    sys_excep.c
+
+  Summary:
+    This file contains a function which overrides the deafult _weak_ exception
+    handler provided by the XC32 compiler.
+
+  Description:
+    This file redefines the default _weak_  exception handler with a more debug
+    friendly one. If an unexpected exception occurs a crash record is written
+    to persistent RAM and the device is reset by software. The record is
+    reported on the next boot through SYS_EXCEP_CrashRecordGet. The two
+    variables _excep_code and _except_addr can still be examined from the
+    debugger, which halts on SYS_DEBUG_BreakPoint before the reset.
+ *******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2013-2017 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED AS IS WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+ *******************************************************************************/
+// DOM-IGNORE-END
+
+
+#include <xc.h>                 /* Defines special function registers, CP0 regs  */
+#include "system_config.h"
+#include "system_definitions.h"
+#include "system/debug/sys_debug.h"
+#include "system/excep/sys_excep.h"
+#include <sys/kmem.h>
+
+#if defined(SYS_EXCEP_CRASH_HOOK_INCLUDE)
+#include SYS_EXCEP_CRASH_HOOK_INCLUDE
+#endif
+
+/* Application action after the record is written (system_config.h) */
+#ifndef SYS_EXCEP_CRASH_HOOK
+#define SYS_EXCEP_CRASH_HOOK()
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Exception Reason Data
+
+  <editor-fold defaultstate="expanded" desc="Exception Reason Data">
+
+  Remarks:
+    These global static items are used instead of local variables in the
+    _general_exception_handler function because the stack may not be available
+    if an exception has occured.
+*/
+
+/* Code identifying the cause of the exception (CP0 Cause register). */
+static unsigned int _excep_code;
+
+/* Address of instruction that caused the exception. */
+static unsigned int _excep_addr;
+
+/* Stack and return address registers of the faulting code. */
+static unsigned int _excep_sp;
+static unsigned int _excep_ra;
+
+/* Crash record, not cleared by the startup code so it survives a reset. */
+static SYS_CRASH_RECORD __attribute__((persistent)) _crash_record;
+
+/* Copy of the record validated at boot. */
+static SYS_CRASH_RECORD _crash_last;
+static bool _crash_last_valid = false;
+
+// </editor-fold>
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Exception Handling
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void _general_exception_handler ( unsigned int sp, unsigned int ra )
+
+  Summary:
+    Overrides the XC32 _weak_ _generic_exception_handler.
+
+  Description:
+    This function overrides the XC32 default _weak_ _generic_exception_handler.
+    It is called by _general_exception_context (sys_excep_entry.S)
+    with the sp and ra registers of the faulting code, on a private stack.
+
+  Remarks:
+    Refer to the XC32 User's Guide for additional information.
+ */
+
+
+void _general_exception_handler ( unsigned int sp, unsigned int ra )
+{
+    unsigned int i;
+    unsigned int *pStack;
+    bool stackValid;
+
+    _excep_sp = sp;
+    _excep_ra = ra;
+
+    /* Mask off Mask of the ExcCode Field from the Cause Register
+    Refer to the MIPs Software User's manual */
+    _excep_code = (_CP0_GET_CAUSE() & 0x0000007C) >> 2;
+    _excep_addr = _CP0_GET_EPC();
+
+    /* Fill the crash record, no function call as the stack may be corrupt */
+    _crash_record.nbCrashes++;
+    _crash_record.cause = _excep_code;
+    _crash_record.epc = _excep_addr;
+    _crash_record.badVAddr = _CP0_GET_BADVADDR();
+    _crash_record.sp = _excep_sp;
+    _crash_record.ra = _excep_ra;
+    _crash_record.status = _CP0_GET_STATUS();
+    _crash_record.ipl = (_crash_record.status & _CP0_STATUS_IPL_MASK) >> _CP0_STATUS_IPL_POSITION;
+
+    /* Stack words only if sp is aligned, in KSEG0 or KSEG1 and inside the
+       data RAM (physical address 0 to BMXDRMSZ). KVA_TO_PA alone drops the
+       segment bits, and any other read would fault again in this handler,
+       overwriting the record with its own exception. */
+    pStack = (unsigned int *)_excep_sp;
+    stackValid = ((_excep_sp & 0x3) == 0) &&
+                 (((_excep_sp & 0xE0000000) == 0x80000000) ||
+                  ((_excep_sp & 0xE0000000) == 0xA0000000));
+    for (i = 0; i < SYS_CRASH_STACK_WORDS; i++)
+    {
+        if (stackValid && (KVA_TO_PA(&pStack[i]) < BMXDRMSZ))
+        {
+            _crash_record.stack[i] = pStack[i];
+        }
+        else
+        {
+            _crash_record.stack[i] = 0;
+        }
+    }
+    _crash_record.magic = SYS_CRASH_MAGIC;
+
+    SYS_EXCEP_CRASH_HOOK();
+
+    /* Halts here when a debugger is attached */
+    SYS_DEBUG_BreakPoint();
+
+    /* Software reset : unlock, arm, then the read of RSWRST resets */
+    SYSKEY = 0x00000000;
+    SYSKEY = 0xAA996655;
+    SYSKEY = 0x556699AA;
+    RSWRSTSET = _RSWRST_SWRST_MASK;
+    (void)RSWRST;
+
+    while (1)
+    {
+    }
+}
+
+/*******************************************************************************
+  Function:
+    void SYS_EXCEP_CrashRecordCheck ( void )
+
+  Remarks:
+    See prototype in sys_excep.h.
+ */
+
+void SYS_EXCEP_CrashRecordCheck ( void )
+{
+    /* After a power on or brown out the persistent RAM holds garbage */
+    if ((RCON & (_RCON_POR_MASK | _RCON_BOR_MASK)) != 0)
+    {
+        _crash_record.magic = 0;
+        _crash_record.nbCrashes = 0;
+    }
+    else if (((RCON & _RCON_SWR_MASK) != 0) && (_crash_record.magic == SYS_CRASH_MAGIC))
+    {
+        _crash_last = _crash_record;
+        _crash_last_valid = true;
+    }
+
+    /* Consumed, nbCrashes keeps counting until the next power on */
+    _crash_record.magic = 0;
+    RCONCLR = _RCON_POR_MASK | _RCON_BOR_MASK | _RCON_SWR_MASK;
+}
+
+/*******************************************************************************
+  Function:
+    bool SYS_EXCEP_CrashRecordGet ( SYS_CRASH_RECORD *pRecord )
+
+  Remarks:
+    See prototype in sys_excep.h.
+ */
+
+bool SYS_EXCEP_CrashRecordGet ( SYS_CRASH_RECORD *pRecord )
+{
+    if (_crash_last_valid)
+    {
+        *pRecord = _crash_last;
+    }
+    return _crash_last_valid;
+}
+
+/*******************************************************************************
+ End of File
+*/
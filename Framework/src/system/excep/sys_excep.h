@@ -0,0 +1,123 @@
+/*******************************************************************************
+  MPLAB Harmony Exceptions Header File
+
+  File Name:
+    sys_excep.h
+
+  Summary:
+    Crash record kept across a software reset.
+
+  Description:
+    On an unexpected exception _general_exception_handler fills a crash
+    record placed in a persistent (not initialized by the startup code) RAM
+    section and performs a software reset. On the next boot the record can
+    be read back to report the cause and address of the exception.
+
+    Shared by the applications: src/sys_excep.c and src/sys_excep_entry.S
+    are project source files, not part of libminf_framework.a (the linker
+    would not pull an archive member only to replace the XC32
+    _general_exception_context and _general_exception_handler).
+
+    Optional configuration (system_config.h):
+      SYS_EXCEP_CRASH_HOOK_INCLUDE  header declaring the hook
+      SYS_EXCEP_CRASH_HOOK()        called once the record is written,
+                                    on the private exception stack
+ *******************************************************************************/
+
+#ifndef _SYS_EXCEP_H
+#define _SYS_EXCEP_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Marks a record written by the exception handler ("CRSH") */
+#define SYS_CRASH_MAGIC                 0x43525348ul
+
+/* Number of words copied from the stack pointer upwards */
+#define SYS_CRASH_STACK_WORDS           8
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Crash record
+
+  Summary:
+    Processor state captured by the exception handler.
+
+  Remarks:
+    sp and ra are those of the faulting code, passed to
+    _general_exception_handler by _general_exception_context before it
+    switches to its own stack. The stack words are read from that sp. ra
+    is the return address of the faulting function if it is a leaf, else
+    that of its last call.
+*/
+
+typedef struct
+{
+    uint32_t magic;                         /* SYS_CRASH_MAGIC when valid */
+    uint32_t nbCrashes;                     /* Crashes since power on */
+    uint32_t cause;                         /* ExcCode field of CP0 Cause */
+    uint32_t epc;                           /* Faulting instruction */
+    uint32_t badVAddr;                      /* Address of an address error */
+    uint32_t sp;
+    uint32_t ra;
+    uint32_t status;                        /* CP0 Status */
+    uint32_t ipl;                           /* 0 = main loop, n = ISR level n */
+    uint32_t stack[SYS_CRASH_STACK_WORDS];
+
+} SYS_CRASH_RECORD;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_EXCEP_CrashRecordCheck ( void )
+
+  Summary:
+    Validates the crash record left by the previous run.
+
+  Description:
+    Must be called first in SYS_Initialize. The record is kept only when the
+    reset was a software reset requested by the exception handler, the
+    reset flags are then cleared.
+*/
+
+void SYS_EXCEP_CrashRecordCheck ( void );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_EXCEP_CrashRecordGet ( SYS_CRASH_RECORD *pRecord )
+
+  Summary:
+    Gets the record of the crash that caused the last reset.
+
+  Returns:
+    true and a copy of the record if the last reset followed a crash.
+*/
+
+bool SYS_EXCEP_CrashRecordGet ( SYS_CRASH_RECORD *pRecord );
+
+#endif /* _SYS_EXCEP_H */
+/*******************************************************************************
+ End of File
+*/
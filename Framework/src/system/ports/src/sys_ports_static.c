@@ -50,10 +50,36 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 
 #include "system_config.h"
 #include "system/ports/sys_ports.h"
+#include "system/ports/sys_ports_pins.h"
 #include "peripheral/devcon/plib_devcon.h"
 #include "peripheral/ports/plib_ports.h"
 #include "peripheral/int/plib_int.h"
 
+/* Port init table, generated from SYS_PORTS_PIN_TABLE (system_config.h) */
+typedef struct
+{
+    uint16_t output;
+    uint16_t latch;
+    uint16_t openDrain;
+} SYS_PORTS_INIT_ENTRY;
+
+#define SYS_PORTS_INIT_ENTRY_FOR(channel) \
+    { SYS_PORTS_OUTPUT_MASK(channel), SYS_PORTS_LATCH_INIT(channel), \
+      SYS_PORTS_OPEN_DRAIN_MASK(channel) }
+
+static const SYS_PORTS_INIT_ENTRY sysPortsInit[] =
+{
+    SYS_PORTS_INIT_ENTRY_FOR(PORT_CHANNEL_A),
+    SYS_PORTS_INIT_ENTRY_FOR(PORT_CHANNEL_B),
+    SYS_PORTS_INIT_ENTRY_FOR(PORT_CHANNEL_C),
+    SYS_PORTS_INIT_ENTRY_FOR(PORT_CHANNEL_D),
+    SYS_PORTS_INIT_ENTRY_FOR(PORT_CHANNEL_E),
+    SYS_PORTS_INIT_ENTRY_FOR(PORT_CHANNEL_F),
+    SYS_PORTS_INIT_ENTRY_FOR(PORT_CHANNEL_G),
+};
+
+#define SYS_PORTS_NB_CHANNELS   (sizeof(sysPortsInit) / sizeof(sysPortsInit[0]))
+
 /******************************************************************************
   Function:
     SYS_PORTS_Initialize(void)
@@ -66,53 +92,43 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
     It also remaps the pins to the desired specific function.
 
   Remarks:
-    None.
+    Registers still at their reset value (no open drain, ports without
+    outputs, CN disabled) are not written.
 */
 void SYS_PORTS_Initialize(void)
 {
+    const SYS_PORTS_INIT_ENTRY *pEntry;
+    PORTS_CHANNEL channel;
+    uint8_t i;
 
     /* AN and CN Pins Initialization */
-    PLIB_PORTS_AnPinsModeSelect(PORTS_ID_0, SYS_PORT_AD1PCFG, PORTS_PIN_MODE_DIGITAL);
+    PLIB_PORTS_AnPinsModeSelect(PORTS_ID_0, SYS_PORTS_DIGITAL_MASK, PORTS_PIN_MODE_DIGITAL);
+#if (SYS_PORT_CNPUE != 0)
     PLIB_PORTS_CnPinsPullUpEnable(PORTS_ID_0, SYS_PORT_CNPUE);
+#endif
+#if (SYS_PORT_CNEN != 0)
     PLIB_PORTS_CnPinsEnable(PORTS_ID_0, SYS_PORT_CNEN);
     PLIB_PORTS_ChangeNoticeEnable(PORTS_ID_0);
+#endif
 
-    
-    /* PORT A Initialization */
-    PLIB_PORTS_OpenDrainEnable(PORTS_ID_0, PORT_CHANNEL_A, SYS_PORT_A_ODC);
-    PLIB_PORTS_Write( PORTS_ID_0, PORT_CHANNEL_A,  SYS_PORT_A_LAT);
-	PLIB_PORTS_DirectionOutputSet( PORTS_ID_0, PORT_CHANNEL_A,  SYS_PORT_A_TRIS ^ 0xFFFF);
-    
-    /* PORT B Initialization */
-    PLIB_PORTS_OpenDrainEnable(PORTS_ID_0, PORT_CHANNEL_B, SYS_PORT_B_ODC);
-    PLIB_PORTS_Write( PORTS_ID_0, PORT_CHANNEL_B,  SYS_PORT_B_LAT);
-	PLIB_PORTS_DirectionOutputSet( PORTS_ID_0, PORT_CHANNEL_B,  SYS_PORT_B_TRIS ^ 0xFFFF);
-    
-    /* PORT C Initialization */
-    PLIB_PORTS_OpenDrainEnable(PORTS_ID_0, PORT_CHANNEL_C, SYS_PORT_C_ODC);
-    PLIB_PORTS_Write( PORTS_ID_0, PORT_CHANNEL_C,  SYS_PORT_C_LAT);
-	PLIB_PORTS_DirectionOutputSet( PORTS_ID_0, PORT_CHANNEL_C,  SYS_PORT_C_TRIS ^ 0xFFFF);
-    
-    /* PORT D Initialization */
-    PLIB_PORTS_OpenDrainEnable(PORTS_ID_0, PORT_CHANNEL_D, SYS_PORT_D_ODC);
-    PLIB_PORTS_Write( PORTS_ID_0, PORT_CHANNEL_D,  SYS_PORT_D_LAT);
-	PLIB_PORTS_DirectionOutputSet( PORTS_ID_0, PORT_CHANNEL_D,  SYS_PORT_D_TRIS ^ 0xFFFF);
-    
-    /* PORT E Initialization */
-    PLIB_PORTS_OpenDrainEnable(PORTS_ID_0, PORT_CHANNEL_E, SYS_PORT_E_ODC);
-    PLIB_PORTS_Write( PORTS_ID_0, PORT_CHANNEL_E,  SYS_PORT_E_LAT);
-	PLIB_PORTS_DirectionOutputSet( PORTS_ID_0, PORT_CHANNEL_E,  SYS_PORT_E_TRIS ^ 0xFFFF);
-    
-    /* PORT F Initialization */
-    PLIB_PORTS_OpenDrainEnable(PORTS_ID_0, PORT_CHANNEL_F, SYS_PORT_F_ODC);
-    PLIB_PORTS_Write( PORTS_ID_0, PORT_CHANNEL_F,  SYS_PORT_F_LAT);
-	PLIB_PORTS_DirectionOutputSet( PORTS_ID_0, PORT_CHANNEL_F,  SYS_PORT_F_TRIS ^ 0xFFFF);
-    
-    /* PORT G Initialization */
-    PLIB_PORTS_OpenDrainEnable(PORTS_ID_0, PORT_CHANNEL_G, SYS_PORT_G_ODC);
-    PLIB_PORTS_Write( PORTS_ID_0, PORT_CHANNEL_G,  SYS_PORT_G_LAT);
-	PLIB_PORTS_DirectionOutputSet( PORTS_ID_0, PORT_CHANNEL_G,  SYS_PORT_G_TRIS ^ 0xFFFF);
-    
+    /* PORT A to G Initialization */
+    for (i = 0; i < SYS_PORTS_NB_CHANNELS; i++)
+    {
+        pEntry = &sysPortsInit[i];
+        channel = (PORTS_CHANNEL)(PORT_CHANNEL_A + i);
+
+        /* Without outputs the port keeps its reset state : all inputs */
+        if (pEntry->output == 0)
+        {
+            continue;
+        }
+        if (pEntry->openDrain != 0)
+        {
+            PLIB_PORTS_OpenDrainEnable(PORTS_ID_0, channel, pEntry->openDrain);
+        }
+        PLIB_PORTS_Write(PORTS_ID_0, channel, pEntry->latch);
+        PLIB_PORTS_DirectionOutputSet(PORTS_ID_0, channel, pEntry->output);
+    }
 }
 
 /******************************************************************************
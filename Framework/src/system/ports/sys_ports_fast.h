@@ -0,0 +1,121 @@
+/*******************************************************************************
+  Ports System Service Fast Pin Access
+
+  File Name:
+    sys_ports_fast.h
+
+  Summary:
+    Inline pin set, clear, toggle and write for constant pins.
+
+  Description:
+    SYS_PORTS_PinSet, PinClear, PinToggle and PinWrite are out-of-line
+    functions forwarding index, channel and bit position to the PLIB at run
+    time. The macros below resolve, when channel and bitPos are compile-time
+    constants, to a single store to the LATxSET, LATxCLR or LATxINV register
+    of the pin. Otherwise they call the generic SYS_PORTS_Pin* function.
+
+    The constant test is done by __builtin_constant_p inside the macro, so
+    the fast path is selected even at -O0.
+
+  Remarks:
+    Only PORTS_ID_0 exists on PIC32MX. Port registers are laid out every
+    0x40 bytes from TRISA: TRISx, PORTx, LATx, ODCx, each followed by its
+    CLR, SET and INV registers.
+*******************************************************************************/
+
+#ifndef _SYS_PORTS_FAST_H
+#define _SYS_PORTS_FAST_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include <stdint.h>
+#include "system/ports/sys_ports.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Register Access
+// *****************************************************************************
+// *****************************************************************************
+
+/* Word offsets from LATx */
+#define SYS_PORTS_FAST_CLR              1
+#define SYS_PORTS_FAST_SET              2
+#define SYS_PORTS_FAST_INV              3
+
+/* Word distance between two ports (0x40 bytes) */
+#define SYS_PORTS_FAST_STRIDE           16
+
+#define _SYS_PORTS_FAST_LAT(channel, reg) \
+    (*(&LATA + ((uint32_t)(channel) * SYS_PORTS_FAST_STRIDE) + (reg)))
+
+#define _SYS_PORTS_FAST_IS_CONST(channel, bitPos) \
+    (__builtin_constant_p(channel) && __builtin_constant_p(bitPos))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_PORTS_FastPinSet ( PORTS_CHANNEL channel, PORTS_BIT_POS bitPos )
+
+  Summary:
+    Sets the selected pin, one store to LATxSET for constant arguments.
+*/
+
+#define SYS_PORTS_FastPinSet(channel, bitPos) \
+    (_SYS_PORTS_FAST_IS_CONST(channel, bitPos) ? \
+        (void)(_SYS_PORTS_FAST_LAT(channel, SYS_PORTS_FAST_SET) = (1u << (bitPos))) : \
+        SYS_PORTS_PinSet(PORTS_ID_0, (channel), (bitPos)))
+
+// *****************************************************************************
+/* Function:
+    void SYS_PORTS_FastPinClear ( PORTS_CHANNEL channel, PORTS_BIT_POS bitPos )
+
+  Summary:
+    Clears the selected pin, one store to LATxCLR for constant arguments.
+*/
+
+#define SYS_PORTS_FastPinClear(channel, bitPos) \
+    (_SYS_PORTS_FAST_IS_CONST(channel, bitPos) ? \
+        (void)(_SYS_PORTS_FAST_LAT(channel, SYS_PORTS_FAST_CLR) = (1u << (bitPos))) : \
+        SYS_PORTS_PinClear(PORTS_ID_0, (channel), (bitPos)))
+
+// *****************************************************************************
+/* Function:
+    void SYS_PORTS_FastPinToggle ( PORTS_CHANNEL channel, PORTS_BIT_POS bitPos )
+
+  Summary:
+    Toggles the selected pin, one store to LATxINV for constant arguments.
+*/
+
+#define SYS_PORTS_FastPinToggle(channel, bitPos) \
+    (_SYS_PORTS_FAST_IS_CONST(channel, bitPos) ? \
+        (void)(_SYS_PORTS_FAST_LAT(channel, SYS_PORTS_FAST_INV) = (1u << (bitPos))) : \
+        SYS_PORTS_PinToggle(PORTS_ID_0, (channel), (bitPos)))
+
+// *****************************************************************************
+/* Function:
+    void SYS_PORTS_FastPinWrite ( PORTS_CHANNEL channel, PORTS_BIT_POS bitPos,
+                                  bool value )
+
+  Summary:
+    Writes the selected pin through LATxSET or LATxCLR.
+*/
+
+#define SYS_PORTS_FastPinWrite(channel, bitPos, value) \
+    ((value) ? SYS_PORTS_FastPinSet(channel, bitPos) : \
+               SYS_PORTS_FastPinClear(channel, bitPos))
+
+#endif // _SYS_PORTS_FAST_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,122 @@
+/*******************************************************************************
+  Ports System Service Pin Configuration
+
+  File Name:
+    sys_ports_pins.h
+
+  Summary:
+    Port init masks and pin map generated from SYS_PORTS_PIN_TABLE.
+
+  Description:
+    The pins of the board are described once, in the SYS_PORTS_PIN_TABLE
+    list of the application's system_config.h :
+
+        PIN(name, port, bit, mode, initial latch, arg)
+
+    with mode OUT, OD (open drain output), IN or AN (analog input). Pins
+    not listed stay digital inputs.
+
+    From this list are generated :
+      - the output, latch and open drain masks of each port, used by
+        SYS_PORTS_Initialize
+      - the digital pin mask written to AD1PCFG
+      - the pin map SYS_PIN_<name>_CHANNEL, SYS_PIN_<name>_BIT and
+        SYS_PIN_<name>_MASK, compile-time constants usable with
+        sys_ports_fast.h
+
+  Remarks:
+    On PIC32MX7xx the analog inputs AN0-AN15 are the pins of port B.
+*******************************************************************************/
+
+#ifndef _SYS_PORTS_PINS_H
+#define _SYS_PORTS_PINS_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include "system_config.h"
+#include "system/ports/sys_ports.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Pin Modes
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_PORTS_MODE_IN               0
+#define SYS_PORTS_MODE_OUT              1
+#define SYS_PORTS_MODE_OD               2
+#define SYS_PORTS_MODE_AN               3
+
+#define _SYS_PORTS_IS_OUTPUT(mode) \
+    ((SYS_PORTS_MODE_##mode == SYS_PORTS_MODE_OUT) || \
+     (SYS_PORTS_MODE_##mode == SYS_PORTS_MODE_OD))
+
+/* Bit of the pin if it belongs to channel and cond is true */
+#define _SYS_PORTS_BIT_IF(port, bit, cond, channel) \
+    ((((PORT_CHANNEL_##port) == (channel)) && (cond)) ? (1u << (bit)) : 0u)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Port Init Masks
+// *****************************************************************************
+// *****************************************************************************
+
+#define _SYS_PORTS_OUTPUT_BIT(name, port, bit, mode, init, channel) \
+    | _SYS_PORTS_BIT_IF(port, bit, _SYS_PORTS_IS_OUTPUT(mode), channel)
+
+#define _SYS_PORTS_LATCH_BIT(name, port, bit, mode, init, channel) \
+    | _SYS_PORTS_BIT_IF(port, bit, _SYS_PORTS_IS_OUTPUT(mode) && ((init) != 0), channel)
+
+#define _SYS_PORTS_OPEN_DRAIN_BIT(name, port, bit, mode, init, channel) \
+    | _SYS_PORTS_BIT_IF(port, bit, SYS_PORTS_MODE_##mode == SYS_PORTS_MODE_OD, channel)
+
+#define _SYS_PORTS_ANALOG_BIT(name, port, bit, mode, init, channel) \
+    | _SYS_PORTS_BIT_IF(port, bit, SYS_PORTS_MODE_##mode == SYS_PORTS_MODE_AN, channel)
+
+/* Pins of the channel driven as outputs (cleared in TRISx) */
+#define SYS_PORTS_OUTPUT_MASK(channel) \
+    ((uint16_t)(0u SYS_PORTS_PIN_TABLE(_SYS_PORTS_OUTPUT_BIT, channel)))
+
+/* Initial value of LATx */
+#define SYS_PORTS_LATCH_INIT(channel) \
+    ((uint16_t)(0u SYS_PORTS_PIN_TABLE(_SYS_PORTS_LATCH_BIT, channel)))
+
+/* Open drain outputs (set in ODCx) */
+#define SYS_PORTS_OPEN_DRAIN_MASK(channel) \
+    ((uint16_t)(0u SYS_PORTS_PIN_TABLE(_SYS_PORTS_OPEN_DRAIN_BIT, channel)))
+
+/* Digital pins of port B, written to AD1PCFG */
+#define SYS_PORTS_DIGITAL_MASK \
+    ((uint16_t)~(0u SYS_PORTS_PIN_TABLE(_SYS_PORTS_ANALOG_BIT, PORT_CHANNEL_B)))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Pin Map
+// *****************************************************************************
+// *****************************************************************************
+
+/* Mask of the pin if it belongs to channel, to build masks of pin groups */
+#define SYS_PORTS_PIN_MASK_IN(name, channel) \
+    (((int)SYS_PIN_##name##_CHANNEL == (int)(channel)) ? (uint16_t)SYS_PIN_##name##_MASK : 0u)
+
+#define _SYS_PORTS_PIN_MAP(name, port, bit, mode, init, arg) \
+    SYS_PIN_##name##_CHANNEL = PORT_CHANNEL_##port, \
+    SYS_PIN_##name##_BIT = (bit), \
+    SYS_PIN_##name##_MASK = (1 << (bit)),
+
+typedef enum
+{
+    SYS_PORTS_PIN_TABLE(_SYS_PORTS_PIN_MAP, 0)
+
+} SYS_PORTS_PIN_MAP;
+
+#endif // _SYS_PORTS_PINS_H
+
+/*******************************************************************************
+ End of File
+*/
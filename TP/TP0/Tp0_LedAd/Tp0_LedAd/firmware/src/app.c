@@ -56,6 +56,15 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "app.h"            // Contient les dfinitions, prototypes et structures de l'application.
 #include "Mc32DriverLcd.h"  // Fournit les fonctions pour grer l'cran LCD (initialisation, affichage, etc.).
 #include "Mc32DriverAdc.h"   // Fournit les fonctions et structures pour grer le convertisseur analogique-numrique (ADC).
+#include "hotPath.h"        // Placement en RAM des fonctions appeles  chaque tic.
+#include "gestTelemetry.h"  // Envoi des mesures ADC au PC (UART + DMA).
+#include "gestFlashLog.h"   // Historique des mesures ADC en flash programme.
+#include "eventTrace.h"     // Trace des vnements (TRC_ENABLE).
+#include "dspFilter.h"      // Filtres des mesures, mesure de leur cot (FLT_BENCH_ENABLE).
+#include "gestSpectrum.h"   // Spectre des mesures par FFT (dspFft.h).
+#include "gestStats.h"      // Statistiques des mesures (moyenne, variance, histogramme).
+#include "gestCalib.h"      // Calibration des mesures (table en flash).
+#include "gestDds.h"        // Gnrateur de signaux DDS sur OC1 (RD0, GDDS_ENABLE).
 #include "bsp.h"            // Inclut les fonctions spcifiques au matriel (ADC, LEDs, etc.).
 #include <stdbool.h>         // Permet l'utilisation du type bool (true/false).
 #include <stdint.h>          // Fournit des types standard tels que uint8_t, uint32_t, etc.
@@ -96,7 +105,7 @@ APP_DATA appData;
  * Appele lors de chaque interruption du Timer 1. Gre un compteur pour les premires
  * secondes et lance l'excution de tches aprs ce dlai.
  */
-void App_Timer1Callback()
+HOT_RAMFUNC void App_Timer1Callback()
 {
     static int8_t Iteration = 0;      // Compteur pour suivre les cycles (100 ms par cycle)
     static bool InitialDelayDone = false; // Indique si le dlai initial de 3 secondes est termin
@@ -110,6 +119,12 @@ void App_Timer1Callback()
             InitialDelayDone = true; // Le dlai initial est termin
             APP_UpdateState(APP_STATE_SERVICE_TASKS); // Passe  l'tat APP_STATE_SERVICE_TASKS
         }
+#if APP_FAST_START == 1
+        else
+        {
+            APP_UpdateState(APP_STATE_SERVICE_ADC); // Mesures dj actives pendant l'attente
+        }
+#endif
     }
     else
     {
@@ -123,14 +138,122 @@ void App_Timer1Callback()
 // *****************************************************************************
 // *****************************************************************************
 
+/**
+ * @brief Initialise le LCD et affiche le texte d'introduction.
+ *
+ * Opration lente (dlais du contrleur LCD), diffre en dmarrage rapide.
+ */
+static void APP_LcdInit(void)
+{
+    SYS_CRASH_RECORD crash; // Rapport du crash prcdent
+    SYS_WDM_RECORD wdmReset; // Rapport du reset watchdog prcdent
+
+    TRC_BEGIN(LCD, 0);
+    lcd_init(); // Initialisation de l'cran LCD
+    lcd_bl_on(); // Allume le rtroclairage du LCD
+    
+    lcd_gotoxy(1,1); // Positionne le curseur  la premire ligne
+    printf_lcd("TP0 LED+AD 2024-25"); // Affiche un texte d'introduction
+    lcd_gotoxy(1,2); // Positionne le curseur  la deuxime ligne
+    printf_lcd("Mendes Leo"); // Affiche le nom de l'auteur
+
+    if (SYS_EXCEP_CrashRecordGet(&crash)) // Redmarrage aprs une exception
+    {
+        lcd_gotoxy(1,4);
+        printf_lcd("Exc%2u EPC %08X", (unsigned)crash.cause, (unsigned)crash.epc);
+        appData.lcdReport = true;
+    }
+    else if (SYS_WDM_ResetRecordGet(&wdmReset)) // Redmarrage par le watchdog
+    {
+        lcd_gotoxy(1,4);
+        printf_lcd("WDT tache %u +%lums", (unsigned)wdmReset.taskId, (unsigned long)wdmReset.lateMs);
+        appData.lcdReport = true;
+    }
+    else if (SYS_CLK_CallbackRejectedCountGet() != 0) // Table des rappels d'horloge pleine
+    {
+        lcd_gotoxy(1,4);
+        printf_lcd("Rappels clk refus%3lu", (unsigned long)SYS_CLK_CallbackRejectedCountGet());
+        appData.lcdReport = true;
+    }
+
+    TRC_END(LCD, 0);
+
+    appData.lcdPending = false;
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_LCD);
+}
+
+/**
+ * @brief Affiche en ligne 4 les temps de dmarrage (SYS_BOOT_ReportGet).
+ *
+ * Contrle actif et LCD prt, en ms depuis l'entre dans SYS_Initialize.
+ * Une seule fois,  la premire mesure affiche : les deux tapes sont
+ * alors marques. Le spectre remplace la ligne au bloc suivant.
+ */
+static void APP_ShowBootReport(void)
+{
+    SYS_BOOT_REPORT boot;
+    const uint32_t needed = (1ul << SYS_BOOT_STAGE_CONTROL) | (1ul << SYS_BOOT_STAGE_LCD);
+
+    SYS_BOOT_ReportGet(&boot);
+    if ((boot.validMask & needed) == needed)
+    {
+        lcd_gotoxy(1,4);
+        printf_lcd("Ctl%5lu Lcd%5lu ms",
+                   (unsigned long)(boot.stageTicks[SYS_BOOT_STAGE_CONTROL] / (SYS_BOOT_TICKS_PER_US * 1000ul)),
+                   (unsigned long)(boot.stageTicks[SYS_BOOT_STAGE_LCD] / (SYS_BOOT_TICKS_PER_US * 1000ul)));
+    }
+    appData.bootShown = true;
+}
+
+/**
+ * @brief Lit les ADC et affiche les rsultats (si le LCD est prt).
+ * Ligne 4 : temps de dmarrage  la premire mesure, puis raie dominante
+ * de Chan0  chaque bloc analys, sauf si elle affiche le rapport de
+ * redmarrage.
+ */
+static void APP_ServiceAdc(void)
+{
+    char line[GSPC_LINE_SIZE + 1];
+    bool newSpectrum;
+
+    appData.AdcRes = BSP_ReadAllADC(); // Lecture des rsultats des ADC
+    GCAL_ApplyAdc(&appData.AdcRes); // Mesures corriges (offset, gain, linarit)
+    TRC_POINT(ADC_DONE, appData.AdcRes.Chan0);
+    GTLM_PushAdc(&appData.AdcRes); // Mesure horodate vers la tlmtrie
+    GFLG_PushAdc(&appData.AdcRes); // Moyenne enregistre en flash (1 / 10 s)
+    GSTA_PushAdc(&appData.AdcRes); // Statistiques, lues par GSTA_GetSnapshot
+    newSpectrum = GSPC_PushAdc(&appData.AdcRes); // FFT  chaque bloc de GSPC_SIZE mesures
+    
+    if (appData.lcdPending == false)
+    {
+        TRC_BEGIN(LCD, 1);
+        lcd_gotoxy(1,3); // Positionne le curseur  la troisime ligne
+        printf_lcd("Ch0 %4d Ch1 %4d", appData.AdcRes.Chan0, appData.AdcRes.Chan1); // Affiche les valeurs des ADC
+        TRC_END(LCD, 1);
+
+        if ((appData.bootShown == false) && (appData.lcdReport == false))
+        {
+            APP_ShowBootReport();
+        }
+        else if (newSpectrum && (appData.lcdReport == false))
+        {
+            TRC_BEGIN(LCD, 2);
+            GSPC_FormatLine(0, line);
+            lcd_gotoxy(1,4);
+            printf_lcd("%s", line); // Frquence et barre d'amplitude (6 dB / caractre)
+            TRC_END(LCD, 2);
+        }
+    }
+}
+
 /**
  * @brief Gre l'activation d'une LED dans une squence de chaser.
  *
  * Cette fonction teint d'abord toutes les LEDs, puis active une LED spcifique 
  * selon la position dans le tableau `ledPins`. La LED active est dtermine par 
  * la valeur de `_chaserPosition`, qui doit tre un index dans la plage [0, LED_COUNT-1].
- * Le port et la pin associs  chaque LED sont dfinis par les constantes spcifiques 
- * pour les pins de PORTA et PORTB.
+ * Le port et le masque de chaque LED sont gnrs depuis la table des broches
+ * (SYS_PORTS_PIN_TABLE), via la liste APP_LEDS.
  *
  * @param _chaserPosition L'index de la LED  activer dans le tableau `ledPins`.
  *                        La valeur doit tre comprise entre 0 et `LED_COUNT - 1`.
@@ -139,25 +262,22 @@ void App_Timer1Callback()
  */
 void chaser(uint8_t _chaserPosition)
 {
-    // Accder directement  la LED correspondante
-    static uint8_t ledPin ;
-    // Tableau des positions des LEDs actives
-    static const uint8_t ledPins[NBR_LEDS] = {RA0, RA1, RA4, RA5, RA6, RA15, RB10};
+    // Port et masque de chaque LED, dans l'ordre du chenillard
+    static const uint8_t ledPorts[NBR_LEDS] = { APP_LEDS(APP_LED_CHANNEL, 0) };
+    static const uint16_t ledPins[NBR_LEDS] = { APP_LEDS(APP_LED_PIN_MASK, 0) };
     
     // teindre toutes les LEDs
     TurnOffAllLEDs();
 
-    ledPin= ledPins[_chaserPosition];
-
-    // Si la LED est sur le PORTA (RA0  RA7 et RA15), on l'active
-    if (ledPin <= (RA6+1) || ledPin == RA15) 
+    // Si la LED est sur le PORTA, on l'active
+    if (ledPorts[_chaserPosition] == PORT_CHANNEL_A) 
     {
-        LATA &= ~(1 << ledPin);  // Met le bit correspondant  0
+        LATACLR = ledPins[_chaserPosition];  // Met le bit correspondant  0
     }
-    // Si la LED est sur le PORTB (RB10), on l'active
-    else if (ledPin == RB10) 
+    // Si la LED est sur le PORTB, on l'active
+    else if (ledPorts[_chaserPosition] == PORT_CHANNEL_B) 
     {
-        LATB &= ~(1 << ledPin);  // Met le bit correspondant  0
+        LATBCLR = ledPins[_chaserPosition];  // Met le bit correspondant  0
     }
 }
 
@@ -215,6 +335,10 @@ void APP_Initialize ( void )
 {
     /* Place the App state machine in its initial state. */
     appData.state = APP_STATE_INIT;
+    appData.lcdPending = true;
+    appData.lcdReport = false;
+    appData.bootShown = false;
+    appData.wdmTask = SYS_WDM_TASK_INVALID;
 
     
     /* TODO: Initialize your application's state machine and other
@@ -242,17 +366,28 @@ void APP_Tasks ( void )
         /* Application's initial state. */
         case APP_STATE_INIT:
         {
-            lcd_init(); // Initialisation de l'cran LCD
-            lcd_bl_on(); // Allume le rtroclairage du LCD
-            
-            lcd_gotoxy(1,1); // Positionne le curseur  la premire ligne
-            printf_lcd("TP0 LED+AD 2024-25"); // Affiche un texte d'introduction
-            lcd_gotoxy(1,2); // Positionne le curseur  la deuxime ligne
-            printf_lcd("Mendes Leo"); // Affiche le nom de l'auteur
-            
+#if APP_FAST_START == 0
+            APP_LcdInit(); // LCD avant le reste (dmarrage standard)
+#endif
             BSP_InitADC10(); // Initialisation des ADC (convertisseurs analogiques-numriques)
+            GCAL_Initialize(); // Table de calibration lue en flash (identit si absente)
+            GCAL_Bench(); // Cycles par mesure corrige, rsultat dans gcalBench
+            GTLM_Initialize(); // UART et DMA de la tlmtrie
+            GFLG_Initialize(); // Reprise du journal en flash aprs la dernire range
+            FLT_Bench(); // Cycles par coefficient des filtres, rsultat dans fltBench
+            FFT_Bench(); // Cycles par transforme, rsultat dans fftBench
+            GSPC_Initialize(); // Premier bloc du spectre
+            GSTA_Initialize(); // Statistiques remises  zro
+#if GDDS_ENABLE == 1
+            GDDS_Initialize(); // Gnrateur DDS : sinus 1 kHz, arrt
+            PLIB_PORTS_PinDirectionOutputSet(PORTS_ID_0, GDDS_PIN_CHANNEL, GDDS_PIN_BIT); // RD0 en sortie (OC1)
+            GDDS_Bench(); // Charge CPU par mode et cadence, rsultat dans gddsBench
+            GDDS_SetAmplitude(GDDS_AMPLITUDE_MAX / 2); // Demi-chelle
+            GDDS_Start(GDDS_RATE_DEFAULT_HZ, GDDS_MODE_DMA); // Sinus sur RD0 (filtre RC externe)
+#endif
             TurnOnAllLEDs(); // Allume toutes les LEDs
             DRV_TMR0_Start(); // Dmarre le timer 0 avec une priode de 100 ms
+            SYS_BOOT_StageMark(SYS_BOOT_STAGE_CONTROL);
             
             APP_UpdateState(APP_STATE_WAIT); // Passe  l'tat WAIT
             break;
@@ -260,15 +395,31 @@ void APP_Tasks ( void )
         
         case APP_STATE_WAIT:
         {
-            break; // Ne fait rien dans cet tat, en attente d'un dclencheur
+            if (appData.lcdPending == true) // Init LCD diffre (dmarrage rapide)
+            {
+                APP_LcdInit();
+            }
+            break; // En attente d'un dclencheur
+        }
+
+        case APP_STATE_SERVICE_ADC:
+        {
+            TRC_BEGIN(APP_SERVICE, APP_STATE_SERVICE_ADC);
+            APP_ServiceAdc(); // Mesures seules pendant l'attente post-init
+            TRC_END(APP_SERVICE, APP_STATE_SERVICE_ADC);
+            APP_UpdateState(APP_STATE_WAIT); // Retourne  l'tat WAIT
+            break;
         }
 
         case APP_STATE_SERVICE_TASKS:
         {
+            TRC_BEGIN(APP_SERVICE, APP_STATE_SERVICE_TASKS);
             if (First_iteration == true) // Si c'est la premire itration
             {
                 TurnOffAllLEDs(); // teint toutes les LEDs
                 First_iteration = false; // Marque la fin de la premire itration
+                // Service priodique surveill ds la fin de l'attente post-init
+                appData.wdmTask = SYS_WDM_TaskRegister(APP_WDM_MAX_PERIOD_MS);
             }
             else
             {
@@ -280,10 +431,9 @@ void APP_Tasks ( void )
                 chaser(chaserPosition); // Met  jour l'tat des LEDs
             }
             
-            appData.AdcRes = BSP_ReadAllADC(); // Lecture des rsultats des ADC
-            
-            lcd_gotoxy(1,3); // Positionne le curseur  la troisime ligne
-            printf_lcd("Ch0 %4d Ch1 %4d", appData.AdcRes.Chan0, appData.AdcRes.Chan1); // Affiche les valeurs des ADC
+            APP_ServiceAdc(); // Lecture et affichage des ADC
+            SYS_WDM_CheckIn(appData.wdmTask); // Service effectu dans les temps
+            TRC_END(APP_SERVICE, APP_STATE_SERVICE_TASKS);
             
             APP_UpdateState(APP_STATE_WAIT); // Retourne  l'tat WAIT
             break;
@@ -308,6 +458,7 @@ void APP_Tasks ( void )
  */ 
 void APP_UpdateState (APP_STATES Newstate)
 {
+    TRC_POINT(APP_STATE, Newstate);
     appData.state = Newstate; // Met  jour l'tat de l'application
 }
 /*******************************************************************************
@@ -54,6 +54,7 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 
 #include "system_config.h"   // Dfinit la configuration spcifique du systme Harmony.
 #include "system_definitions.h" // Contient les dfinitions globales et les fonctions systme (timers, interruptions, etc.).
+#include "system/ports/sys_ports_pins.h" // Table des broches : masques et positions des LEDs.
 #include "Mc32DriverAdc.h"   // Fournit les fonctions et structures pour grer le convertisseur analogique-numrique (ADC).
 
 // DOM-IGNORE-BEGIN
@@ -69,22 +70,32 @@ extern "C" {
 // Section: Type Definitions
 // *****************************************************************************
 // *****************************************************************************
-#define NBR_LEDS 8
-// Dfinition des positions des LEDs
-#define RA0 0
-#define RA1 1
-#define RA4 4
-#define RA5 5
-#define RA6 6
-#define RA15 15
-#define RB10 10
+// LEDs du chenillard, dans l'ordre. Port et bit viennent de la table
+// SYS_PORTS_PIN_TABLE (system_config.h), comme l'init des ports.
+#define APP_LEDS(LED, arg) \
+    LED(LED0, arg) LED(LED1, arg) LED(LED2, arg) LED(LED3, arg) \
+    LED(LED4, arg) LED(LED5, arg) LED(LED6, arg) LED(LED7, arg)
+
+#define APP_LED_COUNT(name, arg)    + 1
+#define APP_LED_MASK(name, channel) | SYS_PORTS_PIN_MASK_IN(name, channel)
+#define APP_LED_CHANNEL(name, arg)  SYS_PIN_##name##_CHANNEL,
+#define APP_LED_PIN_MASK(name, arg) SYS_PIN_##name##_MASK,
+
+#define NBR_LEDS (0 APP_LEDS(APP_LED_COUNT, 0))
 
     // Masques pour les LEDs
-#define LEDS_PORTA_MASK  0b1000011111110011 // RA0-RA7 et RA15
-#define LEDS_PORTB_MASK  0b0000010000000000 // RB10 
+#define LEDS_PORTA_MASK  (0u APP_LEDS(APP_LED_MASK, PORT_CHANNEL_A))
+#define LEDS_PORTB_MASK  (0u APP_LEDS(APP_LED_MASK, PORT_CHANNEL_B))
  
 // Nbr d'iterations de 100ms lors de l'attente post-init 
 #define NBR_TIC_INIT_TIME 29
+
+// Dlai max. entre 2 services priodiques (100 ms) avant reset watchdog
+#define APP_WDM_MAX_PERIOD_MS 300
+
+// 1 = dmarrage rapide : timer et ADC d'abord, init LCD diffre dans
+// l'tat WAIT, lecture ADC ds le 1er tic (pendant l'attente post-init)
+#define APP_FAST_START 1
 // *****************************************************************************
 /* Application states
 
@@ -102,6 +113,7 @@ typedef enum
 	APP_STATE_INIT=0,
     APP_STATE_WAIT,        
 	APP_STATE_SERVICE_TASKS,
+    APP_STATE_SERVICE_ADC,  // lecture ADC seule, pendant l'attente post-init
 
 	/* TODO: Define states used by the application state machine. */
 
@@ -126,6 +138,10 @@ typedef struct
     /* The application's current state */
     S_ADCResults AdcRes;
     APP_STATES state;
+    bool lcdPending;        // init LCD pas encore faite (dmarrage rapide)
+    bool lcdReport;         // ligne 4 : rapport de redmarrage, pas de spectre
+    bool bootShown;         // ligne 4 : temps de dmarrage dj affichs
+    SYS_WDM_TASK_ID wdmTask; // surveillance du service priodique
 
     /* TODO: Define any additional data used by the application. */
 
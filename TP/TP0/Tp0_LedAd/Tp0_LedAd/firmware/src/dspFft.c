@@ -0,0 +1,411 @@
+/*--------------------------------------------------------*/
+// DspFft.c
+/*--------------------------------------------------------*/
+//	Description :	FFT complexe en virgule fixe (Q15), 64 a 1024
+//			        points, et analyse du spectre d'un bloc de
+//			        mesures ADC (raies dominantes)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include "dspFft.h"
+
+// Facteurs de rotation W^k = cos - j sin, angle 2 pi k / FFT_MAX_SIZE,
+// Q15 arrondi (cos 0 sature a 32767). Regeneree et verifiee par
+// sim/simFft -w.
+static const S_fftComplex fftTwiddle[FFT_TWIDDLE_SIZE] = {
+    { 32767,     0}, { 32767,   201}, { 32766,   402}, { 32762,   603}, { 32758,   804}, { 32753,  1005},
+    { 32746,  1206}, { 32738,  1407}, { 32729,  1608}, { 32718,  1809}, { 32706,  2009}, { 32693,  2210},
+    { 32679,  2411}, { 32664,  2611}, { 32647,  2811}, { 32629,  3012}, { 32610,  3212}, { 32590,  3412},
+    { 32568,  3612}, { 32546,  3812}, { 32522,  4011}, { 32496,  4211}, { 32470,  4410}, { 32442,  4609},
+    { 32413,  4808}, { 32383,  5007}, { 32352,  5205}, { 32319,  5404}, { 32286,  5602}, { 32251,  5800},
+    { 32214,  5998}, { 32177,  6195}, { 32138,  6393}, { 32099,  6590}, { 32058,  6787}, { 32015,  6983},
+    { 31972,  7180}, { 31927,  7376}, { 31881,  7571}, { 31834,  7767}, { 31786,  7962}, { 31737,  8157},
+    { 31686,  8351}, { 31634,  8546}, { 31581,  8740}, { 31527,  8933}, { 31471,  9127}, { 31415,  9319},
+    { 31357,  9512}, { 31298,  9704}, { 31238,  9896}, { 31177, 10088}, { 31114, 10279}, { 31050, 10469},
+    { 30986, 10660}, { 30920, 10850}, { 30853, 11039}, { 30784, 11228}, { 30715, 11417}, { 30644, 11605},
+    { 30572, 11793}, { 30499, 11980}, { 30425, 12167}, { 30350, 12354}, { 30274, 12540}, { 30196, 12725},
+    { 30118, 12910}, { 30038, 13095}, { 29957, 13279}, { 29875, 13463}, { 29792, 13646}, { 29707, 13828},
+    { 29622, 14010}, { 29535, 14192}, { 29448, 14373}, { 29359, 14553}, { 29269, 14733}, { 29178, 14912},
+    { 29086, 15091}, { 28993, 15269}, { 28899, 15447}, { 28803, 15624}, { 28707, 15800}, { 28610, 15976},
+    { 28511, 16151}, { 28411, 16326}, { 28311, 16500}, { 28209, 16673}, { 28106, 16846}, { 28002, 17018},
+    { 27897, 17190}, { 27791, 17361}, { 27684, 17531}, { 27576, 17700}, { 27467, 17869}, { 27357, 18037},
+    { 27246, 18205}, { 27133, 18372}, { 27020, 18538}, { 26906, 18703}, { 26791, 18868}, { 26674, 19032},
+    { 26557, 19195}, { 26439, 19358}, { 26320, 19520}, { 26199, 19681}, { 26078, 19841}, { 25956, 20001},
+    { 25833, 20160}, { 25708, 20318}, { 25583, 20475}, { 25457, 20632}, { 25330, 20788}, { 25202, 20943},
+    { 25073, 21097}, { 24943, 21251}, { 24812, 21403}, { 24680, 21555}, { 24548, 21706}, { 24414, 21856},
+    { 24279, 22006}, { 24144, 22154}, { 24008, 22302}, { 23870, 22449}, { 23732, 22595}, { 23593, 22740},
+    { 23453, 22884}, { 23312, 23028}, { 23170, 23170}, { 23028, 23312}, { 22884, 23453}, { 22740, 23593},
+    { 22595, 23732}, { 22449, 23870}, { 22302, 24008}, { 22154, 24144}, { 22006, 24279}, { 21856, 24414},
+    { 21706, 24548}, { 21555, 24680}, { 21403, 24812}, { 21251, 24943}, { 21097, 25073}, { 20943, 25202},
+    { 20788, 25330}, { 20632, 25457}, { 20475, 25583}, { 20318, 25708}, { 20160, 25833}, { 20001, 25956},
+    { 19841, 26078}, { 19681, 26199}, { 19520, 26320}, { 19358, 26439}, { 19195, 26557}, { 19032, 26674},
+    { 18868, 26791}, { 18703, 26906}, { 18538, 27020}, { 18372, 27133}, { 18205, 27246}, { 18037, 27357},
+    { 17869, 27467}, { 17700, 27576}, { 17531, 27684}, { 17361, 27791}, { 17190, 27897}, { 17018, 28002},
+    { 16846, 28106}, { 16673, 28209}, { 16500, 28311}, { 16326, 28411}, { 16151, 28511}, { 15976, 28610},
+    { 15800, 28707}, { 15624, 28803}, { 15447, 28899}, { 15269, 28993}, { 15091, 29086}, { 14912, 29178},
+    { 14733, 29269}, { 14553, 29359}, { 14373, 29448}, { 14192, 29535}, { 14010, 29622}, { 13828, 29707},
+    { 13646, 29792}, { 13463, 29875}, { 13279, 29957}, { 13095, 30038}, { 12910, 30118}, { 12725, 30196},
+    { 12540, 30274}, { 12354, 30350}, { 12167, 30425}, { 11980, 30499}, { 11793, 30572}, { 11605, 30644},
+    { 11417, 30715}, { 11228, 30784}, { 11039, 30853}, { 10850, 30920}, { 10660, 30986}, { 10469, 31050},
+    { 10279, 31114}, { 10088, 31177}, {  9896, 31238}, {  9704, 31298}, {  9512, 31357}, {  9319, 31415},
+    {  9127, 31471}, {  8933, 31527}, {  8740, 31581}, {  8546, 31634}, {  8351, 31686}, {  8157, 31737},
+    {  7962, 31786}, {  7767, 31834}, {  7571, 31881}, {  7376, 31927}, {  7180, 31972}, {  6983, 32015},
+    {  6787, 32058}, {  6590, 32099}, {  6393, 32138}, {  6195, 32177}, {  5998, 32214}, {  5800, 32251},
+    {  5602, 32286}, {  5404, 32319}, {  5205, 32352}, {  5007, 32383}, {  4808, 32413}, {  4609, 32442},
+    {  4410, 32470}, {  4211, 32496}, {  4011, 32522}, {  3812, 32546}, {  3612, 32568}, {  3412, 32590},
+    {  3212, 32610}, {  3012, 32629}, {  2811, 32647}, {  2611, 32664}, {  2411, 32679}, {  2210, 32693},
+    {  2009, 32706}, {  1809, 32718}, {  1608, 32729}, {  1407, 32738}, {  1206, 32746}, {  1005, 32753},
+    {   804, 32758}, {   603, 32762}, {   402, 32766}, {   201, 32767}, {     0, 32767}, {  -201, 32767},
+    {  -402, 32766}, {  -603, 32762}, {  -804, 32758}, { -1005, 32753}, { -1206, 32746}, { -1407, 32738},
+    { -1608, 32729}, { -1809, 32718}, { -2009, 32706}, { -2210, 32693}, { -2411, 32679}, { -2611, 32664},
+    { -2811, 32647}, { -3012, 32629}, { -3212, 32610}, { -3412, 32590}, { -3612, 32568}, { -3812, 32546},
+    { -4011, 32522}, { -4211, 32496}, { -4410, 32470}, { -4609, 32442}, { -4808, 32413}, { -5007, 32383},
+    { -5205, 32352}, { -5404, 32319}, { -5602, 32286}, { -5800, 32251}, { -5998, 32214}, { -6195, 32177},
+    { -6393, 32138}, { -6590, 32099}, { -6787, 32058}, { -6983, 32015}, { -7180, 31972}, { -7376, 31927},
+    { -7571, 31881}, { -7767, 31834}, { -7962, 31786}, { -8157, 31737}, { -8351, 31686}, { -8546, 31634},
+    { -8740, 31581}, { -8933, 31527}, { -9127, 31471}, { -9319, 31415}, { -9512, 31357}, { -9704, 31298},
+    { -9896, 31238}, {-10088, 31177}, {-10279, 31114}, {-10469, 31050}, {-10660, 30986}, {-10850, 30920},
+    {-11039, 30853}, {-11228, 30784}, {-11417, 30715}, {-11605, 30644}, {-11793, 30572}, {-11980, 30499},
+    {-12167, 30425}, {-12354, 30350}, {-12540, 30274}, {-12725, 30196}, {-12910, 30118}, {-13095, 30038},
+    {-13279, 29957}, {-13463, 29875}, {-13646, 29792}, {-13828, 29707}, {-14010, 29622}, {-14192, 29535},
+    {-14373, 29448}, {-14553, 29359}, {-14733, 29269}, {-14912, 29178}, {-15091, 29086}, {-15269, 28993},
+    {-15447, 28899}, {-15624, 28803}, {-15800, 28707}, {-15976, 28610}, {-16151, 28511}, {-16326, 28411},
+    {-16500, 28311}, {-16673, 28209}, {-16846, 28106}, {-17018, 28002}, {-17190, 27897}, {-17361, 27791},
+    {-17531, 27684}, {-17700, 27576}, {-17869, 27467}, {-18037, 27357}, {-18205, 27246}, {-18372, 27133},
+    {-18538, 27020}, {-18703, 26906}, {-18868, 26791}, {-19032, 26674}, {-19195, 26557}, {-19358, 26439},
+    {-19520, 26320}, {-19681, 26199}, {-19841, 26078}, {-20001, 25956}, {-20160, 25833}, {-20318, 25708},
+    {-20475, 25583}, {-20632, 25457}, {-20788, 25330}, {-20943, 25202}, {-21097, 25073}, {-21251, 24943},
+    {-21403, 24812}, {-21555, 24680}, {-21706, 24548}, {-21856, 24414}, {-22006, 24279}, {-22154, 24144},
+    {-22302, 24008}, {-22449, 23870}, {-22595, 23732}, {-22740, 23593}, {-22884, 23453}, {-23028, 23312},
+    {-23170, 23170}, {-23312, 23028}, {-23453, 22884}, {-23593, 22740}, {-23732, 22595}, {-23870, 22449},
+    {-24008, 22302}, {-24144, 22154}, {-24279, 22006}, {-24414, 21856}, {-24548, 21706}, {-24680, 21555},
+    {-24812, 21403}, {-24943, 21251}, {-25073, 21097}, {-25202, 20943}, {-25330, 20788}, {-25457, 20632},
+    {-25583, 20475}, {-25708, 20318}, {-25833, 20160}, {-25956, 20001}, {-26078, 19841}, {-26199, 19681},
+    {-26320, 19520}, {-26439, 19358}, {-26557, 19195}, {-26674, 19032}, {-26791, 18868}, {-26906, 18703},
+    {-27020, 18538}, {-27133, 18372}, {-27246, 18205}, {-27357, 18037}, {-27467, 17869}, {-27576, 17700},
+    {-27684, 17531}, {-27791, 17361}, {-27897, 17190}, {-28002, 17018}, {-28106, 16846}, {-28209, 16673},
+    {-28311, 16500}, {-28411, 16326}, {-28511, 16151}, {-28610, 15976}, {-28707, 15800}, {-28803, 15624},
+    {-28899, 15447}, {-28993, 15269}, {-29086, 15091}, {-29178, 14912}, {-29269, 14733}, {-29359, 14553},
+    {-29448, 14373}, {-29535, 14192}, {-29622, 14010}, {-29707, 13828}, {-29792, 13646}, {-29875, 13463},
+    {-29957, 13279}, {-30038, 13095}, {-30118, 12910}, {-30196, 12725}, {-30274, 12540}, {-30350, 12354},
+    {-30425, 12167}, {-30499, 11980}, {-30572, 11793}, {-30644, 11605}, {-30715, 11417}, {-30784, 11228},
+    {-30853, 11039}, {-30920, 10850}, {-30986, 10660}, {-31050, 10469}, {-31114, 10279}, {-31177, 10088},
+    {-31238,  9896}, {-31298,  9704}, {-31357,  9512}, {-31415,  9319}, {-31471,  9127}, {-31527,  8933},
+    {-31581,  8740}, {-31634,  8546}, {-31686,  8351}, {-31737,  8157}, {-31786,  7962}, {-31834,  7767},
+    {-31881,  7571}, {-31927,  7376}, {-31972,  7180}, {-32015,  6983}, {-32058,  6787}, {-32099,  6590},
+    {-32138,  6393}, {-32177,  6195}, {-32214,  5998}, {-32251,  5800}, {-32286,  5602}, {-32319,  5404},
+    {-32352,  5205}, {-32383,  5007}, {-32413,  4808}, {-32442,  4609}, {-32470,  4410}, {-32496,  4211},
+    {-32522,  4011}, {-32546,  3812}, {-32568,  3612}, {-32590,  3412}, {-32610,  3212}, {-32629,  3012},
+    {-32647,  2811}, {-32664,  2611}, {-32679,  2411}, {-32693,  2210}, {-32706,  2009}, {-32718,  1809},
+    {-32729,  1608}, {-32738,  1407}, {-32746,  1206}, {-32753,  1005}, {-32758,   804}, {-32762,   603},
+    {-32766,   402}, {-32767,   201}, {-32768,     0}, {-32767,  -201}, {-32766,  -402}, {-32762,  -603},
+    {-32758,  -804}, {-32753, -1005}, {-32746, -1206}, {-32738, -1407}, {-32729, -1608}, {-32718, -1809},
+    {-32706, -2009}, {-32693, -2210}, {-32679, -2411}, {-32664, -2611}, {-32647, -2811}, {-32629, -3012},
+    {-32610, -3212}, {-32590, -3412}, {-32568, -3612}, {-32546, -3812}, {-32522, -4011}, {-32496, -4211},
+    {-32470, -4410}, {-32442, -4609}, {-32413, -4808}, {-32383, -5007}, {-32352, -5205}, {-32319, -5404},
+    {-32286, -5602}, {-32251, -5800}, {-32214, -5998}, {-32177, -6195}, {-32138, -6393}, {-32099, -6590},
+    {-32058, -6787}, {-32015, -6983}, {-31972, -7180}, {-31927, -7376}, {-31881, -7571}, {-31834, -7767},
+    {-31786, -7962}, {-31737, -8157}, {-31686, -8351}, {-31634, -8546}, {-31581, -8740}, {-31527, -8933},
+    {-31471, -9127}, {-31415, -9319}, {-31357, -9512}, {-31298, -9704}, {-31238, -9896}, {-31177,-10088},
+    {-31114,-10279}, {-31050,-10469}, {-30986,-10660}, {-30920,-10850}, {-30853,-11039}, {-30784,-11228},
+    {-30715,-11417}, {-30644,-11605}, {-30572,-11793}, {-30499,-11980}, {-30425,-12167}, {-30350,-12354},
+    {-30274,-12540}, {-30196,-12725}, {-30118,-12910}, {-30038,-13095}, {-29957,-13279}, {-29875,-13463},
+    {-29792,-13646}, {-29707,-13828}, {-29622,-14010}, {-29535,-14192}, {-29448,-14373}, {-29359,-14553},
+    {-29269,-14733}, {-29178,-14912}, {-29086,-15091}, {-28993,-15269}, {-28899,-15447}, {-28803,-15624},
+    {-28707,-15800}, {-28610,-15976}, {-28511,-16151}, {-28411,-16326}, {-28311,-16500}, {-28209,-16673},
+    {-28106,-16846}, {-28002,-17018}, {-27897,-17190}, {-27791,-17361}, {-27684,-17531}, {-27576,-17700},
+    {-27467,-17869}, {-27357,-18037}, {-27246,-18205}, {-27133,-18372}, {-27020,-18538}, {-26906,-18703},
+    {-26791,-18868}, {-26674,-19032}, {-26557,-19195}, {-26439,-19358}, {-26320,-19520}, {-26199,-19681},
+    {-26078,-19841}, {-25956,-20001}, {-25833,-20160}, {-25708,-20318}, {-25583,-20475}, {-25457,-20632},
+    {-25330,-20788}, {-25202,-20943}, {-25073,-21097}, {-24943,-21251}, {-24812,-21403}, {-24680,-21555},
+    {-24548,-21706}, {-24414,-21856}, {-24279,-22006}, {-24144,-22154}, {-24008,-22302}, {-23870,-22449},
+    {-23732,-22595}, {-23593,-22740}, {-23453,-22884}, {-23312,-23028}, {-23170,-23170}, {-23028,-23312},
+    {-22884,-23453}, {-22740,-23593}, {-22595,-23732}, {-22449,-23870}, {-22302,-24008}, {-22154,-24144},
+    {-22006,-24279}, {-21856,-24414}, {-21706,-24548}, {-21555,-24680}, {-21403,-24812}, {-21251,-24943},
+    {-21097,-25073}, {-20943,-25202}, {-20788,-25330}, {-20632,-25457}, {-20475,-25583}, {-20318,-25708},
+    {-20160,-25833}, {-20001,-25956}, {-19841,-26078}, {-19681,-26199}, {-19520,-26320}, {-19358,-26439},
+    {-19195,-26557}, {-19032,-26674}, {-18868,-26791}, {-18703,-26906}, {-18538,-27020}, {-18372,-27133},
+    {-18205,-27246}, {-18037,-27357}, {-17869,-27467}, {-17700,-27576}, {-17531,-27684}, {-17361,-27791},
+    {-17190,-27897}, {-17018,-28002}, {-16846,-28106}, {-16673,-28209}, {-16500,-28311}, {-16326,-28411},
+    {-16151,-28511}, {-15976,-28610}, {-15800,-28707}, {-15624,-28803}, {-15447,-28899}, {-15269,-28993},
+    {-15091,-29086}, {-14912,-29178}, {-14733,-29269}, {-14553,-29359}, {-14373,-29448}, {-14192,-29535},
+    {-14010,-29622}, {-13828,-29707}, {-13646,-29792}, {-13463,-29875}, {-13279,-29957}, {-13095,-30038},
+    {-12910,-30118}, {-12725,-30196}, {-12540,-30274}, {-12354,-30350}, {-12167,-30425}, {-11980,-30499},
+    {-11793,-30572}, {-11605,-30644}, {-11417,-30715}, {-11228,-30784}, {-11039,-30853}, {-10850,-30920},
+    {-10660,-30986}, {-10469,-31050}, {-10279,-31114}, {-10088,-31177}, { -9896,-31238}, { -9704,-31298},
+    { -9512,-31357}, { -9319,-31415}, { -9127,-31471}, { -8933,-31527}, { -8740,-31581}, { -8546,-31634},
+    { -8351,-31686}, { -8157,-31737}, { -7962,-31786}, { -7767,-31834}, { -7571,-31881}, { -7376,-31927},
+    { -7180,-31972}, { -6983,-32015}, { -6787,-32058}, { -6590,-32099}, { -6393,-32138}, { -6195,-32177},
+    { -5998,-32214}, { -5800,-32251}, { -5602,-32286}, { -5404,-32319}, { -5205,-32352}, { -5007,-32383},
+    { -4808,-32413}, { -4609,-32442}, { -4410,-32470}, { -4211,-32496}, { -4011,-32522}, { -3812,-32546},
+    { -3612,-32568}, { -3412,-32590}, { -3212,-32610}, { -3012,-32629}, { -2811,-32647}, { -2611,-32664},
+    { -2411,-32679}, { -2210,-32693}, { -2009,-32706}, { -1809,-32718}, { -1608,-32729}, { -1407,-32738},
+    { -1206,-32746}, { -1005,-32753}, {  -804,-32758}, {  -603,-32762}, {  -402,-32766}, {  -201,-32767}
+};
+
+typedef char FFT_CheckTwiddle[(sizeof(fftTwiddle) / sizeof(fftTwiddle[0]) == FFT_TWIDDLE_SIZE) ? 1 : -1];
+
+
+/*--------------------------------------------------------*/
+// Transformee
+/*--------------------------------------------------------*/
+
+// Division arrondie par 2^shift
+#define FFT_SCALE(v, shift)     (((v) + (1 << ((shift) - 1))) >> (shift))
+
+// (x + jy) (cos - j sin), Q15 arrondi
+static inline void FFT_Rotate(S_fftComplex *pDst, int32_t x, int32_t y, const S_fftComplex *pW)
+{
+    pDst->re = (int16_t)((x * pW->re + y * pW->im + (1 << 14)) >> 15);
+    pDst->im = (int16_t)((y * pW->re - x * pW->im + (1 << 14)) >> 15);
+}
+
+static void FFT_Radix4Stage(S_fftComplex *pData, uint16_t size, uint16_t len)
+{
+    uint16_t quarter = len / 4;
+    uint16_t step = FFT_MAX_SIZE / len;
+    uint16_t group, i;
+    S_fftComplex *p0, *p1, *p2, *p3;
+    int32_t s02re, s02im, d02re, d02im, s13re, s13im, d13re, d13im;
+
+    for (group = 0; group < size; group += len)
+    {
+        for (i = 0; i < quarter; i++)
+        {
+            p0 = &pData[group + i];
+            p1 = p0 + quarter;
+            p2 = p1 + quarter;
+            p3 = p2 + quarter;
+
+            s02re = p0->re + p2->re;    s02im = p0->im + p2->im;
+            d02re = p0->re - p2->re;    d02im = p0->im - p2->im;
+            s13re = p1->re + p3->re;    s13im = p1->im + p3->im;
+            d13re = p1->re - p3->re;    d13im = p1->im - p3->im;
+
+            // X0 -> p0, X2 (W^2i) -> p1, X1 (W^i) -> p2, X3 (W^3i) -> p3
+            p0->re = (int16_t)FFT_SCALE(s02re + s13re, 2);
+            p0->im = (int16_t)FFT_SCALE(s02im + s13im, 2);
+            FFT_Rotate(p1, FFT_SCALE(s02re - s13re, 2), FFT_SCALE(s02im - s13im, 2),
+                       &fftTwiddle[2 * i * step]);
+            FFT_Rotate(p2, FFT_SCALE(d02re + d13im, 2), FFT_SCALE(d02im - d13re, 2),
+                       &fftTwiddle[i * step]);
+            FFT_Rotate(p3, FFT_SCALE(d02re - d13im, 2), FFT_SCALE(d02im + d13re, 2),
+                       &fftTwiddle[3 * i * step]);
+        }
+    }
+}
+
+// Dernier etage des tailles 2 x 4^n, sans rotation
+static void FFT_Radix2Stage(S_fftComplex *pData, uint16_t size)
+{
+    S_fftComplex *p = pData;
+    int32_t re, im;
+
+    for (; p < pData + size; p += 2)
+    {
+        re = p[0].re - p[1].re;
+        im = p[0].im - p[1].im;
+        p[0].re = (int16_t)FFT_SCALE(p[0].re + p[1].re, 1);
+        p[0].im = (int16_t)FFT_SCALE(p[0].im + p[1].im, 1);
+        p[1].re = (int16_t)FFT_SCALE(re, 1);
+        p[1].im = (int16_t)FFT_SCALE(im, 1);
+    }
+}
+
+static void FFT_BitReverse(S_fftComplex *pData, uint16_t size)
+{
+    S_fftComplex tmp;
+    uint16_t i, j = 0, bit;
+
+    for (i = 1; i < size; i++)
+    {
+        // j = i bit-inverse : increment depuis le poids fort
+        for (bit = size >> 1; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j)
+        {
+            tmp = pData[i];
+            pData[i] = pData[j];
+            pData[j] = tmp;
+        }
+    }
+}
+
+bool FFT_Transform(S_fftComplex *pData, uint16_t size)
+{
+    uint16_t len;
+
+    if ((size < FFT_MIN_SIZE) || (size > FFT_MAX_SIZE) || ((size & (size - 1)) != 0))
+    {
+        return false;
+    }
+    for (len = size; len >= 4; len /= 4)
+    {
+        FFT_Radix4Stage(pData, size, len);
+    }
+    if (len == 2)
+    {
+        FFT_Radix2Stage(pData, size);
+    }
+    FFT_BitReverse(pData, size);
+    return true;
+}
+
+
+/*--------------------------------------------------------*/
+// Analyse d'un bloc ADC
+/*--------------------------------------------------------*/
+
+static uint16_t FFT_Sqrt(uint32_t value)
+{
+    uint32_t root = 0, bit = 1ul << 30;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)root;
+}
+
+// Hann : 0.5 - 0.5 cos(2 pi n / size), Q15 ; cos lu dans la table,
+// symetrique au-dela de 3/4 du bloc
+static inline int32_t FFT_Hann(uint16_t n, uint16_t size)
+{
+    uint16_t k = (n < size * 3 / 4) ? n : size - n;
+
+    return (32768 - fftTwiddle[k * (FFT_MAX_SIZE / size)].re) >> 1;
+}
+
+uint8_t FFT_AnalyzeAdc(const uint16_t *pAdc, uint16_t stride, uint16_t size,
+                       uint32_t sampleRateMilliHz, S_fftComplex *pWork,
+                       S_fftPeak *pPeaks, uint8_t nbPeaks)
+{
+    uint32_t sum = 0, mag, prevMag, nextMag;
+    int32_t mean, x;
+    uint16_t n, k, amp;
+    uint8_t nb = 0, i;
+
+    if ((nbPeaks == 0) || (size < FFT_MIN_SIZE) || (size > FFT_MAX_SIZE)
+        || ((size & (size - 1)) != 0))
+    {
+        return 0;
+    }
+
+    // Moyenne retiree, fenetre, Q15
+    for (n = 0; n < size; n++)
+    {
+        sum += pAdc[n * stride];
+    }
+    mean = (int32_t)((sum + size / 2) / size);
+    for (n = 0; n < size; n++)
+    {
+        x = ((int32_t)pAdc[n * stride] - mean) * (1 << FFT_ADC_SHIFT);
+        pWork[n].re = (int16_t)((x * FFT_Hann(n, size) + (1 << 14)) >> 15);
+        pWork[n].im = 0;
+    }
+    FFT_Transform(pWork, size);
+
+    // Maxima locaux du module au carre, continu exclu. Module de la
+    // raie : A x 2^FFT_ADC_SHIFT x 1/2 (Hann) x 1/2 (deux cotes)
+    prevMag = 0;
+    mag = (uint32_t)(pWork[1].re * pWork[1].re) + (uint32_t)(pWork[1].im * pWork[1].im);
+    for (k = 1; k < size / 2; k++)
+    {
+        nextMag = (uint32_t)(pWork[k + 1].re * pWork[k + 1].re)
+                  + (uint32_t)(pWork[k + 1].im * pWork[k + 1].im);
+        if ((mag > prevMag) && (mag >= nextMag) && (mag != 0))
+        {
+            // Insertion dans les nbPeaks plus grandes
+            amp = FFT_Sqrt(mag);
+            if ((nb < nbPeaks) || (amp > pPeaks[nb - 1].amplitude))
+            {
+                i = (nb < nbPeaks) ? nb++ : nb - 1;
+                for (; (i > 0) && (pPeaks[i - 1].amplitude < amp); i--)
+                {
+                    pPeaks[i] = pPeaks[i - 1];
+                }
+                pPeaks[i].bin = k;
+                pPeaks[i].freqMilliHz = (uint32_t)((uint64_t)k * sampleRateMilliHz / size);
+                pPeaks[i].amplitude = amp;
+            }
+        }
+        prevMag = mag;
+        mag = nextMag;
+    }
+
+    // Module -> amplitude crete en LSB ADC
+    for (i = 0; i < nb; i++)
+    {
+        pPeaks[i].amplitude = (uint16_t)(((uint32_t)pPeaks[i].amplitude * 4
+                              + (1 << (FFT_ADC_SHIFT - 1))) >> FFT_ADC_SHIFT);
+    }
+    return nb;
+}
+
+
+/*--------------------------------------------------------*/
+// Mesure du cout (FFT_BENCH_ENABLE)
+/*--------------------------------------------------------*/
+
+#if (FFT_BENCH_ENABLE == 1)
+
+#define FFT_BENCH_RUNS          3       // minimum : sans les interruptions
+
+S_fftBench fftBench;
+
+void FFT_Bench(void)
+{
+    static const uint16_t sizes[FFT_BENCH_NB_SIZES] = {
+#define FFT_BENCH_SIZE(n)       n,
+        FFT_BENCH_SIZES(FFT_BENCH_SIZE)
+    };
+    static S_fftComplex data[FFT_MAX_SIZE];
+    uint32_t start, cycles;
+    uint16_t n;
+    uint8_t i, run;
+
+    for (i = 0; i < FFT_BENCH_NB_SIZES; i++)
+    {
+        fftBench.size[i] = sizes[i];
+        fftBench.cycles[i] = UINT32_MAX;
+        for (run = 0; run < FFT_BENCH_RUNS; run++)
+        {
+            for (n = 0; n < sizes[i]; n++)
+            {
+                data[n].re = (int16_t)(((n * 37) % 101) * 100 - 5000);
+                data[n].im = 0;
+            }
+            start = _CP0_GET_COUNT();
+            FFT_Transform(data, sizes[i]);
+            cycles = 2 * (_CP0_GET_COUNT() - start);
+            if (cycles < fftBench.cycles[i])
+            {
+                fftBench.cycles[i] = cycles;
+            }
+        }
+    }
+}
+
+#endif
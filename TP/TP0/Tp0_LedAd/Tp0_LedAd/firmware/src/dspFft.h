@@ -0,0 +1,112 @@
+#ifndef DspFft_H
+#define DspFft_H
+/*--------------------------------------------------------*/
+// DspFft.h
+/*--------------------------------------------------------*/
+//	Description :	FFT complexe en virgule fixe (Q15), 64 a 1024
+//			        points, et analyse du spectre d'un bloc de
+//			        mesures ADC (raies dominantes)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+//  FFT_Transform : en place, decimation en frequence. Etages radix 4
+//  tant que possible, un etage radix 2 pour 128 et 512 points. Le
+//  papillon radix 4 range ses sorties dans l'ordre X0 X2 X1 X3 : il
+//  vaut deux etages radix 2, la sortie est en ordre bit-inverse pour
+//  toutes les tailles, remise en ordre naturel a la fin.
+//  Chaque etage divise par 4 (ou 2), arrondi : pas de debordement
+//  pour des entrees de module < 1, le resultat est la TFD divisee
+//  par la taille.
+//
+//  Facteurs de rotation : table de FFT_MAX_SIZE * 3 / 4 paires
+//  cos / sin Q15 en flash (3 ko), partagee par toutes les tailles
+//  (pas FFT_MAX_SIZE / taille). Elle sert aussi a la fenetre de Hann.
+//
+//  FFT_AnalyzeAdc : bloc de mesures (pas en u16, comme dspFilter.h),
+//  moyenne retiree, fenetre de Hann, FFT, puis les nbPeaks maxima
+//  locaux du module, plus grand d'abord. Amplitude des raies en LSB
+//  ADC (crete), frequence d'apres la cadence des mesures.
+//
+//  Cout par taille : FFT_Bench (FFT_BENCH_ENABLE = 1), resultat dans
+//  fftBench. Precision et temps sur PC : sim/, make fft.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*--------------------------------------------------------*/
+// Options de build
+/*--------------------------------------------------------*/
+
+// 1 = FFT_Bench compile (cycles par transformee, resultat fftBench)
+#ifndef FFT_BENCH_ENABLE
+#define FFT_BENCH_ENABLE        0
+#endif
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+#define FFT_MIN_SIZE            64
+#define FFT_MAX_SIZE            1024
+#define FFT_TWIDDLE_SIZE        (FFT_MAX_SIZE * 3 / 4)
+
+// Mesure ADC (10 bits, moyenne retiree) -> Q15
+#define FFT_ADC_SHIFT           5
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+typedef struct {
+    int16_t re;
+    int16_t im;
+} S_fftComplex;
+
+// Raie du spectre
+typedef struct {
+    uint16_t bin;
+    uint32_t freqMilliHz;
+    uint16_t amplitude;     // LSB ADC, crete
+} S_fftPeak;
+
+// Resultat de FFT_Bench (cycles CPU par transformee)
+#define FFT_BENCH_SIZES(X)      X(64) X(128) X(256) X(512) X(1024)
+
+#define FFT_BENCH_COUNT(n)      + 1
+#define FFT_BENCH_NB_SIZES      (0 FFT_BENCH_SIZES(FFT_BENCH_COUNT))
+
+typedef struct {
+    uint16_t size[FFT_BENCH_NB_SIZES];
+    uint32_t cycles[FFT_BENCH_NB_SIZES];
+} S_fftBench;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+// false si size n'est pas une puissance de 2 de FFT_MIN_SIZE a
+// FFT_MAX_SIZE
+bool FFT_Transform(S_fftComplex *pData, uint16_t size);
+
+// pWork : size elements. Retourne le nombre de raies trouvees.
+uint8_t FFT_AnalyzeAdc(const uint16_t *pAdc, uint16_t stride, uint16_t size,
+                       uint32_t sampleRateMilliHz, S_fftComplex *pWork,
+                       S_fftPeak *pPeaks, uint8_t nbPeaks);
+
+#if (FFT_BENCH_ENABLE == 1)
+extern S_fftBench fftBench;
+void FFT_Bench(void);
+#else
+#define FFT_Bench()             ((void)0)
+#endif
+
+
+#endif
@@ -0,0 +1,331 @@
+/*--------------------------------------------------------*/
+// DspFilter.c
+/*--------------------------------------------------------*/
+//	Description :	Filtres numeriques en virgule fixe pour les
+//			        mesures ADC : FIR Q15 et cascade de biquads
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include "dspFilter.h"
+
+#define FLT_FIR_ROUND           (1l << 14)      // demi LSB de la sortie Q15
+#define FLT_IIR_ROUND           (1l << 29)      // demi LSB du Q31 (coefs Q30)
+#define FLT_IIR_IN_SHIFT        16              // 16 bits -> poids forts du Q31
+
+#if (FLT_MAC_ASM == 1) && defined(__XC32)
+#define FLT_USE_ASM             1
+#else
+#define FLT_USE_ASM             0
+#endif
+
+
+/*--------------------------------------------------------*/
+// Produits scalaires (accumulateur HI/LO)
+/*--------------------------------------------------------*/
+
+// FLT_FIR_ROUND + somme de pX[k] * pH[k], k = 0..n-1 (n >= 1)
+static inline int64_t FLT_DotQ15(const int16_t *pX, const int16_t *pH, uint16_t n)
+{
+#if FLT_USE_ASM
+    const int16_t *pEnd = pX + n;
+    int32_t hi, lo, x0, h0, x1, h1;
+
+    // Paires de produits, le premier seul si n est impair. Delais de
+    // branchement remplis a la main (noreorder) : 9 instructions par
+    // paire dans la boucle
+    __asm__ volatile (
+        ".set push                  \n\t"
+        ".set noreorder             \n\t"
+        "mthi   $zero               \n\t"
+        "andi   %[x0], %[n], 1      \n\t"
+        "beqz   %[x0], 2f           \n\t"
+        "mtlo   %[rnd]              \n\t"
+        "lh     %[x0], 0(%[pX])     \n\t"
+        "lh     %[h0], 0(%[pH])     \n\t"
+        "addiu  %[pX], %[pX], 2     \n\t"
+        "addiu  %[pH], %[pH], 2     \n\t"
+        "madd   %[x0], %[h0]        \n\t"
+        "2:                         \n\t"
+        "beq    %[pX], %[pEnd], 3f  \n\t"
+        "nop                        \n\t"
+        "1:                         \n\t"
+        "lh     %[x0], 0(%[pX])     \n\t"
+        "lh     %[h0], 0(%[pH])     \n\t"
+        "lh     %[x1], 2(%[pX])     \n\t"
+        "lh     %[h1], 2(%[pH])     \n\t"
+        "addiu  %[pX], %[pX], 4     \n\t"
+        "madd   %[x0], %[h0]        \n\t"
+        "madd   %[x1], %[h1]        \n\t"
+        "bne    %[pX], %[pEnd], 1b  \n\t"
+        "addiu  %[pH], %[pH], 4     \n\t"
+        "3:                         \n\t"
+        "mfhi   %[hi]               \n\t"
+        "mflo   %[lo]               \n\t"
+        ".set pop                   \n\t"
+        : [hi] "=r" (hi), [lo] "=r" (lo), [x0] "=&r" (x0), [h0] "=&r" (h0),
+          [x1] "=&r" (x1), [h1] "=&r" (h1), [pX] "+r" (pX), [pH] "+r" (pH)
+        : [pEnd] "r" (pEnd), [n] "r" ((uint32_t)n), [rnd] "r" (FLT_FIR_ROUND)
+        : "hi", "lo", "memory");
+
+    return (int64_t)(((uint64_t)(uint32_t)hi << 32) | (uint32_t)lo);
+#else
+    int64_t acc = FLT_FIR_ROUND;
+
+    while (n--)
+    {
+        acc += (int32_t)*pX++ * *pH++;
+    }
+    return acc;
+#endif
+}
+
+// FLT_IIR_ROUND + b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2
+static inline int64_t FLT_DotBiquad(const S_fltBiquadCoefs *pC, const S_fltBiquadState *pS,
+                                    int32_t x)
+{
+#if FLT_USE_ASM
+    int32_t hi, lo;
+
+    __asm__ volatile (
+        "mthi   $zero               \n\t"
+        "mtlo   %[rnd]              \n\t"
+        "madd   %[b0], %[x]         \n\t"
+        "madd   %[b1], %[x1]        \n\t"
+        "madd   %[b2], %[x2]        \n\t"
+        "msub   %[a1], %[y1]        \n\t"
+        "msub   %[a2], %[y2]        \n\t"
+        "mfhi   %[hi]               \n\t"
+        "mflo   %[lo]               \n\t"
+        : [hi] "=r" (hi), [lo] "=r" (lo)
+        : [b0] "r" (pC->b0), [b1] "r" (pC->b1), [b2] "r" (pC->b2),
+          [a1] "r" (pC->a1), [a2] "r" (pC->a2), [x] "r" (x),
+          [x1] "r" (pS->x1), [x2] "r" (pS->x2), [y1] "r" (pS->y1), [y2] "r" (pS->y2),
+          [rnd] "r" (FLT_IIR_ROUND)
+        : "hi", "lo");
+
+    return (int64_t)(((uint64_t)(uint32_t)hi << 32) | (uint32_t)lo);
+#else
+    return FLT_IIR_ROUND + (int64_t)pC->b0 * x + (int64_t)pC->b1 * pS->x1
+           + (int64_t)pC->b2 * pS->x2 - (int64_t)pC->a1 * pS->y1 - (int64_t)pC->a2 * pS->y2;
+#endif
+}
+
+static inline int16_t FLT_SatQ15(int64_t acc)
+{
+    acc >>= 15;
+    if (acc > INT16_MAX)    return INT16_MAX;
+    if (acc < INT16_MIN)    return INT16_MIN;
+    return (int16_t)acc;
+}
+
+static inline int32_t FLT_SatQ31(int64_t acc)
+{
+    acc >>= 30;
+    if (acc > INT32_MAX)    return INT32_MAX;
+    if (acc < INT32_MIN)    return INT32_MIN;
+    return (int32_t)acc;
+}
+
+
+/*--------------------------------------------------------*/
+// FIR Q15
+/*--------------------------------------------------------*/
+
+void FLT_FirQ15Init(S_fltFirQ15 *pFir, const int16_t *pCoefs, int16_t *pState,
+                    uint16_t nbTaps)
+{
+    pFir->pCoefs = pCoefs;
+    pFir->pState = pState;
+    pFir->nbTaps = nbTaps;
+    FLT_FirQ15Reset(pFir, 0);
+}
+
+// Ligne a retard remplie de value : sortie immediate en regime etabli
+void FLT_FirQ15Reset(S_fltFirQ15 *pFir, int16_t value)
+{
+    uint16_t i;
+
+    for (i = 0; i < FLT_FIR_STATE_SIZE(pFir->nbTaps); i++)
+    {
+        pFir->pState[i] = value;
+    }
+    pFir->pos = 0;
+}
+
+// x[n] en pState[pos] et pState[pos + nbTaps] : x[n-k] = pState[pos + k]
+static inline int16_t FLT_FirQ15Step(S_fltFirQ15 *pFir, int16_t x)
+{
+    uint16_t pos = (pFir->pos == 0) ? pFir->nbTaps - 1 : pFir->pos - 1;
+
+    pFir->pos = pos;
+    pFir->pState[pos] = x;
+    pFir->pState[pos + pFir->nbTaps] = x;
+    return FLT_SatQ15(FLT_DotQ15(&pFir->pState[pos], pFir->pCoefs, pFir->nbTaps));
+}
+
+int16_t FLT_FirQ15Sample(S_fltFirQ15 *pFir, int16_t x)
+{
+    return FLT_FirQ15Step(pFir, x);
+}
+
+void FLT_FirQ15Block(S_fltFirQ15 *pFir, const int16_t *pIn, uint16_t inStride,
+                     int16_t *pOut, uint16_t outStride, uint16_t nb)
+{
+    while (nb--)
+    {
+        *pOut = FLT_FirQ15Step(pFir, *pIn);
+        pIn += inStride;
+        pOut += outStride;
+    }
+}
+
+
+/*--------------------------------------------------------*/
+// Biquads Q30 / Q31
+/*--------------------------------------------------------*/
+
+void FLT_BiquadInit(S_fltBiquad *pIir, const S_fltBiquadCoefs *pCoefs,
+                    S_fltBiquadState *pState, uint8_t nbSections)
+{
+    pIir->pCoefs = pCoefs;
+    pIir->pState = pState;
+    pIir->nbSections = nbSections;
+    FLT_BiquadReset(pIir);
+}
+
+void FLT_BiquadReset(S_fltBiquad *pIir)
+{
+    uint8_t i;
+
+    for (i = 0; i < pIir->nbSections; i++)
+    {
+        pIir->pState[i].x1 = 0;
+        pIir->pState[i].x2 = 0;
+        pIir->pState[i].y1 = 0;
+        pIir->pState[i].y2 = 0;
+    }
+}
+
+static inline int16_t FLT_BiquadStep(S_fltBiquad *pIir, int16_t x)
+{
+    const S_fltBiquadCoefs *pC = pIir->pCoefs;
+    S_fltBiquadState *pS = pIir->pState;
+    int32_t v = (int32_t)((uint32_t)(int32_t)x << FLT_IIR_IN_SHIFT);
+    int32_t y;
+    uint8_t i;
+
+    for (i = 0; i < pIir->nbSections; i++, pC++, pS++)
+    {
+        y = FLT_SatQ31(FLT_DotBiquad(pC, pS, v));
+        pS->x2 = pS->x1;
+        pS->x1 = v;
+        pS->y2 = pS->y1;
+        pS->y1 = y;
+        v = y;
+    }
+
+    // Retour sur 16 bits, arrondi et sature
+    v = (v >> FLT_IIR_IN_SHIFT) + ((v >> (FLT_IIR_IN_SHIFT - 1)) & 1);
+    return (v > INT16_MAX) ? INT16_MAX : (int16_t)v;
+}
+
+int16_t FLT_BiquadSample(S_fltBiquad *pIir, int16_t x)
+{
+    return FLT_BiquadStep(pIir, x);
+}
+
+void FLT_BiquadBlock(S_fltBiquad *pIir, const int16_t *pIn, uint16_t inStride,
+                     int16_t *pOut, uint16_t outStride, uint16_t nb)
+{
+    while (nb--)
+    {
+        *pOut = FLT_BiquadStep(pIir, *pIn);
+        pIn += inStride;
+        pOut += outStride;
+    }
+}
+
+
+/*--------------------------------------------------------*/
+// Mesure du cout (FLT_BENCH_ENABLE)
+/*--------------------------------------------------------*/
+
+#if (FLT_BENCH_ENABLE == 1)
+
+#define FLT_BENCH_MAX_TAPS      128
+#define FLT_BENCH_RUNS          3       // minimum : sans les interruptions
+
+S_fltBench fltBench;
+
+static const int16_t benchCoefs[FLT_BENCH_MAX_TAPS] = {
+    [0 ... FLT_BENCH_MAX_TAPS - 1] = FLT_Q15(1.0 / FLT_BENCH_MAX_TAPS)
+};
+
+// Passe-bas de Butterworth d'ordre 2, fc = fs / 10
+static const S_fltBiquadCoefs benchBiquad = {
+    FLT_Q30(0.0674553), FLT_Q30(0.1349105), FLT_Q30(0.0674553),
+    FLT_Q30(-1.1429805), FLT_Q30(0.4128016)
+};
+
+// Cycles CPU (core timer x 2) du bloc le plus rapide
+#define FLT_BENCH_MEASURE(cycles, call) \
+    do { \
+        uint32_t start, tics; \
+        uint8_t run; \
+        (cycles) = UINT32_MAX; \
+        for (run = 0; run < FLT_BENCH_RUNS; run++) \
+        { \
+            start = _CP0_GET_COUNT(); \
+            call; \
+            tics = _CP0_GET_COUNT() - start; \
+            if (2 * tics < (cycles))    (cycles) = 2 * tics; \
+        } \
+    } while (0)
+
+void FLT_Bench(void)
+{
+    static const uint16_t taps[FLT_BENCH_NB_FIR] = {
+#define FLT_BENCH_TAP(n)        n,
+        FLT_BENCH_TAPS(FLT_BENCH_TAP)
+    };
+    static int16_t state[FLT_FIR_STATE_SIZE(FLT_BENCH_MAX_TAPS)];
+    static int16_t in[FLT_BENCH_BLOCK];
+    static int16_t out[FLT_BENCH_BLOCK];
+    S_fltBiquadCoefs sections[FLT_BENCH_SECTIONS];
+    S_fltBiquadState sectionState[FLT_BENCH_SECTIONS];
+    S_fltFirQ15 fir;
+    S_fltBiquad iir;
+    uint32_t cycles;
+    uint8_t i;
+
+    for (i = 0; i < FLT_BENCH_BLOCK; i++)
+    {
+        in[i] = (int16_t)(512 + (i * 37) % 101);
+    }
+
+    for (i = 0; i < FLT_BENCH_NB_FIR; i++)
+    {
+        FLT_FirQ15Init(&fir, benchCoefs, state, taps[i]);
+        FLT_BENCH_MEASURE(cycles, FLT_FirQ15Block(&fir, in, 1, out, 1, FLT_BENCH_BLOCK));
+        fltBench.nbTaps[i] = taps[i];
+        fltBench.firCyclesPerSample[i] = cycles / FLT_BENCH_BLOCK;
+        fltBench.firCyclesPerTapX100[i] = (uint32_t)((uint64_t)cycles * 100
+                                          / ((uint32_t)FLT_BENCH_BLOCK * taps[i]));
+    }
+
+    for (i = 0; i < FLT_BENCH_SECTIONS; i++)
+    {
+        sections[i] = benchBiquad;
+    }
+    FLT_BiquadInit(&iir, sections, sectionState, FLT_BENCH_SECTIONS);
+    FLT_BENCH_MEASURE(cycles, FLT_BiquadBlock(&iir, in, 1, out, 1, FLT_BENCH_BLOCK));
+    fltBench.biquadCyclesPerSectionX100 = cycles * 100 / (FLT_BENCH_BLOCK * FLT_BENCH_SECTIONS);
+}
+
+#endif
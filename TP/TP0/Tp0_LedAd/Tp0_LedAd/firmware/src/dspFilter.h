@@ -0,0 +1,147 @@
+#ifndef DspFilter_H
+#define DspFilter_H
+/*--------------------------------------------------------*/
+// DspFilter.h
+/*--------------------------------------------------------*/
+//	Description :	Filtres numeriques en virgule fixe pour les
+//			        mesures ADC : FIR Q15 et cascade de biquads
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+//  FIR : forme directe, coefficients Q15. Ligne a retard circulaire
+//  doublee (2 x nbTaps echantillons, fournie par l'appelant) : chaque
+//  echantillon est ecrit deux fois, la fenetre des nbTaps derniers
+//  est toujours contigue et la boucle de produits n'a pas de modulo.
+//  Sortie = somme(h[k] x[n-k]) >> 15 arrondie et saturee : avec un
+//  gain statique de 1, elle est dans l'unite de l'entree (mesure ADC
+//  brute 0..1023 directement).
+//
+//  IIR : cascade de biquads en forme directe I, coefficients Q30
+//  (|a1| < 2), etats Q31. Entree / sortie sur 16 bits, placees dans
+//  les 16 bits de poids fort du Q31 : les etats gardent 16 bits
+//  fractionnaires, pas de cycle limite a l'echelle d'un LSB ADC.
+//
+//  Accumulateur : HI/LO du MIPS32 (64 bits), un madd (msub) par
+//  produit, lu une fois par sortie par mfhi/mflo. FLT_MAC_ASM = 0 :
+//  meme calcul en C (int64_t), reference des tests sur PC.
+//
+//  Blocs : les fonctions Block traitent nb echantillons d'un tableau
+//  avec un pas (inStride, outStride en elements de 16 bits), par
+//  exemple le canal 0 d'un tableau de S_ADCResults :
+//      FLT_FirQ15Block(&fir, (const int16_t *)&adc[0].Chan0, 2,
+//                      out, 1, nb);
+//  Traiter un bloc en plusieurs morceaux donne le meme resultat.
+//
+//  Cout mesure par FLT_Bench (FLT_BENCH_ENABLE = 1), tests et modele
+//  de reference sur PC : sim/, make filter.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+
+/*--------------------------------------------------------*/
+// Options de build
+/*--------------------------------------------------------*/
+
+// 1 = boucles de produits en assembleur (madd / msub), sur la cible
+#ifndef FLT_MAC_ASM
+#define FLT_MAC_ASM             1
+#endif
+
+// 1 = FLT_Bench compile (cycles par coefficient, resultat fltBench)
+#ifndef FLT_BENCH_ENABLE
+#define FLT_BENCH_ENABLE        0
+#endif
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+// Conversion des coefficients a la compilation (constantes reelles)
+#define FLT_Q15(x)              ((int16_t)((x) * 32768.0 + (((x) >= 0) ? 0.5 : -0.5)))
+#define FLT_Q30(x)              ((int32_t)((x) * 1073741824.0 + (((x) >= 0) ? 0.5 : -0.5)))
+
+// Taille de la ligne a retard d'un FIR
+#define FLT_FIR_STATE_SIZE(nbTaps)  (2 * (nbTaps))
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+typedef struct {
+    const int16_t *pCoefs;  // h[0..nbTaps-1], Q15
+    int16_t *pState;        // FLT_FIR_STATE_SIZE(nbTaps) echantillons
+    uint16_t nbTaps;
+    uint16_t pos;           // echantillon le plus recent
+} S_fltFirQ15;
+
+// y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2, Q30
+typedef struct {
+    int32_t b0;
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+} S_fltBiquadCoefs;
+
+typedef struct {
+    int32_t x1;
+    int32_t x2;
+    int32_t y1;
+    int32_t y2;
+} S_fltBiquadState;
+
+typedef struct {
+    const S_fltBiquadCoefs *pCoefs;     // nbSections
+    S_fltBiquadState *pState;           // nbSections
+    uint8_t nbSections;
+} S_fltBiquad;
+
+// Resultat de FLT_Bench (cycles CPU, centiemes)
+#define FLT_BENCH_BLOCK         32
+#define FLT_BENCH_TAPS(X)       X(8) X(16) X(32) X(64) X(128)
+#define FLT_BENCH_SECTIONS      4
+
+#define FLT_BENCH_COUNT(n)      + 1
+#define FLT_BENCH_NB_FIR        (0 FLT_BENCH_TAPS(FLT_BENCH_COUNT))
+
+typedef struct {
+    uint16_t nbTaps[FLT_BENCH_NB_FIR];
+    uint32_t firCyclesPerTapX100[FLT_BENCH_NB_FIR];
+    uint32_t firCyclesPerSample[FLT_BENCH_NB_FIR];
+    uint32_t biquadCyclesPerSectionX100;
+} S_fltBench;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+void FLT_FirQ15Init(S_fltFirQ15 *pFir, const int16_t *pCoefs, int16_t *pState,
+                    uint16_t nbTaps);
+void FLT_FirQ15Reset(S_fltFirQ15 *pFir, int16_t value);  // regime etabli sur value
+int16_t FLT_FirQ15Sample(S_fltFirQ15 *pFir, int16_t x);
+void FLT_FirQ15Block(S_fltFirQ15 *pFir, const int16_t *pIn, uint16_t inStride,
+                     int16_t *pOut, uint16_t outStride, uint16_t nb);
+
+void FLT_BiquadInit(S_fltBiquad *pIir, const S_fltBiquadCoefs *pCoefs,
+                    S_fltBiquadState *pState, uint8_t nbSections);
+void FLT_BiquadReset(S_fltBiquad *pIir);
+int16_t FLT_BiquadSample(S_fltBiquad *pIir, int16_t x);
+void FLT_BiquadBlock(S_fltBiquad *pIir, const int16_t *pIn, uint16_t inStride,
+                     int16_t *pOut, uint16_t outStride, uint16_t nb);
+
+#if (FLT_BENCH_ENABLE == 1)
+extern S_fltBench fltBench;
+void FLT_Bench(void);
+#else
+#define FLT_Bench()             ((void)0)
+#endif
+
+
+#endif
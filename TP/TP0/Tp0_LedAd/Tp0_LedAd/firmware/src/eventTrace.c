@@ -0,0 +1,109 @@
+/*--------------------------------------------------------*/
+// EventTrace.c
+/*--------------------------------------------------------*/
+//	Description :	Trace d'evenements horodates en RAM (ISR,
+//			        etats APP, LCD, ADC) pour mesurer le timing
+//			        sans point d'arret
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+/*--------------------------------------------------------*/
+
+#include "eventTrace.h"
+
+#if (TRC_ENABLE == 1)
+
+#include <stdbool.h>
+#include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
+
+#define TRC_CALIB_COUNT         16
+
+// Non efface par le startup : une trace figee survit au reset
+#if defined(__XC32)
+S_traceLog __attribute__((persistent)) trcLog;
+#else
+S_traceLog trcLog;
+#endif
+
+static bool clockRegistered = false;
+
+// Cout d'un enregistrement : TRC_CALIB_COUNT enregistrements de suite,
+// laisses en tete de la trace (evenement CALIB)
+static void TRC_Calibrate(void)
+{
+    uint32_t start = _CP0_GET_COUNT();
+    uint8_t i;
+
+    for (i = 0; i < TRC_CALIB_COUNT; i++)
+    {
+        TRC_POINT(CALIB, i);
+    }
+    trcLog.costTics = _CP0_GET_COUNT() - start;
+}
+
+// Avant SYS_EXCEP_CrashRecordCheck, qui efface les flags POR / BOR :
+// apres une mise sous tension la RAM persistante est quelconque
+void TRC_ResetCheck(void)
+{
+    if ((RCON & (_RCON_POR_MASK | _RCON_BOR_MASK)) != 0)
+    {
+        trcLog.magic = 0;
+    }
+}
+
+// Avant l'activation des interruptions ; une trace figee avant le
+// reset est gardee pour ce demarrage seulement
+void TRC_Initialize(void)
+{
+    // Une seule inscription (TRC_Initialize peut etre rappelee)
+    if (!clockRegistered)
+    {
+        clockRegistered = SYS_CLK_FrequencyChangeCallbackRegister(TRC_ClockChanged);
+        if (!clockRegistered)
+        {
+            TRC_POINT(CLK_REJECT, TRC_CLK_TRACE);
+        }
+    }
+
+    if ((trcLog.magic == TRC_MAGIC) && (trcLog.size == TRC_SIZE)
+        && (trcLog.frozen != TRC_FREEZE_NONE) && (trcLog.nbBoots == 0))
+    {
+        trcLog.nbBoots = 1;
+        return;
+    }
+    TRC_Rearm();
+}
+
+// Trace videe et relancee
+void TRC_Rearm(void)
+{
+    trcLog.frozen = TRC_FREEZE_USER;
+    trcLog.magic = TRC_MAGIC;
+    trcLog.size = TRC_SIZE;
+    trcLog.recordSize = sizeof(S_traceRecord);
+    trcLog.coreClockHz = SYS_CLK_SystemFrequencyGet() / 2;
+    trcLog.head = 0;
+    trcLog.nbBoots = 0;
+    trcLog.frozen = TRC_FREEZE_NONE;
+    TRC_Calibrate();
+}
+
+// Horloge modifiee : l'ancienne frequence (kHz, core timer < 65 MHz)
+// reste dans l'anneau pour le decodeur. costTics est en cycles CPU / 2,
+// il ne change pas. Une trace figee garde l'en-tete de sa capture.
+void TRC_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz)
+{
+    (void)peripheralClockHz;
+
+    if (trcLog.frozen == TRC_FREEZE_NONE)
+    {
+        TRC_POINT(CLK_CHANGE, trcLog.coreClockHz / 1000);
+        trcLog.coreClockHz = systemClockHz / 2;
+    }
+}
+
+#endif
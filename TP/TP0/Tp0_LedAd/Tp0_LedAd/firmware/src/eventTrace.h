@@ -0,0 +1,180 @@
+#ifndef EventTrace_H
+#define EventTrace_H
+/*--------------------------------------------------------*/
+// EventTrace.h
+/*--------------------------------------------------------*/
+//	Description :	Trace d'evenements horodates en RAM (ISR,
+//			        etats APP, LCD, ADC) pour mesurer le timing
+//			        sans point d'arret
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+//  Chaque evenement ecrit un enregistrement de 8 octets (core timer,
+//  evenement, argument) dans un anneau de TRC_SIZE enregistrements :
+//  lecture du core timer, reservation atomique de la case (ll/sc),
+//  trois ecritures. Sans masquage des interruptions : une ISR peut
+//  s'intercaler entre l'horodatage et la reservation, le decodeur
+//  remet les enregistrements dans l'ordre des horodatages.
+//
+//  L'anneau n'est pas efface au reset (persistent). TRC_FREEZE le
+//  fige : watchdog (SYS_WDM_Check) ou exception. Une trace figee est
+//  conservee par TRC_Initialize pendant le demarrage qui suit, pour
+//  etre lue apres le reset, puis relancee au reset suivant (nbBoots)
+//  ou par TRC_Rearm. Apres une mise sous tension ou un brown-out,
+//  TRC_ResetCheck l'invalide (RAM quelconque).
+//
+//  Lecture : export binaire de la variable trcLog depuis le debugger
+//  (fenetre Memory, sizeof(S_traceLog) octets), puis sur le PC :
+//      sim/trcDecode -t -j trace.json trcLog.bin
+//  (chronologie, statistiques par evenement, trace.json pour
+//  ui.perfetto.dev ou chrome://tracing)
+//
+//  Changement d'horloge : TRC_ClockChanged enregistre CLK_CHANGE
+//  (ancienne frequence du core timer) et met l'en-tete a la nouvelle ;
+//  trcDecode ramene les horodatages d'avant a celle-ci.
+//
+//  TRC_ENABLE = 0 : macros vides, aucun code ni RAM.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <xc.h>
+
+
+/*--------------------------------------------------------*/
+// Options de build
+/*--------------------------------------------------------*/
+
+// 1 = trace compilee
+#ifndef TRC_ENABLE
+#define TRC_ENABLE              0
+#endif
+
+// Enregistrements dans l'anneau (puissance de 2)
+#ifndef TRC_SIZE
+#define TRC_SIZE                256
+#endif
+
+
+/*--------------------------------------------------------*/
+// Evenements
+/*--------------------------------------------------------*/
+
+// Contexte d'un evenement (piste de la chronologie)
+#define TRC_CTX_MAIN            0
+#define TRC_CTX_ISR             1
+
+// EVT(nom, contexte). Un evenement est ponctuel (TRC_POINT) ou un
+// intervalle (TRC_BEGIN / TRC_END).
+#define TRC_EVENTS(EVT) \
+    EVT(CALIB,       TRC_CTX_MAIN)  /* mesure du cout, TRC_Initialize */ \
+    EVT(TMR1_ISR,    TRC_CTX_ISR)   /* ISR Timer1 (100 ms) */ \
+    EVT(DMA0_ISR,    TRC_CTX_ISR)   /* ISR fin de trame telemetrie */ \
+    EVT(APP_STATE,   TRC_CTX_MAIN)  /* APP_UpdateState, arg : etat */ \
+    EVT(APP_SERVICE, TRC_CTX_MAIN)  /* etats SERVICE_*, arg : etat */ \
+    EVT(LCD,         TRC_CTX_MAIN)  /* ecriture LCD, arg : 0 init, 1 ADC, 2 spectre */ \
+    EVT(ADC_DONE,    TRC_CTX_MAIN)  /* mesure lue, arg : Chan0 */ \
+    EVT(CLK_REJECT,  TRC_CTX_MAIN)  /* rappel d'horloge refuse, arg : TRC_CLK_xxx */ \
+    EVT(CLK_CHANGE,  TRC_CTX_MAIN)  /* TRC_ClockChanged, arg : ancien coreClockHz en kHz */
+
+#define TRC_EVT_ID(name, ctx)   TRC_EVT_##name,
+typedef enum { TRC_EVENTS(TRC_EVT_ID) TRC_NB_EVENTS } TRC_EVENT;
+
+// Argument de CLK_REJECT : module qui ne sera pas prevenu d'un
+// changement de frequence (table de sys_clk_static.h pleine)
+#define TRC_CLK_ADC             0
+#define TRC_CLK_TMR0            1
+#define TRC_CLK_TELEMETRY       2
+#define TRC_CLK_FLASHLOG        3
+#define TRC_CLK_DDS             4
+#define TRC_CLK_TRACE           5
+
+// Bit de fin d'intervalle dans S_traceRecord.event
+#define TRC_END_FLAG            0x8000
+
+// Cause du gel de la trace (S_traceLog.frozen)
+#define TRC_FREEZE_NONE         0
+#define TRC_FREEZE_USER         1
+#define TRC_FREEZE_WATCHDOG     2
+#define TRC_FREEZE_EXCEPTION    3
+
+#define TRC_MAGIC               0x32435254      // "TRC2"
+
+
+/*--------------------------------------------------------*/
+// Types (format du dump, little endian)
+/*--------------------------------------------------------*/
+
+typedef struct {
+    uint32_t tics;          // core timer (SYS_CLK_FREQ / 2)
+    uint16_t event;         // TRC_EVENT, | TRC_END_FLAG en fin d'intervalle
+    uint16_t arg;
+} S_traceRecord;
+
+typedef struct {
+    uint32_t magic;         // TRC_MAGIC
+    uint16_t size;          // TRC_SIZE
+    uint16_t recordSize;    // sizeof(S_traceRecord)
+    uint32_t coreClockHz;   // au dernier enregistrement (CLK_CHANGE)
+    uint32_t costTics;      // cout d'un enregistrement (x 1/16 tic)
+    volatile uint32_t head; // enregistrements ecrits depuis TRC_Initialize
+    volatile uint32_t frozen;   // TRC_FREEZE_xxx
+    uint32_t nbBoots;       // demarrages depuis le gel (0 ou 1)
+    S_traceRecord rec[TRC_SIZE];
+} S_traceLog;
+
+
+/*--------------------------------------------------------*/
+// Enregistrement
+/*--------------------------------------------------------*/
+
+#if (TRC_ENABLE == 1)
+
+typedef char TRC_CheckSize[((TRC_SIZE & (TRC_SIZE - 1)) == 0) ? 1 : -1];
+
+extern S_traceLog trcLog;
+
+static inline void TRC_Record(uint16_t event, uint16_t arg)
+{
+    uint32_t tics = _CP0_GET_COUNT();
+    uint32_t slot;
+
+    if (trcLog.frozen == TRC_FREEZE_NONE)
+    {
+        slot = __atomic_fetch_add(&trcLog.head, 1, __ATOMIC_RELAXED) & (TRC_SIZE - 1);
+        trcLog.rec[slot].tics = tics;
+        trcLog.rec[slot].event = event;
+        trcLog.rec[slot].arg = arg;
+    }
+}
+
+// Simple ecriture : utilisable dans le handler d'exception
+#define TRC_FREEZE(reason)      (trcLog.frozen = (reason))
+
+#define TRC_POINT(name, arg)    TRC_Record(TRC_EVT_##name, (uint16_t)(arg))
+#define TRC_BEGIN(name, arg)    TRC_Record(TRC_EVT_##name, (uint16_t)(arg))
+#define TRC_END(name, arg)      TRC_Record(TRC_EVT_##name | TRC_END_FLAG, (uint16_t)(arg))
+
+void TRC_ResetCheck(void);
+void TRC_Initialize(void);
+void TRC_Rearm(void);
+void TRC_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz);
+
+#else
+
+// Arguments non evalues
+#define TRC_FREEZE(reason)      ((void)0)
+#define TRC_POINT(name, arg)    ((void)0)
+#define TRC_BEGIN(name, arg)    ((void)0)
+#define TRC_END(name, arg)      ((void)0)
+#define TRC_ResetCheck()        ((void)0)
+#define TRC_Initialize()        ((void)0)
+#define TRC_Rearm()             ((void)0)
+#define TRC_ClockChanged(sysHz, pbHz) ((void)0)
+
+#endif
+
+
+#endif
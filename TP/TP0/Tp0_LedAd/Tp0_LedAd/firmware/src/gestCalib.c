@@ -0,0 +1,376 @@
+/*--------------------------------------------------------*/
+// GestCalib.c
+/*--------------------------------------------------------*/
+//	Description :	Calibration des mesures ADC (offset, gain,
+//			        linearisation multi-points) par table en
+//			        flash, appliquee a chaque lecture
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include <string.h>
+#include <sys/kmem.h>
+#include "gestCalib.h"
+#include "hotPath.h"
+#include "telemetryFrame.h"
+#include "system_config.h"
+#include "system/int/sys_int.h"
+#include "peripheral/nvm/plib_nvm.h"
+
+#define GCAL_NVM_KEY1           0xAA996655
+#define GCAL_NVM_KEY2           0x556699AA
+
+// Octets couverts par le CRC : de lutSize a la fin
+#define GCAL_CRC_OFFSET         4
+
+#define GCAL_SEG_MASK           ((1 << GCAL_SEG_SHIFT) - 1)
+
+typedef char GCAL_CheckRecord[((sizeof(S_calibRecord) % sizeof(uint32_t)) == 0)
+                              && (sizeof(S_calibRecord) <= GCAL_PAGE_SIZE) ? 1 : -1];
+typedef char GCAL_CheckAdcLayout[(sizeof(S_ADCResults) % sizeof(uint16_t) == 0) ? 1 : -1];
+
+// Page reservee a adresse fixe (preservable par le programmateur)
+#if defined(__XC32)
+static const uint8_t calibPage[GCAL_PAGE_SIZE]
+    __attribute__((aligned(GCAL_PAGE_SIZE), space(prog), address(GCAL_PAGE_ADDRESS), noload));
+#else
+// Simulation : page de la NVM du simulateur (sim/simNvm.c)
+extern uint8_t simNvmCalib[GCAL_PAGE_SIZE];
+#define calibPage               simNvmCalib
+#endif
+
+// Enregistrement en vigueur, table lue a chaque mesure
+static S_calibRecord record;
+static bool calibrated = false;
+
+// Capture en cours
+static S_calibPoint capPoints[GCAL_NB_CHAN][GCAL_MAX_POINTS];
+static uint8_t capNbPoints[GCAL_NB_CHAN];
+static uint8_t capChan;
+static uint16_t capMilliVolt;
+static uint32_t capSum;
+static bool capSaturated;
+static volatile uint8_t capLeft = 0;    // lectures restantes du point
+
+/*--------------------------------------------------------*/
+// Table
+/*--------------------------------------------------------*/
+
+static void GCAL_Identity(uint8_t chan)
+{
+    uint8_t i;
+
+    for (i = 0; i < GCAL_LUT_SIZE; i++)
+    {
+        record.lut[chan][i] = (int16_t)((i << GCAL_SEG_SHIFT) << GCAL_FRAC_BITS);
+    }
+}
+
+// Code ideal (Q4) d'une tension, reference GCAL_VREF_MV
+static int32_t GCAL_IdealQ4(uint16_t milliVolt)
+{
+    return (int32_t)(((uint32_t)milliVolt * (1024u << GCAL_FRAC_BITS) + GCAL_VREF_MV / 2)
+                     / GCAL_VREF_MV);
+}
+
+// Segments entre les points captures (tries par code brut), table aux
+// codes 0, 64 ... ; bords prolonges par le premier / dernier segment
+static void GCAL_BuildLut(uint8_t chan, const S_calibPoint *pPoints, uint8_t nbPoints)
+{
+    S_calibPoint sorted[GCAL_MAX_POINTS];
+    S_calibPoint tmp;
+    int32_t x, xa, xb, ya, yb;
+    int64_t y;
+    uint8_t i, j, k, nb = 0;
+
+    // Tri par insertion, doublons de code brut ecartes
+    for (i = 0; i < nbPoints; i++)
+    {
+        for (j = 0; (j < nb) && (sorted[j].rawQ4 != pPoints[i].rawQ4); j++)
+        {
+        }
+        if (j < nb)
+        {
+            continue;
+        }
+        sorted[nb] = pPoints[i];
+        for (j = nb++; (j > 0) && (sorted[j - 1].rawQ4 > sorted[j].rawQ4); j--)
+        {
+            tmp = sorted[j];
+            sorted[j] = sorted[j - 1];
+            sorted[j - 1] = tmp;
+        }
+    }
+
+    if (nb == 0)
+    {
+        GCAL_Identity(chan);
+        return;
+    }
+    for (i = 0; i < GCAL_LUT_SIZE; i++)
+    {
+        x = (int32_t)(i << GCAL_SEG_SHIFT) << GCAL_FRAC_BITS;
+        if (nb == 1)
+        {
+            // Offset seul
+            y = x + GCAL_IdealQ4(sorted[0].milliVolt) - sorted[0].rawQ4;
+        }
+        else
+        {
+            for (k = 0; (k < nb - 2) && (x > sorted[k + 1].rawQ4); k++)
+            {
+            }
+            xa = sorted[k].rawQ4;
+            xb = sorted[k + 1].rawQ4;
+            ya = GCAL_IdealQ4(sorted[k].milliVolt);
+            yb = GCAL_IdealQ4(sorted[k + 1].milliVolt);
+            y = (int64_t)(x - xa) * (yb - ya);
+            y = ya + ((y >= 0) ? (y + (xb - xa) / 2) : (y - (xb - xa) / 2)) / (xb - xa);
+        }
+        record.lut[chan][i] = (int16_t)((y > INT16_MAX) ? INT16_MAX : ((y < INT16_MIN) ? INT16_MIN : y));
+    }
+}
+
+static inline uint16_t GCAL_Lookup(const int16_t *pLut, uint16_t raw)
+{
+    int32_t a, y;
+
+    if (raw > GCAL_ADC_MAX)
+    {
+        raw = GCAL_ADC_MAX;
+    }
+    a = pLut[raw >> GCAL_SEG_SHIFT];
+    y = a + (((pLut[(raw >> GCAL_SEG_SHIFT) + 1] - a) * (int32_t)(raw & GCAL_SEG_MASK)
+              + (1 << (GCAL_SEG_SHIFT - 1))) >> GCAL_SEG_SHIFT);
+    y = (y + (1 << (GCAL_FRAC_BITS - 1))) >> GCAL_FRAC_BITS;
+    return (uint16_t)((y < 0) ? 0 : ((y > GCAL_ADC_MAX) ? GCAL_ADC_MAX : y));
+}
+
+uint16_t GCAL_Correct(uint8_t chan, uint16_t raw)
+{
+    return GCAL_Lookup(record.lut[chan], raw);
+}
+
+HOT_RAMFUNC void GCAL_ApplyAdc(S_ADCResults *pAdcRes)
+{
+    uint16_t *pValues = (uint16_t *)pAdcRes;
+    uint8_t chan;
+
+    // Capture : moyenne des lectures brutes
+    if (capLeft != 0)
+    {
+        capSum += pValues[capChan];
+        if ((pValues[capChan] == 0) || (pValues[capChan] >= GCAL_ADC_MAX))
+        {
+            capSaturated = true;
+        }
+        if ((--capLeft == 0) && !capSaturated)
+        {
+            capPoints[capChan][capNbPoints[capChan]].rawQ4 =
+                (uint16_t)(((capSum << GCAL_FRAC_BITS) + GCAL_CAPTURE_SAMPLES / 2) / GCAL_CAPTURE_SAMPLES);
+            capPoints[capChan][capNbPoints[capChan]].milliVolt = capMilliVolt;
+            capNbPoints[capChan]++;
+        }
+    }
+
+    for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+    {
+        pValues[chan] = GCAL_Lookup(record.lut[chan], pValues[chan]);
+    }
+}
+
+
+/*--------------------------------------------------------*/
+// Flash
+/*--------------------------------------------------------*/
+
+// Operation NVM (page ou mot) : sequence de deverrouillage sans
+// interruption, le CPU est suspendu jusqu'a la fin de l'operation
+static bool GCAL_NvmOperation(NVM_OPERATION_MODE operation, const uint8_t *pFlash, uint32_t data)
+{
+    SYS_INT_PROCESSOR_STATUS intStatus;
+
+    PLIB_NVM_MemoryModifyInhibit(NVM_ID_0);
+    PLIB_NVM_MemoryOperationSelect(NVM_ID_0, operation);
+    PLIB_NVM_FlashAddressToModify(NVM_ID_0, KVA_TO_PA(pFlash));
+    PLIB_NVM_FlashProvideData(NVM_ID_0, data);
+    PLIB_NVM_MemoryModifyEnable(NVM_ID_0);
+
+    intStatus = SYS_INT_StatusGetAndDisable();
+    PLIB_NVM_FlashWriteKeySequence(NVM_ID_0, GCAL_NVM_KEY1);
+    PLIB_NVM_FlashWriteKeySequence(NVM_ID_0, GCAL_NVM_KEY2);
+    PLIB_NVM_FlashWriteStart(NVM_ID_0);
+    SYS_INT_StatusRestore(intStatus);
+
+    while (!PLIB_NVM_FlashWriteCycleHasCompleted(NVM_ID_0))
+    {
+    }
+    PLIB_NVM_MemoryModifyInhibit(NVM_ID_0);
+
+    return !PLIB_NVM_WriteOperationHasTerminated(NVM_ID_0)
+           && !PLIB_NVM_LowVoltageHasOccurred(NVM_ID_0);
+}
+
+// Lecture par KSEG1 : sans cache, donc a jour apres une programmation
+static const uint8_t *GCAL_PageAddress(void)
+{
+    return (const uint8_t *)KVA0_TO_KVA1((uintptr_t)calibPage);
+}
+
+// Page effacee puis enregistrement programme mot par mot (~35 mots,
+// ~20 ms d'effacement + 0.7 ms)
+static bool GCAL_WriteRecord(void)
+{
+    const uint32_t *pWords = (const uint32_t *)&record;
+    uint16_t i;
+    bool ok;
+
+    ok = GCAL_NvmOperation(PAGE_ERASE_OPERATION, calibPage, 0);
+    for (i = 0; ok && (i < sizeof(record) / sizeof(uint32_t)); i++)
+    {
+        ok = GCAL_NvmOperation(WORD_PROGRAM_OPERATION, calibPage + i * sizeof(uint32_t), pWords[i]);
+    }
+    return ok && (memcmp(GCAL_PageAddress(), &record, sizeof(record)) == 0);
+}
+
+void GCAL_Initialize(void)
+{
+    uint8_t chan;
+
+    capLeft = 0;
+    memcpy(&record, GCAL_PageAddress(), sizeof(record));
+    calibrated = (record.magic == GCAL_MAGIC) && (record.lutSize == GCAL_LUT_SIZE)
+                 && (TFRM_Crc16((const uint8_t *)&record + GCAL_CRC_OFFSET,
+                                sizeof(record) - GCAL_CRC_OFFSET) == record.crc);
+    if (!calibrated)
+    {
+        memset(&record, 0, sizeof(record));
+        for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+        {
+            GCAL_Identity(chan);
+        }
+    }
+}
+
+bool GCAL_IsCalibrated(void)
+{
+    return calibrated;
+}
+
+
+/*--------------------------------------------------------*/
+// Capture
+/*--------------------------------------------------------*/
+
+void GCAL_CaptureStart(void)
+{
+    capLeft = 0;
+    memset(capNbPoints, 0, sizeof(capNbPoints));
+}
+
+bool GCAL_CapturePoint(uint8_t chan, uint16_t milliVolt)
+{
+    if ((capLeft != 0) || (chan >= GCAL_NB_CHAN) || (capNbPoints[chan] >= GCAL_MAX_POINTS))
+    {
+        return false;
+    }
+    capChan = chan;
+    capMilliVolt = milliVolt;
+    capSum = 0;
+    capSaturated = false;
+    capLeft = GCAL_CAPTURE_SAMPLES;     // en dernier : arme la capture
+    return true;
+}
+
+bool GCAL_CaptureBusy(void)
+{
+    return capLeft != 0;
+}
+
+uint8_t GCAL_CaptureNbPoints(uint8_t chan)
+{
+    return (chan < GCAL_NB_CHAN) ? capNbPoints[chan] : 0;
+}
+
+bool GCAL_CaptureCommit(void)
+{
+    uint8_t chan;
+
+    if (capLeft != 0)
+    {
+        return false;
+    }
+    memset(&record, 0, sizeof(record));
+    record.magic = GCAL_MAGIC;
+    record.lutSize = GCAL_LUT_SIZE;
+    for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+    {
+        record.nbPoints[chan] = capNbPoints[chan];
+        memcpy(record.points[chan], capPoints[chan], sizeof(record.points[chan]));
+        GCAL_BuildLut(chan, capPoints[chan], capNbPoints[chan]);
+    }
+    record.crc = TFRM_Crc16((const uint8_t *)&record + GCAL_CRC_OFFSET,
+                            sizeof(record) - GCAL_CRC_OFFSET);
+    calibrated = GCAL_WriteRecord();
+    return calibrated;
+}
+
+bool GCAL_Erase(void)
+{
+    bool ok = GCAL_NvmOperation(PAGE_ERASE_OPERATION, calibPage, 0);
+
+    GCAL_Initialize();
+    return ok;
+}
+
+void GCAL_GetRecord(S_calibRecord *pRecord)
+{
+    *pRecord = record;
+}
+
+
+/*--------------------------------------------------------*/
+// Mesure du cout (GCAL_BENCH_ENABLE)
+/*--------------------------------------------------------*/
+
+#if (GCAL_BENCH_ENABLE == 1)
+
+#define GCAL_BENCH_RUNS         3       // minimum : sans les interruptions
+#define GCAL_BENCH_NB_ADC       (GCAL_BENCH_BLOCK / GCAL_NB_CHAN)
+
+S_calibBench gcalBench;
+
+void GCAL_Bench(void)
+{
+    static S_ADCResults block[GCAL_BENCH_NB_ADC];
+    uint32_t start, cycles, best = UINT32_MAX;
+    uint16_t *pValues = (uint16_t *)block;
+    uint16_t i;
+    uint8_t run;
+
+    for (run = 0; run < GCAL_BENCH_RUNS; run++)
+    {
+        for (i = 0; i < GCAL_BENCH_BLOCK; i++)
+        {
+            pValues[i] = (uint16_t)((i * 37) & GCAL_ADC_MAX);
+        }
+        start = _CP0_GET_COUNT();
+        for (i = 0; i < GCAL_BENCH_NB_ADC; i++)
+        {
+            GCAL_ApplyAdc(&block[i]);
+        }
+        cycles = 2 * (_CP0_GET_COUNT() - start);
+        if (cycles < best)
+        {
+            best = cycles;
+        }
+    }
+    gcalBench.cyclesPerSampleX100 = best * 100 / GCAL_BENCH_BLOCK;
+}
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef GestCalib_H
+#define GestCalib_H
+/*--------------------------------------------------------*/
+// GestCalib.h
+/*--------------------------------------------------------*/
+//	Description :	Calibration des mesures ADC (offset, gain,
+//			        linearisation multi-points) par table en
+//			        flash, appliquee a chaque lecture
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+//  Correction : par canal, table de GCAL_LUT_SIZE points (code ADC
+//  corrige, Q4) aux codes bruts 0, 64, 128 .. 1024. Entre deux
+//  points, interpolation lineaire en entiers : une multiplication et
+//  deux decalages par mesure, resultat arrondi et sature 0..1023,
+//  dans l'echelle de la mesure brute (LSB = GCAL_VREF_MV / 1024).
+//  Table identite tant que la carte n'est pas calibree.
+//
+//  Capture (au debugger ou depuis un code de test), la mesure ADC
+//  tournant normalement :
+//   1. GCAL_CaptureStart
+//   2. pour chaque point : tension de reference stable sur l'entree,
+//      mesuree au multimetre, GCAL_CapturePoint(canal, mV), attendre
+//      GCAL_CaptureBusy() == false (moyenne de GCAL_CAPTURE_SAMPLES
+//      lectures brutes). Un point dont une lecture est saturee (0 ou
+//      1023) est ecarte : GCAL_CaptureNbPoints ne change pas.
+//   3. GCAL_CaptureCommit : table calculee et ecrite en flash
+//  1 point : offset seul. 2 points : offset et gain (droite). Plus :
+//  segments entre les points (non-linearite), prolonges aux bords
+//  par le premier et le dernier segment. La table reechantillonne
+//  ces segments aux codes 0, 64 ..., un coude entre deux points de
+//  la table est adouci.
+//
+//  Flash : une page a adresse fixe (GCAL_PAGE_ADDRESS), en-tete +
+//  CRC16, points captures conserves avec la table. Pour qu'elle
+//  survive a la reprogrammation, declarer la page dans "Preserve
+//  Program Memory" du programmateur (MPLAB X). CRC faux ou page
+//  vierge : table identite, GCAL_IsCalibrated() == false.
+//
+//  Cout mesure par GCAL_Bench (GCAL_BENCH_ENABLE = 1), tests sur PC
+//  avec un modele de carte : sim/, make calib.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Mc32DriverAdc.h"
+
+
+/*--------------------------------------------------------*/
+// Options de build
+/*--------------------------------------------------------*/
+
+// 1 = GCAL_Bench compile (cycles par mesure, resultat gcalBench)
+#ifndef GCAL_BENCH_ENABLE
+#define GCAL_BENCH_ENABLE       0
+#endif
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+#define GCAL_NB_CHAN            (sizeof(S_ADCResults) / sizeof(uint16_t))
+#define GCAL_ADC_MAX            1023
+
+// Reference de l'ADC : VDD (ADC_REFERENCE_VDD_TO_AVSS)
+#ifndef GCAL_VREF_MV
+#define GCAL_VREF_MV            3300
+#endif
+
+// Table : segments de 2^GCAL_SEG_SHIFT codes
+#define GCAL_SEG_SHIFT          6
+#define GCAL_LUT_SIZE           ((1024 >> GCAL_SEG_SHIFT) + 1)
+#define GCAL_FRAC_BITS          4       // Q4
+
+#define GCAL_MAX_POINTS         8       // points captures par canal
+#define GCAL_CAPTURE_SAMPLES    16      // lectures moyennees par point
+
+// Derniere page de la flash programme (512 ko), KSEG0
+#define GCAL_PAGE_SIZE          4096
+#define GCAL_PAGE_ADDRESS       0x9D07F000
+#define GCAL_MAGIC              0x4341
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+// Point capture : moyenne brute (Q4) pour une tension connue
+typedef struct {
+    uint16_t rawQ4;
+    uint16_t milliVolt;
+} S_calibPoint;
+
+// Enregistrement en flash (mots de 32 bits)
+typedef struct {
+    uint16_t magic;
+    uint16_t crc;               // CRC16 de ce qui suit
+    uint16_t lutSize;           // GCAL_LUT_SIZE a l'ecriture
+    uint8_t nbPoints[GCAL_NB_CHAN];
+    int16_t lut[GCAL_NB_CHAN][GCAL_LUT_SIZE];
+    S_calibPoint points[GCAL_NB_CHAN][GCAL_MAX_POINTS];
+} S_calibRecord;
+
+// Resultat de GCAL_Bench (cycles CPU, centiemes)
+#define GCAL_BENCH_BLOCK        256
+
+typedef struct {
+    uint32_t cyclesPerSampleX100;   // par canal
+} S_calibBench;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+// Table lue en flash (identite si absente ou invalide)
+void GCAL_Initialize(void);
+bool GCAL_IsCalibrated(void);
+
+// Chemin d'acquisition : mesures brutes -> corrigees, en place
+void GCAL_ApplyAdc(S_ADCResults *pAdcRes);
+uint16_t GCAL_Correct(uint8_t chan, uint16_t raw);
+
+// Capture
+void GCAL_CaptureStart(void);
+bool GCAL_CapturePoint(uint8_t chan, uint16_t milliVolt);
+bool GCAL_CaptureBusy(void);
+uint8_t GCAL_CaptureNbPoints(uint8_t chan);
+bool GCAL_CaptureCommit(void);
+// Retour a la table identite, page effacee
+bool GCAL_Erase(void);
+
+// Enregistrement en vigueur (tables et points captures)
+void GCAL_GetRecord(S_calibRecord *pRecord);
+
+#if (GCAL_BENCH_ENABLE == 1)
+extern S_calibBench gcalBench;
+void GCAL_Bench(void);
+#else
+#define GCAL_Bench()            ((void)0)
+#endif
+
+
+#endif
@@ -0,0 +1,473 @@
+/*--------------------------------------------------------*/
+// GestDds.c
+/*--------------------------------------------------------*/
+//	Description :	Generateur de signaux par synthese numerique
+//			        directe (DDS) sur la PWM de OC1, echantillons
+//			        pousses par DMA ou par l'ISR du Timer2
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include <string.h>
+#include <sys/kmem.h>
+#include "gestDds.h"
+#include "hotPath.h"
+#include "eventTrace.h"
+#include "system_config.h"
+#include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
+#include "peripheral/tmr/plib_tmr.h"
+#include "peripheral/oc/plib_oc.h"
+#include "peripheral/dma/plib_dma.h"
+#include "peripheral/int/plib_int.h"
+
+// Phase : index de table (poids forts), puis fraction d'interpolation
+#define GDDS_FRAC_BITS          15
+#define GDDS_INDEX_SHIFT        (32 - GDDS_TABLE_BITS)
+#define GDDS_FRAC_SHIFT         (GDDS_INDEX_SHIFT - GDDS_FRAC_BITS)
+#define GDDS_FRAC_MASK          ((1 << GDDS_FRAC_BITS) - 1)
+
+#define GDDS_FREQ_DEFAULT_MHZ   1000000     // 1 kHz
+
+// Difference de 2 points Q15 x fraction : tient sur 31 bits
+typedef char GDDS_CheckFrac[(GDDS_FRAC_SHIFT >= 0) && (GDDS_FRAC_BITS <= 15) ? 1 : -1];
+typedef char GDDS_CheckRamp[((GDDS_RAMP_SAMPLES & (GDDS_RAMP_SAMPLES - 1)) == 0) ? 1 : -1];
+
+// Sinus et triangle, Q15 arrondi (crete 32767), point final egal au
+// premier. Regeneres et verifies par sim/simDds -w.
+const int16_t gddsSine[GDDS_TABLE_SIZE + 1] = {
+         0,    804,   1608,   2410,   3212,   4011,   4808,   5602,
+      6393,   7179,   7962,   8739,   9512,  10278,  11039,  11793,
+     12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+     18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,
+     23170,  23731,  24279,  24811,  25329,  25832,  26319,  26790,
+     27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+     30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,
+     32137,  32285,  32412,  32521,  32609,  32678,  32728,  32757,
+     32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+     32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,
+     30273,  29956,  29621,  29268,  28898,  28510,  28105,  27683,
+     27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+     23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,
+     18204,  17530,  16846,  16151,  15446,  14732,  14010,  13279,
+     12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+      6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,
+         0,   -804,  -1608,  -2410,  -3212,  -4011,  -4808,  -5602,
+     -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+    -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+    -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+    -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+    -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+    -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+    -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+    -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+    -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,
+     -6393,  -5602,  -4808,  -4011,  -3212,  -2410,  -1608,   -804,
+         0
+};
+
+const int16_t gddsTriangle[GDDS_TABLE_SIZE + 1] = {
+         0,    512,   1024,   1536,   2048,   2560,   3072,   3584,
+      4096,   4608,   5120,   5632,   6144,   6656,   7168,   7680,
+      8192,   8704,   9216,   9728,  10240,  10752,  11264,  11776,
+     12288,  12800,  13312,  13824,  14336,  14848,  15360,  15872,
+     16384,  16895,  17407,  17919,  18431,  18943,  19455,  19967,
+     20479,  20991,  21503,  22015,  22527,  23039,  23551,  24063,
+     24575,  25087,  25599,  26111,  26623,  27135,  27647,  28159,
+     28671,  29183,  29695,  30207,  30719,  31231,  31743,  32255,
+     32767,  32255,  31743,  31231,  30719,  30207,  29695,  29183,
+     28671,  28159,  27647,  27135,  26623,  26111,  25599,  25087,
+     24575,  24063,  23551,  23039,  22527,  22015,  21503,  20991,
+     20479,  19967,  19455,  18943,  18431,  17919,  17407,  16895,
+     16384,  15872,  15360,  14848,  14336,  13824,  13312,  12800,
+     12288,  11776,  11264,  10752,  10240,   9728,   9216,   8704,
+      8192,   7680,   7168,   6656,   6144,   5632,   5120,   4608,
+      4096,   3584,   3072,   2560,   2048,   1536,   1024,    512,
+         0,   -512,  -1024,  -1536,  -2048,  -2560,  -3072,  -3584,
+     -4096,  -4608,  -5120,  -5632,  -6144,  -6656,  -7168,  -7680,
+     -8192,  -8704,  -9216,  -9728, -10240, -10752, -11264, -11776,
+    -12288, -12800, -13312, -13824, -14336, -14848, -15360, -15872,
+    -16384, -16895, -17407, -17919, -18431, -18943, -19455, -19967,
+    -20479, -20991, -21503, -22015, -22527, -23039, -23551, -24063,
+    -24575, -25087, -25599, -26111, -26623, -27135, -27647, -28159,
+    -28671, -29183, -29695, -30207, -30719, -31231, -31743, -32255,
+    -32767, -32255, -31743, -31231, -30719, -30207, -29695, -29183,
+    -28671, -28159, -27647, -27135, -26623, -26111, -25599, -25087,
+    -24575, -24063, -23551, -23039, -22527, -22015, -21503, -20991,
+    -20479, -19967, -19455, -18943, -18431, -17919, -17407, -16895,
+    -16384, -15872, -15360, -14848, -14336, -13824, -13312, -12800,
+    -12288, -11776, -11264, -10752, -10240,  -9728,  -9216,  -8704,
+     -8192,  -7680,  -7168,  -6656,  -6144,  -5632,  -5120,  -4608,
+     -4096,  -3584,  -3072,  -2560,  -2048,  -1536,  -1024,   -512,
+         0
+};
+
+// Buffer lu par le DMA : 2 moities, remplies tour a tour par l'ISR
+static uint16_t dmaBuf[2 * GDDS_HALF_SIZE];
+
+// Demandes de la boucle principale, prises au remplissage suivant
+// (mots de 32 bits : lecture atomique)
+static volatile uint32_t reqStep;
+static volatile uint32_t reqAmplitude;
+static const int16_t * volatile pReqWave;
+
+// Etat du generateur (ISR)
+static uint32_t phase;
+static uint32_t step;
+static const int16_t *pWave;
+static uint32_t amplitude;          // derniere demande prise
+static int32_t scaleQ16;            // crete en niveaux PWM, Q16
+static int32_t targetScale;
+static int32_t rampStepQ16;
+static uint16_t rampLeft;
+static uint16_t center;             // (PR2 + 1) / 2
+
+static uint32_t rateHz = GDDS_RATE_DEFAULT_HZ;
+static uint32_t freqMilliHz = GDDS_FREQ_DEFAULT_MHZ;
+static GDDS_MODE runMode = GDDS_MODE_DMA;
+static volatile bool running = false;
+static bool clockRegistered = false;
+
+static S_ddsStats stats;
+
+// Pas de phase arrondi, f * 2^32 / cadence
+static uint32_t GDDS_Step(uint32_t milliHz)
+{
+    uint64_t rateMilliHz = (uint64_t)rateHz * 1000u;
+
+    return (uint32_t)((((uint64_t)milliHz << 32) + rateMilliHz / 2) / rateMilliHz);
+}
+
+void GDDS_Initialize(void)
+{
+    GDDS_Stop();
+    rateHz = GDDS_RATE_DEFAULT_HZ;
+    freqMilliHz = GDDS_FREQ_DEFAULT_MHZ;
+    reqStep = GDDS_Step(freqMilliHz);
+    reqAmplitude = 0;
+    pReqWave = gddsSine;
+    memset(&stats, 0, sizeof(stats));
+
+    // Une seule inscription (GDDS_Initialize peut etre rappelee)
+    if (!clockRegistered)
+    {
+        clockRegistered = SYS_CLK_FrequencyChangeCallbackRegister(GDDS_ClockChanged);
+        if (!clockRegistered)
+        {
+            TRC_POINT(CLK_REJECT, TRC_CLK_DDS);
+        }
+    }
+}
+
+/*--------------------------------------------------------*/
+// Synthese
+/*--------------------------------------------------------*/
+
+HOT_RAMFUNC void GDDS_Fill(uint16_t *pDst, uint16_t nbSamples)
+{
+    uint32_t start = _CP0_GET_COUNT();
+    const int16_t *pNewWave = pReqWave;
+    uint32_t next, index, tics;
+    int32_t a, s;
+    uint16_t n;
+
+    // Frequence : la phase continue, seul le pas change
+    step = reqStep;
+
+    // Amplitude : rampe depuis la valeur courante (meme en cours de
+    // rampe), la crete suit la cadence (center)
+    if (reqAmplitude != amplitude)
+    {
+        amplitude = reqAmplitude;
+        targetScale = (int32_t)((amplitude * center + (1u << 14)) >> 15);
+        rampStepQ16 = (((int32_t)targetScale << 16) - scaleQ16) / GDDS_RAMP_SAMPLES;
+        rampLeft = GDDS_RAMP_SAMPLES;
+        stats.nbRamps++;
+    }
+
+    for (n = 0; n < nbSamples; n++)
+    {
+        index = phase >> GDDS_INDEX_SHIFT;
+        a = pWave[index];
+        s = a + (((pWave[index + 1] - a) * (int32_t)((phase >> GDDS_FRAC_SHIFT) & GDDS_FRAC_MASK)
+                  + (1 << (GDDS_FRAC_BITS - 1))) >> GDDS_FRAC_BITS);
+
+        if (rampLeft != 0)
+        {
+            scaleQ16 = (--rampLeft == 0) ? ((int32_t)targetScale << 16) : (scaleQ16 + rampStepQ16);
+        }
+        pDst[n] = (uint16_t)(center + ((s * (scaleQ16 >> 16) + (1 << 14)) >> 15));
+
+        // Forme d'onde : changee au passage de la phase par 0
+        next = phase + step;
+        if ((next < phase) && (pNewWave != pWave))
+        {
+            pWave = pNewWave;
+            stats.nbWaveChanges++;
+        }
+        phase = next;
+    }
+
+    stats.nbFills++;
+    stats.nbSamples += nbSamples;
+    tics = _CP0_GET_COUNT() - start;
+    if (tics > stats.maxFillTics)
+    {
+        stats.maxFillTics = tics;
+    }
+}
+
+// Mode DMA : moitie lue par le DMA -> remplie pour le tour suivant.
+// Les 2 flags a la fois : l'ISR a manque une moitie, relue telle
+// quelle par le DMA (discontinuite).
+HOT_RAMFUNC void GDDS_DmaCallback(void)
+{
+    bool firstHalf = PLIB_DMA_ChannelXINTSourceFlagGet(DMA_ID_0, GDDS_DMA_CHANNEL,
+                                                       DMA_INT_SOURCE_HALF_EMPTY);
+    bool secondHalf = PLIB_DMA_ChannelXINTSourceFlagGet(DMA_ID_0, GDDS_DMA_CHANNEL,
+                                                        DMA_INT_SOURCE_DONE);
+
+    PLIB_DMA_ChannelXINTSourceFlagClear(DMA_ID_0, GDDS_DMA_CHANNEL, DMA_INT_SOURCE_HALF_EMPTY);
+    PLIB_DMA_ChannelXINTSourceFlagClear(DMA_ID_0, GDDS_DMA_CHANNEL, DMA_INT_SOURCE_DONE);
+
+    if (firstHalf && secondHalf)
+    {
+        stats.nbLate++;
+    }
+    if (firstHalf)
+    {
+        GDDS_Fill(&dmaBuf[0], GDDS_HALF_SIZE);
+    }
+    if (secondHalf)
+    {
+        GDDS_Fill(&dmaBuf[GDDS_HALF_SIZE], GDDS_HALF_SIZE);
+    }
+}
+
+// Mode ISR : OC1RS est pris a la periode suivante, l'ISR a toute la
+// periode pour l'ecrire
+HOT_RAMFUNC void GDDS_TimerCallback(void)
+{
+    uint16_t duty;
+
+    GDDS_Fill(&duty, 1);
+    PLIB_OC_PulseWidth16BitSet(GDDS_OC_ID, duty);
+}
+
+/*--------------------------------------------------------*/
+// Commande
+/*--------------------------------------------------------*/
+
+bool GDDS_Start(uint32_t newRateHz, GDDS_MODE mode)
+{
+    uint32_t period;
+
+    if ((newRateHz < GDDS_RATE_MIN_HZ) || (newRateHz > GDDS_RATE_MAX_HZ) || (mode >= GDDS_NB_MODES))
+    {
+        return false;
+    }
+    period = SYS_CLK_PeripheralFrequencyGet(CLK_BUS_PERIPHERAL_1) / newRateHz;
+    if (period > 65536)
+    {
+        return false;
+    }
+    GDDS_Stop();
+
+    // Depart de la phase 0, crete nulle : l'amplitude demandee est
+    // atteinte par une rampe
+    rateHz = newRateHz;
+    runMode = mode;
+    center = (uint16_t)(period / 2);
+    reqStep = GDDS_Step(freqMilliHz);
+    phase = 0;
+    pWave = pReqWave;
+    amplitude = 0;
+    scaleQ16 = 0;
+    targetScale = 0;
+    rampLeft = 0;
+
+    // Timer2 : periode PWM = periode d'echantillonnage
+    PLIB_TMR_Stop(GDDS_TMR_ID);
+    PLIB_TMR_ClockSourceSelect(GDDS_TMR_ID, TMR_CLOCK_SOURCE_PERIPHERAL_CLOCK);
+    PLIB_TMR_PrescaleSelect(GDDS_TMR_ID, TMR_PRESCALE_VALUE_1);
+    PLIB_TMR_Mode16BitEnable(GDDS_TMR_ID);
+    PLIB_TMR_Counter16BitClear(GDDS_TMR_ID);
+    PLIB_TMR_Period16BitSet(GDDS_TMR_ID, (uint16_t)(period - 1));
+
+    // OC1 : PWM, rapport cyclique OC1RS pris a chaque periode
+    PLIB_OC_Disable(GDDS_OC_ID);
+    PLIB_OC_ModeSelect(GDDS_OC_ID, OC_COMPARE_PWM_MODE_WITHOUT_FAULT_PROTECTION);
+    PLIB_OC_BufferSizeSelect(GDDS_OC_ID, OC_BUFFER_SIZE_16BIT);
+    PLIB_OC_TimerSelect(GDDS_OC_ID, GDDS_OC_TIMER);
+    PLIB_OC_Buffer16BitSet(GDDS_OC_ID, center);
+    PLIB_OC_PulseWidth16BitSet(GDDS_OC_ID, center);
+    PLIB_OC_Enable(GDDS_OC_ID);
+
+    if (mode == GDDS_MODE_DMA)
+    {
+        // Buffer plein avant le 1er evenement. Une cellule (u16) vers
+        // OC1RS par periode, en boucle (auto enable). T2IF declenche le
+        // transfert sans etre efface, l'IT du Timer2 reste inactive.
+        GDDS_Fill(dmaBuf, 2 * GDDS_HALF_SIZE);
+        PLIB_DMA_Enable(DMA_ID_0);
+        PLIB_DMA_ChannelXPrioritySelect(DMA_ID_0, GDDS_DMA_CHANNEL, DMA_CHANNEL_PRIORITY_3);
+        PLIB_DMA_ChannelXAutoEnable(DMA_ID_0, GDDS_DMA_CHANNEL);
+        PLIB_DMA_ChannelXStartIRQSet(DMA_ID_0, GDDS_DMA_CHANNEL, GDDS_DMA_TRIGGER);
+        PLIB_DMA_ChannelXTriggerEnable(DMA_ID_0, GDDS_DMA_CHANNEL, DMA_CHANNEL_TRIGGER_TRANSFER_START);
+        PLIB_DMA_ChannelXSourceStartAddressSet(DMA_ID_0, GDDS_DMA_CHANNEL, KVA_TO_PA(dmaBuf));
+        PLIB_DMA_ChannelXSourceSizeSet(DMA_ID_0, GDDS_DMA_CHANNEL, sizeof(dmaBuf));
+        PLIB_DMA_ChannelXDestinationStartAddressSet(DMA_ID_0, GDDS_DMA_CHANNEL, KVA_TO_PA(&GDDS_OC_RS));
+        PLIB_DMA_ChannelXDestinationSizeSet(DMA_ID_0, GDDS_DMA_CHANNEL, sizeof(uint16_t));
+        PLIB_DMA_ChannelXCellSizeSet(DMA_ID_0, GDDS_DMA_CHANNEL, sizeof(uint16_t));
+        PLIB_DMA_ChannelXINTSourceFlagClear(DMA_ID_0, GDDS_DMA_CHANNEL, DMA_INT_SOURCE_HALF_EMPTY);
+        PLIB_DMA_ChannelXINTSourceFlagClear(DMA_ID_0, GDDS_DMA_CHANNEL, DMA_INT_SOURCE_DONE);
+        PLIB_DMA_ChannelXINTSourceEnable(DMA_ID_0, GDDS_DMA_CHANNEL, DMA_INT_SOURCE_HALF_EMPTY);
+        PLIB_DMA_ChannelXINTSourceEnable(DMA_ID_0, GDDS_DMA_CHANNEL, DMA_INT_SOURCE_DONE);
+
+        PLIB_INT_VectorPrioritySet(INT_ID_0, GDDS_DMA_INT_VECTOR, GDDS_DMA_INT_PRIORITY);
+        PLIB_INT_VectorSubPrioritySet(INT_ID_0, GDDS_DMA_INT_VECTOR, INT_SUBPRIORITY_LEVEL0);
+        PLIB_INT_SourceFlagClear(INT_ID_0, GDDS_DMA_INT_SOURCE);
+        PLIB_INT_SourceEnable(INT_ID_0, GDDS_DMA_INT_SOURCE);
+        PLIB_DMA_ChannelXEnable(DMA_ID_0, GDDS_DMA_CHANNEL);
+    }
+    else
+    {
+        PLIB_INT_VectorPrioritySet(INT_ID_0, GDDS_TMR_INT_VECTOR, GDDS_TMR_INT_PRIORITY);
+        PLIB_INT_VectorSubPrioritySet(INT_ID_0, GDDS_TMR_INT_VECTOR, INT_SUBPRIORITY_LEVEL0);
+        PLIB_INT_SourceFlagClear(INT_ID_0, GDDS_TMR_INT_SOURCE);
+        PLIB_INT_SourceEnable(INT_ID_0, GDDS_TMR_INT_SOURCE);
+    }
+
+    running = true;
+    PLIB_TMR_Start(GDDS_TMR_ID);
+    return true;
+}
+
+// La PWM continue a 50 % : sortie filtree au point milieu
+void GDDS_Stop(void)
+{
+    if (!running)
+    {
+        return;
+    }
+    PLIB_INT_SourceDisable(INT_ID_0, GDDS_TMR_INT_SOURCE);
+    PLIB_INT_SourceDisable(INT_ID_0, GDDS_DMA_INT_SOURCE);
+    PLIB_DMA_ChannelXDisable(DMA_ID_0, GDDS_DMA_CHANNEL);
+    PLIB_DMA_AbortTransferSet(DMA_ID_0, GDDS_DMA_CHANNEL);     // pointeurs au debut
+    PLIB_OC_PulseWidth16BitSet(GDDS_OC_ID, center);
+    running = false;
+}
+
+bool GDDS_IsRunning(void)
+{
+    return running;
+}
+
+// Horloge modifiee : PR2 recalcule pour garder la cadence, avec le
+// pas de phase et la crete (center). Le generateur repart (saut
+// possible, rampe d'amplitude) ; arrete au point milieu si la cadence
+// n'est plus atteignable.
+void GDDS_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz)
+{
+    (void)systemClockHz;
+    (void)peripheralClockHz;    // relue par GDDS_Start
+
+    if (running && !GDDS_Start(rateHz, runMode))
+    {
+        GDDS_Stop();
+    }
+}
+
+bool GDDS_SetFrequency(uint32_t milliHz)
+{
+    if ((uint64_t)milliHz * 2 > (uint64_t)rateHz * 1000u)
+    {
+        return false;
+    }
+    freqMilliHz = milliHz;
+    reqStep = GDDS_Step(milliHz);
+    return true;
+}
+
+void GDDS_SetAmplitude(uint16_t amplitudeQ15)
+{
+    reqAmplitude = (amplitudeQ15 > GDDS_AMPLITUDE_MAX) ? GDDS_AMPLITUDE_MAX : amplitudeQ15;
+}
+
+void GDDS_SetWaveform(const int16_t *pTable)
+{
+    pReqWave = pTable;
+}
+
+void GDDS_GetStats(S_ddsStats *pStats)
+{
+    *pStats = stats;
+}
+
+
+/*--------------------------------------------------------*/
+// Mesure de la charge CPU (GDDS_BENCH_ENABLE)
+/*--------------------------------------------------------*/
+
+#if (GDDS_BENCH_ENABLE == 1)
+
+S_ddsBench gddsBench;
+
+// Tours d'une boucle vide pendant GDDS_BENCH_MS : les cycles pris par
+// les ISR et le DMA manquent a la boucle
+static uint32_t GDDS_BenchLoop(void)
+{
+    uint32_t tics = SYS_CLK_SystemFrequencyGet() / 2 / 1000 * GDDS_BENCH_MS;
+    uint32_t start = _CP0_GET_COUNT();
+    uint32_t count = 0;
+
+    while ((_CP0_GET_COUNT() - start) < tics)
+    {
+        count++;
+    }
+    return count;
+}
+
+void GDDS_Bench(void)
+{
+    static const uint32_t rates[GDDS_BENCH_NB_RATES] = {
+#define GDDS_BENCH_RATE(n)      n,
+        GDDS_BENCH_RATES(GDDS_BENCH_RATE)
+    };
+    bool wasRunning = running;
+    uint32_t oldRate = rateHz;
+    GDDS_MODE oldMode = runMode;
+    uint32_t reference, count;
+    uint8_t mode, i;
+
+    GDDS_Stop();
+    reference = GDDS_BenchLoop();
+    for (mode = 0; mode < GDDS_NB_MODES; mode++)
+    {
+        for (i = 0; i < GDDS_BENCH_NB_RATES; i++)
+        {
+            gddsBench.rateHz[i] = rates[i];
+            GDDS_Start(rates[i], (GDDS_MODE)mode);
+            count = GDDS_BenchLoop();
+            GDDS_Stop();
+            gddsBench.loadPermille[mode][i] = (count >= reference) ? 0
+                : (uint16_t)(1000 - ((uint64_t)count * 1000 + reference / 2) / reference);
+        }
+    }
+    if (wasRunning)
+    {
+        GDDS_Start(oldRate, oldMode);
+    }
+}
+
+#endif
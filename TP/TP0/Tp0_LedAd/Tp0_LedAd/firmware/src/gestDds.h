@@ -0,0 +1,199 @@
+#ifndef GestDds_H
+#define GestDds_H
+/*--------------------------------------------------------*/
+// GestDds.h
+/*--------------------------------------------------------*/
+//	Description :	Generateur de signaux par synthese numerique
+//			        directe (DDS) sur la PWM de OC1, echantillons
+//			        pousses par DMA ou par l'ISR du Timer2
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+//  Sortie : OC1 (RD0) en PWM, base de temps Timer2. Une periode PWM
+//  par echantillon : rapport cyclique 0..PR2 + 1, PR2 + 1 = PBCLK /
+//  cadence (800 niveaux, 9.6 bits, a 100 kHz). Filtre RC externe
+//  (passe-bas sous la moitie de la cadence) pour obtenir le signal.
+//
+//  Synthese : accumulateur de phase 32 bits, pas = f * 2^32 /
+//  cadence (resolution cadence / 2^32). Les 8 bits de poids fort
+//  indexent une table de GDDS_TABLE_SIZE + 1 points (Q15, en flash),
+//  les 15 suivants interpolent lineairement entre deux points
+//  (sinus : erreur < 9e-5 de la crete, SINAD 85 dB, sous la PWM
+//  au-dessus de 10 kHz). Une multiplication pour l'interpolation,
+//  une pour l'amplitude.
+//
+//  Modes :
+//  - GDDS_MODE_DMA : le canal DMA GDDS_DMA_CHANNEL copie un
+//    echantillon du buffer vers OC1RS a chaque periode du Timer2
+//    (declenchement par T2IF, interruption du Timer2 inactive), en
+//    boucle sur 2 moities de GDDS_HALF_SIZE. L'ISR DMA remplit la
+//    moitie qui vient d'etre lue : une ISR par GDDS_HALF_SIZE
+//    echantillons.
+//  - GDDS_MODE_ISR : l'ISR du Timer2 calcule et ecrit chaque
+//    echantillon (pas de latence de buffer, une ISR par echantillon).
+//
+//  Changements sans saut :
+//  - frequence : seul le pas change, la phase continue
+//  - amplitude : rampe lineaire sur GDDS_RAMP_SAMPLES echantillons
+//  - forme d'onde : prise en compte au passage de la phase par 0
+//  Valeurs prises au debut du remplissage suivant (mode DMA : jusqu'a
+//  3 moities de buffer de retard, 0.5 ms a 100 kHz).
+//
+//  Changement d'horloge (SYS_CLK_SystemFrequencyScale) : PR2 suit
+//  PBCLK pour garder la cadence, le generateur repart.
+//
+//  Mise en service : GDDS_ENABLE = 1 (sinon l'application ne lance
+//  ni le generateur ni GDDS_Bench, RD0 reste en entree). Les
+//  effacements de page du journal flash (GFLG) arretent le CPU : en
+//  mode DMA les moities non remplies a temps sont comptees (nbLate).
+//
+//  Cout : GDDS_Bench (GDDS_BENCH_ENABLE = 1) mesure la charge CPU de
+//  chaque mode a plusieurs cadences, resultat dans gddsBench. Purete
+//  spectrale et changements sans saut sur PC : sim/, make dds.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*--------------------------------------------------------*/
+// Options de build
+/*--------------------------------------------------------*/
+
+// 1 = generateur lance par l'application (APP_STATE_INIT) : sinus a
+// GDDS_RATE_DEFAULT_HZ en mode DMA, RD0 passe en sortie
+#ifndef GDDS_ENABLE
+#define GDDS_ENABLE             0
+#endif
+
+// 1 = GDDS_Bench compile (charge CPU par mode et cadence, resultat
+// gddsBench). Dure GDDS_BENCH_MS x (1 + 2 x nombre de cadences).
+#ifndef GDDS_BENCH_ENABLE
+#define GDDS_BENCH_ENABLE       0
+#endif
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+// Timer, OC et DMA utilises (RD0 libre sur le kit, a verifier avec le
+// schema). Priorites : l'ISR DMA doit remplir une moitie avant que le
+// DMA y revienne, l'ISR Timer2 finir avant l'echantillon suivant.
+#define GDDS_TMR_ID             TMR_ID_2
+#define GDDS_OC_ID              OC_ID_1
+#define GDDS_OC_TIMER           OC_TIMER_16BIT_TMR2
+#define GDDS_OC_RS              OC1RS
+#define GDDS_PIN_CHANNEL        PORT_CHANNEL_D  // RD0 = OC1
+#define GDDS_PIN_BIT            PORTS_BIT_POS_0
+#define GDDS_DMA_CHANNEL        DMA_CHANNEL_1
+#define GDDS_DMA_TRIGGER        DMA_TRIGGER_TIMER_2
+#define GDDS_DMA_INT_SOURCE     INT_SOURCE_DMA_1
+#define GDDS_DMA_INT_VECTOR     INT_VECTOR_DMA1
+#define GDDS_DMA_INT_PRIORITY   INT_PRIORITY_LEVEL4
+#define GDDS_TMR_INT_SOURCE     INT_SOURCE_TIMER_2
+#define GDDS_TMR_INT_VECTOR     INT_VECTOR_T2
+#define GDDS_TMR_INT_PRIORITY   INT_PRIORITY_LEVEL5
+
+// Cadence : PR2 sur 16 bits, au moins 200 niveaux de PWM (7.6 bits)
+#define GDDS_RATE_MIN_HZ        2000
+#define GDDS_RATE_MAX_HZ        400000
+#define GDDS_RATE_DEFAULT_HZ    100000
+
+// Table : 2^GDDS_TABLE_BITS points + 1 (le dernier egal au premier)
+#define GDDS_TABLE_BITS         8
+#define GDDS_TABLE_SIZE         (1 << GDDS_TABLE_BITS)
+
+#define GDDS_HALF_SIZE          32      // echantillons par ISR DMA
+#define GDDS_RAMP_SAMPLES       32      // rampe d'amplitude
+
+// Amplitude Q15 : 32767 = pleine echelle (rapport cyclique 0..100 %)
+#define GDDS_AMPLITUDE_MAX      32767
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+typedef enum {
+    GDDS_MODE_DMA = 0,
+    GDDS_MODE_ISR,
+    GDDS_NB_MODES
+} GDDS_MODE;
+
+// Instrumentation (tics du core timer, SYS_CLK_FREQ / 2)
+typedef struct {
+    uint32_t nbFills;       // remplissages (ISR DMA ou Timer2)
+    uint32_t nbSamples;     // echantillons calcules
+    uint32_t nbLate;        // mode DMA : moitie relue avant d'etre remplie
+    uint32_t nbRamps;       // changements d'amplitude
+    uint32_t nbWaveChanges; // formes d'onde prises au passage par 0
+    uint32_t maxFillTics;   // remplissage le plus long
+} S_ddsStats;
+
+// Resultat de GDDS_Bench : charge CPU en pour mille, d'apres les
+// cycles pris a une boucle de reference (ISR complete, entree et
+// sortie comprises, et acces DMA au bus)
+#define GDDS_BENCH_RATES(X)     X(10000) X(25000) X(50000) X(100000) X(200000)
+
+#define GDDS_BENCH_COUNT(n)     + 1
+#define GDDS_BENCH_NB_RATES     (0 GDDS_BENCH_RATES(GDDS_BENCH_COUNT))
+#define GDDS_BENCH_MS           20
+
+typedef struct {
+    uint32_t rateHz[GDDS_BENCH_NB_RATES];
+    uint16_t loadPermille[GDDS_NB_MODES][GDDS_BENCH_NB_RATES];
+} S_ddsBench;
+
+
+/*--------------------------------------------------------*/
+// Tables en flash (GDDS_TABLE_SIZE + 1 points, Q15)
+/*--------------------------------------------------------*/
+
+extern const int16_t gddsSine[GDDS_TABLE_SIZE + 1];
+extern const int16_t gddsTriangle[GDDS_TABLE_SIZE + 1];
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+// Sinus, 1 kHz, amplitude nulle, generateur arrete
+void GDDS_Initialize(void);
+
+// Cadence et mode : le generateur repart (saut possible), frequence
+// et amplitude conservees. false si la cadence est hors limites.
+bool GDDS_Start(uint32_t rateHz, GDDS_MODE mode);
+void GDDS_Stop(void);                   // sortie au point milieu
+bool GDDS_IsRunning(void);
+
+// Sans saut, appelables pendant la generation. false si la frequence
+// depasse la moitie de la cadence.
+bool GDDS_SetFrequency(uint32_t freqMilliHz);
+void GDDS_SetAmplitude(uint16_t amplitudeQ15);
+// pTable : GDDS_TABLE_SIZE + 1 points Q15, pTable[GDDS_TABLE_SIZE] ==
+// pTable[0], garde en memoire pendant la generation (const : en flash)
+void GDDS_SetWaveform(const int16_t *pTable);
+
+// Echantillons suivants (rapports cycliques), sans sortie : utilise
+// par les ISR, et par les tests sur PC
+void GDDS_Fill(uint16_t *pDst, uint16_t nbSamples);
+
+void GDDS_GetStats(S_ddsStats *pStats);
+
+void GDDS_DmaCallback(void);            // appelee par l'ISR DMA
+void GDDS_TimerCallback(void);          // appelee par l'ISR Timer2
+void GDDS_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz);
+
+#if (GDDS_BENCH_ENABLE == 1)
+extern S_ddsBench gddsBench;
+void GDDS_Bench(void);
+#else
+#define GDDS_Bench()            ((void)0)
+#endif
+
+
+#endif
@@ -0,0 +1,472 @@
+/*--------------------------------------------------------*/
+// GestFlashLog.c
+/*--------------------------------------------------------*/
+//	Description :	Historique des mesures ADC en flash programme,
+//			        journal circulaire conserve sans alimentation
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include <string.h>
+#include <sys/kmem.h>
+#include "gestFlashLog.h"
+#include "telemetryFrame.h"
+#include "eventTrace.h"
+#include "system_config.h"
+#include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
+#include "system/int/sys_int.h"
+#include "peripheral/nvm/plib_nvm.h"
+
+#define GFLG_NVM_KEY1           0xAA996655
+#define GFLG_NVM_KEY2           0x556699AA
+
+// Octets couverts par le CRC : de nbSamples a la fin des echantillons
+#define GFLG_CRC_OFFSET         4
+
+// En-tete et echantillons occupent au plus une rangee
+typedef char GFLG_CheckHeader[(sizeof(S_flashLogRowHeader) == GFLG_HEADER_SIZE) ? 1 : -1];
+typedef char GFLG_CheckRow[(GFLG_HEADER_SIZE + GFLG_SAMPLES_PER_ROW * GFLG_SAMPLE_SIZE
+                            <= GFLG_ROW_SIZE) ? 1 : -1];
+typedef char GFLG_CheckAdcLayout[(sizeof(S_ADCResults) % sizeof(uint16_t) == 0) ? 1 : -1];
+
+// Zone reservee. noload : pas d'image dans le .hex, le programmateur
+// la laisse effacee et le journal survit aux resets.
+#if defined(__XC32)
+static const uint8_t flashRegion[GFLG_REGION_SIZE]
+    __attribute__((aligned(GFLG_PAGE_SIZE), space(prog), noload));
+#else
+// Simulation : memoire NVM du simulateur (sim/simNvm.c)
+extern uint8_t simNvmFlash[GFLG_REGION_SIZE];
+#define flashRegion             simNvmFlash
+#endif
+
+// Rangee en construction, source du DMA de programmation (alignee mot)
+static uint32_t rowBuf[GFLG_ROW_SIZE / sizeof(uint32_t)];
+static S_flashLogRowHeader * const pRowHeader = (S_flashLogRowHeader *)rowBuf;
+static uint16_t * const pRowSamples = (uint16_t *)((uint8_t *)rowBuf + GFLG_HEADER_SIZE);
+
+// Decimation : somme des mesures en cours
+static uint32_t decimSum[GFLG_NB_CHAN];
+static uint16_t decimCount = 0;
+
+// Prochaine rangee de l'historique a programmer
+static uint32_t nextRowSeq = 0;
+
+// Horodatage en ms depuis le core timer, qui suit l'horloge systeme
+static uint32_t coreClockHz = SYS_CLK_FREQ / 2;
+static uint32_t lastCount;
+static uint64_t remainder = 0;     // tics x 1000 pas encore convertis
+static uint32_t nowMs = 0;
+
+static S_flashLogStats stats;
+
+static uint32_t GFLG_StampMs(void)
+{
+    uint32_t count = _CP0_GET_COUNT();
+
+    remainder += (uint64_t)(count - lastCount) * 1000u;
+    lastCount = count;
+    nowMs += (uint32_t)(remainder / coreClockHz);
+    remainder %= coreClockHz;
+
+    return nowMs;
+}
+
+// Lecture de la zone par KSEG1 : sans cache, donc a jour apres une
+// programmation
+static const uint8_t *GFLG_RowAddress(uint32_t rowSeq)
+{
+    uintptr_t base = KVA0_TO_KVA1((uintptr_t)flashRegion);
+
+    return (const uint8_t *)base + (rowSeq % GFLG_NB_ROWS) * GFLG_ROW_SIZE;
+}
+
+// Plus ancienne rangee conservee : l'entree dans la page de nextRowSeq
+// a efface les GFLG_ROWS_PER_PAGE rangees du tour precedent
+static uint32_t GFLG_OldestSeq(void)
+{
+    uint32_t pageEnd = (nextRowSeq + GFLG_ROWS_PER_PAGE - 1) / GFLG_ROWS_PER_PAGE
+                       * GFLG_ROWS_PER_PAGE;
+
+    return (pageEnd > GFLG_NB_ROWS) ? (pageEnd - GFLG_NB_ROWS) : 0;
+}
+
+// Rangee rowSeq presente et complete (CRC), en-tete copie dans pHeader
+static bool GFLG_RowValid(uint32_t rowSeq, S_flashLogRowHeader *pHeader)
+{
+    const uint8_t *pRow = GFLG_RowAddress(rowSeq);
+
+    memcpy(pHeader, pRow, GFLG_HEADER_SIZE);
+    if ((pHeader->magic != GFLG_ROW_MAGIC) || (pHeader->rowSeq != rowSeq)
+        || (pHeader->nbSamples == 0) || (pHeader->nbSamples > GFLG_SAMPLES_PER_ROW))
+    {
+        return false;
+    }
+    return TFRM_Crc16(pRow + GFLG_CRC_OFFSET, GFLG_HEADER_SIZE - GFLG_CRC_OFFSET
+                      + pHeader->nbSamples * GFLG_SAMPLE_SIZE) == pHeader->crc;
+}
+
+static bool GFLG_RowErased(const uint8_t *pRow)
+{
+    const uint32_t *pWord = (const uint32_t *)pRow;
+    uint16_t i;
+
+    for (i = 0; i < GFLG_ROW_SIZE / sizeof(uint32_t); i++)
+    {
+        if (pWord[i] != 0xFFFFFFFF)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Operation NVM (page ou rangee) : sequence de deverrouillage sans
+// interruption, le CPU est suspendu jusqu'a la fin de l'operation
+static bool GFLG_NvmOperation(NVM_OPERATION_MODE operation, const uint8_t *pFlash,
+                              const void *pSource)
+{
+    SYS_INT_PROCESSOR_STATUS intStatus;
+
+    PLIB_NVM_MemoryModifyInhibit(NVM_ID_0);
+    PLIB_NVM_MemoryOperationSelect(NVM_ID_0, operation);
+    PLIB_NVM_FlashAddressToModify(NVM_ID_0, KVA_TO_PA(pFlash));
+    if (pSource != NULL)
+    {
+        PLIB_NVM_DataBlockSourceAddress(NVM_ID_0, KVA_TO_PA(pSource));
+    }
+    PLIB_NVM_MemoryModifyEnable(NVM_ID_0);
+
+    intStatus = SYS_INT_StatusGetAndDisable();
+    PLIB_NVM_FlashWriteKeySequence(NVM_ID_0, GFLG_NVM_KEY1);
+    PLIB_NVM_FlashWriteKeySequence(NVM_ID_0, GFLG_NVM_KEY2);
+    PLIB_NVM_FlashWriteStart(NVM_ID_0);
+    SYS_INT_StatusRestore(intStatus);
+
+    while (!PLIB_NVM_FlashWriteCycleHasCompleted(NVM_ID_0))
+    {
+    }
+    PLIB_NVM_MemoryModifyInhibit(NVM_ID_0);
+
+    return !PLIB_NVM_WriteOperationHasTerminated(NVM_ID_0)
+           && !PLIB_NVM_LowVoltageHasOccurred(NVM_ID_0);
+}
+
+// Programmation de la rangee en construction sous nextRowSeq
+static void GFLG_WriteRow(void)
+{
+    uint32_t start = _CP0_GET_COUNT();
+    uint32_t tics;
+    const uint8_t *pRow;
+    uint32_t rowSeq;
+
+    // 1re rangee d'une page : effacement de la page (plus anciennes
+    // mesures). Sinon la rangee doit etre vierge ; une rangee
+    // programmee est un reste de coupure, elle est sautee.
+    for (;;)
+    {
+        rowSeq = nextRowSeq;
+        pRow = GFLG_RowAddress(rowSeq);
+        if ((rowSeq % GFLG_ROWS_PER_PAGE) == 0)
+        {
+            if (!GFLG_NvmOperation(PAGE_ERASE_OPERATION, pRow, NULL))
+            {
+                stats.nbErrors++;
+            }
+            stats.nbErases++;
+            break;
+        }
+        if (GFLG_RowErased(pRow))
+        {
+            break;
+        }
+        stats.nbSkipped++;
+        nextRowSeq++;
+    }
+
+    pRowHeader->magic = GFLG_ROW_MAGIC;
+    pRowHeader->reserved = 0xFFFF;
+    pRowHeader->rowSeq = rowSeq;
+    pRowHeader->crc = TFRM_Crc16((const uint8_t *)rowBuf + GFLG_CRC_OFFSET,
+                                 GFLG_HEADER_SIZE - GFLG_CRC_OFFSET
+                                 + pRowHeader->nbSamples * GFLG_SAMPLE_SIZE);
+
+    // Relecture : une cellule usee ne se programme plus, la rangee
+    // reste invalide (CRC) et sera sautee a la lecture
+    if (!GFLG_NvmOperation(ROW_PROGRAM_OPERATION, pRow, rowBuf)
+        || (memcmp(pRow, rowBuf, GFLG_ROW_SIZE) != 0))
+    {
+        stats.nbErrors++;
+    }
+    stats.nbRows++;
+    nextRowSeq = rowSeq + 1;
+
+    pRowHeader->nbSamples = 0;
+    memset(pRowSamples, 0xFF, GFLG_ROW_SIZE - GFLG_HEADER_SIZE);
+
+    tics = _CP0_GET_COUNT() - start;
+    if (tics > stats.maxWriteTics)
+    {
+        stats.maxWriteTics = tics;
+    }
+}
+
+// Ajout d'un echantillon (moyenne de GFLG_DECIMATION mesures)
+static void GFLG_AddSample(uint32_t stampMs, const uint16_t *pChan)
+{
+    uint16_t *pSample;
+    uint8_t i;
+
+    // Delta sur 16 bits : un ecart plus long commence une rangee
+    if ((pRowHeader->nbSamples > 0) && ((stampMs - pRowHeader->lastMs) > 0xFFFF))
+    {
+        GFLG_WriteRow();
+    }
+
+    pSample = pRowSamples + pRowHeader->nbSamples * (GFLG_SAMPLE_SIZE / sizeof(uint16_t));
+    if (pRowHeader->nbSamples == 0)
+    {
+        pRowHeader->firstMs = stampMs;
+        pSample[0] = 0;
+    }
+    else
+    {
+        pSample[0] = (uint16_t)(stampMs - pRowHeader->lastMs);
+    }
+    for (i = 0; i < GFLG_NB_CHAN; i++)
+    {
+        pSample[1 + i] = pChan[i];
+    }
+    pRowHeader->lastMs = stampMs;
+    pRowHeader->nbSamples++;
+    stats.nbSamples++;
+
+    if (pRowHeader->nbSamples >= GFLG_SAMPLES_PER_ROW)
+    {
+        GFLG_WriteRow();
+    }
+}
+
+// Recherche de la rangee la plus recente : numero de la prochaine
+// rangee et reprise de l'horodatage apres sa derniere mesure
+void GFLG_Initialize(void)
+{
+    S_flashLogRowHeader header;
+    bool found = false;
+    uint32_t row;
+
+    memset(&stats, 0, sizeof(stats));
+    nextRowSeq = 0;
+    nowMs = 0;
+    for (row = 0; row < GFLG_NB_ROWS; row++)
+    {
+        memcpy(&header, GFLG_RowAddress(row), GFLG_HEADER_SIZE);
+        if (((header.rowSeq % GFLG_NB_ROWS) == row) && GFLG_RowValid(header.rowSeq, &header)
+            && (!found || (header.rowSeq >= nextRowSeq)))
+        {
+            found = true;
+            nextRowSeq = header.rowSeq + 1;
+            nowMs = header.lastMs + 1;
+        }
+    }
+
+    pRowHeader->nbSamples = 0;
+    memset(pRowSamples, 0xFF, GFLG_ROW_SIZE - GFLG_HEADER_SIZE);
+    decimCount = 0;
+    memset(decimSum, 0, sizeof(decimSum));
+
+    coreClockHz = SYS_CLK_SystemFrequencyGet() / 2;
+    lastCount = _CP0_GET_COUNT();
+    remainder = 0;
+
+    if (!SYS_CLK_FrequencyChangeCallbackRegister(GFLG_ClockChanged))
+    {
+        TRC_POINT(CLK_REJECT, TRC_CLK_FLASHLOG);
+    }
+}
+
+void GFLG_PushAdc(const S_ADCResults *pAdcRes)
+{
+    const uint16_t *pChan = (const uint16_t *)pAdcRes;
+    uint32_t stampMs = GFLG_StampMs();
+    uint16_t average[GFLG_NB_CHAN];
+    uint8_t i;
+
+    for (i = 0; i < GFLG_NB_CHAN; i++)
+    {
+        decimSum[i] += pChan[i];
+    }
+    decimCount++;
+
+    if (decimCount >= GFLG_DECIMATION)
+    {
+        for (i = 0; i < GFLG_NB_CHAN; i++)
+        {
+            average[i] = (uint16_t)((decimSum[i] + GFLG_DECIMATION / 2) / GFLG_DECIMATION);
+            decimSum[i] = 0;
+        }
+        decimCount = 0;
+        GFLG_AddSample(stampMs, average);
+    }
+}
+
+void GFLG_Flush(void)
+{
+    if (pRowHeader->nbSamples > 0)
+    {
+        GFLG_WriteRow();
+    }
+}
+
+void GFLG_GetStats(S_flashLogStats *pStats)
+{
+    *pStats = stats;
+    pStats->nextRowSeq = nextRowSeq;
+}
+
+// Horodatages compares modulo 2^32 : valable tant que la zone couvre
+// moins de 24 jours
+bool GFLG_Find(uint32_t stampMs, S_flashLogCursor *pCursor)
+{
+    S_flashLogRowHeader header;
+    const uint16_t *pSample;
+    uint32_t lo = GFLG_OldestSeq();
+    uint32_t hi = nextRowSeq;
+    uint32_t mid;
+    uint32_t seq;
+    uint32_t sampleMs;
+    uint16_t i;
+
+    // 1re rangee valide dont la derniere mesure est >= stampMs ; une
+    // rangee invalide prend la place de la suivante valide
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        for (seq = mid; (seq < hi) && !GFLG_RowValid(seq, &header); seq++)
+        {
+        }
+        if (seq >= hi)
+        {
+            hi = mid;
+        }
+        else if ((int32_t)(header.lastMs - stampMs) >= 0)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = seq + 1;
+        }
+    }
+
+    // lo : 1re rangee candidate, sans doute precedee de rangees invalides
+    for (; (lo < nextRowSeq) && !GFLG_RowValid(lo, &header); lo++)
+    {
+    }
+    if (lo >= nextRowSeq)
+    {
+        return false;
+    }
+
+    pSample = (const uint16_t *)(GFLG_RowAddress(lo) + GFLG_HEADER_SIZE);
+    sampleMs = header.firstMs;
+    for (i = 0; i < header.nbSamples; i++)
+    {
+        sampleMs += pSample[0];
+        if ((int32_t)(sampleMs - stampMs) >= 0)
+        {
+            break;
+        }
+        pSample += GFLG_SAMPLE_SIZE / sizeof(uint16_t);
+    }
+    pCursor->rowSeq = lo;
+    pCursor->index = i;
+    pCursor->stampMs = sampleMs;
+    return true;
+}
+
+bool GFLG_Read(S_flashLogCursor *pCursor, S_flashLogSample *pSample)
+{
+    S_flashLogRowHeader header;
+    const uint16_t *pRaw;
+    uint8_t i;
+
+    for (;;)
+    {
+        if (pCursor->rowSeq >= nextRowSeq)
+        {
+            return false;       // fin du journal
+        }
+        if (pCursor->rowSeq < GFLG_OldestSeq())
+        {
+            return false;       // rangee effacee depuis GFLG_Find
+        }
+        if (!GFLG_RowValid(pCursor->rowSeq, &header) || (pCursor->index >= header.nbSamples))
+        {
+            pCursor->rowSeq++;
+            pCursor->index = 0;
+            continue;
+        }
+        break;
+    }
+
+    pRaw = (const uint16_t *)(GFLG_RowAddress(pCursor->rowSeq) + GFLG_HEADER_SIZE)
+           + pCursor->index * (GFLG_SAMPLE_SIZE / sizeof(uint16_t));
+    if (pCursor->index == 0)
+    {
+        pCursor->stampMs = header.firstMs;
+    }
+    pSample->stampMs = pCursor->stampMs;
+    for (i = 0; i < GFLG_NB_CHAN; i++)
+    {
+        pSample->chan[i] = pRaw[1 + i];
+    }
+
+    // Position suivante : horodatage par le delta de l'echantillon
+    pCursor->index++;
+    if (pCursor->index < header.nbSamples)
+    {
+        pCursor->stampMs += pRaw[GFLG_SAMPLE_SIZE / sizeof(uint16_t)];
+    }
+    return true;
+}
+
+bool GFLG_GetRange(uint32_t *pOldestMs, uint32_t *pNewestMs)
+{
+    S_flashLogRowHeader header;
+    uint32_t seq;
+    bool found = false;
+
+    for (seq = GFLG_OldestSeq(); seq < nextRowSeq; seq++)
+    {
+        if (GFLG_RowValid(seq, &header))
+        {
+            *pOldestMs = header.firstMs;
+            found = true;
+            break;
+        }
+    }
+    for (seq = nextRowSeq; found && (seq > GFLG_OldestSeq()); seq--)
+    {
+        if (GFLG_RowValid(seq - 1, &header))
+        {
+            *pNewestMs = header.lastMs;
+            break;
+        }
+    }
+    return found;
+}
+
+// Horloge modifiee : tics ecoules convertis a l'ancienne frequence
+void GFLG_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz)
+{
+    (void)peripheralClockHz;
+    GFLG_StampMs();
+    coreClockHz = systemClockHz / 2;
+}
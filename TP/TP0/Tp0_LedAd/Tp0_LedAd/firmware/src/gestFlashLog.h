@@ -0,0 +1,141 @@
+#ifndef GestFlashLog_H
+#define GestFlashLog_H
+/*--------------------------------------------------------*/
+// GestFlashLog.h
+/*--------------------------------------------------------*/
+//	Description :	Historique des mesures ADC en flash programme,
+//			        journal circulaire conserve sans alimentation
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+//  Fonctionnement :
+//  - GFLG_PushAdc moyenne GFLG_DECIMATION mesures et ajoute le
+//    resultat, horodate en ms, a une rangee en RAM
+//  - rangee pleine (GFLG_SAMPLES_PER_ROW echantillons) : une seule
+//    programmation de rangee NVM (512 octets) dans la zone reservee
+//  - les rangees sont ecrites dans l'ordre, la zone est un anneau :
+//    en entrant dans une page on l'efface (elle contient les plus
+//    anciennes mesures). Chaque page est effacee une fois par tour,
+//    l'usure est repartie uniformement (nombre d'effacements de la
+//    page = rowSeq / GFLG_NB_ROWS).
+//  - rangee n de l'historique (rowSeq) : rangee n % GFLG_NB_ROWS de
+//    la zone. L'en-tete (numero, CRC) indique si elle est valide.
+//  - au demarrage, GFLG_Initialize retrouve la rangee la plus recente
+//    et reprend l'horodatage apres sa derniere mesure ; une rangee
+//    coupee par une perte d'alimentation (CRC faux) est sautee.
+//  - lecture par horodatage : recherche dichotomique sur les en-tetes
+//    des rangees, puis parcours de la rangee trouvee.
+//
+//  Programmation flash : le CPU et les interruptions sont suspendus
+//  pendant l'operation (rangee ~3 ms, page ~20 ms, ~23 ms au plus une
+//  fois par page), appels depuis la boucle principale seulement.
+//  Reste dans le budget du watchdog (APP_WDM_MAX_PERIOD_MS).
+//  Les echantillons encore en RAM sont perdus a la coupure :
+//  GFLG_Flush ecrit la rangee en cours.
+//
+//  Horodatage : ms de fonctionnement cumulees, reprises apres la
+//  derniere mesure enregistree (pas d'horloge temps reel).
+//
+//  Endurance : 1000 cycles effacement / ecriture garantis par page.
+//  A 1 echantillon / 10 s (GFLG_DECIMATION 100), un tour de zone dure
+//  ~58 h, soit ~150 effacements par page et par an (~6.5 ans).
+//  Verification et debit : sim/, make flashlog.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Mc32DriverAdc.h"
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+// Geometrie flash PIC32MX795
+#define GFLG_PAGE_SIZE          4096
+#define GFLG_ROW_SIZE           512
+#define GFLG_ROWS_PER_PAGE      (GFLG_PAGE_SIZE / GFLG_ROW_SIZE)
+
+// Zone reservee en flash programme (alignee sur une page, non
+// programmee par le chargement du .hex)
+#define GFLG_REGION_PAGES       32      // 128 ko
+#define GFLG_REGION_SIZE        (GFLG_REGION_PAGES * GFLG_PAGE_SIZE)
+#define GFLG_NB_ROWS            (GFLG_REGION_PAGES * GFLG_ROWS_PER_PAGE)
+
+// Mesures moyennees par echantillon enregistre (APP : 1 mesure / 100 ms)
+#ifndef GFLG_DECIMATION
+#define GFLG_DECIMATION         100
+#endif
+
+// S_ADCResults est enregistre comme un tableau de u16
+#define GFLG_NB_CHAN            (sizeof(S_ADCResults) / sizeof(uint16_t))
+
+// Rangee : en-tete puis echantillons (delta ms u16 + canaux u16)
+#define GFLG_ROW_MAGIC          0x474C
+#define GFLG_HEADER_SIZE        20
+#define GFLG_SAMPLE_SIZE        (2 + 2 * GFLG_NB_CHAN)
+#define GFLG_SAMPLES_PER_ROW    ((GFLG_ROW_SIZE - GFLG_HEADER_SIZE) / GFLG_SAMPLE_SIZE)
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+// En-tete de rangee, little endian, GFLG_HEADER_SIZE octets
+typedef struct {
+    uint16_t magic;         // GFLG_ROW_MAGIC
+    uint16_t crc;           // CRC16 de nbSamples a la fin des echantillons
+    uint16_t nbSamples;
+    uint16_t reserved;      // 0xFFFF
+    uint32_t rowSeq;        // numero de rangee dans l'historique
+    uint32_t firstMs;       // horodatage du 1er echantillon
+    uint32_t lastMs;        // horodatage du dernier echantillon
+} S_flashLogRowHeader;
+
+typedef struct {
+    uint32_t stampMs;       // ms de fonctionnement cumulees
+    uint16_t chan[GFLG_NB_CHAN];
+} S_flashLogSample;
+
+// Position de lecture (GFLG_Find, GFLG_Read)
+typedef struct {
+    uint32_t rowSeq;
+    uint16_t index;         // echantillon dans la rangee
+    uint32_t stampMs;       // horodatage de cet echantillon
+} S_flashLogCursor;
+
+// Instrumentation (tics du core timer, SYS_CLK_FREQ / 2)
+typedef struct {
+    uint32_t nbSamples;     // echantillons enregistres (apres decimation)
+    uint32_t nbRows;        // rangees programmees
+    uint32_t nbErases;      // pages effacees
+    uint32_t nbSkipped;     // rangees non effacees sautees (coupure)
+    uint32_t nbErrors;      // operations NVM en erreur ou relecture fausse
+    uint32_t nextRowSeq;    // prochaine rangee ecrite
+    uint32_t maxWriteTics;  // rangee (+ effacement eventuel), maximum
+} S_flashLogStats;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+void GFLG_Initialize(void);
+void GFLG_PushAdc(const S_ADCResults *pAdcRes);
+void GFLG_Flush(void);                  // ecrit la rangee en cours
+void GFLG_GetStats(S_flashLogStats *pStats);
+
+// Lecture : 1er echantillon enregistre a stampMs ou apres
+bool GFLG_Find(uint32_t stampMs, S_flashLogCursor *pCursor);
+// Echantillon a la position, puis avance ; false en fin de journal
+// ou si la rangee a ete effacee depuis
+bool GFLG_Read(S_flashLogCursor *pCursor, S_flashLogSample *pSample);
+bool GFLG_GetRange(uint32_t *pOldestMs, uint32_t *pNewestMs);
+
+void GFLG_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz);
+
+
+#endif
@@ -0,0 +1,104 @@
+/*--------------------------------------------------------*/
+// GestSpectrum.c
+/*--------------------------------------------------------*/
+//	Description :	Spectre des mesures ADC par blocs (dspFft.h) :
+//			        raies dominantes de chaque canal et barre LCD
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include <stdio.h>
+#include <string.h>
+#include "gestSpectrum.h"
+
+typedef char GSPC_CheckSize[((GSPC_SIZE >= FFT_MIN_SIZE) && (GSPC_SIZE <= FFT_MAX_SIZE)
+                             && ((GSPC_SIZE & (GSPC_SIZE - 1)) == 0)) ? 1 : -1];
+
+// Bloc en cours, canaux entrelaces comme S_ADCResults
+static uint16_t block[GSPC_SIZE][GSPC_NB_CHAN];
+static uint16_t blockLen;
+static S_fftComplex work[GSPC_SIZE];
+
+static S_fftPeak peaks[GSPC_NB_CHAN][GSPC_NB_PEAKS];
+static uint8_t nbPeaks[GSPC_NB_CHAN];
+
+static S_spectrumStats stats;
+
+void GSPC_Initialize(void)
+{
+    blockLen = 0;
+    memset(nbPeaks, 0, sizeof(nbPeaks));
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool GSPC_PushAdc(const S_ADCResults *pAdcRes)
+{
+    uint32_t start;
+    uint8_t chan;
+
+    memcpy(block[blockLen], pAdcRes, sizeof(block[0]));
+    if (++blockLen < GSPC_SIZE)
+    {
+        return false;
+    }
+    blockLen = 0;
+
+    start = _CP0_GET_COUNT();
+    for (chan = 0; chan < GSPC_NB_CHAN; chan++)
+    {
+        nbPeaks[chan] = FFT_AnalyzeAdc(&block[0][chan], GSPC_NB_CHAN, GSPC_SIZE,
+                                       GSPC_SAMPLE_RATE_MHZ, work, peaks[chan], GSPC_NB_PEAKS);
+    }
+    stats.lastTics = _CP0_GET_COUNT() - start;
+    if (stats.lastTics > stats.maxTics)
+    {
+        stats.maxTics = stats.lastTics;
+    }
+    stats.nbBlocks++;
+    return true;
+}
+
+uint8_t GSPC_GetPeaks(uint8_t chan, S_fftPeak *pPeaks)
+{
+    memcpy(pPeaks, peaks[chan], nbPeaks[chan] * sizeof(S_fftPeak));
+    return nbPeaks[chan];
+}
+
+// "Ch0 1.25Hz ######   " : frequence en Hz (2 decimales), barre
+void GSPC_FormatLine(uint8_t chan, char *pLine)
+{
+    uint16_t amplitude;
+    int len;
+
+    if (nbPeaks[chan] == 0)
+    {
+        len = snprintf(pLine, GSPC_LINE_SIZE + 1, "Ch%u  --.--Hz", (unsigned)chan);
+        amplitude = 0;
+    }
+    else
+    {
+        len = snprintf(pLine, GSPC_LINE_SIZE + 1, "Ch%u %3lu.%02luHz ", (unsigned)chan,
+                       (unsigned long)(peaks[chan][0].freqMilliHz / 1000),
+                       (unsigned long)(peaks[chan][0].freqMilliHz % 1000 / 10));
+        amplitude = peaks[chan][0].amplitude;
+    }
+    for (; (len < GSPC_LINE_SIZE) && (amplitude != 0); len++, amplitude >>= 1)
+    {
+        pLine[len] = '#';
+    }
+    for (; len < GSPC_LINE_SIZE; len++)
+    {
+        pLine[len] = ' ';
+    }
+    pLine[GSPC_LINE_SIZE] = '\0';
+}
+
+void GSPC_GetStats(S_spectrumStats *pStats)
+{
+    *pStats = stats;
+}
@@ -0,0 +1,82 @@
+#ifndef GestSpectrum_H
+#define GestSpectrum_H
+/*--------------------------------------------------------*/
+// GestSpectrum.h
+/*--------------------------------------------------------*/
+//	Description :	Spectre des mesures ADC par blocs (dspFft.h) :
+//			        raies dominantes de chaque canal et barre LCD
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+//  GSPC_PushAdc recoit les mesures a cadence fixe (APP : 1 / 100 ms,
+//  GSPC_SAMPLE_RATE_MHZ). Bloc de GSPC_SIZE mesures plein : FFT de
+//  chaque canal dans la boucle principale, GSPC_NB_PEAKS raies
+//  gardees jusqu'au bloc suivant (blocs sans recouvrement).
+//
+//  Bande analysee : 0 a la moitie de la cadence des mesures. A 10 Hz,
+//  oscillation lente du potentiometre (resolution 10 Hz / GSPC_SIZE) ;
+//  le ronflement secteur (50 Hz) est replie et n'est visible qu'avec
+//  une cadence d'au moins 100 Hz.
+//
+//  GSPC_FormatLine : raie dominante d'un canal pour une ligne LCD,
+//  frequence puis barre d'amplitude, un caractere par 6 dB (doublement)
+//  au-dessus de 1 LSB.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Mc32DriverAdc.h"
+#include "dspFft.h"
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+// Mesures par bloc (puissance de 2, FFT_MIN_SIZE a FFT_MAX_SIZE)
+#ifndef GSPC_SIZE
+#define GSPC_SIZE               64
+#endif
+
+// Cadence des mesures (mHz)
+#ifndef GSPC_SAMPLE_RATE_MHZ
+#define GSPC_SAMPLE_RATE_MHZ    10000
+#endif
+
+#define GSPC_NB_PEAKS           3
+#define GSPC_NB_CHAN            (sizeof(S_ADCResults) / sizeof(uint16_t))
+
+// Ligne LCD
+#define GSPC_LINE_SIZE          20
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+// Instrumentation (tics du core timer, SYS_CLK_FREQ / 2)
+typedef struct {
+    uint32_t nbBlocks;      // blocs analyses
+    uint32_t lastTics;      // analyse de tous les canaux, dernier bloc
+    uint32_t maxTics;
+} S_spectrumStats;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+void GSPC_Initialize(void);
+// true si un bloc vient d'etre analyse
+bool GSPC_PushAdc(const S_ADCResults *pAdcRes);
+// Raies du dernier bloc, plus grande d'abord ; retourne leur nombre
+uint8_t GSPC_GetPeaks(uint8_t chan, S_fftPeak *pPeaks);
+// GSPC_LINE_SIZE caracteres + '\0'
+void GSPC_FormatLine(uint8_t chan, char *pLine);
+void GSPC_GetStats(S_spectrumStats *pStats);
+
+
+#endif
@@ -0,0 +1,251 @@
+/*--------------------------------------------------------*/
+// GestStats.c
+/*--------------------------------------------------------*/
+//	Description :	Statistiques des mesures ADC au fil de l'eau,
+//			        par canal : min / max, moyenne, variance,
+//			        fenetre glissante, moyenne exponentielle,
+//			        histogramme
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include <string.h>
+#include "gestStats.h"
+#include "hotPath.h"
+
+typedef char GSTA_CheckWindow[((GSTA_WINDOW & (GSTA_WINDOW - 1)) == 0)
+                              && (GSTA_WINDOW <= 256) ? 1 : -1];
+typedef char GSTA_CheckBins[((GSTA_HIST_NB_BINS & (GSTA_HIST_NB_BINS - 1)) == 0)
+                            && (GSTA_HIST_NB_BINS <= (1 << GSTA_ADC_BITS)) ? 1 : -1];
+
+#define GSTA_ADC_MAX            ((1 << GSTA_ADC_BITS) - 1)
+#define GSTA_SNAPSHOT_TRIES     4
+
+// Seul l'ordre des acces compte (un coeur) : barriere du compilateur
+#define GSTA_BARRIER()          __asm__ volatile ("" ::: "memory")
+
+typedef struct {
+    // Welford
+    uint32_t count;
+    uint16_t min;
+    uint16_t max;
+    int32_t meanQ16;
+    uint64_t m2Q16;             // somme des carres des ecarts
+
+    // Fenetre glissante
+    uint16_t ring[GSTA_WINDOW];
+    uint32_t winSum;
+    uint32_t winSumSq;
+
+    // Exponentielle
+    int32_t emaMeanQ16;
+    uint32_t emaVarQ10;         // Q10 : pas de blocage a quelques Q8
+
+    uint32_t histogram[GSTA_HIST_NB_BINS];
+} S_statsChan;
+
+static S_statsChan chanStats[GSTA_NB_CHAN];
+static uint16_t winPos;         // prochaine case de l'anneau
+static uint16_t winCount;
+
+// Impair pendant une mise a jour
+static volatile uint32_t updateSeq;
+
+static S_statsStats stats;
+
+void GSTA_Initialize(void)
+{
+    uint8_t chan;
+
+    updateSeq++;
+    GSTA_BARRIER();
+    memset(chanStats, 0, sizeof(chanStats));
+    for (chan = 0; chan < GSTA_NB_CHAN; chan++)
+    {
+        chanStats[chan].min = UINT16_MAX;
+    }
+    winPos = 0;
+    winCount = 0;
+    memset(&stats, 0, sizeof(stats));
+    GSTA_BARRIER();
+    updateSeq++;
+}
+
+static inline void GSTA_Update(S_statsChan *pChan, uint16_t x, bool first)
+{
+    int32_t xQ16 = (int32_t)x << 16;
+    int32_t delta;
+    int64_t prod;
+    uint32_t t;
+    uint16_t old;
+
+    if (x < pChan->min)
+    {
+        pChan->min = x;
+    }
+    if (x > pChan->max)
+    {
+        pChan->max = x;
+    }
+
+    // Welford : une division par mesure, arrondie (une troncature
+    // s'accumule dans la moyenne). Compte sature apres 2^31 mesures
+    // (moyenne figee, 6 ans a 10 Hz).
+    if (pChan->count < INT32_MAX)
+    {
+        pChan->count++;
+    }
+    delta = xQ16 - pChan->meanQ16;
+    pChan->meanQ16 += (delta + ((delta < 0) ? -(int32_t)(pChan->count / 2)
+                                            : (int32_t)(pChan->count / 2))) / (int32_t)pChan->count;
+    prod = (int64_t)delta * (xQ16 - pChan->meanQ16);
+    if (prod > 0)
+    {
+        pChan->m2Q16 += (uint64_t)prod >> 16;
+    }
+
+    // Fenetre : la mesure la plus ancienne sort
+    if (winCount == GSTA_WINDOW)
+    {
+        old = pChan->ring[winPos];
+        pChan->winSum -= old;
+        pChan->winSumSq -= (uint32_t)old * old;
+    }
+    pChan->ring[winPos] = x;
+    pChan->winSum += x;
+    pChan->winSumSq += (uint32_t)x * x;
+
+    // Exponentielle : var = (1 - a) (var + a d^2), d = x - moyenne
+    if (first)
+    {
+        pChan->emaMeanQ16 = xQ16;
+        pChan->emaVarQ10 = 0;
+    }
+    else
+    {
+        delta = xQ16 - pChan->emaMeanQ16;
+        pChan->emaMeanQ16 += delta >> GSTA_EMA_SHIFT;
+        t = pChan->emaVarQ10 + (uint32_t)(((int64_t)delta * delta) >> (22 + GSTA_EMA_SHIFT));
+        pChan->emaVarQ10 = t - ((t + (1 << (GSTA_EMA_SHIFT - 1))) >> GSTA_EMA_SHIFT);
+    }
+
+    pChan->histogram[(x > GSTA_ADC_MAX) ? (GSTA_HIST_NB_BINS - 1)
+                     : ((x * GSTA_HIST_NB_BINS) >> GSTA_ADC_BITS)]++;
+}
+
+HOT_RAMFUNC void GSTA_PushAdc(const S_ADCResults *pAdcRes)
+{
+    const uint16_t *pValues = (const uint16_t *)pAdcRes;
+    uint32_t start = _CP0_GET_COUNT();
+    bool first = (chanStats[0].count == 0);
+    uint8_t chan;
+
+    updateSeq++;
+    GSTA_BARRIER();
+    for (chan = 0; chan < GSTA_NB_CHAN; chan++)
+    {
+        GSTA_Update(&chanStats[chan], pValues[chan], first);
+    }
+    winPos = (winPos + 1) & (GSTA_WINDOW - 1);
+    if (winCount < GSTA_WINDOW)
+    {
+        winCount++;
+    }
+    GSTA_BARRIER();
+    updateSeq++;
+
+    stats.nbPush++;
+    stats.lastTics = _CP0_GET_COUNT() - start;
+    if (stats.lastTics > stats.maxTics)
+    {
+        stats.maxTics = stats.lastTics;
+    }
+    if (stats.lastTics > GSTA_BUDGET_TICS)
+    {
+        stats.nbOverBudget++;
+    }
+}
+
+bool GSTA_GetSnapshot(uint8_t chan, S_statsSnapshot *pSnap)
+{
+    S_statsChan copy;
+    uint32_t seq;
+    uint16_t count, i;
+    uint8_t tries;
+    uint64_t n, var;
+
+    if (chan >= GSTA_NB_CHAN)
+    {
+        return false;
+    }
+
+    // Copie sans mise a jour au milieu. Numero impair : cette lecture
+    // interrompt la mise a jour, qui ne peut pas finir avant elle.
+    for (tries = 0; ; tries++)
+    {
+        seq = updateSeq;
+        GSTA_BARRIER();
+        if (((seq & 1) != 0) || (tries == GSTA_SNAPSHOT_TRIES))
+        {
+            stats.nbBusy++;
+            return false;
+        }
+        copy = chanStats[chan];
+        count = winCount;
+        GSTA_BARRIER();
+        if (updateSeq == seq)
+        {
+            break;
+        }
+        stats.nbRetries++;
+    }
+
+    pSnap->count = copy.count;
+    pSnap->min = copy.min;
+    pSnap->max = copy.max;
+    pSnap->meanQ8 = (uint32_t)((copy.meanQ16 + (1 << 7)) >> 8);
+    pSnap->varianceQ8 = (copy.count < 2) ? 0
+                        : (uint32_t)((copy.m2Q16 / (copy.count - 1) + (1 << 7)) >> 8);
+
+    pSnap->winCount = count;
+    pSnap->winMin = UINT16_MAX;
+    pSnap->winMax = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (copy.ring[i] < pSnap->winMin)
+        {
+            pSnap->winMin = copy.ring[i];
+        }
+        if (copy.ring[i] > pSnap->winMax)
+        {
+            pSnap->winMax = copy.ring[i];
+        }
+    }
+    n = count;
+    pSnap->winMeanQ8 = (count == 0) ? 0 : (uint32_t)(((uint64_t)copy.winSum * 256 + n / 2) / n);
+    if (count < 2)
+    {
+        pSnap->winVarianceQ8 = 0;
+    }
+    else
+    {
+        // (n S2 - S1^2) / (n (n - 1)), exact en entiers
+        var = n * copy.winSumSq - (uint64_t)copy.winSum * copy.winSum;
+        pSnap->winVarianceQ8 = (uint32_t)((var * 256 + n * (n - 1) / 2) / (n * (n - 1)));
+    }
+
+    pSnap->emaMeanQ8 = (uint32_t)((copy.emaMeanQ16 + (1 << 7)) >> 8);
+    pSnap->emaVarianceQ8 = (copy.emaVarQ10 + 2) >> 2;
+    memcpy(pSnap->histogram, copy.histogram, sizeof(pSnap->histogram));
+    return true;
+}
+
+void GSTA_GetStats(S_statsStats *pStats)
+{
+    *pStats = stats;
+}
@@ -0,0 +1,120 @@
+#ifndef GestStats_H
+#define GestStats_H
+/*--------------------------------------------------------*/
+// GestStats.h
+/*--------------------------------------------------------*/
+//	Description :	Statistiques des mesures ADC au fil de l'eau,
+//			        par canal : min / max, moyenne, variance,
+//			        fenetre glissante, moyenne exponentielle,
+//			        histogramme
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+//  GSTA_PushAdc : cout constant par mesure, entiers seulement, pas de
+//  boucle. Appelable depuis une interruption (un seul contexte
+//  ecrivain), placee en RAM (HOT_RAMFUNC). Duree mesuree au core
+//  timer a chaque appel, comparee a GSTA_BUDGET_TICS.
+//
+//  - depuis le debut : min, max, moyenne et variance par Welford
+//    (moyenne Q16, somme des carres des ecarts Q16 sur 64 bits)
+//  - fenetre glissante des GSTA_WINDOW dernieres mesures : anneau,
+//    somme et somme des carres exactes (entiers, pas d'erreur
+//    accumulee). Min / max de la fenetre calcules a la lecture.
+//  - moyenne et variance exponentielles, poids 2^-GSTA_EMA_SHIFT
+//  - histogramme de GSTA_HIST_NB_BINS classes egales sur la plage ADC
+//
+//  GSTA_GetSnapshot : copie coherente d'un canal depuis un autre
+//  contexte (boucle principale ou interruption). Numero de sequence
+//  impair pendant la mise a jour : la lecture recommence si une mise
+//  a jour l'a interrompue. Une lecture qui interrompt elle-meme la
+//  mise a jour retourne false (donnees inchangees), sans attendre.
+//
+//  Resultats en Q8 (1/256 LSB, LSB^2 pour les variances).
+//  Precision et temps sur PC : sim/, make stats.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Mc32DriverAdc.h"
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+// Fenetre glissante (mesures, puissance de 2)
+#ifndef GSTA_WINDOW
+#define GSTA_WINDOW             64
+#endif
+
+// Moyenne exponentielle : poids de la nouvelle mesure 2^-GSTA_EMA_SHIFT
+#ifndef GSTA_EMA_SHIFT
+#define GSTA_EMA_SHIFT          4
+#endif
+
+// Histogramme (puissance de 2) sur 0..2^GSTA_ADC_BITS - 1
+#ifndef GSTA_HIST_NB_BINS
+#define GSTA_HIST_NB_BINS       16
+#endif
+#define GSTA_ADC_BITS           10
+
+// Budget de GSTA_PushAdc, tous canaux (tics du core timer, SYS_CLK_FREQ / 2)
+#ifndef GSTA_BUDGET_TICS
+#define GSTA_BUDGET_TICS        250
+#endif
+
+#define GSTA_NB_CHAN            (sizeof(S_ADCResults) / sizeof(uint16_t))
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+typedef struct {
+    // Depuis GSTA_Initialize
+    uint32_t count;
+    uint16_t min;
+    uint16_t max;
+    uint32_t meanQ8;
+    uint32_t varianceQ8;        // variance de l'echantillon (n - 1)
+
+    // Fenetre glissante
+    uint16_t winCount;          // mesures dans la fenetre (<= GSTA_WINDOW)
+    uint16_t winMin;
+    uint16_t winMax;
+    uint32_t winMeanQ8;
+    uint32_t winVarianceQ8;
+
+    // Exponentielle
+    uint32_t emaMeanQ8;
+    uint32_t emaVarianceQ8;
+
+    uint32_t histogram[GSTA_HIST_NB_BINS];
+} S_statsSnapshot;
+
+// Instrumentation (tics du core timer)
+typedef struct {
+    uint32_t nbPush;
+    uint32_t lastTics;
+    uint32_t maxTics;
+    uint32_t nbOverBudget;      // appels au-dela de GSTA_BUDGET_TICS
+    uint32_t nbRetries;         // lectures recommencees
+    uint32_t nbBusy;            // lectures refusees (mise a jour interrompue)
+} S_statsStats;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+void GSTA_Initialize(void);
+void GSTA_PushAdc(const S_ADCResults *pAdcRes);
+// false : canal invalide ou lecture depuis une interruption de la mise a jour
+bool GSTA_GetSnapshot(uint8_t chan, S_statsSnapshot *pSnap);
+void GSTA_GetStats(S_statsStats *pStats);
+
+
+#endif
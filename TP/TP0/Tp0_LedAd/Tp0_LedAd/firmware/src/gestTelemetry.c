@@ -0,0 +1,213 @@
+/*--------------------------------------------------------*/
+// GestTelemetry.c
+/*--------------------------------------------------------*/
+//	Description :	Telemetrie des mesures ADC sur UART par DMA
+//			        trames COBS + CRC16 (telemetryFrame.h)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include <sys/kmem.h>
+#include "gestTelemetry.h"
+#include "hotPath.h"
+#include "eventTrace.h"
+#include "system_config.h"
+#include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
+#include "peripheral/usart/plib_usart.h"
+#include "peripheral/dma/plib_dma.h"
+#include "peripheral/int/plib_int.h"
+
+#define GTLM_NO_BUFFER          (-1)
+
+// Les canaux de S_ADCResults sont lus comme des u16
+typedef char GTLM_CheckAdcLayout[(sizeof(S_ADCResults) % sizeof(uint16_t) == 0) ? 1 : -1];
+
+// Trame en construction (boucle principale)
+static S_tfrmBuilder frame;
+static uint8_t frameRaw[GTLM_RAW_SIZE];
+static uint16_t frameSeq = 0;
+
+// Buffers d'emission : l'un envoye par le DMA, l'autre en attente
+static uint8_t txBuf[2][GTLM_TX_SIZE];
+static uint16_t txLen[2];
+static volatile int8_t txActive = GTLM_NO_BUFFER;
+static volatile int8_t txPending = GTLM_NO_BUFFER;
+
+// Horodatage en us depuis le core timer, qui suit l'horloge systeme
+static uint32_t coreClockHz = SYS_CLK_FREQ / 2;
+static uint32_t lastCount;
+static uint64_t remainder = 0;     // tics x 1e6 pas encore convertis
+static uint32_t nowUs = 0;
+
+static S_telemetryStats stats;
+
+static uint32_t GTLM_StampUs(void)
+{
+    uint32_t count = _CP0_GET_COUNT();
+
+    remainder += (uint64_t)(count - lastCount) * 1000000u;
+    lastCount = count;
+    nowUs += (uint32_t)(remainder / coreClockHz);
+    remainder %= coreClockHz;
+
+    return nowUs;
+}
+
+// Programmation du bloc DMA : adresse et taille du buffer
+static HOT_RAMFUNC void GTLM_DmaStart(int8_t buffer)
+{
+    txActive = buffer;
+    PLIB_DMA_ChannelXSourceStartAddressSet(DMA_ID_0, GTLM_DMA_CHANNEL,
+                                           KVA_TO_PA(txBuf[buffer]));
+    PLIB_DMA_ChannelXSourceSizeSet(DMA_ID_0, GTLM_DMA_CHANNEL, txLen[buffer]);
+    PLIB_DMA_ChannelXEnable(DMA_ID_0, GTLM_DMA_CHANNEL);
+    // 1er octet force : la FIFO TX vide ne genere pas de nouvel evenement
+    PLIB_DMA_StartTransferSet(DMA_ID_0, GTLM_DMA_CHANNEL);
+}
+
+void GTLM_Initialize(void)
+{
+    txActive = GTLM_NO_BUFFER;
+    txPending = GTLM_NO_BUFFER;
+    coreClockHz = SYS_CLK_SystemFrequencyGet() / 2;
+    lastCount = _CP0_GET_COUNT();
+    frame.nbSamples = 0;    // trame commencee au 1er echantillon
+
+    // UART 8N1, emission seule ; l'interruption TX ne sert qu'au DMA
+    PLIB_USART_BaudRateSet(GTLM_USART_ID, SYS_CLK_PeripheralFrequencyGet(CLK_BUS_PERIPHERAL_1),
+                           GTLM_BAUDRATE);
+    PLIB_USART_LineControlModeSelect(GTLM_USART_ID, USART_8N1);
+    PLIB_USART_TransmitterInterruptModeSelect(GTLM_USART_ID, USART_TRANSMIT_FIFO_NOT_FULL);
+    PLIB_USART_TransmitterEnable(GTLM_USART_ID);
+    PLIB_USART_Enable(GTLM_USART_ID);
+
+    // DMA : 1 octet par evenement TX vers UxTXREG, fin de bloc en IT
+    PLIB_DMA_Enable(DMA_ID_0);
+    PLIB_DMA_ChannelXPrioritySelect(DMA_ID_0, GTLM_DMA_CHANNEL, DMA_CHANNEL_PRIORITY_0);
+    PLIB_DMA_ChannelXStartIRQSet(DMA_ID_0, GTLM_DMA_CHANNEL, GTLM_DMA_TRIGGER);
+    PLIB_DMA_ChannelXTriggerEnable(DMA_ID_0, GTLM_DMA_CHANNEL, DMA_CHANNEL_TRIGGER_TRANSFER_START);
+    PLIB_DMA_ChannelXDestinationStartAddressSet(DMA_ID_0, GTLM_DMA_CHANNEL,
+        KVA_TO_PA(PLIB_USART_TransmitterAddressGet(GTLM_USART_ID)));
+    PLIB_DMA_ChannelXDestinationSizeSet(DMA_ID_0, GTLM_DMA_CHANNEL, 1);
+    PLIB_DMA_ChannelXCellSizeSet(DMA_ID_0, GTLM_DMA_CHANNEL, 1);
+    PLIB_DMA_ChannelXINTSourceFlagClear(DMA_ID_0, GTLM_DMA_CHANNEL, DMA_INT_BLOCK_TRANSFER_COMPLETE);
+    PLIB_DMA_ChannelXINTSourceEnable(DMA_ID_0, GTLM_DMA_CHANNEL, DMA_INT_BLOCK_TRANSFER_COMPLETE);
+
+    PLIB_INT_VectorPrioritySet(INT_ID_0, GTLM_DMA_INT_VECTOR, INT_PRIORITY_LEVEL2);
+    PLIB_INT_VectorSubPrioritySet(INT_ID_0, GTLM_DMA_INT_VECTOR, INT_SUBPRIORITY_LEVEL0);
+    PLIB_INT_SourceFlagClear(INT_ID_0, GTLM_DMA_INT_SOURCE);
+    PLIB_INT_SourceEnable(INT_ID_0, GTLM_DMA_INT_SOURCE);
+
+    if (!SYS_CLK_FrequencyChangeCallbackRegister(GTLM_ClockChanged))
+    {
+        TRC_POINT(CLK_REJECT, TRC_CLK_TELEMETRY);
+    }
+}
+
+void GTLM_PushAdc(const S_ADCResults *pAdcRes)
+{
+    uint32_t stampUs = GTLM_StampUs();
+
+    if (frame.nbSamples == 0)
+    {
+        TFRM_Begin(&frame, frameRaw, frameSeq, GTLM_NB_CHAN, stampUs);
+    }
+    TFRM_AddSample(&frame, stampUs, (const uint16_t *)pAdcRes);
+    stats.nbSamples++;
+
+    if (frame.nbSamples >= GTLM_SAMPLES_PER_FRAME)
+    {
+        GTLM_Flush();
+    }
+}
+
+void GTLM_Flush(void)
+{
+    uint32_t start = _CP0_GET_COUNT();
+    uint32_t tics;
+    int8_t buffer;
+
+    if (frame.nbSamples == 0)
+    {
+        return;
+    }
+
+    // Buffer libre : ni envoye, ni en attente. Sans ISR DMA entre la
+    // lecture et la mise a jour de txActive / txPending.
+    PLIB_INT_SourceDisable(INT_ID_0, GTLM_DMA_INT_SOURCE);
+    if (txPending != GTLM_NO_BUFFER)
+    {
+        stats.nbDropped++;
+        buffer = GTLM_NO_BUFFER;
+    }
+    else
+    {
+        buffer = (txActive == 0) ? 1 : 0;
+    }
+    PLIB_INT_SourceEnable(INT_ID_0, GTLM_DMA_INT_SOURCE);
+
+    if (buffer != GTLM_NO_BUFFER)
+    {
+        txLen[buffer] = TFRM_Finish(&frame, txBuf[buffer]);
+        stats.nbFrames++;
+        stats.nbBytes += txLen[buffer];
+
+        PLIB_INT_SourceDisable(INT_ID_0, GTLM_DMA_INT_SOURCE);
+        if (txActive == GTLM_NO_BUFFER)
+        {
+            GTLM_DmaStart(buffer);
+        }
+        else
+        {
+            txPending = buffer;
+        }
+        PLIB_INT_SourceEnable(INT_ID_0, GTLM_DMA_INT_SOURCE);
+    }
+
+    // Numero incremente meme si la trame est perdue : trou visible au PC
+    frameSeq++;
+    frame.nbSamples = 0;
+
+    tics = _CP0_GET_COUNT() - start;
+    if (tics > stats.maxFrameTics)
+    {
+        stats.maxFrameTics = tics;
+    }
+}
+
+void GTLM_GetStats(S_telemetryStats *pStats)
+{
+    *pStats = stats;
+}
+
+// Fin de bloc DMA : trame envoyee, enchaine le buffer en attente
+HOT_RAMFUNC void GTLM_DmaCallback(void)
+{
+    PLIB_DMA_ChannelXINTSourceFlagClear(DMA_ID_0, GTLM_DMA_CHANNEL, DMA_INT_BLOCK_TRANSFER_COMPLETE);
+
+    if (txPending != GTLM_NO_BUFFER)
+    {
+        GTLM_DmaStart(txPending);
+        txPending = GTLM_NO_BUFFER;
+    }
+    else
+    {
+        txActive = GTLM_NO_BUFFER;
+    }
+}
+
+// Horloge modifiee : tics ecoules convertis a l'ancienne frequence,
+// nouveau diviseur de l'UART. Une trame en cours d'envoi peut etre
+// corrompue (rejetee par le CRC au PC).
+void GTLM_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz)
+{
+    GTLM_StampUs();
+    coreClockHz = systemClockHz / 2;
+    PLIB_USART_BaudRateSet(GTLM_USART_ID, peripheralClockHz, GTLM_BAUDRATE);
+}
@@ -0,0 +1,82 @@
+#ifndef GestTelemetry_H
+#define GestTelemetry_H
+/*--------------------------------------------------------*/
+// GestTelemetry.h
+/*--------------------------------------------------------*/
+//	Description :	Telemetrie des mesures ADC sur UART par DMA
+//			        trames COBS + CRC16 (telemetryFrame.h)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+//  Fonctionnement :
+//  - GTLM_PushAdc ajoute un echantillon horodate (us) a la trame en
+//    cours ; a GTLM_SAMPLES_PER_FRAME echantillons la trame est
+//    terminee (CRC, COBS) dans un des 2 buffers d'emission
+//  - l'emission est faite par le canal DMA GTLM_DMA_CHANNEL,
+//    declenche par l'interruption TX de l'UART : par trame, le CPU ne
+//    programme que l'adresse et la taille du bloc
+//  - l'ISR DMA (fin de bloc) lance le buffer en attente s'il y en a ;
+//    si les 2 buffers sont occupes la trame est perdue et comptee
+//  Debit : 10 bits par octet sur la ligne, voir sim/ (make bench).
+//
+//  Decodage sur PC : sim/tlmDecode.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Mc32DriverAdc.h"
+#include "telemetryFrame.h"
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+#define GTLM_BAUDRATE           115200
+#define GTLM_SAMPLES_PER_FRAME  8
+
+// UART et DMA utilises (a verifier avec le schema du kit)
+#define GTLM_USART_ID           USART_ID_1
+#define GTLM_DMA_CHANNEL        DMA_CHANNEL_0
+#define GTLM_DMA_TRIGGER        DMA_TRIGGER_USART_1_TRANSMIT
+#define GTLM_DMA_INT_SOURCE     INT_SOURCE_DMA_0
+#define GTLM_DMA_INT_VECTOR     INT_VECTOR_DMA0
+
+// S_ADCResults est transmis comme un tableau de u16
+#define GTLM_NB_CHAN            (sizeof(S_ADCResults) / sizeof(uint16_t))
+
+#define GTLM_RAW_SIZE           TFRM_RAW_SIZE(GTLM_SAMPLES_PER_FRAME, GTLM_NB_CHAN)
+#define GTLM_TX_SIZE            TFRM_ENCODED_SIZE(GTLM_RAW_SIZE)
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+// Instrumentation (tics du core timer, SYS_CLK_FREQ / 2)
+typedef struct {
+    uint32_t nbSamples;     // echantillons recus
+    uint32_t nbFrames;      // trames confiees au DMA
+    uint32_t nbDropped;     // trames perdues, 2 buffers occupes
+    uint32_t nbBytes;       // octets confies au DMA
+    uint32_t maxFrameTics;  // fin de trame (CRC, COBS, DMA), maximum
+} S_telemetryStats;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+void GTLM_Initialize(void);
+void GTLM_PushAdc(const S_ADCResults *pAdcRes);
+void GTLM_Flush(void);                  // envoie la trame en cours
+void GTLM_GetStats(S_telemetryStats *pStats);
+
+void GTLM_DmaCallback(void);            // appelee par l'ISR DMA
+void GTLM_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz);
+
+
+#endif
@@ -54,6 +54,9 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "system_config.h"
 #include "peripheral/adc/plib_adc.h"
 
+/* Requested conversion clock, the prescaler is derived from the PB clock */
+#define DRV_ADC_CONVERSION_CLOCK    320000000
+
 typedef enum {
 
     DRV_ADC_ID_1 = ADC_ID_1,
@@ -169,6 +172,8 @@ typedef enum {
 // *****************************************************************************
 void DRV_ADC_Initialize(void);
 
+void DRV_ADC_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz);
+
 inline void DRV_ADC_DeInitialize(void);
 
 inline void DRV_ADC_Open(void);
@@ -55,7 +55,7 @@ void DRV_ADC_Initialize(void)
     /* Select Clock Source */
     PLIB_ADC_ConversionClockSourceSelect(DRV_ADC_ID_1, ADC_CLOCK_SOURCE_PERIPHERAL_BUS_CLOCK);
     /* Select Clock Prescaler */
-    PLIB_ADC_ConversionClockSet(DRV_ADC_ID_1, SYS_CLK_BUS_PERIPHERAL_1, 320000000);
+    PLIB_ADC_ConversionClockSet(DRV_ADC_ID_1, SYS_CLK_BUS_PERIPHERAL_1, DRV_ADC_CONVERSION_CLOCK);
 
     /* Select Power Mode */
     PLIB_ADC_StopInIdleDisable(DRV_ADC_ID_1);
@@ -94,6 +94,19 @@ void DRV_ADC_Initialize(void)
  
 }
 
+void DRV_ADC_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz)
+{
+    bool wasOn = (AD1CON1bits.ON != 0);
+
+    /* ADCS must not change while the module is on */
+    PLIB_ADC_Disable(DRV_ADC_ID_1);
+    PLIB_ADC_ConversionClockSet(DRV_ADC_ID_1, peripheralClockHz, DRV_ADC_CONVERSION_CLOCK);
+    if (wasOn)
+    {
+        PLIB_ADC_Enable(DRV_ADC_ID_1);
+    }
+}
+
 inline void DRV_ADC_DeInitialize(void)
 {
     /* Disable ADC */
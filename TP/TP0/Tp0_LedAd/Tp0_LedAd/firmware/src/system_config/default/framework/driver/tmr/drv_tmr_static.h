@@ -71,6 +71,9 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVOCES, OR ANY CLAIMS BY THIRD PARTIES
 // minimum divider value for 16 bit operation mode
 #define     DRV_TIMER_DIVIDER_MIN_16BIT     0x2
 
+// Instance 0 period at SYS_CLK_BUS_PERIPHERAL_1 (prescale 256 -> 100 ms)
+#define     DRV_TMR0_PERIOD                 31250
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -111,6 +114,7 @@ void DRV_TMR0_CounterClear(void);
 TMR_PRESCALE DRV_TMR0_PrescalerGet(void);
 void DRV_TMR0_PeriodValueSet(uint32_t value);
 uint32_t DRV_TMR0_PeriodValueGet(void);
+void DRV_TMR0_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz);
 void DRV_TMR0_StopInIdleDisable(void);
 void DRV_TMR0_StopInIdleEnable(void);
 static inline void DRV_TMR0_Tasks(void) {}
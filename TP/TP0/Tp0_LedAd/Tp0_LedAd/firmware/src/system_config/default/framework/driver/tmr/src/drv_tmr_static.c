@@ -157,7 +157,7 @@ void DRV_TMR0_Initialize(void)
     /* Clear counter */ 
     PLIB_TMR_Counter16BitClear(TMR_ID_1);
     /*Set period */ 
-    PLIB_TMR_Period16BitSet(TMR_ID_1, 31250);
+    PLIB_TMR_Period16BitSet(TMR_ID_1, DRV_TMR0_PERIOD);
     /* Setup Interrupt */   
     PLIB_INT_VectorPrioritySet(INT_ID_0, INT_VECTOR_T1, INT_PRIORITY_LEVEL3);
     PLIB_INT_VectorSubPrioritySet(INT_ID_0, INT_VECTOR_T1, INT_SUBPRIORITY_LEVEL0);          
@@ -277,6 +277,13 @@ void DRV_TMR0_PeriodValueSet(uint32_t value)
     PLIB_TMR_Period16BitSet(TMR_ID_1, (uint16_t)value);
 }
 
+void DRV_TMR0_ClockChanged(uint32_t systemClockHz, uint32_t peripheralClockHz)
+{
+    /* Keep the same period in time : scale the value set for the boot clock */
+    DRV_TMR0_PeriodValueSet((uint32_t)(((uint64_t)DRV_TMR0_PERIOD * peripheralClockHz)
+                                       / SYS_CLK_BUS_PERIPHERAL_1));
+}
+
 uint32_t DRV_TMR0_PeriodValueGet(void)
 {
     /* Get 16-bit counter value*/
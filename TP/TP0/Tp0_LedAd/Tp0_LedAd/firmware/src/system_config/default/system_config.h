@@ -89,41 +89,56 @@ extern "C" {
 #define SYS_CLK_CONFIG_SECONDARY_XTAL       0ul
    
 /*** Ports System Service Configuration ***/
-#define SYS_PORT_AD1PCFG        ~0x38c3
 #define SYS_PORT_CNPUE          0x0
 #define SYS_PORT_CNEN           0x0
-#define SYS_PORT_A_TRIS         0x7F0C
-#define SYS_PORT_A_LAT          0x80C0
-#define SYS_PORT_A_ODC          0x0000
-
-#define SYS_PORT_B_TRIS         0xFAFF
-#define SYS_PORT_B_LAT          0x0400
-#define SYS_PORT_B_ODC          0x0000
-
-#define SYS_PORT_C_TRIS         0xFFF9
-#define SYS_PORT_C_LAT          0x0000
-#define SYS_PORT_C_ODC          0x0000
-
-#define SYS_PORT_D_TRIS         0x4DC7
-#define SYS_PORT_D_LAT          0x8238
-#define SYS_PORT_D_ODC          0x0000
-
-#define SYS_PORT_E_TRIS         0xFFF0
-#define SYS_PORT_E_LAT          0x0000
-#define SYS_PORT_E_ODC          0x0000
-
-#define SYS_PORT_F_TRIS         0xDFFF
-#define SYS_PORT_F_LAT          0x2000
-#define SYS_PORT_F_ODC          0x0000
-
-#define SYS_PORT_G_TRIS         0xFFFC
-#define SYS_PORT_G_LAT          0x0002
-#define SYS_PORT_G_ODC          0x0000
 
+/* Board pins : PIN(name, port, bit, mode, initial latch, arg)
+   mode : OUT, OD (open drain output), IN or AN (analog input).
+   Pins not listed stay digital inputs. SYS_PORTS_Initialize and the
+   SYS_PIN_<name>_* pin map are generated from this table, see
+   system/ports/sys_ports_pins.h. LEDs are active low. */
+#define SYS_PORTS_PIN_TABLE(PIN, arg) \
+    PIN(LED0,   A,  0, OUT, 0, arg) \
+    PIN(LED1,   A,  1, OUT, 0, arg) \
+    PIN(LED2,   A,  4, OUT, 0, arg) \
+    PIN(LED3,   A,  5, OUT, 0, arg) \
+    PIN(LED4,   A,  6, OUT, 1, arg) \
+    PIN(LED5,   A,  7, OUT, 1, arg) \
+    PIN(LED6,   A, 15, OUT, 1, arg) \
+    PIN(LED7,   B, 10, OUT, 1, arg) \
+    PIN(AN0,    B,  0, AN,  0, arg) \
+    PIN(AN1,    B,  1, AN,  0, arg) \
+    PIN(AN6,    B,  6, AN,  0, arg) \
+    PIN(AN7,    B,  7, AN,  0, arg) \
+    PIN(RB8,    B,  8, OUT, 0, arg) \
+    PIN(AN11,   B, 11, AN,  0, arg) \
+    PIN(AN12,   B, 12, AN,  0, arg) \
+    PIN(AN13,   B, 13, AN,  0, arg) \
+    PIN(RC1,    C,  1, OUT, 0, arg) \
+    PIN(RC2,    C,  2, OUT, 0, arg) \
+    PIN(RD3,    D,  3, OUT, 1, arg) \
+    PIN(RD4,    D,  4, OUT, 1, arg) \
+    PIN(RD5,    D,  5, OUT, 1, arg) \
+    PIN(RD9,    D,  9, OUT, 1, arg) \
+    PIN(RD12,   D, 12, OUT, 0, arg) \
+    PIN(RD13,   D, 13, OUT, 0, arg) \
+    PIN(RD15,   D, 15, OUT, 1, arg) \
+    PIN(RE0,    E,  0, OUT, 0, arg) \
+    PIN(RE1,    E,  1, OUT, 0, arg) \
+    PIN(RE2,    E,  2, OUT, 0, arg) \
+    PIN(RE3,    E,  3, OUT, 0, arg) \
+    PIN(RF13,   F, 13, OUT, 1, arg) \
+    PIN(RG0,    G,  0, OUT, 0, arg) \
+    PIN(RG1,    G,  1, OUT, 1, arg)
 
 /*** Interrupt System Service Configuration ***/
 #define SYS_INT                     true
 
+/*** Exception Handler Configuration (system/excep/sys_excep.h) ***/
+/* Event trace kept for the dump after the reset */
+#define SYS_EXCEP_CRASH_HOOK_INCLUDE    "eventTrace.h"
+#define SYS_EXCEP_CRASH_HOOK()          TRC_FREEZE(TRC_FREEZE_EXCEPTION)
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Driver Configuration
@@ -132,6 +147,10 @@ extern "C" {
 /*** Timer Driver Configuration ***/
 #define DRV_TMR_INTERRUPT_MODE             true
 
+/* Static instances, for driver/tmr/drv_tmr_dispatch.h */
+#define DRV_TMR_STATIC_INSTANCE_TABLE(INST) \
+    INST(0)
+
 /*** Timer Driver 0 Configuration ***/
 #define DRV_TMR_PERIPHERAL_ID_IDX0          TMR_ID_1
 #define DRV_TMR_INTERRUPT_SOURCE_IDX0       INT_SOURCE_TIMER_1
@@ -51,7 +51,10 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "system/common/sys_module.h"
 #include "system/devcon/sys_devcon.h"
 #include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
 #include "system/int/sys_int.h"
+#include "system/excep/sys_excep.h"
+#include "system_watchdog.h"
 #include "driver/adc/drv_adc_static.h"
 #include "driver/tmr/drv_tmr_static.h"
 #include "peripheral/int/plib_int.h"
@@ -95,6 +98,59 @@ typedef struct
 
 } SYSTEM_OBJECTS;
 
+// *****************************************************************************
+/* Boot stages
+
+  Summary:
+    Steps of the boot timestamped by SYS_BOOT_StageMark.
+
+  Description:
+    The stages up to SYS_BOOT_STAGE_APP are marked by SYS_Initialize, the
+    last ones by the application once the control path runs and once the
+    deferred LCD initialization is done.
+*/
+
+typedef enum
+{
+    SYS_BOOT_STAGE_ENTRY = 0,       /* Entry in SYS_Initialize */
+    SYS_BOOT_STAGE_CLK,
+    SYS_BOOT_STAGE_DEVCON,
+    SYS_BOOT_STAGE_BSP,
+    SYS_BOOT_STAGE_ADC,
+    SYS_BOOT_STAGE_TMR,
+    SYS_BOOT_STAGE_PORTS,
+    SYS_BOOT_STAGE_INT,
+    SYS_BOOT_STAGE_APP,             /* End of SYS_Initialize */
+    SYS_BOOT_STAGE_CONTROL,         /* Control path live (timer, ADC) */
+    SYS_BOOT_STAGE_LCD,             /* LCD ready */
+    SYS_BOOT_STAGE_NB
+
+} SYS_BOOT_STAGE;
+
+/* Core timer ticks (SYSCLK / 2) per microsecond */
+#define SYS_BOOT_TICKS_PER_US       (SYS_CLK_FREQ / 2000000ul)
+
+// *****************************************************************************
+/* Boot report
+
+  Summary:
+    Time of each boot stage.
+
+  Description:
+    entryTicks is the core timer at entry in SYS_Initialize, that is the time
+    spent in the startup code since reset. stageTicks[n] is the time from
+    entry to the end of stage n. Bit n of validMask is set once stage n has
+    been reached, stageTicks[n] is 0 otherwise.
+*/
+
+typedef struct
+{
+    uint32_t entryTicks;
+    uint32_t validMask;
+    uint32_t stageTicks[SYS_BOOT_STAGE_NB];
+
+} SYS_BOOT_REPORT;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: extern declarations
@@ -103,6 +159,15 @@ typedef struct
 
 extern SYSTEM_OBJECTS sysObj;
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Boot Profiler
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_BOOT_StageMark ( SYS_BOOT_STAGE stage );
+void SYS_BOOT_ReportGet ( SYS_BOOT_REPORT *pReport );
+
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
 }
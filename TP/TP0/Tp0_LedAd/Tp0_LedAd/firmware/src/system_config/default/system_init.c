@@ -46,8 +46,10 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 // *****************************************************************************
 
+#include <xc.h>
 #include "system_config.h"
 #include "system_definitions.h"
+#include "eventTrace.h"
 
 
 // ****************************************************************************
@@ -74,7 +76,7 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #pragma config OSCIOFNC =   OFF
 #pragma config FPBDIV =     DIV_1
 #pragma config FCKSM =      CSECMD
-#pragma config WDTPS =      PS1048576
+#pragma config WDTPS =      PS1024
 #pragma config FWDTEN =     OFF
 /*** DEVCFG2 ***/
 
@@ -109,6 +111,12 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 /* Structure to hold the object handles for the modules in the system. */
 SYSTEM_OBJECTS sysObj;
 
+/* Core timer value at the end of each boot stage. */
+static uint32_t sysBootTicks[SYS_BOOT_STAGE_NB];
+
+/* Bit n set once stage n is marked, a timestamp may be 0. */
+static uint32_t sysBootValid;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Module Initialization Data
@@ -140,29 +148,56 @@ SYSTEM_OBJECTS sysObj;
 
 void SYS_Initialize ( void* data )
 {
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_ENTRY);
+
+    /* Crash and watchdog records left by the previous run, before anything else */
+    SYS_WDM_ResetRecordCheck();
+    TRC_ResetCheck();
+    SYS_EXCEP_CrashRecordCheck();
+
     /* Core Processor Initialization */
     SYS_CLK_Initialize( NULL );
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_CLK);
+
+    /* Event trace, kept for this run if frozen by the previous one */
+    TRC_Initialize();
     SYS_DEVCON_Initialize(SYS_DEVCON_INDEX_0, (SYS_MODULE_INIT*)NULL);
     SYS_DEVCON_PerformanceConfig(SYS_CLK_SystemFrequencyGet());
     SYS_DEVCON_JTAGDisable();
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_DEVCON);
 
     /* Board Support Package Initialization */
     BSP_Initialize();        
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_BSP);
 
     /* Initialize Drivers */
 
     /* Initialize ADC */
     DRV_ADC_Initialize();
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_ADC);
 
     /*Initialize TMR0 */
     DRV_TMR0_Initialize();
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_TMR);
+
+    /* Drivers re-derive their settings when the clock is scaled */
+    if (!SYS_CLK_FrequencyChangeCallbackRegister(DRV_ADC_ClockChanged))
+    {
+        TRC_POINT(CLK_REJECT, TRC_CLK_ADC);
+    }
+    if (!SYS_CLK_FrequencyChangeCallbackRegister(DRV_TMR0_ClockChanged))
+    {
+        TRC_POINT(CLK_REJECT, TRC_CLK_TMR0);
+    }
  
  
     /* Initialize System Services */
     SYS_PORTS_Initialize();
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_PORTS);
 
     /*** Interrupt Service Initialization Code ***/
     SYS_INT_Initialize();
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_INT);
 
     /* Initialize Middleware */
 
@@ -171,6 +206,57 @@ void SYS_Initialize ( void* data )
 
     /* Initialize the Application */
     APP_Initialize();
+    SYS_BOOT_StageMark(SYS_BOOT_STAGE_APP);
+
+    /* Main loop deadline monitor, starts the watchdog (about 1 s) */
+    SYS_WDM_Initialize();
+}
+
+/*******************************************************************************
+  Function:
+    void SYS_BOOT_StageMark ( SYS_BOOT_STAGE stage )
+
+  Summary:
+    Timestamps the end of a boot stage with the core timer.
+
+  Remarks:
+    Only the first mark of a stage is kept.
+ */
+
+void SYS_BOOT_StageMark ( SYS_BOOT_STAGE stage )
+{
+    if ((stage < SYS_BOOT_STAGE_NB) && ((sysBootValid & (1ul << stage)) == 0))
+    {
+        sysBootTicks[stage] = _CP0_GET_COUNT();
+        sysBootValid |= (1ul << stage);
+    }
+}
+
+/*******************************************************************************
+  Function:
+    void SYS_BOOT_ReportGet ( SYS_BOOT_REPORT *pReport )
+
+  Summary:
+    Gets the boot report, times relative to the entry in SYS_Initialize.
+ */
+
+void SYS_BOOT_ReportGet ( SYS_BOOT_REPORT *pReport )
+{
+    uint8_t i;
+
+    pReport->entryTicks = sysBootTicks[SYS_BOOT_STAGE_ENTRY];
+    pReport->validMask = sysBootValid;
+    for (i = 0; i < SYS_BOOT_STAGE_NB; i++)
+    {
+        if ((sysBootValid & (1ul << i)) != 0)
+        {
+            pReport->stageTicks[i] = sysBootTicks[i] - sysBootTicks[SYS_BOOT_STAGE_ENTRY];
+        }
+        else
+        {
+            pReport->stageTicks[i] = 0;
+        }
+    }
 }
 
 
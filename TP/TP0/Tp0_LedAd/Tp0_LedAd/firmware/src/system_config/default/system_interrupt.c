@@ -62,6 +62,10 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "system/common/sys_common.h"
 #include "app.h"
 #include "system_definitions.h"
+#include "hotPath.h"
+#include "gestTelemetry.h"
+#include "gestDds.h"
+#include "eventTrace.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -71,11 +75,52 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 
  
 
+/* Mesure de l'ISR pour le choix des fonctions placees en RAM (hotPath.h) */
+S_hotProfile hotProfTmr1;
+
 void __ISR(_TIMER_1_VECTOR, ipl3AUTO) IntHandlerDrvTmrInstance0(void)
 {
+    HOT_PROFILE_BEGIN();
+    TRC_BEGIN(TMR1_ISR, 0);
     PLIB_INT_SourceFlagClear(INT_ID_0,INT_SOURCE_TIMER_1);
     App_Timer1Callback();
+    SYS_WDM_Check();    /* records the late task even if the main loop is stuck */
+    TRC_END(TMR1_ISR, 0);
+    HOT_PROFILE_END(hotProfTmr1);
+}
+
+S_hotProfile hotProfDma0;
+
+/* End of a telemetry frame sent by DMA to the UART */
+void __ISR(_DMA_0_VECTOR, ipl2AUTO) IntHandlerTelemetryDma(void)
+{
+    HOT_PROFILE_BEGIN();
+    TRC_BEGIN(DMA0_ISR, 0);
+    GTLM_DmaCallback();
+    PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_DMA_0);
+    TRC_END(DMA0_ISR, 0);
+    HOT_PROFILE_END(hotProfDma0);
+}
+
+#if (GDDS_ENABLE == 1)
+S_hotProfile hotProfDma1;
+
+/* Half of the DDS sample buffer read by DMA, refilled (GDDS_MODE_DMA) */
+void __ISR(_DMA_1_VECTOR, ipl4AUTO) IntHandlerDdsDma(void)
+{
+    HOT_PROFILE_BEGIN();
+    GDDS_DmaCallback();
+    PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_DMA_1);
+    HOT_PROFILE_END(hotProfDma1);
+}
+
+/* One DDS sample per Timer2 period (GDDS_MODE_ISR) */
+void __ISR(_TIMER_2_VECTOR, ipl5AUTO) IntHandlerDdsTimer(void)
+{
+    PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_TIMER_2);
+    GDDS_TimerCallback();
 }
+#endif
  /*******************************************************************************
  End of File
 */
@@ -0,0 +1,275 @@
+/*******************************************************************************
+  MPLAB Harmony Watchdog Monitor Source File
+
+  File Name:
+    system_watchdog.c
+
+  Summary:
+    Main loop deadline monitor backed by the watchdog timer.
+
+  Description:
+    The watchdog is enabled by software (FWDTEN = OFF) with the WDTPS
+    postscaler of the configuration bits, and cleared only while every
+    registered task checks in within its declared period.
+ *******************************************************************************/
+
+#include <xc.h>
+#include "system_config.h"
+#include "system_definitions.h"
+#include "system_watchdog.h"
+#include "eventTrace.h"
+#include "peripheral/wdt/plib_wdt.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Core timer ticks per millisecond */
+#define SYS_WDM_TICKS_PER_MS            (SYS_CLK_FREQ / 2000ul)
+
+/* Monitored tasks, task 0 is the main loop */
+static volatile uint32_t wdmLastCheckIn[SYS_WDM_TASKS_MAX];
+static uint32_t wdmMaxTicks[SYS_WDM_TASKS_MAX];
+static volatile uint8_t wdmNbTasks = 0;
+
+/* Latched once a task has been late : the watchdog is no longer cleared */
+static volatile bool wdmFailed = false;
+
+/* Time of the last full check and load measurement window */
+static uint32_t wdmLastCheck;
+static uint32_t wdmWindowStart;
+static uint32_t wdmWindowBusy;
+static uint32_t wdmWindowPasses;
+static SYS_WDM_STATS wdmStats;
+
+/* Reset record, not cleared by the startup code so it survives a reset */
+static SYS_WDM_RECORD __attribute__((persistent)) wdmRecord;
+
+/* Copy of the record validated at boot */
+static SYS_WDM_RECORD wdmLastRecord;
+static bool wdmLastRecordValid = false;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Watchdog Monitor Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void SYS_WDM_ResetRecordCheck ( void )
+
+  Remarks:
+    Must run before SYS_EXCEP_CrashRecordCheck, which clears the power on
+    flags.
+ */
+
+void SYS_WDM_ResetRecordCheck ( void )
+{
+    /* After a power on or brown out the persistent RAM holds garbage */
+    if ((RCON & (_RCON_POR_MASK | _RCON_BOR_MASK)) != 0)
+    {
+        wdmRecord.magic = 0;
+        wdmRecord.nbResets = 0;
+    }
+    else if (((RCON & _RCON_WDTO_MASK) != 0) && (wdmRecord.magic == SYS_WDM_MAGIC))
+    {
+        wdmLastRecord = wdmRecord;
+        wdmLastRecordValid = true;
+    }
+
+    wdmRecord.magic = 0;
+    RCONCLR = _RCON_WDTO_MASK;
+}
+
+/*******************************************************************************
+  Function:
+    void SYS_WDM_Initialize ( void )
+ */
+
+void SYS_WDM_Initialize ( void )
+{
+    uint32_t now = _CP0_GET_COUNT();
+
+    /* Task 0 : the main loop, checked in by SYS_WDM_Service */
+    SYS_WDM_TaskRegister(SYS_WDM_LOOP_MAX_MS);
+
+    wdmLastCheck = now;
+    wdmWindowStart = now;
+
+    PLIB_WDT_TimerClear(WDT_ID_0);
+    PLIB_WDT_Enable(WDT_ID_0);
+}
+
+/*******************************************************************************
+  Function:
+    SYS_WDM_TASK_ID SYS_WDM_TaskRegister ( uint32_t maxPeriodMs )
+
+  Remarks:
+    Must be called from the main loop. The first deadline runs from the
+    registration.
+ */
+
+SYS_WDM_TASK_ID SYS_WDM_TaskRegister ( uint32_t maxPeriodMs )
+{
+    SYS_WDM_TASK_ID taskId = wdmNbTasks;
+
+    if (taskId >= SYS_WDM_TASKS_MAX)
+    {
+        return SYS_WDM_TASK_INVALID;
+    }
+    wdmMaxTicks[taskId] = maxPeriodMs * SYS_WDM_TICKS_PER_MS;
+    wdmLastCheckIn[taskId] = _CP0_GET_COUNT();
+
+    /* Visible to SYS_WDM_Check once initialized */
+    wdmNbTasks = taskId + 1;
+
+    return taskId;
+}
+
+/*******************************************************************************
+  Function:
+    void SYS_WDM_CheckIn ( SYS_WDM_TASK_ID taskId )
+ */
+
+void SYS_WDM_CheckIn ( SYS_WDM_TASK_ID taskId )
+{
+    if (taskId < wdmNbTasks)
+    {
+        wdmLastCheckIn[taskId] = _CP0_GET_COUNT();
+    }
+}
+
+/*******************************************************************************
+  Function:
+    bool SYS_WDM_Check ( void )
+
+  Summary:
+    Verifies every deadline, records the first late task.
+
+  Remarks:
+    Called from the main loop and from the Timer1 ISR. The failure is
+    latched with interrupts disabled so a late task is recorded, and
+    nbResets incremented, only once.
+ */
+
+bool SYS_WDM_Check ( void )
+{
+    uint32_t now = _CP0_GET_COUNT();
+    uint32_t elapsed;
+    SYS_INT_PROCESSOR_STATUS intStatus;
+    uint8_t i;
+
+    for (i = 0; (i < wdmNbTasks) && (wdmFailed == false); i++)
+    {
+        elapsed = now - wdmLastCheckIn[i];
+        if (elapsed > wdmMaxTicks[i])
+        {
+            intStatus = SYS_INT_StatusGetAndDisable();
+            if (wdmFailed == false)
+            {
+                wdmFailed = true;
+
+                wdmRecord.taskId = i;
+                wdmRecord.maxPeriodMs = wdmMaxTicks[i] / SYS_WDM_TICKS_PER_MS;
+                wdmRecord.lateMs = elapsed / SYS_WDM_TICKS_PER_MS;
+                wdmRecord.nbResets++;
+                wdmRecord.magic = SYS_WDM_MAGIC;
+
+                /* Events leading to the stall, kept across the reset */
+                TRC_FREEZE(TRC_FREEZE_WATCHDOG);
+            }
+            SYS_INT_StatusRestore(intStatus);
+        }
+    }
+
+    return (wdmFailed == false);
+}
+
+/*******************************************************************************
+  Function:
+    void SYS_WDM_Service ( void )
+
+  Summary:
+    Checks in the main loop and clears the watchdog if all tasks are on time.
+
+  Remarks:
+    Every pass is timed, the ones returning after the period test as well
+    as the full checks, so loadPer10k is the cost of the monitor in the
+    main loop. Only the call and return, a few cycles, are not counted.
+ */
+
+void SYS_WDM_Service ( void )
+{
+    uint32_t start = _CP0_GET_COUNT();
+    uint32_t duration;
+    uint32_t window;
+
+    wdmWindowPasses++;
+    if ((start - wdmLastCheck) < (SYS_WDM_CHECK_PERIOD_MS * SYS_WDM_TICKS_PER_MS))
+    {
+        wdmWindowBusy += _CP0_GET_COUNT() - start;
+        return;
+    }
+    wdmLastCheck = start;
+
+    wdmLastCheckIn[0] = start;
+    if (SYS_WDM_Check())
+    {
+        PLIB_WDT_TimerClear(WDT_ID_0);
+    }
+
+    /* Cost of the check and load over the window */
+    duration = _CP0_GET_COUNT() - start;
+    wdmStats.nbChecks++;
+    wdmStats.lastCheckTicks = duration;
+    if (duration > wdmStats.maxCheckTicks)
+    {
+        wdmStats.maxCheckTicks = duration;
+    }
+    wdmWindowBusy += duration;
+
+    window = start - wdmWindowStart;
+    if (window >= (SYS_WDM_LOAD_WINDOW_MS * SYS_WDM_TICKS_PER_MS))
+    {
+        wdmStats.loadPer10k = (uint32_t)(((uint64_t)wdmWindowBusy * 10000) / window);
+        wdmStats.nbPasses = wdmWindowPasses;
+        wdmStats.passTicksAvg = wdmWindowBusy / wdmWindowPasses;
+        wdmWindowStart = start;
+        wdmWindowBusy = 0;
+        wdmWindowPasses = 0;
+    }
+}
+
+/*******************************************************************************
+  Function:
+    bool SYS_WDM_ResetRecordGet ( SYS_WDM_RECORD *pRecord )
+
+  Summary:
+    Gets the record of the task that caused the last watchdog reset.
+ */
+
+bool SYS_WDM_ResetRecordGet ( SYS_WDM_RECORD *pRecord )
+{
+    if (wdmLastRecordValid)
+    {
+        *pRecord = wdmLastRecord;
+    }
+    return wdmLastRecordValid;
+}
+
+/*******************************************************************************
+  Function:
+    void SYS_WDM_StatsGet ( SYS_WDM_STATS *pStats )
+ */
+
+void SYS_WDM_StatsGet ( SYS_WDM_STATS *pStats )
+{
+    *pStats = wdmStats;
+}
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,143 @@
+/*******************************************************************************
+  MPLAB Harmony Watchdog Monitor Header File
+
+  File Name:
+    system_watchdog.h
+
+  Summary:
+    Main loop deadline monitor backed by the watchdog timer.
+
+  Description:
+    Each monitored task is registered with a maximum period between two
+    check-ins. SYS_WDM_Service, called on every SYS_Tasks pass, verifies all
+    deadlines and clears the watchdog only when every task is on time. The
+    first task found late is written to a persistent RAM record, the watchdog
+    is then left to expire and reset the device. The record is reported on
+    the next boot through SYS_WDM_ResetRecordGet.
+
+    The main loop itself is task 0, checked in by SYS_WDM_Service. As a
+    stalled loop no longer calls SYS_WDM_Service, SYS_WDM_Check is also
+    called from a periodic ISR so the offender is still recorded.
+
+  Remarks:
+    Deadlines are measured with the core timer (SYSCLK / 2) converted at
+    SYS_CLK_FREQ. When the clock is scaled down they become longer.
+ *******************************************************************************/
+
+#ifndef _SYSTEM_WATCHDOG_H
+#define _SYSTEM_WATCHDOG_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Maximum number of monitored tasks, main loop included */
+#define SYS_WDM_TASKS_MAX               4
+
+/* Task 0 : maximum time between two SYS_Tasks passes */
+#define SYS_WDM_LOOP_MAX_MS             500
+
+/* Deadlines are verified at most once per period, the calls in between
+   cost a single core timer read */
+#define SYS_WDM_CHECK_PERIOD_MS         10
+
+/* Window over which the monitor load is computed */
+#define SYS_WDM_LOAD_WINDOW_MS          1000
+
+/* Returned when no more task can be registered */
+#define SYS_WDM_TASK_INVALID            0xFF
+
+/* Marks a record written by the monitor ("WDTO") */
+#define SYS_WDM_MAGIC                   0x5744544Ful
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef uint8_t SYS_WDM_TASK_ID;
+
+// *****************************************************************************
+/* Watchdog reset record
+
+  Summary:
+    Task that missed its deadline before the last watchdog reset.
+*/
+
+typedef struct
+{
+    uint32_t magic;                         /* SYS_WDM_MAGIC when valid */
+    uint32_t taskId;                        /* 0 = main loop */
+    uint32_t maxPeriodMs;                   /* Declared deadline */
+    uint32_t lateMs;                        /* Time since the last check-in */
+    uint32_t nbResets;                      /* Watchdog resets since power on */
+
+} SYS_WDM_RECORD;
+
+// *****************************************************************************
+/* Monitor statistics
+
+  Summary:
+    Cost of the monitor, in core timer ticks.
+
+  Description:
+    loadPer10k is the time spent in SYS_WDM_Service over the last
+    SYS_WDM_LOAD_WINDOW_MS, every main loop pass included, in 0.01 % of
+    the elapsed time (100 = 1 %). nbPasses and passTicksAvg are the main
+    loop passes in that window and their average cost.
+*/
+
+typedef struct
+{
+    uint32_t nbChecks;                      /* Full deadline checks */
+    uint32_t lastCheckTicks;
+    uint32_t maxCheckTicks;
+    uint32_t loadPer10k;
+    uint32_t nbPasses;                      /* SYS_WDM_Service calls, last window */
+    uint32_t passTicksAvg;
+
+} SYS_WDM_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Called first in SYS_Initialize, keeps the record after a watchdog reset */
+void SYS_WDM_ResetRecordCheck ( void );
+
+/* Registers the main loop and starts the watchdog, end of SYS_Initialize */
+void SYS_WDM_Initialize ( void );
+
+/* Returns SYS_WDM_TASK_INVALID if SYS_WDM_TASKS_MAX tasks are registered */
+SYS_WDM_TASK_ID SYS_WDM_TaskRegister ( uint32_t maxPeriodMs );
+
+void SYS_WDM_CheckIn ( SYS_WDM_TASK_ID taskId );
+
+/* Called on every SYS_Tasks pass */
+void SYS_WDM_Service ( void );
+
+/* Returns false once a task has been late, also called from an ISR */
+bool SYS_WDM_Check ( void );
+
+bool SYS_WDM_ResetRecordGet ( SYS_WDM_RECORD *pRecord );
+
+void SYS_WDM_StatsGet ( SYS_WDM_STATS *pStats );
+
+#endif /* _SYSTEM_WATCHDOG_H */
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,207 @@
+/*--------------------------------------------------------*/
+// TelemetryFrame.c
+/*--------------------------------------------------------*/
+//	Description :	Trames binaires de telemetrie : echantillons ADC
+//			        horodates, CRC16 et encodage COBS
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+/*--------------------------------------------------------*/
+
+#include "telemetryFrame.h"
+
+static void TFRM_PutU16(uint8_t *pDst, uint16_t value)
+{
+    pDst[0] = (uint8_t)value;
+    pDst[1] = (uint8_t)(value >> 8);
+}
+
+static uint16_t TFRM_GetU16(const uint8_t *pSrc)
+{
+    return (uint16_t)(pSrc[0] | (pSrc[1] << 8));
+}
+
+uint16_t TFRM_Crc16(const uint8_t *pData, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;
+    uint8_t i;
+
+    while (len--)
+    {
+        crc ^= (uint16_t)(*pData++) << 8;
+        for (i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint16_t TFRM_CobsEncode(const uint8_t *pSrc, uint16_t len, uint8_t *pDst)
+{
+    uint8_t *pCode = pDst;      // octet de code du bloc en cours
+    uint8_t *pOut = pDst + 1;
+    uint8_t code = 1;
+
+    while (len--)
+    {
+        if (*pSrc == 0)
+        {
+            *pCode = code;
+            pCode = pOut++;
+            code = 1;
+        }
+        else
+        {
+            *pOut++ = *pSrc;
+            code++;
+            if (code == 0xFF)
+            {
+                *pCode = code;
+                pCode = pOut++;
+                code = 1;
+            }
+        }
+        pSrc++;
+    }
+    *pCode = code;
+    *pOut++ = 0x00;             // separateur
+
+    return (uint16_t)(pOut - pDst);
+}
+
+uint16_t TFRM_CobsDecode(const uint8_t *pSrc, uint16_t len, uint8_t *pDst)
+{
+    const uint8_t *pEnd = pSrc + len;
+    uint8_t *pOut = pDst;
+    uint8_t code, i;
+
+    while (pSrc < pEnd)
+    {
+        code = *pSrc++;
+        if ((code == 0) || ((pSrc + code - 1) > pEnd))
+        {
+            return 0;
+        }
+        for (i = 1; i < code; i++)
+        {
+            *pOut++ = *pSrc++;
+        }
+        // Un bloc court est suivi d'un zero, sauf en fin de trame
+        if ((code < 0xFF) && (pSrc < pEnd))
+        {
+            *pOut++ = 0x00;
+        }
+    }
+    return (uint16_t)(pOut - pDst);
+}
+
+void TFRM_Begin(S_tfrmBuilder *pFrame, uint8_t *pRaw, uint16_t seq,
+                uint8_t nbChan, uint32_t stampUs)
+{
+    pRaw[0] = TFRM_TYPE_ADC;
+    pRaw[1] = nbChan;
+    TFRM_PutU16(&pRaw[2], seq);
+    TFRM_PutU16(&pRaw[4], (uint16_t)stampUs);
+    TFRM_PutU16(&pRaw[6], (uint16_t)(stampUs >> 16));
+
+    pFrame->pRaw = pRaw;
+    pFrame->len = TFRM_HEADER_SIZE;
+    pFrame->nbChan = nbChan;
+    pFrame->nbSamples = 0;
+    pFrame->lastUs = stampUs;
+}
+
+void TFRM_AddSample(S_tfrmBuilder *pFrame, uint32_t stampUs,
+                    const uint16_t *pChan)
+{
+    uint8_t *pOut = &pFrame->pRaw[pFrame->len];
+    uint32_t delta = stampUs - pFrame->lastUs;
+    uint8_t i;
+
+    while (delta >= 0x80)
+    {
+        *pOut++ = (uint8_t)(delta | 0x80);
+        delta >>= 7;
+    }
+    *pOut++ = (uint8_t)delta;
+
+    for (i = 0; i < pFrame->nbChan; i++)
+    {
+        TFRM_PutU16(pOut, pChan[i]);
+        pOut += 2;
+    }
+
+    pFrame->len = (uint16_t)(pOut - pFrame->pRaw);
+    pFrame->nbSamples++;
+    pFrame->lastUs = stampUs;
+}
+
+uint16_t TFRM_Finish(S_tfrmBuilder *pFrame, uint8_t *pDst)
+{
+    TFRM_PutU16(&pFrame->pRaw[pFrame->len], TFRM_Crc16(pFrame->pRaw, pFrame->len));
+    pFrame->len += TFRM_CRC_SIZE;
+
+    return TFRM_CobsEncode(pFrame->pRaw, pFrame->len, pDst);
+}
+
+bool TFRM_Open(S_tfrmReader *pReader, S_tfrmHeader *pHeader,
+               const uint8_t *pRaw, uint16_t len)
+{
+    if ((len < TFRM_HEADER_SIZE + TFRM_CRC_SIZE) ||
+        (TFRM_Crc16(pRaw, len - TFRM_CRC_SIZE) != TFRM_GetU16(&pRaw[len - TFRM_CRC_SIZE])))
+    {
+        return false;
+    }
+
+    pHeader->type = pRaw[0];
+    pHeader->nbChan = pRaw[1];
+    pHeader->seq = TFRM_GetU16(&pRaw[2]);
+    pHeader->stampUs = TFRM_GetU16(&pRaw[4]) | ((uint32_t)TFRM_GetU16(&pRaw[6]) << 16);
+    if ((pHeader->type != TFRM_TYPE_ADC) || (pHeader->nbChan > TFRM_MAX_CHAN))
+    {
+        return false;
+    }
+
+    pReader->pData = pRaw;
+    pReader->len = len - TFRM_CRC_SIZE;
+    pReader->pos = TFRM_HEADER_SIZE;
+    pReader->nbChan = pHeader->nbChan;
+    pReader->stampUs = pHeader->stampUs;
+    return true;
+}
+
+bool TFRM_Next(S_tfrmReader *pReader, uint32_t *pStampUs, uint16_t *pChan)
+{
+    uint32_t delta = 0;
+    uint8_t shift = 0;
+    uint8_t byte, i;
+
+    do
+    {
+        if ((pReader->pos >= pReader->len) || (shift > 28))
+        {
+            return false;
+        }
+        byte = pReader->pData[pReader->pos++];
+        delta |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    if (pReader->pos + 2 * pReader->nbChan > pReader->len)
+    {
+        return false;
+    }
+    for (i = 0; i < pReader->nbChan; i++)
+    {
+        pChan[i] = TFRM_GetU16(&pReader->pData[pReader->pos]);
+        pReader->pos += 2;
+    }
+
+    pReader->stampUs += delta;
+    *pStampUs = pReader->stampUs;
+    return true;
+}
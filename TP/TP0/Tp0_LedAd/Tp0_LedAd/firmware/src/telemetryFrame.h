@@ -0,0 +1,114 @@
+#ifndef TelemetryFrame_H
+#define TelemetryFrame_H
+/*--------------------------------------------------------*/
+// TelemetryFrame.h
+/*--------------------------------------------------------*/
+//	Description :	Trames binaires de telemetrie : echantillons ADC
+//			        horodates, CRC16 et encodage COBS
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06, gcc (outils PC)
+//
+//  Sans dependance materielle : compile aussi dans les outils PC
+//  (sim/tlmDecode.c, sim/simTelemetry.c).
+//
+//  Trame avant encodage (little endian) :
+//    type        u8      TFRM_TYPE_ADC
+//    nbChan      u8      canaux par echantillon
+//    seq         u16     numero de trame (trames perdues)
+//    stampUs     u32     instant du 1er echantillon [us]
+//    n x { deltaUs varint, nbChan x u16 }
+//                        deltaUs : ecart au precedent (0 pour le 1er),
+//                        LEB128 (7 bits par octet, bit 7 = suite)
+//    crc         u16     CRC16-CCITT (0x1021, init 0xFFFF) de ce qui precede
+//
+//  Sur la ligne : COBS(trame) puis 0x00. Le seul 0x00 du flux est le
+//  separateur, un recepteur se resynchronise a la trame suivante.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+#define TFRM_TYPE_ADC           0xAD
+#define TFRM_HEADER_SIZE        8
+#define TFRM_CRC_SIZE           2
+#define TFRM_VARINT_MAX         5       // u32 en LEB128
+#define TFRM_MAX_CHAN           16
+
+// Taille max. d'une trame avant / apres encodage
+#define TFRM_RAW_SIZE(nbSamples, nbChan) \
+    (TFRM_HEADER_SIZE + (nbSamples) * (TFRM_VARINT_MAX + 2 * (nbChan)) + TFRM_CRC_SIZE)
+
+// COBS : 1 octet de code par bloc de 254 au plus, + separateur
+#define TFRM_ENCODED_SIZE(rawSize) \
+    ((rawSize) + ((rawSize) / 254) + 1 + 1)
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+// Trame en construction (buffer fourni par l'appelant)
+typedef struct {
+    uint8_t *pRaw;
+    uint16_t len;
+    uint8_t nbChan;
+    uint8_t nbSamples;
+    uint32_t lastUs;
+} S_tfrmBuilder;
+
+typedef struct {
+    uint8_t type;
+    uint8_t nbChan;
+    uint16_t seq;
+    uint32_t stampUs;
+} S_tfrmHeader;
+
+// Lecture des echantillons d'une trame verifiee
+typedef struct {
+    const uint8_t *pData;
+    uint16_t len;
+    uint16_t pos;
+    uint8_t nbChan;
+    uint32_t stampUs;
+} S_tfrmReader;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+uint16_t TFRM_Crc16(const uint8_t *pData, uint16_t len);
+
+// Encode len octets vers pDst, separateur 0x00 compris. Retourne la
+// taille ecrite (au plus TFRM_ENCODED_SIZE(len)).
+uint16_t TFRM_CobsEncode(const uint8_t *pSrc, uint16_t len, uint8_t *pDst);
+
+// Decode une trame recue sans son separateur. Retourne la taille
+// decodee, 0 si l'encodage est invalide.
+uint16_t TFRM_CobsDecode(const uint8_t *pSrc, uint16_t len, uint8_t *pDst);
+
+// Construction : Begin, AddSample (pRaw dimensionne avec TFRM_RAW_SIZE
+// pour le nombre d'echantillons), puis Finish qui ajoute le CRC et
+// encode vers pDst (taille retournee).
+void TFRM_Begin(S_tfrmBuilder *pFrame, uint8_t *pRaw, uint16_t seq,
+                uint8_t nbChan, uint32_t stampUs);
+void TFRM_AddSample(S_tfrmBuilder *pFrame, uint32_t stampUs,
+                    const uint16_t *pChan);
+uint16_t TFRM_Finish(S_tfrmBuilder *pFrame, uint8_t *pDst);
+
+// Lecture : Open verifie CRC et entete d'une trame decodee, Next
+// retourne les echantillons un par un (false a la fin).
+bool TFRM_Open(S_tfrmReader *pReader, S_tfrmHeader *pHeader,
+               const uint8_t *pRaw, uint16_t len);
+bool TFRM_Next(S_tfrmReader *pReader, uint32_t *pStampUs, uint16_t *pChan);
+
+
+#endif
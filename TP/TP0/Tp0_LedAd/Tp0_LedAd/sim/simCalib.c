@@ -0,0 +1,353 @@
+/*--------------------------------------------------------*/
+// simCalib.c
+/*--------------------------------------------------------*/
+//	Description :	Tests de gestCalib.c sur PC avec un modele de
+//			        carte (offset, gain, non-linearite, bruit) et
+//			        la NVM simulee, et temps par mesure.
+//
+//	Utilisation :	simCalib [-s graine]
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+//  - non calibre : table identite exacte
+//  - capture par GCAL_ApplyAdc (mesures bruitees), 1 point (offset),
+//    2 points (offset et gain), 6 points (linearisation) : erreur max
+//    sur la plage contre le code ideal de chaque tension. Le point a
+//    3.25 V sature Chan0 (gain +2.5 %) : il doit etre ecarte.
+//  - table monotone ; relue identique apres un reset (flash) ;
+//    CRC faux ou page effacee : identite, non calibre
+//  - sequences NVM correctes (cles, interruptions, pas de
+//    reprogrammation) ; capture refusee si occupee ou pleine
+//  - temps PC par mesure ; sur la cible, GCAL_Bench
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include <time.h>
+#include "simNvm.h"
+#include "gestCalib.h"
+
+#define SIM_BENCH_NB        4096
+#define SIM_NOISE_LSB       1
+
+static int nbFail = 0;
+
+static void SIM_Check(const char *name, int ok, const char *fmt, double value)
+{
+    printf("  %-44s ", name);
+    printf(fmt, value);
+    printf("  %s\n", ok ? "ok" : "ECHEC");
+    if (!ok)
+    {
+        nbFail++;
+    }
+}
+
+static uint64_t SIM_HostNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/*--------------------------------------------------------*/
+// Modele de carte
+/*--------------------------------------------------------*/
+
+static double SIM_Ideal(double milliVolt)
+{
+    return milliVolt * 1024.0 / GCAL_VREF_MV;
+}
+
+// Chan0 : +7 LSB, +2.5 %, bosse de 3 LSB au milieu ;
+// Chan1 : -5 LSB, -1.8 %, ondulation de 2 LSB
+static double SIM_Board(uint8_t chan, double milliVolt)
+{
+    double u = milliVolt / GCAL_VREF_MV;
+
+    if (chan == 0)
+    {
+        return SIM_Ideal(milliVolt) * 1.025 + 7.0 + 12.0 * u * (1.0 - u);
+    }
+    return SIM_Ideal(milliVolt) * 0.982 - 5.0 - 2.0 * sin(2.0 * M_PI * u);
+}
+
+static uint16_t SIM_Raw(double code)
+{
+    long raw = lround(code);
+
+    return (uint16_t)((raw < 0) ? 0 : ((raw > GCAL_ADC_MAX) ? GCAL_ADC_MAX : raw));
+}
+
+// Erreur max (LSB) de la mesure corrigee sur la plage non saturee
+static double SIM_MaxError(uint8_t chan)
+{
+    double mv, code, err, maxErr = 0.0;
+
+    for (mv = 0.0; mv <= GCAL_VREF_MV; mv += 0.5)
+    {
+        code = SIM_Board(chan, mv);
+        if ((code < 0.5) || (code > GCAL_ADC_MAX - 0.5) || (SIM_Ideal(mv) > GCAL_ADC_MAX))
+        {
+            continue;
+        }
+        // Quantification de l'ADC comprise (0.5 LSB)
+        err = fabs(GCAL_Correct(chan, SIM_Raw(code)) - SIM_Ideal(mv));
+        if (err > maxErr)
+        {
+            maxErr = err;
+        }
+    }
+    return maxErr;
+}
+
+// Procedure de capture : tension sur le canal, mesures bruitees
+// passees par le chemin d'acquisition jusqu'a la fin du point
+static void SIM_CapturePoint(uint8_t chan, uint16_t milliVolt)
+{
+    S_ADCResults adc;
+    uint16_t *pValues = (uint16_t *)&adc;
+    uint8_t c;
+
+    if (!GCAL_CapturePoint(chan, milliVolt))
+    {
+        printf("  capture refusee (canal %u, %u mV)\n", chan, milliVolt);
+        nbFail++;
+        return;
+    }
+    // Bruit de SIM_NOISE_LSB : saturation possible au bord (ecartee)
+    while (GCAL_CaptureBusy())
+    {
+        for (c = 0; c < GCAL_NB_CHAN; c++)
+        {
+            pValues[c] = SIM_Raw(SIM_Board(c, (c == chan) ? milliVolt : 1000.0)
+                                 + (rand() % (2 * SIM_NOISE_LSB + 1)) - SIM_NOISE_LSB);
+        }
+        GCAL_ApplyAdc(&adc);
+    }
+}
+
+/*--------------------------------------------------------*/
+// Tests
+/*--------------------------------------------------------*/
+
+static bool SIM_IsIdentity(void)
+{
+    uint16_t raw;
+    uint8_t chan;
+
+    for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+    {
+        for (raw = 0; raw <= GCAL_ADC_MAX; raw++)
+        {
+            if (GCAL_Correct(chan, raw) != raw)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Plus grande descente entre deux codes voisins (0 si monotone)
+static int32_t SIM_MaxDrop(uint8_t chan)
+{
+    int32_t drop, maxDrop = 0;
+    uint16_t raw;
+
+    for (raw = 1; raw <= GCAL_ADC_MAX; raw++)
+    {
+        drop = (int32_t)GCAL_Correct(chan, raw - 1) - GCAL_Correct(chan, raw);
+        if (drop > maxDrop)
+        {
+            maxDrop = drop;
+        }
+    }
+    return maxDrop;
+}
+
+static void SIM_Calibrate(const char *name, const uint16_t *pMilliVolt, uint8_t nb,
+                          double maxErr0, double maxErr1)
+{
+    char label[48];
+    double err;
+    int32_t drop;
+    uint8_t chan, i, nbValid;
+    bool ok;
+
+    printf("%s (%u point%s)\n", name, nb, (nb > 1) ? "s" : "");
+    GCAL_CaptureStart();
+    for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+    {
+        for (i = 0; i < nb; i++)
+        {
+            SIM_CapturePoint(chan, pMilliVolt[i]);
+        }
+    }
+    for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+    {
+        for (i = 0, nbValid = 0; i < nb; i++)
+        {
+            nbValid += (SIM_Board(chan, pMilliVolt[i]) + SIM_NOISE_LSB < GCAL_ADC_MAX - 0.5)
+                       && (SIM_Board(chan, pMilliVolt[i]) - SIM_NOISE_LSB > 0.5);
+        }
+        snprintf(label, sizeof(label), "Chan%u : points gardes (non satures)", chan);
+        SIM_Check(label, GCAL_CaptureNbPoints(chan) == nbValid, "%8.0f", GCAL_CaptureNbPoints(chan));
+    }
+    ok = GCAL_CaptureCommit();
+    SIM_Check("ecriture en flash", ok && GCAL_IsCalibrated(), "%8.0f", ok);
+    for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+    {
+        err = SIM_MaxError(chan);
+        snprintf(label, sizeof(label), "Chan%u : erreur max (LSB)", chan);
+        SIM_Check(label, err <= ((chan == 0) ? maxErr0 : maxErr1), "%8.2f", err);
+        drop = SIM_MaxDrop(chan);
+        snprintf(label, sizeof(label), "Chan%u : table monotone (descente max. LSB)", chan);
+        SIM_Check(label, drop == 0, "%8.0f", drop);
+    }
+}
+
+static void SIM_TestPersistence(void)
+{
+    static uint16_t before[GCAL_NB_CHAN][GCAL_ADC_MAX + 1];
+    S_calibRecord rec;
+    uint32_t erases;
+    uint16_t raw, nbDiff = 0;
+    uint8_t chan;
+
+    printf("Flash\n");
+    for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+    {
+        for (raw = 0; raw <= GCAL_ADC_MAX; raw++)
+        {
+            before[chan][raw] = GCAL_Correct(chan, raw);
+        }
+    }
+    GCAL_Initialize();      // reset
+    for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+    {
+        for (raw = 0; raw <= GCAL_ADC_MAX; raw++)
+        {
+            nbDiff += (GCAL_Correct(chan, raw) != before[chan][raw]);
+        }
+    }
+    GCAL_GetRecord(&rec);
+    SIM_Check("apres reset : calibre, corrections differentes", GCAL_IsCalibrated() && (nbDiff == 0)
+              && (rec.nbPoints[0] == 6) && (rec.nbPoints[1] == 7), "%8.0f", nbDiff);
+
+    // Octet de la table modifie : CRC faux
+    simNvmCalib[offsetof(S_calibRecord, lut) + 3] ^= 0x10;
+    GCAL_Initialize();
+    SIM_Check("CRC faux : identite, non calibre", !GCAL_IsCalibrated() && SIM_IsIdentity(),
+              "%8.0f", GCAL_IsCalibrated());
+
+    erases = SIM_NvmEraseCount(SIM_NVM_CALIB_PAGE);
+    SIM_Check("effacement : identite, non calibre", GCAL_Erase() && !GCAL_IsCalibrated()
+              && SIM_IsIdentity() && (SIM_NvmEraseCount(SIM_NVM_CALIB_PAGE) == erases + 1),
+              "%8.0f", SIM_NvmEraseCount(SIM_NVM_CALIB_PAGE));
+}
+
+static void SIM_TestCapture(void)
+{
+    S_simNvmStats nvmStats;
+    uint8_t i;
+    bool ok = true;
+
+    printf("Capture\n");
+    GCAL_CaptureStart();
+    ok = GCAL_CapturePoint(0, 1000) && !GCAL_CapturePoint(1, 1000) && !GCAL_CaptureCommit();
+    GCAL_CaptureStart();
+    SIM_Check("refusee pendant un point, commit refuse", ok && !GCAL_CaptureBusy(), "%8.0f", ok);
+    SIM_Check("canal invalide refuse", !GCAL_CapturePoint(GCAL_NB_CHAN, 1000), "%8.0f", GCAL_NB_CHAN);
+    for (i = 0; i < GCAL_MAX_POINTS; i++)
+    {
+        SIM_CapturePoint(1, 300 + 300 * i);
+    }
+    SIM_Check("point au-dela de GCAL_MAX_POINTS refuse", !GCAL_CapturePoint(1, 3000), "%8.0f",
+              GCAL_MAX_POINTS);
+    GCAL_CaptureStart();
+
+    SIM_NvmGetStats(&nvmStats);
+    SIM_Check("sequences NVM en erreur", nvmStats.nbSequenceErrors == 0, "%8.0f",
+              nvmStats.nbSequenceErrors);
+    SIM_Check("deverrouillages interruptions actives", nvmStats.nbUnlockIntOn == 0, "%8.0f",
+              nvmStats.nbUnlockIntOn);
+    SIM_Check("reprogrammations sans effacement", nvmStats.nbReprograms == 0, "%8.0f",
+              nvmStats.nbReprograms);
+}
+
+static void SIM_Bench(void)
+{
+    static S_ADCResults block[SIM_BENCH_NB];
+    uint64_t ns, best = UINT64_MAX;
+    uint32_t i, run;
+
+    printf("Cout sur PC\n");
+    for (run = 0; run < 200; run++)
+    {
+        for (i = 0; i < SIM_BENCH_NB; i++)
+        {
+            block[i].Chan0 = (uint16_t)((i * 37) & GCAL_ADC_MAX);
+            block[i].Chan1 = (uint16_t)((i * 91) & GCAL_ADC_MAX);
+        }
+        ns = SIM_HostNs();
+        for (i = 0; i < SIM_BENCH_NB; i++)
+        {
+            GCAL_ApplyAdc(&block[i]);
+        }
+        ns = SIM_HostNs() - ns;
+        if (ns < best) best = ns;
+    }
+    printf("  GCAL_ApplyAdc : %6.2f ns / mesure (canal)\n",
+           (double)best / (SIM_BENCH_NB * GCAL_NB_CHAN));
+
+    // Code de mesure de la cible (core timer simule immobile)
+    GCAL_Bench();
+    SIM_Check("GCAL_Bench execute (core timer immobile)", gcalBench.cyclesPerSampleX100 == 0, "%8.0f",
+              gcalBench.cyclesPerSampleX100);
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint16_t offsetPoint[] = { 1650 };
+    static const uint16_t gainPoints[] = { 200, 3100 };
+    static const uint16_t linPoints[] = { 100, 700, 1300, 1900, 2500, 3100, 3250 };
+    unsigned seed = 1;
+    uint8_t chan;
+    int i;
+
+    for (i = 1; i < argc - 1; i++)
+    {
+        if (strcmp(argv[i], "-s") == 0)  seed = strtoul(argv[++i], NULL, 0);
+    }
+    srand(seed);
+    SIM_NvmReset();
+
+    printf("Carte non calibree\n");
+    GCAL_Initialize();
+    SIM_Check("table identite, non calibre", SIM_IsIdentity() && !GCAL_IsCalibrated(), "%8.0f",
+              GCAL_IsCalibrated());
+    for (chan = 0; chan < GCAL_NB_CHAN; chan++)
+    {
+        printf("  Chan%u : erreur max %.2f LSB\n", chan, SIM_MaxError(chan));
+    }
+
+    // Limites : restes du modele (non-linearite, pente sur les bords)
+    // + quantification de l'ADC et arrondi de la sortie (1 LSB). Chan1 :
+    // corde de la sinusoide entre les points (~0.4 LSB) en plus
+    SIM_Calibrate("Offset", offsetPoint, 1, 17.0, 12.0);
+    SIM_Calibrate("Offset et gain", gainPoints, 2, 4.0, 4.0);
+    SIM_Calibrate("Linearisation", linPoints, 7, 2.0, 2.0);
+    SIM_TestPersistence();
+    SIM_TestCapture();
+    SIM_Bench();
+
+    printf("%s\n", (nbFail == 0) ? "OK" : "ECHEC");
+    return (nbFail == 0) ? 0 : 1;
+}
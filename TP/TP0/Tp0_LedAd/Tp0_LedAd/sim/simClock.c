@@ -0,0 +1,60 @@
+/*--------------------------------------------------------*/
+// simClock.c
+/*--------------------------------------------------------*/
+//	Description :	Core timer, RCON et horloge systeme simules, communs
+//			        aux simulations (simPlib.c, simNvm.c). Le core
+//			        timer est avance par le simulateur.
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <xc.h>
+#include "system_config.h"
+#include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
+
+volatile uint32_t simCoreCount = 0;
+uint32_t simCoreTicsPerRead = 0;
+volatile uint32_t simRcon = 0;
+
+// Table des rappels comme sys_clk_pic32mx.c (PBDIV = 1)
+static uint32_t simClkFreq = SYS_CLK_FREQ;
+static SYS_CLK_FREQ_CHANGE_CALLBACK simClkCallbacks[SYS_CLK_FREQ_CHANGE_CALLBACKS_MAX];
+static uint8_t simClkNbCallbacks = 0;
+static uint32_t simClkNbRejected = 0;
+
+uint32_t SYS_CLK_SystemFrequencyGet(void)       { return simClkFreq; }
+uint32_t SYS_CLK_PeripheralFrequencyGet(CLK_BUSES_PERIPHERAL peripheralBus)
+{
+    (void)peripheralBus;
+    return simClkFreq;
+}
+
+bool SYS_CLK_FrequencyChangeCallbackRegister(SYS_CLK_FREQ_CHANGE_CALLBACK callback)
+{
+    if ((callback == NULL) || (simClkNbCallbacks >= SYS_CLK_FREQ_CHANGE_CALLBACKS_MAX))
+    {
+        simClkNbRejected++;
+        return false;
+    }
+    simClkCallbacks[simClkNbCallbacks++] = callback;
+    return true;
+}
+
+uint32_t SYS_CLK_CallbackRejectedCountGet(void)  { return simClkNbRejected; }
+
+void SIM_ClockScale(uint32_t systemClockHz)
+{
+    uint8_t i;
+
+    simClkFreq = systemClockHz;
+    for (i = 0; i < simClkNbCallbacks; i++)
+    {
+        simClkCallbacks[i](systemClockHz, systemClockHz);
+    }
+}
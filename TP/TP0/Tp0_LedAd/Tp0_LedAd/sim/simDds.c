@@ -0,0 +1,679 @@
+/*--------------------------------------------------------*/
+// simDds.c
+/*--------------------------------------------------------*/
+//	Description :	Tests de gestDds.c sur PC : Timer2, OC1 et DMA
+//			        simules (simPlib.c), purete spectrale, changements
+//			        sans saut, temps par echantillon.
+//
+//	Utilisation :	simDds [-s graine]
+//			        simDds -w      tables sinus et triangle
+//			                       (initialiseurs C de gestDds.c)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+//  Chaque periode du Timer2 : rapport cyclique OC1RS de la periode
+//  releve, puis transfert DMA et ISR comme sur la cible
+//  (system_interrupt.c).
+//  - tables gddsSine / gddsTriangle identiques au calcul en double
+//  - sortie contre le modele en double (phase exacte, meme pas)
+//  - spectre (fenetre de Blackman-Harris, 16384 points) a 3 cadences :
+//    SINAD contre la limite de quantification de la PWM, SFDR
+//  - mode ISR : memes echantillons que le mode DMA
+//  - frequence, amplitude, forme d'onde changees a des instants
+//    aleatoires : ecart entre 2 echantillons borne par la pente
+//    maximale (un saut de phase ou d'amplitude le depasse)
+//  - moitie de buffer manquee comptee, arret au point milieu
+//  - horloge changee (SIM_ClockScale) : PR2, frequence et crete
+//  - temps PC par echantillon ; sur la cible, GDDS_Bench (charge CPU,
+//    boucle sur le core timer : non executable ici)
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "simPlib.h"
+#include "gestDds.h"
+
+#define SIM_FFT_SIZE        16384
+#define SIM_SETTLE          256         // rampe de depart passee
+#define SIM_MAX_SAMPLES     200000
+#define SIM_BENCH_RUNS      20
+#define SIM_BENCH_SAMPLES   (64 * GDDS_HALF_SIZE)
+
+static int nbFail = 0;
+static uint16_t out[SIM_MAX_SAMPLES];
+
+static void SIM_Check(const char *name, int ok, const char *fmt, double value)
+{
+    printf("  %-44s ", name);
+    printf(fmt, value);
+    printf("  %s\n", ok ? "ok" : "ECHEC");
+    if (!ok)
+    {
+        nbFail++;
+    }
+}
+
+static uint64_t SIM_HostNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/*--------------------------------------------------------*/
+// Materiel simule
+/*--------------------------------------------------------*/
+
+// Une periode : OC1RS pris par la PWM, puis evenement T2 (DMA) et ISR
+// actives. skipIsr : ISR DMA retardee (moitie manquee).
+static uint16_t SIM_Period(bool skipIsr)
+{
+    uint16_t duty = (uint16_t)simOcRs[0];
+
+    SIM_TimerPeriod(TMR_ID_2);
+    if (!skipIsr && simIntFlag[INT_SOURCE_DMA_1] && simIntEnabled[INT_SOURCE_DMA_1])
+    {
+        GDDS_DmaCallback();
+        PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_DMA_1);
+    }
+    if (simIntFlag[INT_SOURCE_TIMER_2] && simIntEnabled[INT_SOURCE_TIMER_2])
+    {
+        PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_TIMER_2);
+        GDDS_TimerCallback();
+    }
+    return duty;
+}
+
+static void SIM_Run(uint16_t *pOut, uint32_t nb)
+{
+    uint32_t n;
+
+    for (n = 0; n < nb; n++)
+    {
+        pOut[n] = SIM_Period(false);
+    }
+}
+
+static uint16_t SIM_Center(uint32_t rateHz)
+{
+    return (uint16_t)(SYS_CLK_BUS_PERIPHERAL_1 / rateHz / 2);
+}
+
+// Pas de phase et crete comme gestDds.c
+static uint32_t SIM_Step(uint32_t milliHz, uint32_t rateHz)
+{
+    uint64_t rateMilliHz = (uint64_t)rateHz * 1000u;
+
+    return (uint32_t)((((uint64_t)milliHz << 32) + rateMilliHz / 2) / rateMilliHz);
+}
+
+static int32_t SIM_Scale(uint16_t amplitudeQ15, uint32_t rateHz)
+{
+    return (int32_t)(((uint32_t)amplitudeQ15 * SIM_Center(rateHz) + (1u << 14)) >> 15);
+}
+
+static void SIM_Start(uint32_t rateHz, GDDS_MODE mode, uint32_t milliHz, uint16_t amplitudeQ15,
+                      const int16_t *pTable)
+{
+    // Frequence avant GDDS_Start : buffer DMA rempli a la bonne
+    // frequence (controlee contre la cadence par defaut, 100 kHz)
+    GDDS_Initialize();
+    GDDS_SetWaveform(pTable);
+    GDDS_SetAmplitude(amplitudeQ15);
+    if (!GDDS_SetFrequency(milliHz) || !GDDS_Start(rateHz, mode))
+    {
+        printf("  demarrage refuse (%u Hz)\n", rateHz);
+        nbFail++;
+    }
+}
+
+/*--------------------------------------------------------*/
+// Tables
+/*--------------------------------------------------------*/
+
+static double SIM_Triangle(double x)
+{
+    return (x <= 0.25) ? 4.0 * x : ((x <= 0.75) ? 2.0 - 4.0 * x : 4.0 * x - 4.0);
+}
+
+static void SIM_MakeTables(int16_t *pSine, int16_t *pTriangle)
+{
+    uint16_t k;
+
+    for (k = 0; k <= GDDS_TABLE_SIZE; k++)
+    {
+        pSine[k] = (int16_t)lround(sin(2.0 * M_PI * k / GDDS_TABLE_SIZE) * 32767.0);
+        pTriangle[k] = (int16_t)lround(SIM_Triangle((double)k / GDDS_TABLE_SIZE) * 32767.0);
+    }
+    pSine[GDDS_TABLE_SIZE] = pSine[0];
+}
+
+static void SIM_WriteTable(const char *name, const int16_t *pTable)
+{
+    uint16_t k;
+
+    printf("// %s\n", name);
+    for (k = 0; k <= GDDS_TABLE_SIZE; k++)
+    {
+        printf("%s%6d%s", ((k % 8) == 0) ? "    " : " ", pTable[k],
+               (k == GDDS_TABLE_SIZE) ? "\n" : (((k % 8) == 7) ? ",\n" : ","));
+    }
+}
+
+// Erreur du sinus interpole (table Q15, interpolation exacte) : max
+// en Q15 et SINAD limite par la table, avant la PWM
+#define SIM_INTERP_STEPS    64
+
+static double interpMaxErr, interpSinad;
+
+static void SIM_TestTables(void)
+{
+    int16_t sine[GDDS_TABLE_SIZE + 1], triangle[GDDS_TABLE_SIZE + 1];
+    uint16_t k, i, nbDiff = 0;
+    double x, err, sumErr = 0.0;
+
+    SIM_MakeTables(sine, triangle);
+    for (k = 0; k <= GDDS_TABLE_SIZE; k++)
+    {
+        nbDiff += (sine[k] != gddsSine[k]) + (triangle[k] != gddsTriangle[k]);
+    }
+    printf("Tables (%u + 1 points)\n", GDDS_TABLE_SIZE);
+    SIM_Check("entrees differentes du calcul en double", nbDiff == 0, "%8.0f", nbDiff);
+
+    for (k = 0; k < GDDS_TABLE_SIZE; k++)
+    {
+        for (i = 0; i < SIM_INTERP_STEPS; i++)
+        {
+            x = (double)i / SIM_INTERP_STEPS;
+            err = gddsSine[k] + (gddsSine[k + 1] - gddsSine[k]) * x
+                  - 32767.0 * sin(2.0 * M_PI * (k + x) / GDDS_TABLE_SIZE);
+            interpMaxErr = fmax(interpMaxErr, fabs(err));
+            sumErr += err * err;
+        }
+    }
+    interpSinad = 10.0 * log10(32767.0 * 32767.0 / 2.0 / (sumErr / (GDDS_TABLE_SIZE * SIM_INTERP_STEPS)));
+    printf("  sinus interpole : erreur max %.2f (Q15), SINAD %.1f dB\n", interpMaxErr, interpSinad);
+}
+
+/*--------------------------------------------------------*/
+// Spectre
+/*--------------------------------------------------------*/
+
+// FFT radix 2 en place, en double
+static void SIM_Fft(double *pRe, double *pIm, uint32_t size)
+{
+    uint32_t i, j, k, len;
+    double angle, wr, wi, tr, ti, ur, ui, t;
+
+    for (i = 1, j = 0; i < size; i++)
+    {
+        for (k = size >> 1; j & k; k >>= 1)
+        {
+            j ^= k;
+        }
+        j |= k;
+        if (i < j)
+        {
+            t = pRe[i]; pRe[i] = pRe[j]; pRe[j] = t;
+            t = pIm[i]; pIm[i] = pIm[j]; pIm[j] = t;
+        }
+    }
+    for (len = 2; len <= size; len <<= 1)
+    {
+        for (i = 0; i < size; i += len)
+        {
+            for (k = 0; k < len / 2; k++)
+            {
+                angle = -2.0 * M_PI * k / len;
+                wr = cos(angle);
+                wi = sin(angle);
+                ur = pRe[i + k];
+                ui = pIm[i + k];
+                tr = pRe[i + k + len / 2] * wr - pIm[i + k + len / 2] * wi;
+                ti = pRe[i + k + len / 2] * wi + pIm[i + k + len / 2] * wr;
+                pRe[i + k] = ur + tr;
+                pIm[i + k] = ui + ti;
+                pRe[i + k + len / 2] = ur - tr;
+                pIm[i + k + len / 2] = ui - ti;
+            }
+        }
+    }
+}
+
+// Fenetre de Blackman-Harris (4 termes, lobes < -92 dB, lobe
+// principal +-4 bins) : SINAD (puissance du lobe de la porteuse
+// contre le reste, continu exclu) et SFDR (porteuse contre la plus
+// grande autre raie), en dB
+#define SIM_LOBE            4
+
+static void SIM_Spectrum(const uint16_t *pIn, double *pSinad, double *pSfdr)
+{
+    static double re[SIM_FFT_SIZE], im[SIM_FFT_SIZE], power[SIM_FFT_SIZE / 2];
+    double x, mean = 0.0, carrier = 0.0, rest = 0.0, spur = 0.0;
+    uint32_t n, k, peak = SIM_LOBE + 1;
+
+    for (n = 0; n < SIM_FFT_SIZE; n++)
+    {
+        mean += pIn[n];
+    }
+    mean /= SIM_FFT_SIZE;
+    for (n = 0; n < SIM_FFT_SIZE; n++)
+    {
+        x = 2.0 * M_PI * n / SIM_FFT_SIZE;
+        re[n] = (pIn[n] - mean) * (0.35875 - 0.48829 * cos(x) + 0.14128 * cos(2 * x) - 0.01168 * cos(3 * x));
+        im[n] = 0.0;
+    }
+    SIM_Fft(re, im, SIM_FFT_SIZE);
+    for (k = 0; k < SIM_FFT_SIZE / 2; k++)
+    {
+        power[k] = re[k] * re[k] + im[k] * im[k];
+        if ((k > SIM_LOBE) && (power[k] > power[peak]))
+        {
+            peak = k;
+        }
+    }
+    for (k = SIM_LOBE + 1; k < SIM_FFT_SIZE / 2; k++)
+    {
+        if ((k + SIM_LOBE >= peak) && (k <= peak + SIM_LOBE))
+        {
+            carrier += power[k];
+        }
+        else
+        {
+            rest += power[k];
+            if (power[k] > spur)
+            {
+                spur = power[k];
+            }
+        }
+    }
+    *pSinad = 10.0 * log10(carrier / rest);
+    *pSfdr = 10.0 * log10(power[peak] / spur);
+}
+
+static void SIM_TestPurity(uint32_t rateHz, uint32_t milliHz, double minSfdr)
+{
+    double sinad, sfdr, pwmSinad, limit, errBound, err, maxErr = 0.0, ideal;
+    uint32_t step = SIM_Step(milliHz, rateHz), n;
+    int32_t scale = SIM_Scale(GDDS_AMPLITUDE_MAX, rateHz);
+    uint16_t center = SIM_Center(rateHz);
+    char label[64];
+
+    // Limite : quantification de la PWM (2 x center niveaux, pleine
+    // echelle) et interpolation de la table, bruits sommes
+    pwmSinad = 6.02 * log2(2.0 * center) + 1.76;
+    limit = -10.0 * log10(pow(10.0, -pwmSinad / 10.0) + pow(10.0, -interpSinad / 10.0));
+    printf("Cadence %u Hz, sinus %.3f Hz, %u niveaux (SINAD PWM %.1f dB, avec la table %.1f dB)\n",
+           rateHz, milliHz / 1000.0, 2 * center, pwmSinad, limit);
+
+    SIM_Start(rateHz, GDDS_MODE_DMA, milliHz, GDDS_AMPLITUDE_MAX, gddsSine);
+    SIM_Run(out, SIM_SETTLE + SIM_FFT_SIZE);
+
+    // out[n] : echantillon n - 1 (OC1RS au point milieu au depart).
+    // Ecart admis : arrondi de la PWM, table et interpolation (1 LSB
+    // Q15) ramenes a la crete.
+    errBound = 0.5 + scale * (interpMaxErr + 1.0) / 32768.0;
+    for (n = SIM_SETTLE; n < SIM_SETTLE + SIM_FFT_SIZE; n++)
+    {
+        ideal = center + scale * (32767.0 / 32768.0)
+                * sin(2.0 * M_PI * (double)((uint32_t)((n - 1) * step)) / 4294967296.0);
+        err = fabs(out[n] - ideal);
+        if (err > maxErr)
+        {
+            maxErr = err;
+        }
+    }
+    snprintf(label, sizeof(label), "ecart max au modele en double (LSB), <= %.2f", errBound);
+    SIM_Check(label, maxErr <= errBound, "%8.3f", maxErr);
+
+    SIM_Spectrum(&out[SIM_SETTLE], &sinad, &sfdr);
+    SIM_Check("SINAD (dB), limite - 1.5", sinad >= limit - 1.5, "%8.1f", sinad);
+    snprintf(label, sizeof(label), "SFDR (dBc), >= %.0f", minSfdr);
+    SIM_Check(label, sfdr >= minSfdr, "%8.1f", sfdr);
+}
+
+/*--------------------------------------------------------*/
+// Modes et changements
+/*--------------------------------------------------------*/
+
+static void SIM_TestIsrMode(void)
+{
+    static uint16_t dmaOut[8192], isrOut[8192];
+    S_ddsStats stats;
+    uint32_t n, nbDiff = 0;
+
+    printf("Mode ISR contre mode DMA (100 kHz)\n");
+    SIM_Start(100000, GDDS_MODE_DMA, 1234567, 30000, gddsSine);
+    SIM_Run(dmaOut, 8192);
+    SIM_Start(100000, GDDS_MODE_ISR, 1234567, 30000, gddsSine);
+    SIM_Run(isrOut, 8192);
+    for (n = 0; n < 8192; n++)
+    {
+        nbDiff += (dmaOut[n] != isrOut[n]);
+    }
+    SIM_Check("echantillons differents", nbDiff == 0, "%8.0f", nbDiff);
+    GDDS_GetStats(&stats);
+    SIM_Check("mode ISR : un remplissage par echantillon", stats.nbFills == stats.nbSamples, "%8.0f",
+              stats.nbFills);
+}
+
+// Ecart max entre 2 echantillons, borne par la pente max des tables
+// sur le pas le plus grand, plus la rampe d'amplitude
+static double SIM_MaxJump(const uint16_t *pIn, uint32_t nb)
+{
+    double jump, maxJump = 0.0;
+    uint32_t n;
+
+    for (n = 1; n < nb; n++)
+    {
+        jump = fabs((double)pIn[n] - pIn[n - 1]);
+        if (jump > maxJump)
+        {
+            maxJump = jump;
+        }
+    }
+    return maxJump;
+}
+
+static double SIM_TableSlope(const int16_t *pTable)
+{
+    double slope, maxSlope = 0.0;
+    uint16_t k;
+
+    for (k = 0; k < GDDS_TABLE_SIZE; k++)
+    {
+        slope = fabs((double)pTable[k + 1] - pTable[k]) / 32768.0 * GDDS_TABLE_SIZE;
+        if (slope > maxSlope)
+        {
+            maxSlope = slope;
+        }
+    }
+    return maxSlope;    // pleine echelle par cycle
+}
+
+// Changements a des instants aleatoires, pendant nb echantillons.
+// Retour : indice du dernier changement.
+static uint32_t SIM_RunChanges(uint32_t nb, uint32_t nbChanges, void (*change)(uint32_t i))
+{
+    uint32_t n = 0, next, i;
+
+    for (i = 0; i < nbChanges; i++)
+    {
+        next = (i + 1) * (nb / (nbChanges + 1)) + (uint32_t)(rand() % 200) - 100;
+        SIM_Run(&out[n], next - n);
+        n = next;
+        change(i);
+    }
+    SIM_Run(&out[n], nb - n);
+    return n;
+}
+
+#define SIM_NB_CHANGES      20
+
+static uint32_t freqs[SIM_NB_CHANGES];
+static uint16_t amplitudes[SIM_NB_CHANGES];
+static int16_t arbitrary[GDDS_TABLE_SIZE + 1];
+static const int16_t *waves[3] = { gddsTriangle, arbitrary, gddsSine };
+
+static void SIM_ChangeFreq(uint32_t i)      { GDDS_SetFrequency(freqs[i]); }
+static void SIM_ChangeAmplitude(uint32_t i) { GDDS_SetAmplitude(amplitudes[i]); }
+static void SIM_ChangeWave(uint32_t i)      { GDDS_SetWaveform(waves[i % 3]); }
+
+// Frequence d'apres les passages montants par le point milieu
+// (interpoles), entre le premier et le dernier
+static double SIM_MeasureFreq(const uint16_t *pIn, uint32_t nb, uint16_t center, uint32_t rateHz)
+{
+    double t, first = 0.0, last = 0.0;
+    uint32_t n, count = 0;
+
+    for (n = 1; n < nb; n++)
+    {
+        if ((pIn[n - 1] < center) && (pIn[n] >= center))
+        {
+            t = n - 1 + (double)(center - pIn[n - 1]) / (pIn[n] - pIn[n - 1]);
+            first = (count == 0) ? t : first;
+            last = t;
+            count++;
+        }
+    }
+    return (count < 2) ? 0.0 : (count - 1) * (double)rateHz / (last - first);
+}
+
+static void SIM_TestChanges(void)
+{
+    const uint32_t rate = 100000, nb = 100000;
+    uint16_t center = SIM_Center(rate), peak;
+    S_ddsStats stats;
+    double bound, jump, slope;
+    uint32_t i, maxFreq = 0, n, lastChange;
+    double freq;
+    int32_t maxScale, maxDelta = 0, scale, lastScale;
+
+    printf("Changements sans saut (100 kHz, %u changements)\n", SIM_NB_CHANGES);
+
+    // Frequence : 100 Hz .. 5 kHz, amplitude pleine echelle
+    for (i = 0; i < SIM_NB_CHANGES; i++)
+    {
+        freqs[i] = 100000 + (uint32_t)(rand() % 4900000);
+        maxFreq = (freqs[i] > maxFreq) ? freqs[i] : maxFreq;
+    }
+    freqs[SIM_NB_CHANGES - 1] = 3000000;
+    SIM_Start(rate, GDDS_MODE_DMA, 1000000, GDDS_AMPLITUDE_MAX, gddsSine);
+    SIM_Run(out, SIM_SETTLE);
+    lastChange = SIM_RunChanges(nb, SIM_NB_CHANGES, SIM_ChangeFreq);
+    bound = SIM_Scale(GDDS_AMPLITUDE_MAX, rate) * 2.0 * M_PI * (maxFreq / 1000.0) / rate + 1.0;
+    jump = SIM_MaxJump(out, nb);
+    printf("  ecart max entre 2 echantillons %.0f, borne %.1f (pente du sinus a %.0f Hz)\n",
+           jump, bound, maxFreq / 1000.0);
+    SIM_Check("frequence : pas de saut de phase", jump <= bound, "%8.0f", jump);
+    freq = SIM_MeasureFreq(&out[lastChange + 2 * GDDS_HALF_SIZE], nb - lastChange - 2 * GDDS_HALF_SIZE,
+                           center, rate);
+    SIM_Check("frequence finale (Hz, demande 3000)", fabs(freq - 3000.0) <= 0.5, "%8.2f", freq);
+
+    // Amplitude : pleine echelle .. 0, sinus 1 kHz
+    for (i = 0; i < SIM_NB_CHANGES; i++)
+    {
+        amplitudes[i] = (i % 2 == 0) ? (uint16_t)(rand() % 3300) : (uint16_t)(29000 + rand() % 3768);
+    }
+    amplitudes[SIM_NB_CHANGES - 1] = 20000;
+    SIM_Start(rate, GDDS_MODE_DMA, 1000000, GDDS_AMPLITUDE_MAX, gddsSine);
+    SIM_Run(out, SIM_SETTLE);
+    lastScale = SIM_Scale(GDDS_AMPLITUDE_MAX, rate);
+    maxScale = lastScale;
+    for (i = 0; i < SIM_NB_CHANGES; i++)
+    {
+        scale = SIM_Scale(amplitudes[i], rate);
+        maxDelta = (abs(scale - lastScale) > maxDelta) ? abs(scale - lastScale) : maxDelta;
+        lastScale = scale;
+    }
+    SIM_RunChanges(nb, SIM_NB_CHANGES, SIM_ChangeAmplitude);
+    bound = maxScale * 2.0 * M_PI * 1.0 / (rate / 1000.0) + (double)maxDelta / GDDS_RAMP_SAMPLES + 2.0;
+    jump = SIM_MaxJump(out, nb);
+    printf("  ecart max %.0f, borne %.1f (pente + rampe de %d sur %u)\n", jump, bound, maxDelta,
+           GDDS_RAMP_SAMPLES);
+    SIM_Check("amplitude : rampe, pas de marche", jump <= bound, "%8.0f", jump);
+    for (n = nb - 1000, peak = 0; n < nb; n++)
+    {
+        peak = (out[n] > peak) ? out[n] : peak;
+    }
+    SIM_Check("crete finale - crete demandee (LSB)",
+              abs((int)(peak - center) - (int)(SIM_Scale(20000, rate) * 32767 / 32768)) <= 1, "%8.0f",
+              (double)(peak - center) - SIM_Scale(20000, rate) * 32767.0 / 32768.0);
+    GDDS_GetStats(&stats);
+    SIM_Check("rampes (depart + changements)", stats.nbRamps == SIM_NB_CHANGES + 1, "%8.0f",
+              stats.nbRamps);
+
+    // Forme d'onde : triangle, arbitraire (sinus + harmonique 3), sinus
+    for (n = 0; n <= GDDS_TABLE_SIZE; n++)
+    {
+        arbitrary[n] = (int16_t)lround(24000.0 * (sin(2.0 * M_PI * n / GDDS_TABLE_SIZE)
+                                                  + sin(6.0 * M_PI * n / GDDS_TABLE_SIZE) / 3.0));
+    }
+    arbitrary[GDDS_TABLE_SIZE] = arbitrary[0];
+    SIM_Start(rate, GDDS_MODE_DMA, 1000000, GDDS_AMPLITUDE_MAX, gddsSine);
+    SIM_Run(out, SIM_SETTLE);
+    SIM_RunChanges(nb, SIM_NB_CHANGES, SIM_ChangeWave);
+    slope = fmax(SIM_TableSlope(gddsSine), fmax(SIM_TableSlope(gddsTriangle), SIM_TableSlope(arbitrary)));
+    bound = SIM_Scale(GDDS_AMPLITUDE_MAX, rate) * slope * 1.0 / (rate / 1000.0) + 2.0;
+    jump = SIM_MaxJump(out, nb);
+    printf("  ecart max %.0f, borne %.1f (pente max des 3 tables)\n", jump, bound);
+    SIM_Check("forme d'onde : changee au passage par 0", jump <= bound, "%8.0f", jump);
+    GDDS_GetStats(&stats);
+    SIM_Check("changements de forme pris", stats.nbWaveChanges == SIM_NB_CHANGES, "%8.0f",
+              stats.nbWaveChanges);
+    SIM_Check("moities de buffer manquees", stats.nbLate == 0, "%8.0f", stats.nbLate);
+}
+
+static void SIM_TestControl(void)
+{
+    S_ddsStats stats;
+    uint32_t n;
+    uint16_t peak;
+    double freq;
+    bool ok;
+
+    printf("Commande\n");
+    SIM_Start(100000, GDDS_MODE_DMA, 1000000, GDDS_AMPLITUDE_MAX, gddsSine);
+    ok = !GDDS_Start(GDDS_RATE_MIN_HZ - 1, GDDS_MODE_DMA) && !GDDS_Start(GDDS_RATE_MAX_HZ + 1, GDDS_MODE_DMA)
+         && !GDDS_Start(100000, GDDS_NB_MODES) && GDDS_IsRunning();
+    SIM_Check("cadence ou mode invalide refuse", ok, "%8.0f", ok);
+    ok = !GDDS_SetFrequency(50000001) && GDDS_SetFrequency(50000000);
+    SIM_Check("frequence au-dela de cadence / 2 refusee", ok, "%8.0f", ok);
+
+    // ISR DMA retardee de plus d'une moitie de buffer : evenement
+    // HALF_EMPTY a la 1re periode sautee (pointeur DMA en 31, buffer
+    // de 64), puis DONE
+    GDDS_SetFrequency(1000000);
+    SIM_Run(out, 16 * 2 * GDDS_HALF_SIZE + GDDS_HALF_SIZE - 1);
+    for (n = 0; n < GDDS_HALF_SIZE + 1; n++)
+    {
+        SIM_Period(true);
+    }
+    SIM_Run(out, 1000);
+    GDDS_GetStats(&stats);
+    SIM_Check("moitie manquee comptee", stats.nbLate == 1, "%8.0f", stats.nbLate);
+
+    GDDS_Stop();
+    SIM_Run(out, 100);
+    ok = !GDDS_IsRunning() && !simDma[DMA_CHANNEL_1].enabled && !simIntEnabled[INT_SOURCE_DMA_1]
+         && (out[99] == SIM_Center(100000)) && simTmr[TMR_ID_2].running;
+    SIM_Check("arret : DMA coupe, PWM a 50 %", ok, "%8.0f", out[99]);
+
+    // Depart : rampe depuis le point milieu
+    SIM_Start(100000, GDDS_MODE_ISR, 25000000, GDDS_AMPLITUDE_MAX, gddsSine);
+    SIM_Run(out, 4);
+    SIM_Check("depart : 3e echantillon proche du milieu (LSB)",
+              abs((int)out[3] - (int)SIM_Center(100000)) <= 50, "%8.0f",
+              (double)out[3] - SIM_Center(100000));
+    GDDS_Stop();
+
+    // Horloge divisee par 2 en cours de generation : PR2 suit, la
+    // cadence, la frequence et la crete sont gardees
+    SIM_Start(100000, GDDS_MODE_DMA, 1000000, GDDS_AMPLITUDE_MAX, gddsSine);
+    SIM_Run(out, 1000);
+    SIM_ClockScale(SYS_CLK_FREQ / 2);
+    SIM_Run(out, 20000);
+    ok = GDDS_IsRunning() && (simTmr[TMR_ID_2].period == SYS_CLK_FREQ / 2 / 100000 - 1);
+    SIM_Check("horloge / 2 : PR2 recalcule", ok, "%8.0f", simTmr[TMR_ID_2].period);
+    freq = SIM_MeasureFreq(&out[2 * SIM_SETTLE], 20000 - 2 * SIM_SETTLE, SIM_Center(100000) / 2, 100000);
+    SIM_Check("horloge / 2 : frequence (Hz)", fabs(freq - 1000.0) < 0.1, "%8.3f", freq);
+    peak = 0;
+    for (n = 2 * SIM_SETTLE; n < 20000; n++)
+    {
+        peak = (out[n] > peak) ? out[n] : peak;
+    }
+    SIM_Check("horloge / 2 : crete pleine echelle (niveaux)",
+              peak == SIM_Center(100000) / 2 + SIM_Scale(GDDS_AMPLITUDE_MAX, 100000) / 2, "%8.0f", peak);
+    SIM_ClockScale(SYS_CLK_FREQ);
+    SIM_Run(out, 100);
+    SIM_Check("horloge retablie : PR2 d'origine", simTmr[TMR_ID_2].period == 2 * SIM_Center(100000) - 1,
+              "%8.0f", simTmr[TMR_ID_2].period);
+    GDDS_Stop();
+    SIM_Check("inscrit une seule fois aux rappels d'horloge", SYS_CLK_CallbackRejectedCountGet() == 0,
+              "%8.0f", SYS_CLK_CallbackRejectedCountGet());
+}
+
+/*--------------------------------------------------------*/
+// Cout
+/*--------------------------------------------------------*/
+
+static void SIM_Bench(void)
+{
+    static const uint32_t rates[GDDS_BENCH_NB_RATES] = {
+#define SIM_BENCH_RATE(n)       n,
+        GDDS_BENCH_RATES(SIM_BENCH_RATE)
+    };
+    static uint16_t buf[SIM_BENCH_SAMPLES];
+    uint64_t start, best[GDDS_NB_MODES] = { UINT64_MAX, UINT64_MAX };
+    uint32_t run, n;
+    uint8_t i;
+
+    printf("Cout sur PC\n");
+    SIM_Start(100000, GDDS_MODE_DMA, 1234567, GDDS_AMPLITUDE_MAX, gddsSine);
+    for (run = 0; run < SIM_BENCH_RUNS; run++)
+    {
+        start = SIM_HostNs();
+        for (n = 0; n < SIM_BENCH_SAMPLES; n += GDDS_HALF_SIZE)
+        {
+            GDDS_Fill(&buf[n], GDDS_HALF_SIZE);
+        }
+        best[GDDS_MODE_DMA] = fmin(best[GDDS_MODE_DMA], SIM_HostNs() - start);
+        start = SIM_HostNs();
+        for (n = 0; n < SIM_BENCH_SAMPLES; n++)
+        {
+            GDDS_TimerCallback();
+        }
+        best[GDDS_MODE_ISR] = fmin(best[GDDS_MODE_ISR], SIM_HostNs() - start);
+    }
+    GDDS_Stop();
+    printf("  GDDS_Fill par %u : %6.2f ns / echantillon, 1 par ISR : %6.2f ns\n", GDDS_HALF_SIZE,
+           (double)best[GDDS_MODE_DMA] / SIM_BENCH_SAMPLES, (double)best[GDDS_MODE_ISR] / SIM_BENCH_SAMPLES);
+    printf("  charge PC (calcul seul)     DMA      ISR\n");
+    for (i = 0; i < GDDS_BENCH_NB_RATES; i++)
+    {
+        printf("  %8u Hz              %6.3f %%  %6.3f %%\n", rates[i],
+               (double)best[GDDS_MODE_DMA] / SIM_BENCH_SAMPLES * rates[i] * 1e-7,
+               (double)best[GDDS_MODE_ISR] / SIM_BENCH_SAMPLES * rates[i] * 1e-7);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int16_t sine[GDDS_TABLE_SIZE + 1], triangle[GDDS_TABLE_SIZE + 1];
+    unsigned seed = 1;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-w") == 0)
+        {
+            SIM_MakeTables(sine, triangle);
+            SIM_WriteTable("gddsSine", sine);
+            SIM_WriteTable("gddsTriangle", triangle);
+            return 0;
+        }
+        if ((strcmp(argv[i], "-s") == 0) && (i < argc - 1))
+        {
+            seed = strtoul(argv[++i], NULL, 0);
+        }
+    }
+    srand(seed);
+
+    SIM_TestTables();
+    SIM_TestPurity(400000, 4938000, 55.0);
+    SIM_TestPurity(100000, 1234567, 65.0);
+    SIM_TestPurity(2000, 24691, 85.0);
+    SIM_TestIsrMode();
+    SIM_TestChanges();
+    SIM_TestControl();
+    SIM_Bench();
+
+    printf("%s\n", (nbFail == 0) ? "OK" : "ECHEC");
+    return (nbFail == 0) ? 0 : 1;
+}
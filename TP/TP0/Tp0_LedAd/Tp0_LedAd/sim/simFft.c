@@ -0,0 +1,304 @@
+/*--------------------------------------------------------*/
+// simFft.c
+/*--------------------------------------------------------*/
+//	Description :	Tests de dspFft.c sur PC contre une TFD en
+//			        double, et temps par transformee.
+//
+//	Utilisation :	simFft [-s graine]
+//			        simFft -w      table des facteurs de rotation
+//			                       (initialiseur C de dspFft.c)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+//  - table fftTwiddle identique a cos / sin calcules en double
+//  - FFT_Transform, 64 a 1024 points (radix 4 seul et radix 4 + 2) :
+//    rapport signal / erreur contre la TFD divisee par la taille
+//  - tailles refusees (pas puissance de 2, hors 64..1024)
+//  - FFT_AnalyzeAdc : raie sur son bin, amplitude en LSB ADC,
+//    frequence, ordre des raies, canal d'un tableau de S_ADCResults
+//  - temps PC par transformee ; sur la cible, FFT_Bench
+//
+//  dspFft.c est inclus (pas compile a part) : la table est statique.
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "Mc32DriverAdc.h"
+#include "dspFft.c"
+
+#define SIM_BENCH_RUNS      200
+
+static int nbFail = 0;
+
+static void SIM_Check(const char *name, int ok, const char *fmt, double value)
+{
+    printf("  %-44s ", name);
+    printf(fmt, value);
+    printf("  %s\n", ok ? "ok" : "ECHEC");
+    if (!ok)
+    {
+        nbFail++;
+    }
+}
+
+static uint64_t SIM_HostNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/*--------------------------------------------------------*/
+// Table des facteurs de rotation
+/*--------------------------------------------------------*/
+
+static S_fftComplex SIM_Twiddle(uint16_t k)
+{
+    double angle = 2.0 * M_PI * k / FFT_MAX_SIZE;
+    S_fftComplex w;
+    long c = lround(cos(angle) * 32768.0), s = lround(sin(angle) * 32768.0);
+
+    w.re = (int16_t)((c > 32767) ? 32767 : c);
+    w.im = (int16_t)((s > 32767) ? 32767 : s);
+    return w;
+}
+
+static void SIM_WriteTwiddle(void)
+{
+    S_fftComplex w;
+    uint16_t k;
+
+    for (k = 0; k < FFT_TWIDDLE_SIZE; k++)
+    {
+        w = SIM_Twiddle(k);
+        printf("%s{%6d,%6d}%s", ((k % 6) == 0) ? "    " : " ", w.re, w.im,
+               (k == FFT_TWIDDLE_SIZE - 1) ? "\n" : (((k % 6) == 5) ? ",\n" : ","));
+    }
+}
+
+static void SIM_TestTwiddle(void)
+{
+    S_fftComplex w;
+    uint16_t k, nbDiff = 0;
+
+    for (k = 0; k < FFT_TWIDDLE_SIZE; k++)
+    {
+        w = SIM_Twiddle(k);
+        if ((w.re != fftTwiddle[k].re) || (w.im != fftTwiddle[k].im))
+        {
+            nbDiff++;
+        }
+    }
+    printf("Table des facteurs de rotation (%u)\n", FFT_TWIDDLE_SIZE);
+    SIM_Check("entrees differentes de cos / sin", nbDiff == 0, "%8.0f", nbDiff);
+}
+
+/*--------------------------------------------------------*/
+// Transformee contre la TFD
+/*--------------------------------------------------------*/
+
+// TFD / size, en double
+static void SIM_Dft(const S_fftComplex *pIn, double *pRe, double *pIm, uint16_t size)
+{
+    double angle, re, im;
+    uint16_t k, n;
+
+    for (k = 0; k < size; k++)
+    {
+        re = 0.0;
+        im = 0.0;
+        for (n = 0; n < size; n++)
+        {
+            angle = 2.0 * M_PI * (double)((uint32_t)k * n % size) / size;
+            re += pIn[n].re * cos(angle) + pIn[n].im * sin(angle);
+            im += pIn[n].im * cos(angle) - pIn[n].re * sin(angle);
+        }
+        pRe[k] = re / size;
+        pIm[k] = im / size;
+    }
+}
+
+static void SIM_TestTransform(uint16_t size)
+{
+    static S_fftComplex in[FFT_MAX_SIZE], data[FFT_MAX_SIZE];
+    static double re[FFT_MAX_SIZE], im[FFT_MAX_SIZE];
+    double signal = 0.0, noise = 0.0, err, maxErr = 0.0, snr;
+    char name[48];
+    uint16_t n;
+
+    // Bruit blanc, module < 1 : toutes les raies excitees
+    for (n = 0; n < size; n++)
+    {
+        in[n].re = (int16_t)((rand() % 46000) - 23000);
+        in[n].im = (int16_t)((rand() % 46000) - 23000);
+    }
+    memcpy(data, in, size * sizeof(in[0]));
+    SIM_Dft(in, re, im, size);
+    FFT_Transform(data, size);
+
+    for (n = 0; n < size; n++)
+    {
+        signal += re[n] * re[n] + im[n] * im[n];
+        err = hypot(data[n].re - re[n], data[n].im - im[n]);
+        noise += err * err;
+        if (err > maxErr)
+        {
+            maxErr = err;
+        }
+    }
+    snr = 10.0 * log10(signal / noise);
+    // 20 dB au-dessus du plancher du Q15 a la taille (4 LSB sur les
+    // etages, signal divise par racine de la taille)
+    snprintf(name, sizeof(name), "%4u points, signal / erreur (dB)", size);
+    SIM_Check(name, snr > 98.0 - 10.0 * log10(size) - 20.0, "%8.1f", snr);
+    snprintf(name, sizeof(name), "%4u points, erreur max (LSB)", size);
+    SIM_Check(name, maxErr < 4.0, "%8.2f", maxErr);
+}
+
+static void SIM_TestSizes(void)
+{
+    static S_fftComplex data[FFT_MAX_SIZE];
+    static const uint16_t refused[] = { 0, 32, 96, 100, 2048 };
+    uint16_t i, nbBad = 0;
+
+    memset(data, 0, sizeof(data));
+    for (i = 0; i < sizeof(refused) / sizeof(refused[0]); i++)
+    {
+        if (FFT_Transform(data, refused[i]))
+        {
+            nbBad++;
+        }
+    }
+    SIM_Check("tailles invalides acceptees", nbBad == 0, "%8.0f", nbBad);
+}
+
+/*--------------------------------------------------------*/
+// Analyse de blocs ADC
+/*--------------------------------------------------------*/
+
+#define SIM_RATE_MHZ        10000       // 10 Hz, comme APP
+
+// Bloc de S_ADCResults : Chan0 = ton sur bin0 (amp0), Chan1 = deux tons
+static void SIM_Block(S_ADCResults *pAdc, uint16_t size, double bin0, double amp0,
+                      double bin1, double amp1, double bin2, double amp2)
+{
+    uint16_t n;
+
+    for (n = 0; n < size; n++)
+    {
+        pAdc[n].Chan0 = (uint16_t)lround(512.0 + amp0 * cos(2.0 * M_PI * bin0 * n / size)
+                                         + (rand() % 3 - 1));
+        pAdc[n].Chan1 = (uint16_t)lround(400.0 + amp1 * sin(2.0 * M_PI * bin1 * n / size)
+                                         + amp2 * cos(2.0 * M_PI * bin2 * n / size + 1.0));
+    }
+}
+
+static void SIM_TestAnalyze(uint16_t size)
+{
+    static S_ADCResults adc[FFT_MAX_SIZE];
+    static S_fftComplex work[FFT_MAX_SIZE];
+    S_fftPeak peaks[3];
+    uint8_t nb;
+    char name[48];
+    uint16_t bin = size / 8 + 3;
+
+    printf("Analyse, %u mesures a %u.%u Hz\n", size, SIM_RATE_MHZ / 1000, SIM_RATE_MHZ % 1000 / 100);
+    SIM_Block(adc, size, bin, 200.0, size / 4, 300.0, size / 16, 60.0);
+
+    nb = FFT_AnalyzeAdc(&adc[0].Chan0, 2, size, SIM_RATE_MHZ, work, peaks, 3);
+    snprintf(name, sizeof(name), "Chan0 : raie sur le bin %u", bin);
+    SIM_Check(name, (nb >= 1) && (peaks[0].bin == bin), "%8.0f", (nb >= 1) ? peaks[0].bin : 0);
+    SIM_Check("Chan0 : amplitude (LSB, ton de 200)", (nb >= 1) && (abs(peaks[0].amplitude - 200) <= 2),
+              "%8.0f", (nb >= 1) ? peaks[0].amplitude : 0);
+    SIM_Check("Chan0 : frequence (mHz)", (nb >= 1)
+              && (peaks[0].freqMilliHz == (uint32_t)((uint64_t)bin * SIM_RATE_MHZ / size)),
+              "%8.0f", (nb >= 1) ? peaks[0].freqMilliHz : 0);
+
+    nb = FFT_AnalyzeAdc(&adc[0].Chan1, 2, size, SIM_RATE_MHZ, work, peaks, 3);
+    SIM_Check("Chan1 : deux raies, la plus grande d'abord", (nb >= 2) && (peaks[0].bin == size / 4)
+              && (peaks[1].bin == size / 16), "%8.0f", nb);
+    SIM_Check("Chan1 : amplitudes (LSB, 300 et 60)", (nb >= 2) && (abs(peaks[0].amplitude - 300) <= 2)
+              && (abs(peaks[1].amplitude - 60) <= 2), "%8.0f", (nb >= 2) ? peaks[1].amplitude : 0);
+
+    // Bloc constant : pas de raie
+    SIM_Block(adc, size, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+    nb = FFT_AnalyzeAdc(&adc[0].Chan1, 2, size, SIM_RATE_MHZ, work, peaks, 3);
+    SIM_Check("bloc constant : aucune raie", nb == 0, "%8.0f", nb);
+}
+
+/*--------------------------------------------------------*/
+// Cout
+/*--------------------------------------------------------*/
+
+static void SIM_Bench(void)
+{
+    static S_fftComplex data[FFT_MAX_SIZE];
+    uint64_t ns, best;
+    uint16_t size, n;
+    uint32_t run;
+
+    printf("Cout sur PC\n");
+    for (size = FFT_MIN_SIZE; size <= FFT_MAX_SIZE; size *= 2)
+    {
+        for (run = 0, best = UINT64_MAX; run < SIM_BENCH_RUNS; run++)
+        {
+            for (n = 0; n < size; n++)
+            {
+                data[n].re = (int16_t)(((n * 37) % 101) * 100 - 5000);
+                data[n].im = 0;
+            }
+            ns = SIM_HostNs();
+            FFT_Transform(data, size);
+            ns = SIM_HostNs() - ns;
+            if (ns < best) best = ns;
+        }
+        printf("  %4u points : %8.2f us, %5.2f ns / (N log2 N)\n", size, best / 1000.0,
+               (double)best / (size * log2(size)));
+    }
+
+    // Code de mesure de la cible (core timer simule immobile)
+    FFT_Bench();
+    SIM_Check("FFT_Bench execute", fftBench.size[FFT_BENCH_NB_SIZES - 1] == FFT_MAX_SIZE, "%8.0f",
+              fftBench.size[FFT_BENCH_NB_SIZES - 1]);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned seed = 1;
+    uint16_t size;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-w") == 0)
+        {
+            SIM_WriteTwiddle();
+            return 0;
+        }
+        if ((strcmp(argv[i], "-s") == 0) && (i < argc - 1))
+        {
+            seed = strtoul(argv[++i], NULL, 0);
+        }
+    }
+    srand(seed);
+
+    SIM_TestTwiddle();
+    printf("FFT_Transform contre la TFD (bruit blanc)\n");
+    for (size = FFT_MIN_SIZE; size <= FFT_MAX_SIZE; size *= 2)
+    {
+        SIM_TestTransform(size);
+    }
+    SIM_TestSizes();
+    SIM_TestAnalyze(64);
+    SIM_TestAnalyze(512);
+    SIM_Bench();
+
+    printf("%s\n", (nbFail == 0) ? "OK" : "ECHEC");
+    return (nbFail == 0) ? 0 : 1;
+}
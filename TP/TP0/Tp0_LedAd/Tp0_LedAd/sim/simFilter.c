@@ -0,0 +1,337 @@
+/*--------------------------------------------------------*/
+// simFilter.c
+/*--------------------------------------------------------*/
+//	Description :	Tests de dspFilter.c sur PC contre des modeles
+//			        de reference, et cout par coefficient.
+//
+//	Utilisation :	simFilter [-n echantillons] [-s graine]
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+//  - FIR : identique au bit pres au modele entier (accumulateur
+//    64 bits, meme arrondi), a 1 LSB du modele en double
+//  - biquads : a 1 LSB du modele en double (memes coefficients Q30)
+//  - blocs : canal d'un tableau de S_ADCResults (pas de 2), decoupe
+//    en morceaux de taille aleatoire = echantillon par echantillon
+//  - regime etabli (FLT_FirQ15Reset), gain statique, saturation
+//  - temps PC par coefficient ; sur la cible, FLT_Bench
+//
+//  Compile sans FLT_MAC_ASM (pas de MIPS) : c'est le calcul en C,
+//  que les boucles madd / msub reproduisent (meme accumulateur 64
+//  bits, meme arrondi).
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "Mc32DriverAdc.h"
+#include "dspFilter.h"
+
+#define SIM_MAX_TAPS        128
+#define SIM_MAX_SAMPLES     100000
+#define SIM_SECTIONS        2
+#define SIM_BENCH_BLOCK     256
+
+static int nbFail = 0;
+
+static void SIM_Check(const char *name, int ok, const char *fmt, double value)
+{
+    printf("  %-44s ", name);
+    printf(fmt, value);
+    printf("  %s\n", ok ? "ok" : "ECHEC");
+    if (!ok)
+    {
+        nbFail++;
+    }
+}
+
+static uint64_t SIM_HostNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/*--------------------------------------------------------*/
+// Conception et modeles de reference
+/*--------------------------------------------------------*/
+
+// Passe-bas a sinus cardinal, fenetre de Hamming, gain statique 1
+static void SIM_DesignFir(double *pH, int16_t *pQ15, uint16_t nbTaps, double fc)
+{
+    double m = (nbTaps - 1) / 2.0, sum = 0.0, t;
+    uint16_t k;
+
+    for (k = 0; k < nbTaps; k++)
+    {
+        t = k - m;
+        pH[k] = ((t == 0.0) ? 2.0 * fc : sin(2.0 * M_PI * fc * t) / (M_PI * t))
+                * (0.54 - 0.46 * cos(2.0 * M_PI * k / (nbTaps - 1)));
+        sum += pH[k];
+    }
+    for (k = 0; k < nbTaps; k++)
+    {
+        pH[k] /= sum;
+        pQ15[k] = (int16_t)lround(pH[k] * 32768.0);
+    }
+}
+
+// Butterworth d'ordre 2 x nbSections (formules RBJ), Q30
+static void SIM_DesignButterworth(S_fltBiquadCoefs *pC, uint8_t nbSections, double fc)
+{
+    double w0 = 2.0 * M_PI * fc, q, alpha, a0;
+    uint8_t i;
+
+    for (i = 0; i < nbSections; i++)
+    {
+        q = 1.0 / (2.0 * cos(M_PI * (2 * i + 1) / (4.0 * nbSections)));
+        alpha = sin(w0) / (2.0 * q);
+        a0 = 1.0 + alpha;
+        pC[i].b0 = FLT_Q30((1.0 - cos(w0)) / 2.0 / a0);
+        pC[i].b1 = FLT_Q30((1.0 - cos(w0)) / a0);
+        pC[i].b2 = pC[i].b0;
+        pC[i].a1 = FLT_Q30(-2.0 * cos(w0) / a0);
+        pC[i].a2 = FLT_Q30((1.0 - alpha) / a0);
+    }
+}
+
+// Modele entier du FIR : meme accumulateur, meme arrondi
+static int16_t SIM_FirExact(const int16_t *pX, uint32_t n, const int16_t *pH, uint16_t nbTaps)
+{
+    int64_t acc = 1 << 14;
+    uint16_t k;
+
+    for (k = 0; k < nbTaps; k++)
+    {
+        acc += (int32_t)pH[k] * ((n >= k) ? pX[n - k] : 0);
+    }
+    acc >>= 15;
+    return (acc > INT16_MAX) ? INT16_MAX : (acc < INT16_MIN) ? INT16_MIN : (int16_t)acc;
+}
+
+// Modeles en double
+static double SIM_FirDouble(const int16_t *pX, uint32_t n, const double *pH, uint16_t nbTaps)
+{
+    double acc = 0.0;
+    uint16_t k;
+
+    for (k = 0; k < nbTaps; k++)
+    {
+        acc += pH[k] * ((n >= k) ? pX[n - k] : 0);
+    }
+    return acc;
+}
+
+static void SIM_BiquadDouble(const S_fltBiquadCoefs *pC, uint8_t nbSections,
+                             const int16_t *pX, double *pY, uint32_t nb)
+{
+    double s[SIM_SECTIONS][4] = { { 0 } };
+    double v, y;
+    uint32_t n;
+    uint8_t i;
+
+    for (n = 0; n < nb; n++)
+    {
+        v = pX[n];
+        for (i = 0; i < nbSections; i++)
+        {
+            y = (pC[i].b0 * v + pC[i].b1 * s[i][0] + pC[i].b2 * s[i][1]
+                 - pC[i].a1 * s[i][2] - pC[i].a2 * s[i][3]) / 1073741824.0;
+            s[i][1] = s[i][0];
+            s[i][0] = v;
+            s[i][3] = s[i][2];
+            s[i][2] = y;
+            v = y;
+        }
+        pY[n] = v;
+    }
+}
+
+/*--------------------------------------------------------*/
+// Tests
+/*--------------------------------------------------------*/
+
+// Potentiometre : lent + ronflement + bruit, 0..1023
+static void SIM_Signal(S_ADCResults *pAdc, int16_t *pX, uint32_t nb)
+{
+    uint32_t n;
+    double v;
+
+    for (n = 0; n < nb; n++)
+    {
+        v = 511.5 + 400.0 * sin(2.0 * M_PI * n / 1000.0) + 60.0 * sin(2.0 * M_PI * n / 4.0)
+            + (rand() % 21) - 10;
+        pAdc[n].Chan0 = (uint16_t)((v < 0) ? 0 : (v > 1023) ? 1023 : lround(v));
+        pAdc[n].Chan1 = (uint16_t)(n % 1024);
+        pX[n] = (int16_t)pAdc[n].Chan0;
+    }
+}
+
+static void SIM_TestFir(const S_ADCResults *pAdc, const int16_t *pX, uint32_t nb, uint16_t nbTaps)
+{
+    static int16_t state[FLT_FIR_STATE_SIZE(SIM_MAX_TAPS)];
+    static int16_t outBlock[SIM_MAX_SAMPLES];
+    double h[SIM_MAX_TAPS], err, maxErr = 0.0;
+    int16_t hQ15[SIM_MAX_TAPS], y;
+    S_fltFirQ15 fir;
+    uint32_t n, nbDiff = 0, chunk;
+
+    SIM_DesignFir(h, hQ15, nbTaps, 0.05);
+    printf("FIR %u coefficients, passe-bas fs/20\n", nbTaps);
+
+    // Echantillon par echantillon contre les modeles
+    FLT_FirQ15Init(&fir, hQ15, state, nbTaps);
+    for (n = 0; n < nb; n++)
+    {
+        y = FLT_FirQ15Sample(&fir, pX[n]);
+        nbDiff += (y != SIM_FirExact(pX, n, hQ15, nbTaps));
+        err = fabs(y - SIM_FirDouble(pX, n, h, nbTaps));
+        if (err > maxErr)   maxErr = err;
+    }
+    SIM_Check("sorties differentes du modele entier", nbDiff == 0, "%8.0f", nbDiff);
+    SIM_Check("erreur max / modele double (LSB)", maxErr <= 1.0, "%8.3f", maxErr);
+
+    // Canal 0 des S_ADCResults par morceaux aleatoires
+    FLT_FirQ15Init(&fir, hQ15, state, nbTaps);
+    for (n = 0; n < nb; n += chunk)
+    {
+        chunk = 1 + rand() % 97;
+        if (chunk > nb - n) chunk = nb - n;
+        FLT_FirQ15Block(&fir, (const int16_t *)&pAdc[n].Chan0, 2, &outBlock[n], 1, (uint16_t)chunk);
+    }
+    FLT_FirQ15Init(&fir, hQ15, state, nbTaps);
+    for (n = 0, nbDiff = 0; n < nb; n++)
+    {
+        nbDiff += (outBlock[n] != FLT_FirQ15Sample(&fir, pX[n]));
+    }
+    SIM_Check("blocs (pas 2, morceaux 1..97) differents", nbDiff == 0, "%8.0f", nbDiff);
+
+    // Regime etabli : sortie immediate a la valeur
+    FLT_FirQ15Reset(&fir, 700);
+    y = FLT_FirQ15Sample(&fir, 700);
+    SIM_Check("regime etabli sur 700", abs(y - 700) <= 1, "%8.0f", y);
+}
+
+static void SIM_TestBiquad(const int16_t *pX, uint32_t nb)
+{
+    static double ref[SIM_MAX_SAMPLES];
+    S_fltBiquadCoefs coefs[SIM_SECTIONS];
+    S_fltBiquadState state[SIM_SECTIONS];
+    S_fltBiquad iir;
+    double err, maxErr = 0.0;
+    int16_t x, y = 0;
+    uint32_t n, nbWrap = 0;
+
+    SIM_DesignButterworth(coefs, SIM_SECTIONS, 0.05);
+    printf("Biquads : Butterworth d'ordre %u, fs/20\n", 2 * SIM_SECTIONS);
+
+    SIM_BiquadDouble(coefs, SIM_SECTIONS, pX, ref, nb);
+    FLT_BiquadInit(&iir, coefs, state, SIM_SECTIONS);
+    for (n = 0; n < nb; n++)
+    {
+        err = fabs(FLT_BiquadSample(&iir, pX[n]) - ref[n]);
+        if (err > maxErr)   maxErr = err;
+    }
+    SIM_Check("erreur max / modele double (LSB)", maxErr <= 1.0, "%8.3f", maxErr);
+
+    // Echelon : gain statique 1
+    FLT_BiquadReset(&iir);
+    for (n = 0; n < 2000; n++)
+    {
+        y = FLT_BiquadSample(&iir, 1000);
+    }
+    SIM_Check("echelon 1000, valeur finale", abs(y - 1000) <= 1, "%8.0f", y);
+
+    // Carre pleine echelle : le depassement sature au lieu de deborder,
+    // la sortie garde le signe de l'entree apres le transitoire
+    FLT_BiquadReset(&iir);
+    for (n = 0; n < 4000; n++)
+    {
+        x = ((n / 400) & 1) ? INT16_MIN : INT16_MAX;
+        y = FLT_BiquadSample(&iir, x);
+        nbWrap += ((n % 400) >= 100) && ((y < 0) != (x < 0));
+    }
+    SIM_Check("pleine echelle : retournements de signe", nbWrap == 0, "%8.0f", nbWrap);
+}
+
+// Temps PC par coefficient et par section
+static void SIM_Bench(void)
+{
+    static const uint16_t taps[] = { 8, 16, 32, 64, 128 };
+    static int16_t state[FLT_FIR_STATE_SIZE(SIM_MAX_TAPS)];
+    static int16_t coefs[SIM_MAX_TAPS];
+    int16_t in[SIM_BENCH_BLOCK], out[SIM_BENCH_BLOCK];
+    S_fltBiquadCoefs sections[4];
+    S_fltBiquadState sectionState[4];
+    S_fltFirQ15 fir;
+    S_fltBiquad iir;
+    uint64_t ns, best;
+    uint32_t i, run;
+
+    for (i = 0; i < SIM_MAX_TAPS; i++)  coefs[i] = FLT_Q15(1.0 / SIM_MAX_TAPS);
+    for (i = 0; i < SIM_BENCH_BLOCK; i++) in[i] = (int16_t)(512 + (i * 37) % 101);
+
+    printf("Cout sur PC (blocs de %u)\n", SIM_BENCH_BLOCK);
+    for (i = 0; i < sizeof(taps) / sizeof(taps[0]); i++)
+    {
+        FLT_FirQ15Init(&fir, coefs, state, taps[i]);
+        for (run = 0, best = UINT64_MAX; run < 200; run++)
+        {
+            ns = SIM_HostNs();
+            FLT_FirQ15Block(&fir, in, 1, out, 1, SIM_BENCH_BLOCK);
+            ns = SIM_HostNs() - ns;
+            if (ns < best) best = ns;
+        }
+        printf("  FIR %3u coefficients : %6.2f ns / coefficient\n", taps[i],
+               (double)best / (SIM_BENCH_BLOCK * taps[i]));
+    }
+    SIM_DesignButterworth(sections, 4, 0.05);
+    FLT_BiquadInit(&iir, sections, sectionState, 4);
+    for (run = 0, best = UINT64_MAX; run < 200; run++)
+    {
+        ns = SIM_HostNs();
+        FLT_BiquadBlock(&iir, in, 1, out, 1, SIM_BENCH_BLOCK);
+        ns = SIM_HostNs() - ns;
+        if (ns < best) best = ns;
+    }
+    printf("  biquads, 4 sections  : %6.2f ns / section\n", (double)best / (SIM_BENCH_BLOCK * 4));
+
+    // Code de mesure de la cible (core timer simule immobile)
+    FLT_Bench();
+    SIM_Check("FLT_Bench execute", fltBench.nbTaps[FLT_BENCH_NB_FIR - 1] == 128, "%8.0f",
+              fltBench.nbTaps[FLT_BENCH_NB_FIR - 1]);
+}
+
+int main(int argc, char *argv[])
+{
+    static S_ADCResults adc[SIM_MAX_SAMPLES];
+    static int16_t x[SIM_MAX_SAMPLES];
+    uint32_t nb = 20000;
+    unsigned seed = 1;
+    int i;
+
+    for (i = 1; i < argc - 1; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0)       nb = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-s") == 0)  seed = strtoul(argv[++i], NULL, 0);
+    }
+    if ((nb == 0) || (nb > SIM_MAX_SAMPLES))
+    {
+        nb = SIM_MAX_SAMPLES;
+    }
+    srand(seed);
+    SIM_Signal(adc, x, nb);
+
+    SIM_TestFir(adc, x, nb, 31);
+    SIM_TestFir(adc, x, nb, 64);
+    SIM_TestBiquad(x, nb);
+    SIM_Bench();
+
+    printf("%s\n", (nbFail == 0) ? "OK" : "ECHEC");
+    return (nbFail == 0) ? 0 : 1;
+}
@@ -0,0 +1,400 @@
+/*--------------------------------------------------------*/
+// simFlashLog.c
+/*--------------------------------------------------------*/
+//	Description :	Verification de gestFlashLog.c sur la flash
+//			        simulee (simNvm.c) :
+//			        - tours de zone : usure repartie, relecture
+//			          complete et recherche par horodatage comparees
+//			          au modele de reference
+//			        - coupures d'alimentation pendant un effacement
+//			          ou une programmation, puis redemarrage
+//			        - debit : programmation par rangee contre la
+//			          meme quantite par mots
+//			        - endurance depassee : rangees fausses sautees
+//
+//	Utilisation :	simFlashLog [-l tours] [-n recherches] [-s graine]
+//			                    [-R us rangee] [-W us mot] [-E us page]
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <sys/kmem.h>
+#include "simNvm.h"
+
+#define SIM_CORE_HZ         (SYS_CLK_FREQ / 2)
+#define SIM_PUSH_TICS       (SIM_CORE_HZ / 10)      // APP : 1 mesure / 100 ms
+#define SIM_SAMPLES_LAP     ((uint32_t)GFLG_NB_ROWS * GFLG_SAMPLES_PER_ROW)
+#define SIM_ENDURANCE_LOW   3
+
+// Modele de reference : horodatage attendu de chaque echantillon
+// enregistre. Les canaux codent le numero de l'echantillon.
+static uint32_t *refMs;
+static uint32_t nbRef = 0;
+
+// Horloge du firmware reconstituee : tics depuis GFLG_Initialize
+static uint64_t ticsSinceInit;
+static uint32_t baseMs;
+
+static jmp_buf powerFailJump;
+
+static void SIM_PowerFail(void)
+{
+    longjmp(powerFailJump, 1);
+}
+
+static void SIM_Boot(uint32_t resumeMs)
+{
+    GFLG_Initialize();
+    ticsSinceInit = 0;
+    baseMs = resumeMs;
+}
+
+// Une mesure ADC toutes les 100 ms ; la derniere d'un groupe de
+// GFLG_DECIMATION donne l'horodatage de l'echantillon enregistre
+static void SIM_PushGroup(void)
+{
+    S_ADCResults res;
+    uint32_t before;
+    uint16_t i;
+
+    res.Chan0 = (uint16_t)(nbRef & 0x0FFF);
+    res.Chan1 = (uint16_t)(nbRef >> 12);
+    for (i = 0; i < GFLG_DECIMATION; i++)
+    {
+        simCoreCount += SIM_PUSH_TICS;
+        ticsSinceInit += SIM_PUSH_TICS;
+        if (i == GFLG_DECIMATION - 1)
+        {
+            refMs[nbRef++] = baseMs + (uint32_t)(ticsSinceInit * 1000u / SIM_CORE_HZ);
+        }
+        // Operations NVM : CPU suspendu, le core timer avance
+        before = simCoreCount;
+        GFLG_PushAdc(&res);
+        ticsSinceInit += (uint32_t)(simCoreCount - before);
+    }
+}
+
+static uint32_t SIM_SampleIndex(const S_flashLogSample *pSample)
+{
+    return pSample->chan[0] | ((uint32_t)pSample->chan[1] << 12);
+}
+
+// Relecture complete depuis le plus ancien : numeros croissants,
+// horodatages du modele. Retourne le nombre d'echantillons lus.
+static uint32_t SIM_CheckReadBack(uint32_t *pFirst, uint32_t *pLast, uint32_t *pErrors)
+{
+    S_flashLogCursor cursor;
+    S_flashLogSample sample;
+    uint32_t oldestMs, newestMs, k;
+    uint32_t nb = 0;
+    bool first = true;
+
+    if (!GFLG_GetRange(&oldestMs, &newestMs) || !GFLG_Find(oldestMs, &cursor))
+    {
+        (*pErrors)++;
+        return 0;
+    }
+    while (GFLG_Read(&cursor, &sample))
+    {
+        k = SIM_SampleIndex(&sample);
+        if ((k >= nbRef) || (sample.stampMs != refMs[k]) || (!first && (k <= *pLast)))
+        {
+            if (*pErrors < 5)
+            {
+                printf("  relecture : echantillon %u a %u ms (attendu %u ms)\n", k,
+                       sample.stampMs, (k < nbRef) ? refMs[k] : 0);
+            }
+            (*pErrors)++;
+        }
+        if (first)
+        {
+            *pFirst = k;
+            first = false;
+        }
+        *pLast = k;
+        nb++;
+    }
+    if (!first && ((refMs[*pFirst] != oldestMs) || (refMs[*pLast] != newestMs)))
+    {
+        printf("  intervalle %u..%u ms, lu %u..%u ms\n", oldestMs, newestMs,
+               refMs[*pFirst], refMs[*pLast]);
+        (*pErrors)++;
+    }
+    return nb;
+}
+
+// Recherches aleatoires : 1er echantillon a l'horodatage ou apres,
+// parmi les echantillons [first, last] du modele
+static uint32_t SIM_CheckFind(uint32_t first, uint32_t last, uint32_t nbFind)
+{
+    S_flashLogCursor cursor;
+    S_flashLogSample sample;
+    uint32_t span = refMs[last] - refMs[first] + 1;
+    uint32_t errors = 0;
+    uint32_t target, expected, n;
+
+    for (n = 0; n < nbFind; n++)
+    {
+        target = refMs[first] + (uint32_t)(rand() % span);
+        for (expected = first; refMs[expected] < target; expected++)
+        {
+        }
+        if (!GFLG_Find(target, &cursor) || !GFLG_Read(&cursor, &sample)
+            || (SIM_SampleIndex(&sample) != expected))
+        {
+            if (errors < 5)
+            {
+                printf("  recherche %u ms : echantillon %u attendu\n", target, expected);
+            }
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Tours de zone : effacements repartis, relecture, recherche
+static bool SIM_PhaseLaps(uint32_t nbLaps, uint32_t nbFind)
+{
+    S_flashLogStats stats;
+    S_simNvmStats nvmStats;
+    uint32_t minErase = UINT32_MAX, maxErase = 0;
+    uint32_t first = 0, last = 0, errors = 0;
+    uint32_t nb, nbTarget, page;
+    bool ok;
+
+    SIM_NvmReset();
+    nbRef = 0;
+    SIM_Boot(0);
+    // Tours complets plus un tiers : la page courante est entamee
+    nbTarget = nbLaps * SIM_SAMPLES_LAP + SIM_SAMPLES_LAP / 3;
+    while (nbRef < nbTarget)
+    {
+        SIM_PushGroup();
+    }
+
+    GFLG_GetStats(&stats);
+    SIM_NvmGetStats(&nvmStats);
+    for (page = 0; page < GFLG_REGION_PAGES; page++)
+    {
+        if (SIM_NvmEraseCount(page) < minErase) minErase = SIM_NvmEraseCount(page);
+        if (SIM_NvmEraseCount(page) > maxErase) maxErase = SIM_NvmEraseCount(page);
+    }
+    nb = SIM_CheckReadBack(&first, &last, &errors);
+    errors += SIM_CheckFind(first, last, nbFind);
+
+    printf("Tours : %u echantillons, %u rangees, %u effacements (%u..%u par page)\n",
+           stats.nbSamples, stats.nbRows, stats.nbErases, minErase, maxErase);
+    printf("  relus %u (no %u a %u), %u recherches, %u erreurs\n", nb, first, last,
+           nbFind, errors);
+    printf("  NVM : %u reprogrammations, %u deverrouillages IT actives, %u erreurs\n",
+           nvmStats.nbReprograms, nvmStats.nbUnlockIntOn, stats.nbErrors);
+
+    // Les echantillons de la rangee en RAM ne sont pas encore relus
+    ok = (maxErase - minErase <= 1) && (errors == 0)
+         && (last + 1 == stats.nbRows * GFLG_SAMPLES_PER_ROW)
+         && (nb == last - first + 1) && (nb + GFLG_ROWS_PER_PAGE * GFLG_SAMPLES_PER_ROW
+                                          >= SIM_SAMPLES_LAP)
+         && (nvmStats.nbReprograms == 0) && (nvmStats.nbUnlockIntOn == 0)
+         && (stats.nbErrors == 0) && (stats.nbSkipped == 0);
+    return ok;
+}
+
+// Coupure pendant la failOp-ieme operation NVM, juste avant la fin du
+// 1er tour, puis redemarrage : les rangees completes restent, la
+// rangee coupee est sautee, une page coupee est effacee a nouveau,
+// l'horodatage reprend apres la derniere mesure conservee
+static bool SIM_PhasePowerFail(uint32_t failOp)
+{
+    S_flashLogStats stats;
+    S_simNvmStats nvmStats;
+    uint32_t first = 0, last = 0, errors = 0;
+    uint32_t durable, nbBefore, nb;
+    volatile uint32_t rowsDone = 0;
+
+    SIM_NvmReset();
+    nbRef = 0;
+    SIM_Boot(0);
+    while (nbRef < SIM_SAMPLES_LAP - 2 * GFLG_SAMPLES_PER_ROW)
+    {
+        SIM_PushGroup();
+    }
+
+    SIM_NvmPowerFailAt(failOp, SIM_PowerFail);
+    if (setjmp(powerFailJump) == 0)
+    {
+        for (;;)
+        {
+            // Au plus une rangee programmee par echantillon
+            GFLG_GetStats(&stats);
+            rowsDone = stats.nbRows;
+            SIM_PushGroup();
+        }
+    }
+
+    // Rangees programmees avant la coupure ; les echantillons suivants
+    // (rangee coupee, RAM) sont perdus et sortent du modele
+    nbBefore = nbRef;
+    durable = rowsDone * GFLG_SAMPLES_PER_ROW;
+    nbRef = durable;
+    SIM_Boot(refMs[durable - 1] + 1);
+    while (nbRef < durable + 3 * GFLG_SAMPLES_PER_ROW)
+    {
+        SIM_PushGroup();
+    }
+    GFLG_Flush();
+
+    GFLG_GetStats(&stats);
+    SIM_NvmGetStats(&nvmStats);
+    nb = SIM_CheckReadBack(&first, &last, &errors);
+    printf("Coupure a l'operation %2u : %u rangees conservees, %2u echantillons perdus, "
+           "%u rangee sautee, %u relus\n", failOp, rowsDone, nbBefore - durable,
+           stats.nbSkipped, nb);
+
+    // Au plus une page effacee et une rangee sautee de moins qu'un tour
+    return (errors == 0) && (last == nbRef - 1) && (nb == last - first + 1)
+           && (nb + (GFLG_ROWS_PER_PAGE + 1) * GFLG_SAMPLES_PER_ROW >= SIM_SAMPLES_LAP)
+           && (nvmStats.nbReprograms == 0) && (stats.nbErrors == 0);
+}
+
+// Debit : un tour de journal, puis une rangee programmee mot a mot
+static bool SIM_PhaseThroughput(uint32_t rowUs, uint32_t wordUs)
+{
+    S_flashLogStats stats;
+    S_simNvmStats nvmStats;
+    SYS_INT_PROCESSOR_STATUS intStatus;
+    uint32_t words[GFLG_ROW_SIZE / sizeof(uint32_t)];
+    uint32_t nbWords = GFLG_ROW_SIZE / sizeof(uint32_t);
+    uint32_t i;
+    double logS;
+
+    SIM_NvmReset();
+    nbRef = 0;
+    SIM_Boot(0);
+    while (nbRef < SIM_SAMPLES_LAP)
+    {
+        SIM_PushGroup();
+    }
+    GFLG_GetStats(&stats);
+    SIM_NvmGetStats(&nvmStats);
+    logS = (double)ticsSinceInit / SIM_CORE_HZ;
+    printf("Debit : %u rangees + %u pages pour %.1f h de mesures, CPU suspendu %.4f %%, "
+           "max. %.1f ms par ecriture\n", nvmStats.nbRowPrograms, nvmStats.nbPageErases,
+           logS / 3600.0, 100.0 * nvmStats.busyUs / 1e6 / logS,
+           stats.maxWriteTics * 1000.0 / SIM_CORE_HZ);
+
+    // Meme quantite mot a mot : une sequence de deverrouillage par mot
+    SIM_NvmReset();
+    memset(words, 0x5A, sizeof(words));
+    for (i = 0; i < nbWords; i++)
+    {
+        PLIB_NVM_MemoryOperationSelect(NVM_ID_0, WORD_PROGRAM_OPERATION);
+        PLIB_NVM_FlashAddressToModify(NVM_ID_0, KVA_TO_PA(&simNvmFlash[i * sizeof(uint32_t)]));
+        PLIB_NVM_FlashProvideData(NVM_ID_0, words[i]);
+        PLIB_NVM_MemoryModifyEnable(NVM_ID_0);
+        intStatus = SYS_INT_StatusGetAndDisable();
+        PLIB_NVM_FlashWriteKeySequence(NVM_ID_0, 0xAA996655);
+        PLIB_NVM_FlashWriteKeySequence(NVM_ID_0, 0x556699AA);
+        PLIB_NVM_FlashWriteStart(NVM_ID_0);
+        SYS_INT_StatusRestore(intStatus);
+        PLIB_NVM_MemoryModifyInhibit(NVM_ID_0);
+    }
+    SIM_NvmGetStats(&nvmStats);
+    printf("  %u octets par rangee : 1 deverrouillage, %u us ; par mots : %u deverrouillages, "
+           "%u us\n", GFLG_ROW_SIZE, rowUs, nvmStats.nbWordPrograms,
+           (uint32_t)nvmStats.busyUs);
+
+    return (nvmStats.nbWordPrograms == nbWords) && (nvmStats.busyUs == (uint64_t)nbWords * wordUs)
+           && (memcmp(simNvmFlash, words, sizeof(words)) == 0)
+           && (stats.nbRows * GFLG_SAMPLES_PER_ROW == stats.nbSamples);
+}
+
+// Endurance faible : les pages effacees une fois de trop donnent des
+// rangees fausses, detectees a la relecture apres programmation puis
+// rejetees par le CRC ; le reste de l'historique reste lisible
+static bool SIM_PhaseEndurance(void)
+{
+    S_flashLogStats stats;
+    S_simNvmStats nvmStats;
+    uint32_t first = 0, last = 0, errors = 0;
+    uint32_t nb;
+    double lapH = (double)SIM_SAMPLES_LAP * GFLG_DECIMATION / 10.0 / 3600.0;
+
+    SIM_NvmReset();
+    SIM_NvmSetEndurance(SIM_ENDURANCE_LOW);
+    nbRef = 0;
+    SIM_Boot(0);
+    while (nbRef < SIM_ENDURANCE_LOW * SIM_SAMPLES_LAP + SIM_SAMPLES_LAP / 2)
+    {
+        SIM_PushGroup();
+    }
+    SIM_NvmSetEndurance(0);
+
+    GFLG_GetStats(&stats);
+    SIM_NvmGetStats(&nvmStats);
+    nb = SIM_CheckReadBack(&first, &last, &errors);
+    printf("Endurance %u cycles : %u rangees sur pages usees, %u detectees, "
+           "%u echantillons relus, %u erreurs\n", SIM_ENDURANCE_LOW,
+           nvmStats.nbWornPrograms, stats.nbErrors, nb, errors);
+    printf("  a %u mesures par echantillon : 1 tour = %.1f h, 1000 cycles = %.1f ans\n",
+           GFLG_DECIMATION, lapH, 1000.0 * lapH / 24.0 / 365.0);
+
+    // Demi-zone usee : seule l'autre moitie (tour precedent) est relue
+    return (stats.nbErrors == nvmStats.nbWornPrograms) && (stats.nbErrors > 0)
+           && (errors == 0) && (nb == last - first + 1)
+           && (nb + (GFLG_ROWS_PER_PAGE + 1) * GFLG_SAMPLES_PER_ROW >= SIM_SAMPLES_LAP / 2);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t nbLaps = 3;
+    uint32_t nbFind = 2000;
+    uint32_t rowUs = SIM_NVM_ROW_US;
+    uint32_t wordUs = SIM_NVM_WORD_US;
+    uint32_t eraseUs = SIM_NVM_ERASE_US;
+    unsigned seed = 1;
+    bool ok = true;
+    uint32_t failOp;
+    int i;
+
+    for (i = 1; i < argc - 1; i++)
+    {
+        if (strcmp(argv[i], "-l") == 0)       nbLaps = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-n") == 0)  nbFind = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-s") == 0)  seed = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-R") == 0)  rowUs = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-W") == 0)  wordUs = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-E") == 0)  eraseUs = strtoul(argv[++i], NULL, 0);
+    }
+    srand(seed);
+    SIM_NvmSetTiming(rowUs, wordUs, eraseUs);
+
+    refMs = malloc((size_t)(nbLaps + SIM_ENDURANCE_LOW + 2) * SIM_SAMPLES_LAP * sizeof(uint32_t));
+    if (refMs == NULL)
+    {
+        return 1;
+    }
+
+    printf("Zone %u pages, %u rangees de %u echantillons, decimation %u\n",
+           GFLG_REGION_PAGES, GFLG_NB_ROWS, (uint32_t)GFLG_SAMPLES_PER_ROW, GFLG_DECIMATION);
+
+    ok &= SIM_PhaseLaps(nbLaps, nbFind);
+    // 2 rangees, effacement de la page 0, ses rangees, effacement de
+    // la page 1 et sa 1re rangee
+    for (failOp = 1; failOp <= GFLG_ROWS_PER_PAGE + 5; failOp++)
+    {
+        ok &= SIM_PhasePowerFail(failOp);
+    }
+    ok &= SIM_PhaseThroughput(rowUs, wordUs);
+    ok &= SIM_PhaseEndurance();
+
+    free(refMs);
+    printf("%s\n", ok ? "OK" : "ECHEC");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,283 @@
+/*--------------------------------------------------------*/
+// simNvm.c
+/*--------------------------------------------------------*/
+//	Description :	Flash programme et controleur NVM simules pour
+//			        executer gestFlashLog.c et gestCalib.c sur PC :
+//			        usure par page, duree des operations, coupure
+//			        d'alimentation.
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+//  Comme la flash PIC32 : l'effacement met la page a 0xFF, la
+//  programmation ne fait que passer des bits a 0 (ET logique). Une
+//  cellule deja programmee ne doit pas l'etre a nouveau, c'est compte.
+//  Au-dela de l'endurance, une page usee perd des bits programmes.
+//  Le CPU est suspendu pendant l'operation : le core timer avance de
+//  la duree de l'operation au lancement (FlashWriteStart).
+/*--------------------------------------------------------*/
+
+#include <string.h>
+#include "simNvm.h"
+
+#define SIM_CORE_TICS_US    (SYS_CLK_FREQ / 2000000)
+#define SIM_NVM_KEY1        0xAA996655
+#define SIM_NVM_KEY2        0x556699AA
+
+bool simIntGlobalEnabled = true;
+
+uint8_t simNvmFlash[GFLG_REGION_SIZE] __attribute__((aligned(GFLG_PAGE_SIZE)));
+uint8_t simNvmCalib[GCAL_PAGE_SIZE] __attribute__((aligned(GCAL_PAGE_SIZE)));
+
+static struct {
+    NVM_OPERATION_MODE operation;
+    bool wren;
+    uint8_t keyStep;            // 0, 1 apres KEY1, 2 apres KEY2
+    uintptr_t address;
+    uintptr_t source;
+    uint32_t data;
+    bool wrerr;
+} nvm;
+
+static uint32_t rowUs = SIM_NVM_ROW_US;
+static uint32_t wordUs = SIM_NVM_WORD_US;
+static uint32_t eraseUs = SIM_NVM_ERASE_US;
+static uint32_t endurance = 0;
+static uint32_t powerFailOp = 0;
+static SIM_NVM_POWER_FAIL powerFailHandler = NULL;
+static uint32_t eraseCount[GFLG_REGION_PAGES + 1];
+static S_simNvmStats stats;
+
+/*--------------------------------------------------------*/
+// Interruptions
+/*--------------------------------------------------------*/
+
+SYS_INT_PROCESSOR_STATUS SYS_INT_StatusGetAndDisable(void)
+{
+    SYS_INT_PROCESSOR_STATUS status = simIntGlobalEnabled ? 1 : 0;
+
+    simIntGlobalEnabled = false;
+    return status;
+}
+
+void SYS_INT_StatusRestore(SYS_INT_PROCESSOR_STATUS processorStatus)
+{
+    simIntGlobalEnabled = (processorStatus != 0);
+}
+
+/*--------------------------------------------------------*/
+// Controleur NVM
+/*--------------------------------------------------------*/
+
+void PLIB_NVM_MemoryOperationSelect(NVM_MODULE_ID index, NVM_OPERATION_MODE operationmode)
+{
+    (void)index;
+    nvm.operation = operationmode;
+}
+void PLIB_NVM_MemoryModifyEnable(NVM_MODULE_ID index)   { (void)index; nvm.wren = true; }
+void PLIB_NVM_MemoryModifyInhibit(NVM_MODULE_ID index)  { (void)index; nvm.wren = false; }
+void PLIB_NVM_FlashAddressToModify(NVM_MODULE_ID index, uintptr_t address)
+{
+    (void)index;
+    nvm.address = address;
+}
+void PLIB_NVM_DataBlockSourceAddress(NVM_MODULE_ID index, uintptr_t address)
+{
+    (void)index;
+    nvm.source = address;
+}
+void PLIB_NVM_FlashProvideData(NVM_MODULE_ID index, uint32_t data)
+{
+    (void)index;
+    nvm.data = data;
+}
+
+void PLIB_NVM_FlashWriteKeySequence(NVM_MODULE_ID index, uint32_t keysequence)
+{
+    (void)index;
+    if (simIntGlobalEnabled)
+    {
+        stats.nbUnlockIntOn++;
+    }
+    if ((nvm.keyStep == 0) && (keysequence == SIM_NVM_KEY1))
+    {
+        nvm.keyStep = 1;
+    }
+    else if ((nvm.keyStep == 1) && (keysequence == SIM_NVM_KEY2))
+    {
+        nvm.keyStep = 2;
+    }
+    else
+    {
+        nvm.keyStep = 0;
+    }
+}
+
+// Zone simulee contenant address (NULL : hors zones), numero de sa 1re page
+static uint8_t *SIM_NvmRegion(uintptr_t address, uint32_t *pFirstPage)
+{
+    if ((address >= (uintptr_t)simNvmFlash) && (address < (uintptr_t)simNvmFlash + GFLG_REGION_SIZE))
+    {
+        *pFirstPage = 0;
+        return simNvmFlash;
+    }
+    if ((address >= (uintptr_t)simNvmCalib) && (address < (uintptr_t)simNvmCalib + GCAL_PAGE_SIZE))
+    {
+        *pFirstPage = SIM_NVM_CALIB_PAGE;
+        return simNvmCalib;
+    }
+    return NULL;
+}
+
+// Programmation de len octets : ET logique, bits perdus sur page usee
+static void SIM_NvmProgram(uint8_t *pDst, uint32_t page, const uint8_t *pSrc, uint32_t len)
+{
+    bool worn = (endurance != 0) && (eraseCount[page] > endurance);
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (pDst[i] != 0xFF)
+        {
+            stats.nbReprograms++;
+            break;
+        }
+    }
+    for (i = 0; i < len; i++)
+    {
+        // Cellule usee : un octet sur 16 ne se programme plus
+        if (!worn || ((i % 16) != 7))
+        {
+            pDst[i] &= pSrc[i];
+        }
+    }
+    if (worn)
+    {
+        stats.nbWornPrograms++;
+    }
+}
+
+void PLIB_NVM_FlashWriteStart(NVM_MODULE_ID index)
+{
+    uint32_t firstPage = 0;
+    uint8_t *pRegion = SIM_NvmRegion(nvm.address, &firstPage);
+    uint32_t offset = (pRegion != NULL) ? (uint32_t)(nvm.address - (uintptr_t)pRegion) : 0;
+    uint32_t page = firstPage + offset / GFLG_PAGE_SIZE;
+    uint32_t len = 0;
+    uint32_t us = 0;
+    bool fail;
+
+    (void)index;
+    nvm.wrerr = (nvm.keyStep != 2) || !nvm.wren || (pRegion == NULL);
+    nvm.keyStep = 0;
+    if (!nvm.wrerr)
+    {
+        switch (nvm.operation)
+        {
+            case PAGE_ERASE_OPERATION:
+                nvm.wrerr = (offset % GFLG_PAGE_SIZE) != 0;
+                len = GFLG_PAGE_SIZE;
+                us = eraseUs;
+                break;
+            case ROW_PROGRAM_OPERATION:
+                nvm.wrerr = (offset % GFLG_ROW_SIZE) != 0;
+                len = GFLG_ROW_SIZE;
+                us = rowUs;
+                break;
+            case WORD_PROGRAM_OPERATION:
+                nvm.wrerr = (offset % sizeof(uint32_t)) != 0;
+                len = sizeof(uint32_t);
+                us = wordUs;
+                break;
+            default:
+                nvm.wrerr = true;
+                break;
+        }
+    }
+    if (nvm.wrerr)
+    {
+        stats.nbSequenceErrors++;
+        return;
+    }
+
+    // Coupure : seule la 1re moitie de l'operation est faite
+    fail = (powerFailOp != 0) && (--powerFailOp == 0);
+    if (fail)
+    {
+        len /= 2;
+    }
+
+    switch (nvm.operation)
+    {
+        case PAGE_ERASE_OPERATION:
+            memset(pRegion + offset, 0xFF, len);
+            eraseCount[page]++;
+            stats.nbPageErases++;
+            break;
+        case ROW_PROGRAM_OPERATION:
+            SIM_NvmProgram(pRegion + offset, page, (const uint8_t *)nvm.source, len);
+            stats.nbRowPrograms++;
+            break;
+        default:
+            SIM_NvmProgram(pRegion + offset, page, (const uint8_t *)&nvm.data, len);
+            stats.nbWordPrograms++;
+            break;
+    }
+    stats.busyUs += us;
+    simCoreCount += us * SIM_CORE_TICS_US;
+
+    if (fail && (powerFailHandler != NULL))
+    {
+        nvm.wren = false;
+        simIntGlobalEnabled = true;
+        powerFailHandler();
+    }
+}
+
+// Operation terminee au lancement (CPU suspendu pendant la duree)
+bool PLIB_NVM_FlashWriteCycleHasCompleted(NVM_MODULE_ID index)  { (void)index; return true; }
+bool PLIB_NVM_WriteOperationHasTerminated(NVM_MODULE_ID index)  { (void)index; return nvm.wrerr; }
+bool PLIB_NVM_LowVoltageHasOccurred(NVM_MODULE_ID index)        { (void)index; return false; }
+
+/*--------------------------------------------------------*/
+// Pilotage par le test
+/*--------------------------------------------------------*/
+
+void SIM_NvmReset(void)
+{
+    memset(simNvmFlash, 0xFF, sizeof(simNvmFlash));
+    memset(simNvmCalib, 0xFF, sizeof(simNvmCalib));
+    memset(eraseCount, 0, sizeof(eraseCount));
+    memset(&stats, 0, sizeof(stats));
+    memset(&nvm, 0, sizeof(nvm));
+    powerFailOp = 0;
+}
+
+void SIM_NvmSetTiming(uint32_t newRowUs, uint32_t newWordUs, uint32_t newEraseUs)
+{
+    rowUs = newRowUs;
+    wordUs = newWordUs;
+    eraseUs = newEraseUs;
+}
+
+void SIM_NvmSetEndurance(uint32_t cycles)
+{
+    endurance = cycles;
+}
+
+void SIM_NvmPowerFailAt(uint32_t nbOps, SIM_NVM_POWER_FAIL powerFail)
+{
+    powerFailOp = nbOps;
+    powerFailHandler = powerFail;
+}
+
+uint32_t SIM_NvmEraseCount(uint16_t page)
+{
+    return eraseCount[page];
+}
+
+void SIM_NvmGetStats(S_simNvmStats *pStats)
+{
+    *pStats = stats;
+}
@@ -0,0 +1,61 @@
+#ifndef SimNvm_H
+#define SimNvm_H
+/*--------------------------------------------------------*/
+// simNvm.h
+/*--------------------------------------------------------*/
+//	Description :	Flash programme et controleur NVM simules pour
+//			        executer gestFlashLog.c et gestCalib.c sur PC :
+//			        usure par page, duree des operations, coupure
+//			        d'alimentation.
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <xc.h>
+#include "system_config.h"
+#include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
+#include "system/int/sys_int.h"
+#include "peripheral/nvm/plib_nvm.h"
+#include "gestFlashLog.h"
+#include "gestCalib.h"
+
+// Durees par defaut (fiche technique : TRW, TWW, TPE)
+#define SIM_NVM_ROW_US          3000
+#define SIM_NVM_WORD_US         20
+#define SIM_NVM_ERASE_US        20000
+
+typedef struct {
+    uint32_t nbRowPrograms;
+    uint32_t nbWordPrograms;
+    uint32_t nbPageErases;
+    uint32_t nbReprograms;      // programmation sur cellules non effacees
+    uint32_t nbUnlockIntOn;     // deverrouillage interruptions actives
+    uint32_t nbSequenceErrors;  // cle, WREN ou alignement faux (WRERR)
+    uint32_t nbWornPrograms;    // programmations sur page usee (bits perdus)
+    uint64_t busyUs;            // CPU suspendu par les operations
+} S_simNvmStats;
+
+// Appelee a la coupure d'alimentation, ne revient pas (longjmp)
+typedef void (*SIM_NVM_POWER_FAIL)(void);
+
+extern uint8_t simNvmFlash[GFLG_REGION_SIZE];
+extern uint8_t simNvmCalib[GCAL_PAGE_SIZE];
+
+// Pages de SIM_NvmEraseCount : zone du journal, puis la page de calibration
+#define SIM_NVM_CALIB_PAGE      GFLG_REGION_PAGES
+
+void SIM_NvmReset(void);                // flash effacee, compteurs a 0
+void SIM_NvmSetTiming(uint32_t rowUs, uint32_t wordUs, uint32_t eraseUs);
+void SIM_NvmSetEndurance(uint32_t cycles);  // 0 = illimitee
+// Coupure au milieu de la nbOps-ieme operation a venir (0 = aucune)
+void SIM_NvmPowerFailAt(uint32_t nbOps, SIM_NVM_POWER_FAIL powerFail);
+uint32_t SIM_NvmEraseCount(uint16_t page);
+void SIM_NvmGetStats(S_simNvmStats *pStats);
+
+#endif
@@ -0,0 +1,242 @@
+/*--------------------------------------------------------*/
+// simPlib.c
+/*--------------------------------------------------------*/
+//	Description :	UART, DMA, INT, timer et OC simules pour
+//			        executer gestTelemetry.c et gestDds.c sur PC
+//			        (horloge : simClock.c).
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <string.h>
+#include "simPlib.h"
+#include "gestTelemetry.h"
+
+SIM_USART_REGS simUsart[USART_NUMBER_OF_MODULES];
+SIM_DMA_REGS simDma[DMA_NUMBER_OF_CHANNELS];
+uint8_t simIntEnabled[INT_SOURCE_NUMBER];
+uint8_t simIntFlag[INT_SOURCE_NUMBER];
+SIM_TMR_REGS simTmr[TMR_NUMBER_OF_MODULES];
+SIM_OC_REGS simOc[OC_NUMBER_OF_MODULES];
+volatile uint32_t simOcRs[OC_NUMBER_OF_MODULES];
+
+// Source d'interruption et declenchement DMA de chaque timer
+static const INT_SOURCE simTmrIntSource[TMR_NUMBER_OF_MODULES] = { INT_SOURCE_TIMER_2 };
+static const DMA_TRIGGER_SOURCE simTmrTrigger[TMR_NUMBER_OF_MODULES] = { DMA_TRIGGER_TIMER_2 };
+
+/*--------------------------------------------------------*/
+// Interruptions
+/*--------------------------------------------------------*/
+
+void PLIB_INT_VectorPrioritySet(INT_MODULE_ID index, INT_VECTOR vector, INT_PRIORITY_LEVEL priority)
+{
+    (void)index; (void)vector; (void)priority;
+}
+void PLIB_INT_VectorSubPrioritySet(INT_MODULE_ID index, INT_VECTOR vector, INT_SUBPRIORITY_LEVEL subPriority)
+{
+    (void)index; (void)vector; (void)subPriority;
+}
+void PLIB_INT_SourceFlagClear(INT_MODULE_ID index, INT_SOURCE source) { (void)index; simIntFlag[source] = 0; }
+void PLIB_INT_SourceEnable(INT_MODULE_ID index, INT_SOURCE source)    { (void)index; simIntEnabled[source] = 1; }
+void PLIB_INT_SourceDisable(INT_MODULE_ID index, INT_SOURCE source)   { (void)index; simIntEnabled[source] = 0; }
+
+/*--------------------------------------------------------*/
+// UART
+/*--------------------------------------------------------*/
+
+void PLIB_USART_BaudRateSet(USART_MODULE_ID index, uint32_t clockFrequency, uint32_t baudRate)
+{
+    (void)clockFrequency;
+    simUsart[index].baud = baudRate;
+}
+void PLIB_USART_LineControlModeSelect(USART_MODULE_ID index, USART_LINECONTROL_MODE dataFlowConfig)
+{
+    (void)index; (void)dataFlowConfig;
+}
+void PLIB_USART_TransmitterInterruptModeSelect(USART_MODULE_ID index, USART_TRANSMIT_INTR_MODE fifolevel)
+{
+    (void)index; (void)fifolevel;
+}
+void PLIB_USART_TransmitterEnable(USART_MODULE_ID index)    { simUsart[index].txEnabled = 1; }
+void PLIB_USART_Enable(USART_MODULE_ID index)               { (void)index; }
+void *PLIB_USART_TransmitterAddressGet(USART_MODULE_ID index)
+{
+    return (void *)&simUsart[index].txReg;
+}
+
+/*--------------------------------------------------------*/
+// DMA
+/*--------------------------------------------------------*/
+
+void PLIB_DMA_Enable(DMA_MODULE_ID index) { (void)index; }
+void PLIB_DMA_ChannelXPrioritySelect(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_CHANNEL_PRIORITY priority)
+{
+    (void)index; (void)channel; (void)priority;
+}
+void PLIB_DMA_ChannelXStartIRQSet(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_TRIGGER_SOURCE IRQnum)
+{
+    (void)index;
+    simDma[channel].trigger = IRQnum;
+}
+void PLIB_DMA_ChannelXTriggerEnable(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_CHANNEL_TRIGGER_TYPE trigger)
+{
+    (void)index; (void)channel; (void)trigger;
+}
+void PLIB_DMA_ChannelXSourceStartAddressSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uintptr_t sourceStartAddress)
+{
+    (void)index;
+    simDma[channel].srcAddr = sourceStartAddress;
+}
+void PLIB_DMA_ChannelXDestinationStartAddressSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uintptr_t destinationStartAddress)
+{
+    (void)index;
+    simDma[channel].dstAddr = destinationStartAddress;
+}
+void PLIB_DMA_ChannelXSourceSizeSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uint16_t sourceSize)
+{
+    (void)index;
+    simDma[channel].srcSize = sourceSize;
+}
+void PLIB_DMA_ChannelXDestinationSizeSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uint16_t destinationSize)
+{
+    (void)index; (void)channel; (void)destinationSize;
+}
+void PLIB_DMA_ChannelXCellSizeSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uint16_t CellSize)
+{
+    (void)index;
+    simDma[channel].cellSize = CellSize;
+}
+void PLIB_DMA_ChannelXINTSourceFlagClear(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_INT_TYPE dmaINTSource)
+{
+    (void)index;
+    simDma[channel].intFlags &= ~dmaINTSource;
+}
+void PLIB_DMA_ChannelXINTSourceEnable(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_INT_TYPE dmaINTSource)
+{
+    (void)index;
+    simDma[channel].intEnabled |= dmaINTSource;
+}
+bool PLIB_DMA_ChannelXINTSourceFlagGet(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_INT_TYPE dmaINTSource)
+{
+    (void)index;
+    return (simDma[channel].intFlags & dmaINTSource) != 0;
+}
+void PLIB_DMA_ChannelXAutoEnable(DMA_MODULE_ID index, DMA_CHANNEL channel)
+{
+    (void)index;
+    simDma[channel].autoEnable = 1;
+}
+void PLIB_DMA_ChannelXEnable(DMA_MODULE_ID index, DMA_CHANNEL channel)
+{
+    (void)index;
+    simDma[channel].enabled = 1;
+    simDma[channel].srcPtr = 0;
+}
+void PLIB_DMA_ChannelXDisable(DMA_MODULE_ID index, DMA_CHANNEL channel)
+{
+    (void)index;
+    simDma[channel].enabled = 0;
+}
+void PLIB_DMA_StartTransferSet(DMA_MODULE_ID index, DMA_CHANNEL channel)
+{
+    (void)index; (void)channel;
+}
+void PLIB_DMA_AbortTransferSet(DMA_MODULE_ID index, DMA_CHANNEL channel)
+{
+    (void)index;
+    simDma[channel].enabled = 0;
+    simDma[channel].srcPtr = 0;
+}
+
+// Canal 0 vers l'UART 1 : un octet par evenement TX, l'UART
+// acceptant maxBytes octets sur la duree du pas
+uint32_t SIM_UartTransmit(uint32_t maxBytes, uint8_t *pOut)
+{
+    SIM_DMA_REGS *pCh = &simDma[DMA_CHANNEL_0];
+    uint32_t nb = 0;
+
+    while ((nb < maxBytes) && pCh->enabled && simUsart[USART_ID_1].txEnabled)
+    {
+        pOut[nb++] = ((const uint8_t *)pCh->srcAddr)[pCh->srcPtr++];
+
+        if (pCh->srcPtr >= pCh->srcSize)
+        {
+            // Fin de bloc : canal desactive, flag et interruption
+            pCh->enabled = 0;
+            pCh->intFlags |= DMA_INT_BLOCK_TRANSFER_COMPLETE;
+            if (pCh->intEnabled & DMA_INT_BLOCK_TRANSFER_COMPLETE)
+            {
+                simIntFlag[INT_SOURCE_DMA_0] = 1;
+            }
+        }
+        // ISR DMA (IntHandlerTelemetryDma) si la source est active
+        if (simIntFlag[INT_SOURCE_DMA_0] && simIntEnabled[INT_SOURCE_DMA_0])
+        {
+            GTLM_DmaCallback();
+            PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_DMA_0);
+        }
+    }
+    return nb;
+}
+
+/*--------------------------------------------------------*/
+// Timer et OC
+/*--------------------------------------------------------*/
+
+void PLIB_TMR_ClockSourceSelect(TMR_MODULE_ID index, TMR_CLOCK_SOURCE source) { (void)index; (void)source; }
+void PLIB_TMR_PrescaleSelect(TMR_MODULE_ID index, TMR_PRESCALE prescale)       { (void)index; (void)prescale; }
+void PLIB_TMR_Mode16BitEnable(TMR_MODULE_ID index)                             { (void)index; }
+void PLIB_TMR_Counter16BitClear(TMR_MODULE_ID index)                           { (void)index; }
+void PLIB_TMR_Period16BitSet(TMR_MODULE_ID index, uint16_t period)             { simTmr[index].period = period; }
+void PLIB_TMR_Start(TMR_MODULE_ID index)                                       { simTmr[index].running = 1; }
+void PLIB_TMR_Stop(TMR_MODULE_ID index)                                        { simTmr[index].running = 0; }
+
+void PLIB_OC_ModeSelect(OC_MODULE_ID index, OC_COMPARE_MODES cmpMode)    { simOc[index].mode = cmpMode; }
+void PLIB_OC_BufferSizeSelect(OC_MODULE_ID index, OC_BUFFER_SIZE size)   { (void)index; (void)size; }
+void PLIB_OC_TimerSelect(OC_MODULE_ID index, OC_16BIT_TIMERS tmr)        { (void)index; (void)tmr; }
+void PLIB_OC_Buffer16BitSet(OC_MODULE_ID index, uint16_t val16Bit)       { simOc[index].r = val16Bit; }
+void PLIB_OC_PulseWidth16BitSet(OC_MODULE_ID index, uint16_t pulseWidth) { simOcRs[index] = pulseWidth; }
+void PLIB_OC_Enable(OC_MODULE_ID index)                                  { simOc[index].enabled = 1; }
+void PLIB_OC_Disable(OC_MODULE_ID index)                                 { simOc[index].enabled = 0; }
+
+void SIM_TimerPeriod(TMR_MODULE_ID index)
+{
+    SIM_DMA_REGS *pCh;
+    uint8_t ch;
+
+    if (!simTmr[index].running)
+    {
+        return;
+    }
+    // Le DMA voit chaque evenement, meme si le flag reste a 1
+    simIntFlag[simTmrIntSource[index]] = 1;
+
+    for (ch = 0; ch < DMA_NUMBER_OF_CHANNELS; ch++)
+    {
+        pCh = &simDma[ch];
+        if (!pCh->enabled || (pCh->trigger != simTmrTrigger[index]))
+        {
+            continue;
+        }
+        memcpy((void *)pCh->dstAddr, (const uint8_t *)pCh->srcAddr + pCh->srcPtr, pCh->cellSize);
+        pCh->srcPtr += pCh->cellSize;
+        if (pCh->srcPtr == pCh->srcSize / 2)
+        {
+            pCh->intFlags |= DMA_INT_SOURCE_HALF_EMPTY;
+        }
+        if (pCh->srcPtr >= pCh->srcSize)
+        {
+            // Fin de bloc : repart au debut en mode auto
+            pCh->intFlags |= DMA_INT_SOURCE_DONE | DMA_INT_BLOCK_TRANSFER_COMPLETE;
+            pCh->srcPtr = 0;
+            pCh->enabled = pCh->autoEnable;
+        }
+        if (pCh->intFlags & pCh->intEnabled)
+        {
+            simIntFlag[INT_SOURCE_DMA_0 + ch] = 1;
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef SimPlib_H
+#define SimPlib_H
+/*--------------------------------------------------------*/
+// simPlib.h
+/*--------------------------------------------------------*/
+//	Description :	UART, DMA, INT, timer et OC simules pour
+//			        executer gestTelemetry.c et gestDds.c sur PC
+//			        (horloge : simClock.c).
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <xc.h>
+#include "system_config.h"
+#include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
+#include "peripheral/usart/plib_usart.h"
+#include "peripheral/dma/plib_dma.h"
+#include "peripheral/int/plib_int.h"
+#include "peripheral/tmr/plib_tmr.h"
+#include "peripheral/oc/plib_oc.h"
+
+// Emission UART : au plus maxBytes octets pris par le DMA, copies
+// dans pOut. Appelle l'ISR DMA en fin de bloc. Retourne le nombre
+// d'octets emis.
+uint32_t SIM_UartTransmit(uint32_t maxBytes, uint8_t *pOut);
+
+// Fin d'une periode du timer (timer en marche) : flag du timer, une
+// cellule transferee par les canaux DMA declenches par ce timer,
+// flags du canal (demi-source, fin de source). Les ISR sont appelees
+// par le simulateur d'apres simIntFlag / simIntEnabled.
+void SIM_TimerPeriod(TMR_MODULE_ID index);
+
+#endif
@@ -0,0 +1,606 @@
+/*--------------------------------------------------------*/
+// simReplay.c
+/*--------------------------------------------------------*/
+//	Description :	Rejoue sur PC des mesures ADC enregistrees sur
+//			        la carte dans l'application complete du TP0
+//			        (app.c, telemetrie, journal en flash).
+//
+//	Utilisation :	simReplay [-t s] [-o sorties.csv] enreg.csv
+//			        simReplay -g enreg.csv [-t s] [-s graine]
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+//  Enregistrement : la telemetrie envoie chaque BSP_ReadAllADC
+//  horodate, tlmDecode -c l'ecrit en CSV (stampUs,Chan0,Chan1) :
+//      tlmDecode -b 115200 -c /dev/ttyUSB0 > enreg.csv
+//  -g ecrit un enregistrement synthetique du meme format.
+//
+//  Rejeu : BSP_ReadAllADC rend la mesure enregistree a l'instant
+//  simule depuis DRV_TMR0_Start (echantillon bloque, horodatages
+//  ramenes au premier). Timer1, UART, DMA, NVM et LCD sont cadences
+//  par le core timer simule : le meme enregistrement donne toujours
+//  les memes sorties. Les empreintes (LCD, LEDs, telemetrie, flash)
+//  sont a comparer avant / apres une modification du filtrage, de
+//  l'affichage ou du sequencement ; -o ecrit l'etat apres chaque
+//  service pour trouver la premiere difference.
+//
+//  La telemetrie emise est decodee et comparee aux mesures lues, les
+//  statistiques (gestStats.c) comptent toutes les lectures. Le
+//  temps PC de chaque service APP_Tasks est mesure (benchmark).
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "simPlib.h"
+#include "simNvm.h"
+#include "app.h"
+#include "Mc32DriverLcd.h"
+#include "gestTelemetry.h"
+#include "gestFlashLog.h"
+#include "gestStats.h"
+
+#define SIM_TICS_US         (SYS_CLK_FREQ / 2000000)
+
+// Sequencement (us), ordres de grandeur de la carte
+#define SIM_TMR1_PERIOD_US  100000
+#define SIM_LOOP_US         5           // passage de SYS_Tasks
+#define SIM_ADC_US          25          // BSP_ReadAllADC
+#define SIM_LCD_INIT_US     50000
+#define SIM_LCD_CHAR_US     45          // commande ou caractere
+
+#define SIM_REC_PERIOD_US   100000      // enregistrement synthetique
+#define SIM_REC_MAX         (1u << 20)
+#define SIM_FLUSH_US        200000      // vidage de la telemetrie a la fin
+
+#define SIM_FNV_BASIS       0x811C9DC5u
+#define SIM_FNV_PRIME       0x01000193u
+
+typedef struct {
+    uint64_t tUs;           // depuis le premier echantillon
+    S_ADCResults adc;
+} S_simRecord;
+
+// Empreintes FNV-1a des sorties
+typedef struct {
+    uint32_t lcd;
+    uint32_t leds;
+    uint32_t telemetry;
+    uint32_t flash;
+} S_simDigests;
+
+/*--------------------------------------------------------*/
+// Etat de la simulation
+/*--------------------------------------------------------*/
+
+volatile uint32_t simLatClr[2];
+uint16_t simPort[PORT_NUMBER_OF_CHANNELS];
+char simLcd[SIM_LCD_LINES][SIM_LCD_COLUMNS + 1];
+
+extern APP_DATA appData;            // app.c
+
+static S_simRecord *rec;
+static uint32_t nbRec;
+static uint32_t recPos;
+
+static uint64_t nowTics;
+static uint32_t lastCount;
+static bool tmrRunning;
+static uint64_t tmrStartTics;
+static uint64_t nextTmr1;
+static uint64_t uartStartTics;
+static uint64_t uartSlots;
+
+static uint8_t lcdX = 1, lcdY = 1;
+static S_simDigests digests = { SIM_FNV_BASIS, SIM_FNV_BASIS, SIM_FNV_BASIS, SIM_FNV_BASIS };
+
+// Mesures rendues par BSP_ReadAllADC, comparees a la telemetrie
+static S_ADCResults *reads;
+static uint32_t nbReads;
+static uint32_t readsSize;
+static uint32_t nbTlmSamples;
+static uint32_t nbTlmMismatch;
+static uint32_t nbTlmErrors;
+static uint8_t tlmCobs[GTLM_TX_SIZE];
+static uint16_t tlmCobsLen;
+
+static SYS_WDM_TASK_ID wdmTasks;
+static uint32_t wdmMaxPeriodMs;
+static uint64_t wdmLastTics;
+static uint64_t wdmMaxTics;
+static uint32_t wdmNbLate;
+static uint64_t bootTics[SYS_BOOT_STAGE_NB];
+static uint32_t bootValid;
+
+static uint32_t SIM_Fnv(uint32_t hash, const void *pData, size_t len)
+{
+    const uint8_t *p = pData;
+
+    while (len--)
+    {
+        hash = (hash ^ *p++) * SIM_FNV_PRIME;
+    }
+    return hash;
+}
+
+/*--------------------------------------------------------*/
+// Temps simule
+/*--------------------------------------------------------*/
+
+// Rattrape le core timer avance hors de SIM_Advance (NVM)
+static void SIM_Sync(void)
+{
+    nowTics += (uint32_t)(simCoreCount - lastCount);
+    lastCount = simCoreCount;
+}
+
+static void SIM_SetNow(uint64_t tics)
+{
+    nowTics = tics;
+    simCoreCount = (uint32_t)tics;
+    lastCount = simCoreCount;
+}
+
+static void SIM_TlmByte(uint8_t byte)
+{
+    uint8_t raw[GTLM_RAW_SIZE];
+    uint16_t chan[TFRM_MAX_CHAN];
+    S_tfrmHeader header;
+    S_tfrmReader reader;
+    uint32_t stampUs;
+    uint16_t rawLen;
+
+    if (byte != 0)
+    {
+        if (tlmCobsLen < sizeof(tlmCobs))
+        {
+            tlmCobs[tlmCobsLen++] = byte;
+        }
+        return;
+    }
+    rawLen = TFRM_CobsDecode(tlmCobs, tlmCobsLen, raw);
+    tlmCobsLen = 0;
+    if ((rawLen == 0) || !TFRM_Open(&reader, &header, raw, rawLen))
+    {
+        nbTlmErrors++;
+        return;
+    }
+    while (TFRM_Next(&reader, &stampUs, chan))
+    {
+        if ((nbTlmSamples >= nbReads) || (chan[0] != reads[nbTlmSamples].Chan0)
+            || (chan[1] != reads[nbTlmSamples].Chan1))
+        {
+            nbTlmMismatch++;
+        }
+        nbTlmSamples++;
+    }
+}
+
+// Octets emis par l'UART jusqu'a untilTics (10 bits par octet). Les
+// creneaux sans donnee du DMA sont perdus, comme sur la ligne.
+static void SIM_Uart(uint64_t untilTics)
+{
+    uint8_t buf[4096];
+    uint64_t slots = (untilTics - uartStartTics) * GTLM_BAUDRATE / (10ull * SIM_TICS_US * 1000000u);
+    uint32_t n = (uint32_t)(slots - uartSlots);
+    uint32_t nb, i;
+
+    uartSlots = slots;
+    while (n > 0)
+    {
+        nb = SIM_UartTransmit((n < sizeof(buf)) ? n : sizeof(buf), buf);
+        digests.telemetry = SIM_Fnv(digests.telemetry, buf, nb);
+        for (i = 0; i < nb; i++)
+        {
+            SIM_TlmByte(buf[i]);
+        }
+        if (nb == 0)
+        {
+            break;
+        }
+        n -= nb;
+    }
+}
+
+// Avance de us, avec les ISR Timer1 dues pendant ce temps
+static void SIM_Advance(uint32_t us)
+{
+    uint64_t end;
+
+    SIM_Sync();
+    end = nowTics + (uint64_t)us * SIM_TICS_US;
+    while (tmrRunning && (nextTmr1 <= end))
+    {
+        SIM_Uart(nextTmr1);
+        SIM_SetNow(nextTmr1);
+        App_Timer1Callback();
+        nextTmr1 += SIM_TMR1_PERIOD_US * SIM_TICS_US;
+    }
+    SIM_Uart(end);
+    SIM_SetNow(end);
+}
+
+/*--------------------------------------------------------*/
+// Carte simulee
+/*--------------------------------------------------------*/
+
+void BSP_InitADC10(void) { }
+
+// Echantillon enregistre a l'instant simule depuis DRV_TMR0_Start
+S_ADCResults BSP_ReadAllADC(void)
+{
+    uint64_t tUs;
+
+    SIM_Advance(SIM_ADC_US);
+    tUs = (nowTics - tmrStartTics) / SIM_TICS_US;
+    while ((recPos + 1 < nbRec) && (rec[recPos + 1].tUs <= tUs))
+    {
+        recPos++;
+    }
+    if (nbReads == readsSize)
+    {
+        readsSize = (readsSize != 0) ? 2 * readsSize : 1024;
+        reads = realloc(reads, readsSize * sizeof(S_ADCResults));
+    }
+    reads[nbReads++] = rec[recPos].adc;
+    return rec[recPos].adc;
+}
+
+void DRV_TMR0_Start(void)
+{
+    SIM_Sync();
+    tmrRunning = true;
+    tmrStartTics = nowTics;
+    nextTmr1 = nowTics + SIM_TMR1_PERIOD_US * SIM_TICS_US;
+}
+
+PORTS_DATA_TYPE PLIB_PORTS_Read(PORTS_MODULE_ID index, PORTS_CHANNEL channel)
+{
+    (void)index;
+    return simPort[channel];
+}
+
+void PLIB_PORTS_Write(PORTS_MODULE_ID index, PORTS_CHANNEL channel, PORTS_DATA_TYPE value)
+{
+    (void)index;
+    simPort[channel] = (uint16_t)value;
+}
+
+// Ecritures LATxCLR faites par APP_Tasks
+static void SIM_PortsUpdate(void)
+{
+    simPort[PORT_CHANNEL_A] &= ~simLatClr[0];
+    simPort[PORT_CHANNEL_B] &= ~simLatClr[1];
+    simLatClr[0] = 0;
+    simLatClr[1] = 0;
+}
+
+void lcd_init(void)
+{
+    memset(simLcd, ' ', sizeof(simLcd));
+    for (lcdY = 0; lcdY < SIM_LCD_LINES; lcdY++)
+    {
+        simLcd[lcdY][SIM_LCD_COLUMNS] = '\0';
+    }
+    lcdX = 1;
+    lcdY = 1;
+    SIM_Advance(SIM_LCD_INIT_US);
+}
+
+void lcd_bl_on(void) { }
+
+void lcd_gotoxy(uint8_t x, uint8_t y)
+{
+    lcdX = x;
+    lcdY = y;
+    SIM_Advance(SIM_LCD_CHAR_US);
+}
+
+void printf_lcd(const char *fmt, ...)
+{
+    char text[64];
+    va_list args;
+    int len, i;
+
+    va_start(args, fmt);
+    len = vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    if (len > (int)sizeof(text) - 1)
+    {
+        len = sizeof(text) - 1;
+    }
+
+    digests.lcd = SIM_Fnv(digests.lcd, &lcdX, 1);
+    digests.lcd = SIM_Fnv(digests.lcd, &lcdY, 1);
+    digests.lcd = SIM_Fnv(digests.lcd, text, len);
+    for (i = 0; i < len; i++)
+    {
+        if ((lcdY >= 1) && (lcdY <= SIM_LCD_LINES) && (lcdX >= 1) && (lcdX <= SIM_LCD_COLUMNS))
+        {
+            simLcd[lcdY - 1][lcdX - 1] = text[i];
+        }
+        lcdX++;
+    }
+    SIM_Advance(len * SIM_LCD_CHAR_US);
+}
+
+/*--------------------------------------------------------*/
+// Services systeme
+/*--------------------------------------------------------*/
+
+bool SYS_EXCEP_CrashRecordGet(SYS_CRASH_RECORD *pRecord)   { (void)pRecord; return false; }
+bool SYS_WDM_ResetRecordGet(SYS_WDM_RECORD *pRecord)       { (void)pRecord; return false; }
+
+SYS_WDM_TASK_ID SYS_WDM_TaskRegister(uint32_t maxPeriodMs)
+{
+    SIM_Sync();
+    wdmMaxPeriodMs = maxPeriodMs;
+    wdmLastTics = nowTics;
+    return ++wdmTasks;
+}
+
+// Periode entre deux check-in, en temps simule
+void SYS_WDM_CheckIn(SYS_WDM_TASK_ID taskId)
+{
+    uint64_t period;
+
+    (void)taskId;
+    SIM_Sync();
+    period = nowTics - wdmLastTics;
+    wdmLastTics = nowTics;
+    if (period > wdmMaxTics)
+    {
+        wdmMaxTics = period;
+    }
+    if (period > (uint64_t)wdmMaxPeriodMs * 1000u * SIM_TICS_US)
+    {
+        wdmNbLate++;
+    }
+}
+
+void SYS_BOOT_StageMark(SYS_BOOT_STAGE stage)
+{
+    SIM_Sync();
+    if ((bootValid & (1ul << stage)) == 0)
+    {
+        bootTics[stage] = nowTics;
+        bootValid |= (1ul << stage);
+    }
+}
+
+// Temps depuis le debut du rejeu (SYS_Initialize n'est pas simule)
+void SYS_BOOT_ReportGet(SYS_BOOT_REPORT *pReport)
+{
+    uint8_t i;
+
+    pReport->entryTicks = 0;
+    pReport->validMask = bootValid;
+    for (i = 0; i < SYS_BOOT_STAGE_NB; i++)
+    {
+        pReport->stageTicks[i] = ((bootValid & (1ul << i)) != 0) ? (uint32_t)bootTics[i] : 0;
+    }
+}
+
+/*--------------------------------------------------------*/
+// Enregistrements
+/*--------------------------------------------------------*/
+
+// CSV de tlmDecode -c ; les lignes illisibles sont ignorees,
+// l'horodatage 32 bits est deroule
+static bool SIM_LoadRecording(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[128];
+    unsigned stamp, chan0, chan1;
+    uint32_t prevStamp = 0;
+    uint64_t tUs = 0;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return false;
+    }
+    rec = malloc(SIM_REC_MAX * sizeof(S_simRecord));
+    while ((nbRec < SIM_REC_MAX) && (fgets(line, sizeof(line), f) != NULL))
+    {
+        if (sscanf(line, "%u,%u,%u", &stamp, &chan0, &chan1) != 3)
+        {
+            continue;
+        }
+        if (nbRec > 0)
+        {
+            tUs += (uint32_t)(stamp - prevStamp);
+        }
+        prevStamp = stamp;
+        rec[nbRec].tUs = tUs;
+        rec[nbRec].adc.Chan0 = (uint16_t)chan0;
+        rec[nbRec].adc.Chan1 = (uint16_t)chan1;
+        nbRec++;
+    }
+    fclose(f);
+    if (nbRec == 0)
+    {
+        fprintf(stderr, "%s : aucune mesure\n", path);
+        return false;
+    }
+    return true;
+}
+
+// Potentiometre tourne lentement avec du bruit, rampe sur Chan1 ;
+// horodatage proche du rebouclage, gigue de quelques us
+static bool SIM_GenerateRecording(const char *path, uint32_t durationS)
+{
+    FILE *f = fopen(path, "w");
+    uint32_t stamp = 0xFFFFFFFFu - 5000000u;
+    uint32_t i, n = durationS * (1000000u / SIM_REC_PERIOD_US);
+    double pot;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return false;
+    }
+    for (i = 0; i < n; i++)
+    {
+        pot = 511.5 + 500.0 * sin(2.0 * M_PI * i / 200.0) + (rand() % 9) - 4;
+        fprintf(f, "%u,%u,%u\n", stamp, (unsigned)lround(pot), (i * 7) % 1024);
+        stamp += SIM_REC_PERIOD_US + (uint32_t)(rand() % 5);
+    }
+    fclose(f);
+    printf("%u mesures sur %u s -> %s\n", n, durationS, path);
+    return true;
+}
+
+/*--------------------------------------------------------*/
+// Rejeu
+/*--------------------------------------------------------*/
+
+static uint64_t SIM_HostNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *outPath = NULL;
+    const char *genPath = NULL;
+    const char *recPath = NULL;
+    uint32_t durationS = 0;
+    unsigned seed = 1;
+    uint64_t endTics, serviceTics, serviceMaxTics = 0, serviceSumTics = 0;
+    uint64_t hostNs, hostSumNs = 0, hostMaxNs = 0;
+    uint32_t nbServices = 0;
+    S_telemetryStats tlmStats;
+    S_flashLogStats flgStats;
+    S_statsSnapshot chan0Stats = { 0 };
+    APP_STATES state;
+    uint16_t leds[2];
+    FILE *out = NULL;
+    bool ok, statsOk;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))       durationS = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc))  seed = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))  outPath = argv[++i];
+        else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc))  genPath = argv[++i];
+        else                                                      recPath = argv[i];
+    }
+    if (genPath != NULL)
+    {
+        srand(seed);
+        return SIM_GenerateRecording(genPath, (durationS != 0) ? durationS : 60) ? 0 : 1;
+    }
+    if ((recPath == NULL) || !SIM_LoadRecording(recPath))
+    {
+        fprintf(stderr, "utilisation : simReplay [-t s] [-o sorties.csv] enreg.csv\n"
+                        "              simReplay -g enreg.csv [-t s] [-s graine]\n");
+        return 1;
+    }
+    if ((outPath != NULL) && ((out = fopen(outPath, "w")) == NULL))
+    {
+        perror(outPath);
+        return 1;
+    }
+
+    // Carte a la sortie de SYS_Initialize : LEDs eteintes (actives bas),
+    // flash effacee, UART libre
+    SIM_NvmReset();
+    simPort[PORT_CHANNEL_A] = LEDS_PORTA_MASK;
+    simPort[PORT_CHANNEL_B] = LEDS_PORTB_MASK;
+    SIM_SetNow(0);
+    uartStartTics = 0;
+    APP_Initialize();
+
+    // Tout l'enregistrement, ou la duree demandee
+    endTics = (durationS != 0) ? (uint64_t)durationS * 1000000u * SIM_TICS_US
+                               : (rec[nbRec - 1].tUs + SIM_REC_PERIOD_US) * SIM_TICS_US;
+    while (!tmrRunning || (nowTics - tmrStartTics < endTics))
+    {
+        state = appData.state;
+        if ((state == APP_STATE_SERVICE_ADC) || (state == APP_STATE_SERVICE_TASKS))
+        {
+            SIM_Sync();
+            serviceTics = nowTics;
+            hostNs = SIM_HostNs();
+            APP_Tasks();
+            hostNs = SIM_HostNs() - hostNs;
+            SIM_Sync();
+            serviceTics = nowTics - serviceTics;
+            SIM_PortsUpdate();
+
+            nbServices++;
+            serviceSumTics += serviceTics;
+            hostSumNs += hostNs;
+            if (serviceTics > serviceMaxTics) serviceMaxTics = serviceTics;
+            if (hostNs > hostMaxNs)           hostMaxNs = hostNs;
+
+            leds[0] = simPort[PORT_CHANNEL_A] & LEDS_PORTA_MASK;
+            leds[1] = simPort[PORT_CHANNEL_B] & LEDS_PORTB_MASK;
+            digests.leds = SIM_Fnv(digests.leds, leds, sizeof(leds));
+            if (out != NULL)
+            {
+                fprintf(out, "%llu,%u,%u,%u,%04X,%04X,%s\n",
+                        (unsigned long long)((nowTics - tmrStartTics) / SIM_TICS_US), state,
+                        appData.AdcRes.Chan0, appData.AdcRes.Chan1, leds[0], leds[1], simLcd[2]);
+            }
+        }
+        else
+        {
+            APP_Tasks();
+            SIM_PortsUpdate();
+        }
+        SIM_Advance(SIM_LOOP_US);
+    }
+
+    // Trames et rangee en cours, puis vidage de l'UART
+    GTLM_Flush();
+    GFLG_Flush();
+    SIM_Advance(SIM_FLUSH_US);
+    digests.flash = SIM_Fnv(digests.flash, simNvmFlash, sizeof(simNvmFlash));
+    GTLM_GetStats(&tlmStats);
+    GFLG_GetStats(&flgStats);
+    statsOk = GSTA_GetSnapshot(0, &chan0Stats) && (chan0Stats.count == nbReads);
+    if (out != NULL)
+    {
+        fclose(out);
+    }
+
+    printf("Enregistrement : %u mesures sur %.1f s (%s)\n", nbRec,
+           rec[nbRec - 1].tUs / 1e6, recPath);
+    printf("Rejeu : %u services, %u lectures ADC, mesures rejouees jusqu'a la %u / %u\n",
+           nbServices, nbReads, recPos + 1, nbRec);
+    printf("Demarrage : controle a %.3f ms, LCD pret a %.3f ms\n",
+           bootTics[SYS_BOOT_STAGE_CONTROL] / (SIM_TICS_US * 1000.0),
+           bootTics[SYS_BOOT_STAGE_LCD] / (SIM_TICS_US * 1000.0));
+    printf("Service (simule) : moyenne %.1f us, max %.1f us ; check-in watchdog max %.1f ms, %u en retard\n",
+           (nbServices != 0) ? (double)serviceSumTics / nbServices / SIM_TICS_US : 0.0,
+           (double)serviceMaxTics / SIM_TICS_US, (double)wdmMaxTics / (SIM_TICS_US * 1000.0), wdmNbLate);
+    printf("Telemetrie : %u mesures decodees, %u differentes des lectures, %u trames invalides, "
+           "%u perdues\n", nbTlmSamples, nbTlmMismatch, nbTlmErrors, tlmStats.nbDropped);
+    printf("Flash : %u echantillons, %u rangees ecrites, %u erreurs\n", flgStats.nbSamples,
+           flgStats.nbRows, flgStats.nbErrors);
+    printf("Statistiques Chan0 : %u mesures, min %u max %u, moyenne %.2f, ecart-type %.2f "
+           "(fenetre %.2f, exponentielle %.2f)\n", chan0Stats.count, chan0Stats.min, chan0Stats.max,
+           chan0Stats.meanQ8 / 256.0, sqrt(chan0Stats.varianceQ8 / 256.0),
+           sqrt(chan0Stats.winVarianceQ8 / 256.0), sqrt(chan0Stats.emaVarianceQ8 / 256.0));
+    printf("LCD : [%s] [%s] [%s] [%s]\n", simLcd[0], simLcd[1], simLcd[2], simLcd[3]);
+    printf("empreinte LCD %08X LEDs %08X telemetrie %08X flash %08X\n",
+           digests.lcd, digests.leds, digests.telemetry, digests.flash);
+    printf("Service (PC) : %u appels, moyenne %.0f ns, max %.0f ns\n", nbServices,
+           (nbServices != 0) ? (double)hostSumNs / nbServices : 0.0, (double)hostMaxNs);
+
+    ok = (nbReads > 0) && (nbTlmSamples == nbReads) && (nbTlmMismatch == 0)
+         && (nbTlmErrors == 0) && (wdmNbLate == 0) && (flgStats.nbErrors == 0) && statsOk;
+    printf("%s\n", ok ? "OK" : "ECHEC");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,343 @@
+/*--------------------------------------------------------*/
+// simStats.c
+/*--------------------------------------------------------*/
+//	Description :	Tests de gestStats.c sur PC contre un calcul
+//			        en double, lectures interrompues, et temps
+//			        par mesure.
+//
+//	Utilisation :	simStats [-n mesures] [-s graine]
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+//  - depuis le debut : compte, min / max exacts, moyenne et variance
+//    (Welford entier) contre le calcul en double
+//  - fenetre glissante contre les GSTA_WINDOW dernieres mesures,
+//    a chaque mesure (remplissage compris)
+//  - exponentielle contre la meme recurrence en double
+//  - histogramme exact, somme = compte
+//  - interruptions simulees par SIGALRM (setitimer) :
+//      lecture dans l'interruption, mise a jour dans la boucle :
+//      lecture coherente ou refusee, jamais melangee
+//      mise a jour dans l'interruption, lecture dans la boucle :
+//      toujours coherente (recommencee si besoin)
+//  - temps PC par mesure ; sur la cible, GSTA_GetStats (tics)
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/time.h>
+#include "gestStats.h"
+
+#define SIM_MAX_SAMPLES     1000000
+#define SIM_IRQ_US          20
+#define SIM_IRQ_RUN_NS      300000000ull
+
+static int nbFail = 0;
+
+static void SIM_Check(const char *name, int ok, const char *fmt, double value)
+{
+    printf("  %-44s ", name);
+    printf(fmt, value);
+    printf("  %s\n", ok ? "ok" : "ECHEC");
+    if (!ok)
+    {
+        nbFail++;
+    }
+}
+
+static uint64_t SIM_HostNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/*--------------------------------------------------------*/
+// Mesures et reference
+/*--------------------------------------------------------*/
+
+// Chan0 : marche aleatoire autour de 500, bruit ; Chan1 : sinus lent
+// sur toute la plage avec saturation
+static void SIM_Signal(S_ADCResults *pAdc, uint32_t nb)
+{
+    double walk = 500.0, v;
+    uint32_t n;
+
+    for (n = 0; n < nb; n++)
+    {
+        walk += (rand() % 9) - 4;
+        walk = (walk < 50.0) ? 50.0 : ((walk > 950.0) ? 950.0 : walk);
+        pAdc[n].Chan0 = (uint16_t)lround(walk + (rand() % 41) - 20);
+        v = 512.0 + 600.0 * sin(2.0 * M_PI * n / 5000.0) + (rand() % 21) - 10;
+        pAdc[n].Chan1 = (uint16_t)((v < 0.0) ? 0 : ((v > 1023.0) ? 1023 : lround(v)));
+    }
+}
+
+static double SIM_Q8(uint32_t v)
+{
+    return v / 256.0;
+}
+
+static void SIM_TestSequence(const S_ADCResults *pAdc, uint32_t nb, uint8_t chan)
+{
+    static uint32_t hist[GSTA_HIST_NB_BINS];
+    S_statsSnapshot snap;
+    const uint16_t *pX = (const uint16_t *)pAdc + chan;
+    double sum = 0.0, sumSq = 0.0, ema = 0.0, emaVar = 0.0, alpha = 1.0 / (1 << GSTA_EMA_SHIFT);
+    double mean, var, d, winMean, winVar, errWin = 0.0, errEma = 0.0, errEmaVar = 0.0;
+    uint16_t min = UINT16_MAX, max = 0, winMin, winMax, x;
+    uint32_t n, k, w, winBad = 0, histBad = 0;
+    char name[48];
+
+    memset(hist, 0, sizeof(hist));
+    GSTA_Initialize();
+    for (n = 0; n < nb; n++)
+    {
+        GSTA_PushAdc(&pAdc[n]);
+        x = pX[n * GSTA_NB_CHAN];
+        sum += x;
+        sumSq += (double)x * x;
+        min = (x < min) ? x : min;
+        max = (x > max) ? x : max;
+        hist[x * GSTA_HIST_NB_BINS >> GSTA_ADC_BITS]++;
+        if (n == 0)
+        {
+            ema = x;
+        }
+        else
+        {
+            d = x - ema;
+            ema += alpha * d;
+            emaVar = (1.0 - alpha) * (emaVar + alpha * d * d);
+        }
+
+        GSTA_GetSnapshot(chan, &snap);
+
+        // Fenetre : les w dernieres mesures
+        w = (n + 1 < GSTA_WINDOW) ? n + 1 : GSTA_WINDOW;
+        winMean = 0.0;
+        winMin = UINT16_MAX;
+        winMax = 0;
+        for (k = n + 1 - w; k <= n; k++)
+        {
+            winMean += pX[k * GSTA_NB_CHAN];
+            winMin = (pX[k * GSTA_NB_CHAN] < winMin) ? pX[k * GSTA_NB_CHAN] : winMin;
+            winMax = (pX[k * GSTA_NB_CHAN] > winMax) ? pX[k * GSTA_NB_CHAN] : winMax;
+        }
+        winMean /= w;
+        winVar = 0.0;
+        for (k = n + 1 - w; k <= n; k++)
+        {
+            winVar += (pX[k * GSTA_NB_CHAN] - winMean) * (pX[k * GSTA_NB_CHAN] - winMean);
+        }
+        winVar = (w > 1) ? winVar / (w - 1) : 0.0;
+        if ((snap.winCount != w) || (snap.winMin != winMin) || (snap.winMax != winMax))
+        {
+            winBad++;
+        }
+        d = fmax(fabs(SIM_Q8(snap.winMeanQ8) - winMean), fabs(SIM_Q8(snap.winVarianceQ8) - winVar));
+        errWin = fmax(errWin, d);
+        if (n >= 10 * (1 << GSTA_EMA_SHIFT))
+        {
+            errEma = fmax(errEma, fabs(SIM_Q8(snap.emaMeanQ8) - ema));
+            errEmaVar = fmax(errEmaVar, fabs(SIM_Q8(snap.emaVarianceQ8) - emaVar) / (emaVar + 1.0));
+        }
+    }
+    for (k = 0; k < GSTA_HIST_NB_BINS; k++)
+    {
+        if (snap.histogram[k] != hist[k])
+        {
+            histBad++;
+        }
+    }
+
+    mean = sum / nb;
+    var = (sumSq - sum * mean) / (nb - 1);
+    printf("Chan%u, %lu mesures\n", chan, (unsigned long)nb);
+    SIM_Check("compte, min, max exacts", (snap.count == nb) && (snap.min == min) && (snap.max == max),
+              "%8.0f", snap.count);
+    SIM_Check("moyenne, ecart au double (LSB)", fabs(SIM_Q8(snap.meanQ8) - mean) < 0.01, "%8.4f",
+              fabs(SIM_Q8(snap.meanQ8) - mean));
+    SIM_Check("variance, ecart relatif au double", fabs(SIM_Q8(snap.varianceQ8) - var) / var < 1e-4,
+              "%8.1e", fabs(SIM_Q8(snap.varianceQ8) - var) / var);
+    snprintf(name, sizeof(name), "fenetre %u : compte, min, max faux", GSTA_WINDOW);
+    SIM_Check(name, winBad == 0, "%8.0f", winBad);
+    SIM_Check("fenetre : moyenne, variance, ecart max", errWin <= 0.5 / 256 + 1e-9, "%8.4f", errWin);
+    SIM_Check("exponentielle : moyenne, ecart max (LSB)", errEma < 0.01, "%8.4f", errEma);
+    SIM_Check("exponentielle : variance, ecart relatif", errEmaVar < 0.01, "%8.4f", errEmaVar);
+    SIM_Check("histogramme : classes differentes", histBad == 0, "%8.0f", histBad);
+}
+
+/*--------------------------------------------------------*/
+// Interruptions simulees
+/*--------------------------------------------------------*/
+
+static volatile sig_atomic_t irqReader;     // 1 : lecture dans l'interruption
+static volatile uint32_t nbPushed;
+static volatile uint32_t nbRead, nbRefused, nbTorn;
+
+// Mesure n : Chan0 = n % 1000, Chan1 = 1000 - Chan0 ; une copie coherente
+// verifie max, somme de l'histogramme et fenetre d'apres le compte
+static void SIM_Push(void)
+{
+    S_ADCResults adc;
+
+    adc.Chan0 = (uint16_t)(nbPushed % 1000);
+    adc.Chan1 = (uint16_t)(1000 - adc.Chan0);
+    GSTA_PushAdc(&adc);
+    nbPushed++;
+}
+
+static void SIM_Read(void)
+{
+    S_statsSnapshot snap;
+    uint32_t total = 0, k, c, last, winMax;
+
+    if (!GSTA_GetSnapshot(0, &snap))
+    {
+        nbRefused++;
+        return;
+    }
+    nbRead++;
+    c = snap.count;
+    for (k = 0; k < GSTA_HIST_NB_BINS; k++)
+    {
+        total += snap.histogram[k];
+    }
+    // Derniere mesure (c - 1) % 1000 ; la fenetre contient 999 si elle
+    // deborde sur le cycle precedent
+    last = (c - 1) % 1000;
+    winMax = ((c > GSTA_WINDOW) && (last < GSTA_WINDOW - 1)) ? 999 : last;
+    if ((c == 0) || (total != c) || (snap.max != ((c > 1000) ? 999 : c - 1))
+        || (snap.winCount != ((c < GSTA_WINDOW) ? c : GSTA_WINDOW)) || (snap.winMax != winMax))
+    {
+        nbTorn++;
+    }
+}
+
+static void SIM_Irq(int sig)
+{
+    (void)sig;
+    if (irqReader)
+    {
+        SIM_Read();
+    }
+    else
+    {
+        SIM_Push();
+    }
+}
+
+static void SIM_TestPreemption(int reader)
+{
+    struct itimerval timer = { { 0, SIM_IRQ_US }, { 0, SIM_IRQ_US } };
+    struct itimerval off = { { 0, 0 }, { 0, 0 } };
+    S_statsStats st;
+    uint64_t start;
+
+    GSTA_Initialize();
+    nbPushed = 0;
+    SIM_Push();
+    nbRead = nbRefused = nbTorn = 0;
+    irqReader = reader;
+    signal(SIGALRM, SIM_Irq);
+    setitimer(ITIMER_REAL, &timer, NULL);
+    for (start = SIM_HostNs(); SIM_HostNs() - start < SIM_IRQ_RUN_NS; )
+    {
+        if (reader)
+        {
+            SIM_Push();
+        }
+        else
+        {
+            SIM_Read();
+        }
+    }
+    setitimer(ITIMER_REAL, &off, NULL);
+    GSTA_GetStats(&st);
+
+    if (reader)
+    {
+        printf("Lecture dans l'interruption : %lu lectures, %lu refusees, %lu mesures\n",
+               (unsigned long)nbRead, (unsigned long)nbRefused, (unsigned long)nbPushed);
+        SIM_Check("lectures melangees", (nbTorn == 0) && (nbRead > 0), "%8.0f", nbTorn);
+    }
+    else
+    {
+        printf("Mise a jour dans l'interruption : %lu lectures, %lu recommencees, %lu mesures\n",
+               (unsigned long)nbRead, (unsigned long)st.nbRetries, (unsigned long)nbPushed);
+        SIM_Check("lectures melangees", (nbTorn == 0) && (nbPushed > 1), "%8.0f", nbTorn);
+        SIM_Check("lectures refusees", nbRefused == 0, "%8.0f", nbRefused);
+    }
+}
+
+/*--------------------------------------------------------*/
+// Cout
+/*--------------------------------------------------------*/
+
+static void SIM_Bench(const S_ADCResults *pAdc, uint32_t nb)
+{
+    S_statsSnapshot snap;
+    uint64_t ns, best = UINT64_MAX;
+    uint32_t n, run;
+
+    for (run = 0; run < 20; run++)
+    {
+        GSTA_Initialize();
+        ns = SIM_HostNs();
+        for (n = 0; n < nb; n++)
+        {
+            GSTA_PushAdc(&pAdc[n]);
+        }
+        ns = SIM_HostNs() - ns;
+        if (ns < best) best = ns;
+    }
+    printf("Cout sur PC\n");
+    printf("  GSTA_PushAdc (%u canaux)   : %6.2f ns / mesure\n", (unsigned)GSTA_NB_CHAN,
+           (double)best / nb);
+    for (run = 0, best = UINT64_MAX; run < 1000; run++)
+    {
+        ns = SIM_HostNs();
+        GSTA_GetSnapshot(1, &snap);
+        ns = SIM_HostNs() - ns;
+        if (ns < best) best = ns;
+    }
+    printf("  GSTA_GetSnapshot         : %6.2f ns\n", (double)best);
+    SIM_Check("canal invalide refuse", !GSTA_GetSnapshot(GSTA_NB_CHAN, &snap), "%8.0f", GSTA_NB_CHAN);
+}
+
+int main(int argc, char *argv[])
+{
+    static S_ADCResults adc[SIM_MAX_SAMPLES];
+    uint32_t nb = 20000;
+    unsigned seed = 1;
+    int i;
+
+    for (i = 1; i < argc - 1; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0)       nb = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-s") == 0)  seed = strtoul(argv[++i], NULL, 0);
+    }
+    if ((nb < 2) || (nb > SIM_MAX_SAMPLES))
+    {
+        nb = SIM_MAX_SAMPLES;
+    }
+    srand(seed);
+    SIM_Signal(adc, nb);
+
+    SIM_TestSequence(adc, nb, 0);
+    SIM_TestSequence(adc, nb, 1);
+    SIM_TestPreemption(1);
+    SIM_TestPreemption(0);
+    SIM_Bench(adc, nb);
+
+    printf("%s\n", (nbFail == 0) ? "OK" : "ECHEC");
+    return (nbFail == 0) ? 0 : 1;
+}
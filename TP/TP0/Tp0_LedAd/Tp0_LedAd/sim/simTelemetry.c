@@ -0,0 +1,178 @@
+/*--------------------------------------------------------*/
+// simTelemetry.c
+/*--------------------------------------------------------*/
+//	Description :	Remplace la carte et l'UART sur PC : gestTelemetry.c
+//			        recoit des mesures ADC synthetiques, le DMA simule
+//			        ecrit les trames dans un pseudo-terminal (pty) au
+//			        debit de la ligne (10 bits par octet, temps reel).
+//			        tlmDecode lit le pty comme un port serie.
+//
+//	Utilisation :	simTelemetry [-b baud] [-r echantillons/s] [-t s]
+//			                     [-l lien]
+//			        lien : lien symbolique vers le pty (/tmp/tlm0)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+#include "simPlib.h"
+#include "gestTelemetry.h"
+
+#define SIM_CORE_TICS_US    (SYS_CLK_FREQ / 2000000)
+#define SIM_STEP_US         1000
+#define SIM_WAIT_READER_S   10
+
+static uint64_t SIM_NowUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+// Pty maitre en mode brut, lien vers l'esclave
+static int SIM_OpenPty(const char *link)
+{
+    struct termios tio;
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if ((fd < 0) || (grantpt(fd) != 0) || (unlockpt(fd) != 0))
+    {
+        perror("pty");
+        exit(1);
+    }
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+
+    unlink(link);
+    if (symlink(ptsname(fd), link) != 0)
+    {
+        perror(link);
+        exit(1);
+    }
+    fprintf(stderr, "UART simulee : %s -> %s\n", link, ptsname(fd));
+    return fd;
+}
+
+// Attend qu'un lecteur ouvre l'esclave (plus de POLLHUP sur le maitre)
+static void SIM_WaitReader(int fd)
+{
+    struct pollfd pfd = { .fd = fd, .events = POLLOUT };
+    int i;
+
+    for (i = 0; i < SIM_WAIT_READER_S * 10; i++)
+    {
+        if ((poll(&pfd, 1, 0) >= 0) && !(pfd.revents & POLLHUP))
+        {
+            return;
+        }
+        usleep(100000);
+    }
+    fprintf(stderr, "pas de lecteur sur le pty\n");
+    exit(1);
+}
+
+// Mesures synthetiques : Ch0 sinus 1 Hz, Ch1 rampe, 10 bits
+static void SIM_Adc(S_ADCResults *pRes, uint64_t tUs)
+{
+    pRes->Chan0 = (uint16_t)(512 + 511 * sin(2 * M_PI * (double)tUs / 1e6));
+    pRes->Chan1 = (uint16_t)((tUs / 1000) % 1024);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t baud = 115200;
+    uint32_t rate = 1000;
+    uint32_t durationS = 5;
+    const char *link = "/tmp/tlm0";
+    uint8_t out[4096];
+    uint64_t t0, tUs, endUs, sampleUs;
+    uint64_t nbSamples = 0;
+    uint64_t lineBytes = 0, sentBytes = 0;
+    uint32_t nb, request, sent;
+    S_ADCResults res;
+    S_telemetryStats stats;
+    int fd, i;
+
+    for (i = 1; i < argc - 1; i++)
+    {
+        if (strcmp(argv[i], "-b") == 0)       baud = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-r") == 0)  rate = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-t") == 0)  durationS = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-l") == 0)  link = argv[++i];
+    }
+    if ((baud == 0) || (rate == 0))
+    {
+        fprintf(stderr, "baud et debit > 0\n");
+        return 1;
+    }
+
+    fd = SIM_OpenPty(link);
+    SIM_WaitReader(fd);
+
+    GTLM_Initialize();
+    endUs = (uint64_t)durationS * 1000000u;
+    t0 = SIM_NowUs();
+
+    do
+    {
+        usleep(SIM_STEP_US);
+        tUs = SIM_NowUs() - t0;
+
+        // Mesures dues depuis le pas precedent
+        while (((sampleUs = (nbSamples * 1000000u) / rate) <= tUs) && (sampleUs < endUs))
+        {
+            simCoreCount = (uint32_t)(sampleUs * SIM_CORE_TICS_US);
+            SIM_Adc(&res, sampleUs);
+            GTLM_PushAdc(&res);
+            nbSamples++;
+        }
+        if (tUs >= endUs)
+        {
+            GTLM_Flush();
+        }
+
+        // Octets que la ligne a pu emettre depuis le debut
+        lineBytes = (tUs * baud) / 10 / 1000000u;
+        request = (uint32_t)(lineBytes - sentBytes);
+        if (request > sizeof(out))
+        {
+            request = sizeof(out);
+        }
+        nb = SIM_UartTransmit(request, out);
+        // Ligne au repos pour le reste du pas si le DMA s'est arrete
+        sentBytes = (nb < request) ? lineBytes : sentBytes + nb;
+        if ((nb > 0) && (write(fd, out, nb) != (ssize_t)nb))
+        {
+            perror("write");
+            return 1;
+        }
+    } while ((tUs < endUs) || simDma[DMA_CHANNEL_0].enabled);
+
+    GTLM_GetStats(&stats);
+    fprintf(stderr, "%u echantillons, %u trames, %u perdues, %u octets en %.2f s\n",
+            stats.nbSamples, stats.nbFrames, stats.nbDropped, stats.nbBytes, tUs / 1e6);
+    sent = stats.nbSamples - stats.nbDropped * GTLM_SAMPLES_PER_FRAME;
+    fprintf(stderr, "ligne %u bauds : %.0f octets/s max., %.2f octets par echantillon envoye\n",
+            baud, baud / 10.0, sent ? (double)stats.nbBytes / sent : 0.0);
+
+    // Laisse le lecteur vider le pty avant la fermeture
+    tcdrain(fd);
+    usleep(200000);
+    close(fd);
+    unlink(link);
+    return 0;
+}
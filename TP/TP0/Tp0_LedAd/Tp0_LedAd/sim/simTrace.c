@@ -0,0 +1,227 @@
+/*--------------------------------------------------------*/
+// simTrace.c
+/*--------------------------------------------------------*/
+//	Description :	Trace d'evenements (eventTrace.c) sur PC :
+//			        scenario du TP0 a durees connues (ISR Timer1
+//			        100 ms, ISR DMA, service ADC + LCD, init LCD
+//			        longue), horloge divisee par 2 pendant les
+//			        SIM_SLOW_US dernieres us (la trace contient les
+//			        deux frequences), puis gel comme par le watchdog et
+//			        ecriture du dump lu par trcDecode. Enfin les
+//			        resets : trace figee gardee un demarrage, relancee
+//			        au suivant ou apres une mise sous tension.
+//
+//	Utilisation :	simTrace [-t s] [-s graine] [-o dump]
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "system_config.h"
+#include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
+#include "eventTrace.h"
+
+// Cout d'un enregistrement sur la cible, avance du core timer a chaque
+// lecture : ~16 instructions (mfc0, ll/sc, 3 sw) a un cycle, le core
+// timer compte a SYSCLK / 2
+#define SIM_RECORD_TICS     8
+#define SIM_CALIB_COUNT     16          // TRC_CALIB_COUNT de eventTrace.c
+
+// Scenario (us)
+#define SIM_TMR1_PERIOD_US  100000
+#define SIM_TMR1_ISR_US     3
+#define SIM_DMA_PERIOD_US   8680        // trame de ~100 octets a 115200 bauds
+#define SIM_DMA_ISR_US      2
+#define SIM_LCD_INIT_US     50000
+#define SIM_ADC_US          25
+#define SIM_LCD_US          1800
+#define SIM_POLL_US         4
+#define SIM_SLOW_US         400000      // fin de scenario a SYS_CLK_FREQ / 2, dans l'anneau
+
+// Etats comme APP_STATES
+#define SIM_STATE_WAIT      1
+#define SIM_STATE_SERVICE   2
+
+static uint32_t ticsUs = SYS_CLK_FREQ / 2000000;
+static uint64_t nowTics = 0;
+static uint64_t nextTmr1;
+static uint64_t nextDma;
+static volatile uint16_t appState = SIM_STATE_WAIT;
+
+static void SIM_SetNow(uint64_t tics)
+{
+    nowTics = tics;
+    simCoreCount = (uint32_t)tics;
+}
+
+static void SIM_IsrTmr1(void)
+{
+    TRC_BEGIN(TMR1_ISR, 0);
+    SIM_SetNow(nowTics + SIM_TMR1_ISR_US * ticsUs / 2);
+    appState = SIM_STATE_SERVICE;
+    TRC_POINT(APP_STATE, SIM_STATE_SERVICE);
+    SIM_SetNow(nowTics + SIM_TMR1_ISR_US * ticsUs / 2);
+    TRC_END(TMR1_ISR, 0);
+}
+
+static void SIM_IsrDma(void)
+{
+    TRC_BEGIN(DMA0_ISR, 0);
+    SIM_SetNow(nowTics + SIM_DMA_ISR_US * ticsUs);
+    TRC_END(DMA0_ISR, 0);
+}
+
+// Temps passe dans la boucle principale, interrompue par les ISR
+// dues (periode Timer1 avec une gigue de 0 a 1 us)
+static void SIM_Run(uint32_t us)
+{
+    uint64_t end = nowTics + (uint64_t)us * ticsUs;
+    uint64_t start;
+
+    while ((nextTmr1 <= end) || (nextDma <= end))
+    {
+        if (nextTmr1 <= nextDma)
+        {
+            SIM_SetNow(nextTmr1);
+            start = nowTics;
+            SIM_IsrTmr1();
+            nextTmr1 += SIM_TMR1_PERIOD_US * ticsUs + (uint32_t)(rand() % ticsUs);
+        }
+        else
+        {
+            SIM_SetNow(nextDma);
+            start = nowTics;
+            SIM_IsrDma();
+            nextDma += SIM_DMA_PERIOD_US * ticsUs;
+        }
+        end += nowTics - start;
+    }
+    SIM_SetNow(end);
+}
+
+// Horloge changee : les ISR deja programmees gardent leur echeance en us
+static void SIM_ClockChange(uint32_t systemClockHz)
+{
+    uint32_t oldTicsUs = ticsUs;
+
+    ticsUs = systemClockHz / 2000000;
+    nextTmr1 = nowTics + (nextTmr1 - nowTics) * ticsUs / oldTicsUs;
+    nextDma = nowTics + (nextDma - nowTics) * ticsUs / oldTicsUs;
+    SIM_ClockScale(systemClockHz);
+}
+
+// Boucle principale jusqu'a endTics
+static uint32_t SIM_Main(uint64_t endTics)
+{
+    uint32_t nbService = 0;
+
+    while (nowTics < endTics)
+    {
+        if (appState == SIM_STATE_SERVICE)
+        {
+            TRC_BEGIN(APP_SERVICE, SIM_STATE_SERVICE);
+            SIM_Run(SIM_ADC_US);
+            TRC_POINT(ADC_DONE, 512 + nbService % 100);
+            TRC_BEGIN(LCD, 1);
+            SIM_Run(SIM_LCD_US);
+            TRC_END(LCD, 1);
+            TRC_END(APP_SERVICE, SIM_STATE_SERVICE);
+            appState = SIM_STATE_WAIT;
+            TRC_POINT(APP_STATE, SIM_STATE_WAIT);
+            nbService++;
+        }
+        SIM_Run(SIM_POLL_US);
+    }
+    return nbService;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *dumpPath = "trace.bin";
+    uint32_t durationS = 3;
+    uint32_t headFrozen, costTics, clockHz;
+    bool kept, rearmed, powerOn, costOk, clockOk;
+    unsigned seed = 1;
+    uint32_t nbService;
+    FILE *f;
+    int i;
+
+    for (i = 1; i < argc - 1; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0)       durationS = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-s") == 0)  seed = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-o") == 0)  dumpPath = argv[++i];
+    }
+    srand(seed);
+    simCoreTicsPerRead = SIM_RECORD_TICS;
+
+    // Core timer proche du rebouclage : le decodeur doit le derouler
+    SIM_SetNow(0xFFFFFFFFull - 2 * SIM_TMR1_PERIOD_US * ticsUs);
+    TRC_Initialize();
+    costTics = trcLog.costTics;
+    nextTmr1 = nowTics + SIM_TMR1_PERIOD_US * ticsUs;
+    nextDma = nowTics + SIM_DMA_PERIOD_US * ticsUs / 2;
+
+    // Init LCD differee (demarrage rapide), interrompue par les ISR
+    TRC_BEGIN(LCD, 0);
+    SIM_Run(SIM_LCD_INIT_US);
+    TRC_END(LCD, 0);
+
+    nbService = SIM_Main(0xFFFFFFFFull + ((uint64_t)durationS * 1000000u - SIM_SLOW_US) * ticsUs);
+    SIM_ClockChange(SYS_CLK_FREQ / 2);
+    clockHz = trcLog.coreClockHz;
+    nbService += SIM_Main(nowTics + (uint64_t)SIM_SLOW_US * ticsUs);
+
+    // Gel comme par SYS_WDM_Check : plus rien n'est enregistre
+    TRC_FREEZE(TRC_FREEZE_WATCHDOG);
+    headFrozen = trcLog.head;
+    SIM_Run(SIM_TMR1_PERIOD_US * 2);
+
+    f = fopen(dumpPath, "wb");
+    if ((f == NULL) || (fwrite(&trcLog, sizeof(trcLog), 1, f) != 1))
+    {
+        perror(dumpPath);
+        return 1;
+    }
+    fclose(f);
+
+    printf("Scenario : ISR Timer1 %u us / %u ms, ISR DMA %u us / %.2f ms, "
+           "service ADC %u us + LCD %u us\n", SIM_TMR1_ISR_US, SIM_TMR1_PERIOD_US / 1000,
+           SIM_DMA_ISR_US, SIM_DMA_PERIOD_US / 1000.0, SIM_ADC_US, SIM_LCD_US);
+    printf("%u services, %u enregistrements ecrits, anneau de %u -> %s\n", nbService,
+           trcLog.head, TRC_SIZE, dumpPath);
+    costOk = (costTics >= SIM_CALIB_COUNT * SIM_RECORD_TICS)
+             && (costTics <= (SIM_CALIB_COUNT + 1) * SIM_RECORD_TICS);
+    printf("Cout d'un enregistrement : %.2f tics mesures, %u modelises (+ une lecture du core timer)%s\n",
+           costTics / 16.0, SIM_RECORD_TICS, costOk ? "" : " ECHEC");
+    clockOk = (clockHz == SYS_CLK_FREQ / 4);
+    printf("Horloge / 2 : en-tete %u Hz%s\n", clockHz, clockOk ? "" : " ECHEC");
+
+
+    // Reset logiciel : gardee pour ce demarrage, relancee au suivant
+    TRC_ResetCheck();
+    TRC_Initialize();
+    kept = (trcLog.frozen == TRC_FREEZE_WATCHDOG) && (trcLog.head == headFrozen);
+    TRC_ResetCheck();
+    TRC_Initialize();
+    rearmed = (trcLog.frozen == TRC_FREEZE_NONE) && (trcLog.nbBoots == 0);
+
+    // Mise sous tension : RAM persistante non fiable, jamais gardee
+    TRC_FREEZE(TRC_FREEZE_EXCEPTION);
+    simRcon = _RCON_POR_MASK;
+    TRC_ResetCheck();
+    TRC_Initialize();
+    powerOn = (trcLog.frozen == TRC_FREEZE_NONE);
+    printf("Reset : trace figee %s au 1er demarrage, %s au 2e, %s apres POR\n",
+           kept ? "gardee" : "PERDUE", rearmed ? "relancee" : "NON relancee",
+           powerOn ? "relancee" : "GARDEE");
+
+    return ((headFrozen > TRC_SIZE) && kept && rearmed && powerOn && costOk && clockOk) ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+#ifndef SIM_MC32DRIVERADC_H
+#define SIM_MC32DRIVERADC_H
+/*--------------------------------------------------------*/
+// Mc32DriverAdc.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Resultats ADC comme le driver du kit. Les
+//			        lectures sont fournies par le simulateur.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+typedef struct {
+    uint16_t Chan0;
+    uint16_t Chan1;
+} S_ADCResults;
+
+void BSP_InitADC10(void);
+S_ADCResults BSP_ReadAllADC(void);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef SIM_MC32DRIVERLCD_H
+#define SIM_MC32DRIVERLCD_H
+/*--------------------------------------------------------*/
+// Mc32DriverLcd.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	LCD 4 x 20 en memoire, lu par le simulateur.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+#define SIM_LCD_LINES       4
+#define SIM_LCD_COLUMNS     20
+
+extern char simLcd[SIM_LCD_LINES][SIM_LCD_COLUMNS + 1];
+
+void lcd_init(void);
+void lcd_bl_on(void);
+void lcd_gotoxy(uint8_t x, uint8_t y);
+void printf_lcd(const char *fmt, ...);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SIM_BSP_H
+#define SIM_BSP_H
+/*--------------------------------------------------------*/
+// bsp.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Rien d'utilise par app.c : l'ADC du kit est
+//			        dans Mc32DriverAdc.h, les LEDs dans la table
+//			        des broches.
+/*--------------------------------------------------------*/
+
+#endif
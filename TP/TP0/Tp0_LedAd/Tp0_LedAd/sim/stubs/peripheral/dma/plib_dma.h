@@ -0,0 +1,58 @@
+#ifndef SIM_PLIB_DMA_H
+#define SIM_PLIB_DMA_H
+/*--------------------------------------------------------*/
+// plib_dma.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Canaux DMA simules : 1 octet par evenement TX
+//			        de l'UART (SIM_UartTransmit), une cellule par
+//			        periode de timer (SIM_TimerPeriod, simPlib.c).
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum { DMA_ID_0 = 0 } DMA_MODULE_ID;
+typedef enum { DMA_CHANNEL_0 = 0, DMA_CHANNEL_1, DMA_NUMBER_OF_CHANNELS } DMA_CHANNEL;
+typedef enum { DMA_CHANNEL_PRIORITY_0 = 0, DMA_CHANNEL_PRIORITY_3 = 3 } DMA_CHANNEL_PRIORITY;
+typedef enum { DMA_TRIGGER_USART_1_TRANSMIT = 0, DMA_TRIGGER_TIMER_2 } DMA_TRIGGER_SOURCE;
+typedef enum { DMA_CHANNEL_TRIGGER_TRANSFER_START = 0 } DMA_CHANNEL_TRIGGER_TYPE;
+typedef enum {
+    DMA_INT_BLOCK_TRANSFER_COMPLETE = 0x08,
+    DMA_INT_SOURCE_HALF_EMPTY = 0x40,
+    DMA_INT_SOURCE_DONE = 0x80
+} DMA_INT_TYPE;
+
+typedef struct {
+    uintptr_t srcAddr;
+    uintptr_t dstAddr;
+    uint16_t srcSize;
+    uint16_t srcPtr;        // octets deja transferes
+    uint16_t cellSize;
+    uint8_t trigger;        // DMA_TRIGGER_SOURCE
+    uint8_t autoEnable;     // bloc recommence a la fin
+    uint8_t enabled;
+    uint8_t intEnabled;     // DMA_INT_TYPE
+    uint8_t intFlags;
+} SIM_DMA_REGS;
+
+extern SIM_DMA_REGS simDma[DMA_NUMBER_OF_CHANNELS];
+
+void PLIB_DMA_Enable(DMA_MODULE_ID index);
+void PLIB_DMA_ChannelXPrioritySelect(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_CHANNEL_PRIORITY priority);
+void PLIB_DMA_ChannelXStartIRQSet(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_TRIGGER_SOURCE IRQnum);
+void PLIB_DMA_ChannelXTriggerEnable(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_CHANNEL_TRIGGER_TYPE trigger);
+void PLIB_DMA_ChannelXSourceStartAddressSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uintptr_t sourceStartAddress);
+void PLIB_DMA_ChannelXDestinationStartAddressSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uintptr_t destinationStartAddress);
+void PLIB_DMA_ChannelXSourceSizeSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uint16_t sourceSize);
+void PLIB_DMA_ChannelXDestinationSizeSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uint16_t destinationSize);
+void PLIB_DMA_ChannelXCellSizeSet(DMA_MODULE_ID index, DMA_CHANNEL channel, uint16_t CellSize);
+void PLIB_DMA_ChannelXINTSourceFlagClear(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_INT_TYPE dmaINTSource);
+void PLIB_DMA_ChannelXINTSourceEnable(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_INT_TYPE dmaINTSource);
+bool PLIB_DMA_ChannelXINTSourceFlagGet(DMA_MODULE_ID index, DMA_CHANNEL channel, DMA_INT_TYPE dmaINTSource);
+void PLIB_DMA_ChannelXAutoEnable(DMA_MODULE_ID index, DMA_CHANNEL channel);
+void PLIB_DMA_ChannelXEnable(DMA_MODULE_ID index, DMA_CHANNEL channel);
+void PLIB_DMA_ChannelXDisable(DMA_MODULE_ID index, DMA_CHANNEL channel);
+void PLIB_DMA_StartTransferSet(DMA_MODULE_ID index, DMA_CHANNEL channel);
+void PLIB_DMA_AbortTransferSet(DMA_MODULE_ID index, DMA_CHANNEL channel);
+
+#endif
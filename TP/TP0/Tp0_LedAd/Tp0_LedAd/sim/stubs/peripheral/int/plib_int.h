@@ -0,0 +1,29 @@
+#ifndef SIM_PLIB_INT_H
+#define SIM_PLIB_INT_H
+/*--------------------------------------------------------*/
+// plib_int.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+typedef enum { INT_ID_0 = 0 } INT_MODULE_ID;
+// INT_SOURCE_DMA_n consecutifs (flag pose par le canal n, simPlib.c)
+typedef enum { INT_SOURCE_DMA_0 = 0, INT_SOURCE_DMA_1, INT_SOURCE_TIMER_2, INT_SOURCE_NUMBER } INT_SOURCE;
+typedef enum { INT_VECTOR_DMA0 = 0, INT_VECTOR_DMA1, INT_VECTOR_T2 } INT_VECTOR;
+typedef enum {
+    INT_PRIORITY_LEVEL2 = 2,
+    INT_PRIORITY_LEVEL4 = 4,
+    INT_PRIORITY_LEVEL5 = 5
+} INT_PRIORITY_LEVEL;
+typedef enum { INT_SUBPRIORITY_LEVEL0 = 0 } INT_SUBPRIORITY_LEVEL;
+
+extern uint8_t simIntEnabled[INT_SOURCE_NUMBER];
+extern uint8_t simIntFlag[INT_SOURCE_NUMBER];
+
+void PLIB_INT_VectorPrioritySet(INT_MODULE_ID index, INT_VECTOR vector, INT_PRIORITY_LEVEL priority);
+void PLIB_INT_VectorSubPrioritySet(INT_MODULE_ID index, INT_VECTOR vector, INT_SUBPRIORITY_LEVEL subPriority);
+void PLIB_INT_SourceFlagClear(INT_MODULE_ID index, INT_SOURCE source);
+void PLIB_INT_SourceEnable(INT_MODULE_ID index, INT_SOURCE source);
+void PLIB_INT_SourceDisable(INT_MODULE_ID index, INT_SOURCE source);
+
+#endif
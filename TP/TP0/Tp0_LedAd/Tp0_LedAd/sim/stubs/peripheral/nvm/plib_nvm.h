@@ -0,0 +1,33 @@
+#ifndef SIM_PLIB_NVM_H
+#define SIM_PLIB_NVM_H
+/*--------------------------------------------------------*/
+// plib_nvm.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Controleur NVM simule (simNvm.c) : effacement
+//			        de page, programmation de mot et de rangee.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum { NVM_ID_0 = 0 } NVM_MODULE_ID;
+typedef enum {
+    NO_OPERATION = 0,
+    WORD_PROGRAM_OPERATION = 1,
+    ROW_PROGRAM_OPERATION = 3,
+    PAGE_ERASE_OPERATION = 4
+} NVM_OPERATION_MODE;
+
+void PLIB_NVM_MemoryOperationSelect(NVM_MODULE_ID index, NVM_OPERATION_MODE operationmode);
+void PLIB_NVM_MemoryModifyEnable(NVM_MODULE_ID index);
+void PLIB_NVM_MemoryModifyInhibit(NVM_MODULE_ID index);
+void PLIB_NVM_FlashAddressToModify(NVM_MODULE_ID index, uintptr_t address);
+void PLIB_NVM_DataBlockSourceAddress(NVM_MODULE_ID index, uintptr_t address);
+void PLIB_NVM_FlashProvideData(NVM_MODULE_ID index, uint32_t data);
+void PLIB_NVM_FlashWriteKeySequence(NVM_MODULE_ID index, uint32_t keysequence);
+void PLIB_NVM_FlashWriteStart(NVM_MODULE_ID index);
+bool PLIB_NVM_FlashWriteCycleHasCompleted(NVM_MODULE_ID index);
+bool PLIB_NVM_WriteOperationHasTerminated(NVM_MODULE_ID index);
+bool PLIB_NVM_LowVoltageHasOccurred(NVM_MODULE_ID index);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SIM_PLIB_OC_H
+#define SIM_PLIB_OC_H
+/*--------------------------------------------------------*/
+// plib_oc.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Output compare simule, OCxRS dans simOcRs
+//			        (xc.h) : rapport cyclique de la periode
+//			        suivante du timer.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+typedef enum { OC_ID_1 = 0, OC_NUMBER_OF_MODULES } OC_MODULE_ID;
+typedef enum { OC_COMPARE_PWM_MODE_WITHOUT_FAULT_PROTECTION = 6 } OC_COMPARE_MODES;
+typedef enum { OC_BUFFER_SIZE_16BIT = 0 } OC_BUFFER_SIZE;
+typedef enum { OC_TIMER_16BIT_TMR2 = 0 } OC_16BIT_TIMERS;
+
+typedef struct {
+    uint16_t r;             // OCxR
+    uint8_t mode;
+    uint8_t enabled;
+} SIM_OC_REGS;
+
+extern SIM_OC_REGS simOc[OC_NUMBER_OF_MODULES];
+
+void PLIB_OC_ModeSelect(OC_MODULE_ID index, OC_COMPARE_MODES cmpMode);
+void PLIB_OC_BufferSizeSelect(OC_MODULE_ID index, OC_BUFFER_SIZE size);
+void PLIB_OC_TimerSelect(OC_MODULE_ID index, OC_16BIT_TIMERS tmr);
+void PLIB_OC_Buffer16BitSet(OC_MODULE_ID index, uint16_t val16Bit);
+void PLIB_OC_PulseWidth16BitSet(OC_MODULE_ID index, uint16_t pulseWidth);
+void PLIB_OC_Enable(OC_MODULE_ID index);
+void PLIB_OC_Disable(OC_MODULE_ID index);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef SIM_PLIB_PORTS_H
+#define SIM_PLIB_PORTS_H
+/*--------------------------------------------------------*/
+// plib_ports.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Latch des ports A et B, lus par le simulateur
+//			        (LEDs). Les ecritures dans LATxCLR (xc.h) sont
+//			        appliquees par SIM_PortsUpdate.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+typedef enum { PORTS_ID_0 = 0 } PORTS_MODULE_ID;
+typedef enum {
+    PORT_CHANNEL_A = 0, PORT_CHANNEL_B, PORT_CHANNEL_C, PORT_CHANNEL_D,
+    PORT_CHANNEL_E, PORT_CHANNEL_F, PORT_CHANNEL_G, PORT_NUMBER_OF_CHANNELS
+} PORTS_CHANNEL;
+typedef uint32_t PORTS_DATA_TYPE;
+
+extern uint16_t simPort[PORT_NUMBER_OF_CHANNELS];
+
+PORTS_DATA_TYPE PLIB_PORTS_Read(PORTS_MODULE_ID index, PORTS_CHANNEL channel);
+void PLIB_PORTS_Write(PORTS_MODULE_ID index, PORTS_CHANNEL channel, PORTS_DATA_TYPE value);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SIM_PLIB_TMR_H
+#define SIM_PLIB_TMR_H
+/*--------------------------------------------------------*/
+// plib_tmr.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Timer simule : periode et marche / arret, les
+//			        periodes sont avancees par SIM_TimerPeriod
+//			        (simPlib.c).
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+typedef enum { TMR_ID_2 = 0, TMR_NUMBER_OF_MODULES } TMR_MODULE_ID;
+typedef enum { TMR_CLOCK_SOURCE_PERIPHERAL_CLOCK = 0 } TMR_CLOCK_SOURCE;
+typedef enum { TMR_PRESCALE_VALUE_1 = 0 } TMR_PRESCALE;
+
+typedef struct {
+    uint16_t period;        // PRx
+    uint8_t running;
+} SIM_TMR_REGS;
+
+extern SIM_TMR_REGS simTmr[TMR_NUMBER_OF_MODULES];
+
+void PLIB_TMR_ClockSourceSelect(TMR_MODULE_ID index, TMR_CLOCK_SOURCE source);
+void PLIB_TMR_PrescaleSelect(TMR_MODULE_ID index, TMR_PRESCALE prescale);
+void PLIB_TMR_Mode16BitEnable(TMR_MODULE_ID index);
+void PLIB_TMR_Counter16BitClear(TMR_MODULE_ID index);
+void PLIB_TMR_Period16BitSet(TMR_MODULE_ID index, uint16_t period);
+void PLIB_TMR_Start(TMR_MODULE_ID index);
+void PLIB_TMR_Stop(TMR_MODULE_ID index);
+
+#endif
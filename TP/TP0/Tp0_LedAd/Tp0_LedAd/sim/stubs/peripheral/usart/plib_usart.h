@@ -0,0 +1,28 @@
+#ifndef SIM_PLIB_USART_H
+#define SIM_PLIB_USART_H
+/*--------------------------------------------------------*/
+// plib_usart.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+typedef enum { USART_ID_1 = 0, USART_NUMBER_OF_MODULES } USART_MODULE_ID;
+typedef enum { USART_8N1 = 0 } USART_LINECONTROL_MODE;
+typedef enum { USART_TRANSMIT_FIFO_NOT_FULL = 0 } USART_TRANSMIT_INTR_MODE;
+
+typedef struct {
+    uint32_t baud;          // debit programme (0 = UART arretee)
+    uint8_t txEnabled;
+    volatile uint32_t txReg;
+} SIM_USART_REGS;
+
+extern SIM_USART_REGS simUsart[USART_NUMBER_OF_MODULES];
+
+void PLIB_USART_BaudRateSet(USART_MODULE_ID index, uint32_t clockFrequency, uint32_t baudRate);
+void PLIB_USART_LineControlModeSelect(USART_MODULE_ID index, USART_LINECONTROL_MODE dataFlowConfig);
+void PLIB_USART_TransmitterInterruptModeSelect(USART_MODULE_ID index, USART_TRANSMIT_INTR_MODE fifolevel);
+void PLIB_USART_TransmitterEnable(USART_MODULE_ID index);
+void PLIB_USART_Enable(USART_MODULE_ID index);
+void *PLIB_USART_TransmitterAddressGet(USART_MODULE_ID index);
+
+#endif
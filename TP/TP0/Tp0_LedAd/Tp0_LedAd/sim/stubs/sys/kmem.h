@@ -0,0 +1,15 @@
+#ifndef SIM_KMEM_H
+#define SIM_KMEM_H
+/*--------------------------------------------------------*/
+// sys/kmem.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Sur PC l'adresse "physique" est le pointeur,
+//			        sans segment cache / non cache.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+#define KVA_TO_PA(v)        ((uintptr_t)(v))
+#define KVA0_TO_KVA1(v)     (v)
+
+#endif
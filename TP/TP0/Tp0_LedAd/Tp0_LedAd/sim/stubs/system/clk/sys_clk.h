@@ -0,0 +1,14 @@
+#ifndef SIM_SYS_CLK_H
+#define SIM_SYS_CLK_H
+/*--------------------------------------------------------*/
+// sys_clk.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+typedef enum { CLK_BUS_PERIPHERAL_1 = 0 } CLK_BUSES_PERIPHERAL;
+
+uint32_t SYS_CLK_SystemFrequencyGet(void);
+uint32_t SYS_CLK_PeripheralFrequencyGet(CLK_BUSES_PERIPHERAL peripheralBus);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef SIM_SYS_CLK_STATIC_H
+#define SIM_SYS_CLK_STATIC_H
+/*--------------------------------------------------------*/
+// sys_clk_static.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Comme Framework/src/system/clk/sys_clk_static.h
+#define SYS_CLK_FREQ_CHANGE_CALLBACKS_MAX   8
+
+typedef void (*SYS_CLK_FREQ_CHANGE_CALLBACK)(uint32_t systemClockHz,
+                                             uint32_t peripheralClockHz);
+
+bool SYS_CLK_FrequencyChangeCallbackRegister(SYS_CLK_FREQ_CHANGE_CALLBACK callback);
+uint32_t SYS_CLK_CallbackRejectedCountGet(void);
+
+// Simulation : nouvelle frequence (PBCLK = SYSCLK), rappels appeles
+void SIM_ClockScale(uint32_t systemClockHz);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef SIM_SYS_INT_H
+#define SIM_SYS_INT_H
+/*--------------------------------------------------------*/
+// sys_int.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Masquage global des interruptions, suivi par
+//			        le controleur NVM simule.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint32_t SYS_INT_PROCESSOR_STATUS;
+
+extern bool simIntGlobalEnabled;
+
+SYS_INT_PROCESSOR_STATUS SYS_INT_StatusGetAndDisable(void);
+void SYS_INT_StatusRestore(SYS_INT_PROCESSOR_STATUS processorStatus);
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef SIM_SYS_PORTS_H
+#define SIM_SYS_PORTS_H
+/*--------------------------------------------------------*/
+// sys_ports.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include "peripheral/ports/plib_ports.h"
+
+#endif
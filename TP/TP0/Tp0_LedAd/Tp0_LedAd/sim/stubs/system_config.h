@@ -0,0 +1,22 @@
+#ifndef SIM_SYSTEM_CONFIG_H
+#define SIM_SYSTEM_CONFIG_H
+/*--------------------------------------------------------*/
+// system_config.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#define SYS_CLK_FREQ                        80000000ul
+#define SYS_CLK_BUS_PERIPHERAL_1            80000000ul
+
+// LEDs de la table des broches du firmware (system_config.h), seules
+// utilisees par app.c
+#define SYS_PORTS_PIN_TABLE(PIN, arg) \
+    PIN(LED0,   A,  0, OUT, 0, arg) \
+    PIN(LED1,   A,  1, OUT, 0, arg) \
+    PIN(LED2,   A,  4, OUT, 0, arg) \
+    PIN(LED3,   A,  5, OUT, 0, arg) \
+    PIN(LED4,   A,  6, OUT, 1, arg) \
+    PIN(LED5,   A,  7, OUT, 1, arg) \
+    PIN(LED6,   A, 15, OUT, 1, arg) \
+    PIN(LED7,   B, 10, OUT, 1, arg)
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SIM_SYSTEM_DEFINITIONS_H
+#define SIM_SYSTEM_DEFINITIONS_H
+/*--------------------------------------------------------*/
+// system_definitions.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Services systeme utilises par app.c. Rapports
+//			        de crash et de watchdog du firmware (en-tetes
+//			        de system_config/default), fonctions fournies
+//			        par le simulateur.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <xc.h>
+#include "system/clk/sys_clk.h"
+#include "system/clk/sys_clk_static.h"
+#include "system/ports/sys_ports.h"
+#include "system/excep/sys_excep.h"
+#include "system_watchdog.h"
+
+// Comme system_definitions.h du firmware
+typedef enum
+{
+    SYS_BOOT_STAGE_ENTRY = 0,
+    SYS_BOOT_STAGE_CLK,
+    SYS_BOOT_STAGE_DEVCON,
+    SYS_BOOT_STAGE_BSP,
+    SYS_BOOT_STAGE_ADC,
+    SYS_BOOT_STAGE_TMR,
+    SYS_BOOT_STAGE_PORTS,
+    SYS_BOOT_STAGE_INT,
+    SYS_BOOT_STAGE_APP,
+    SYS_BOOT_STAGE_CONTROL,
+    SYS_BOOT_STAGE_LCD,
+    SYS_BOOT_STAGE_NB
+
+} SYS_BOOT_STAGE;
+
+#define SYS_BOOT_TICKS_PER_US       (SYS_CLK_FREQ / 2000000ul)
+
+typedef struct
+{
+    uint32_t entryTicks;
+    uint32_t validMask;
+    uint32_t stageTicks[SYS_BOOT_STAGE_NB];
+
+} SYS_BOOT_REPORT;
+
+void SYS_BOOT_StageMark(SYS_BOOT_STAGE stage);
+void SYS_BOOT_ReportGet(SYS_BOOT_REPORT *pReport);
+
+// Timer 1 (100 ms), App_Timer1Callback appele par le simulateur
+void DRV_TMR0_Start(void);
+
+#include "app.h"
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef SIM_XC_H
+#define SIM_XC_H
+/*--------------------------------------------------------*/
+// xc.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Remplace <xc.h> pour la simulation sur PC.
+//			        Le core timer est un compteur avance par le simulateur,
+//			        et de simCoreTicsPerRead a chaque lecture (cout modele
+//			        du code mesure, 0 par defaut).
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+extern volatile uint32_t simCoreCount;
+extern uint32_t simCoreTicsPerRead;
+
+#define _CP0_GET_COUNT()    (simCoreCount += simCoreTicsPerRead)
+
+// RCON : cause du dernier reset
+extern volatile uint32_t simRcon;
+
+#define RCON                (simRcon)
+#define _RCON_POR_MASK      0x00000001
+#define _RCON_BOR_MASK      0x00000002
+
+// Registres LATxCLR (ports A et B) : bits a mettre a 0 dans le latch
+extern volatile uint32_t simLatClr[2];
+
+#define LATACLR             (simLatClr[0])
+#define LATBCLR             (simLatClr[1])
+
+// OC1RS : rapport cyclique de la PWM (plib_oc.h)
+extern volatile uint32_t simOcRs[1];
+
+#define OC1RS               (simOcRs[0])
+
+#endif
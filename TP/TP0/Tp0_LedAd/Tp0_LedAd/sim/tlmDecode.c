@@ -0,0 +1,235 @@
+/*--------------------------------------------------------*/
+// tlmDecode.c
+/*--------------------------------------------------------*/
+//	Description :	Decodeur PC de la telemetrie du TP0 : trames COBS
+//			        separees par 0x00, CRC16, echantillons ADC
+//			        horodates (telemetryFrame.c du firmware).
+//
+//	Utilisation :	tlmDecode [-b baud] [-t s] [-c] port
+//			        port : port serie (/dev/ttyUSB0) ou pty de
+//			               simTelemetry (/tmp/tlm0)
+//			        -c   : echantillons en CSV sur stdout
+//			        -t   : duree max. de la mesure (defaut : jusqu'a
+//			               la fermeture du port)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+#include "telemetryFrame.h"
+
+#define DEC_MAX_FRAME   1024
+
+typedef struct {
+    uint32_t nbFrames;      // trames valides
+    uint32_t nbErrors;      // COBS, CRC ou entete invalides
+    uint32_t nbLost;        // trous dans les numeros de trame
+    uint32_t nbSamples;
+    uint64_t nbBytes;       // octets recus, separateurs compris
+    uint64_t firstUs;       // reception de la 1re / derniere trame
+    uint64_t lastUs;
+    uint32_t firstStampUs;  // horodatage carte, 1er / dernier echantillon
+    uint32_t lastStampUs;
+} S_decStats;
+
+static uint64_t DEC_NowUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static speed_t DEC_Speed(uint32_t baud)
+{
+    switch (baud)
+    {
+        case 9600:      return B9600;
+        case 19200:     return B19200;
+        case 38400:     return B38400;
+        case 57600:     return B57600;
+        case 115200:    return B115200;
+        case 230400:    return B230400;
+        case 460800:    return B460800;
+        case 921600:    return B921600;
+        default:        return B0;
+    }
+}
+
+static int DEC_Open(const char *port, uint32_t baud)
+{
+    struct termios tio;
+    int fd = open(port, O_RDONLY | O_NOCTTY);
+
+    if (fd < 0)
+    {
+        perror(port);
+        exit(1);
+    }
+    if (isatty(fd) && (tcgetattr(fd, &tio) == 0))
+    {
+        cfmakeraw(&tio);
+        if (DEC_Speed(baud) != B0)
+        {
+            cfsetispeed(&tio, DEC_Speed(baud));
+            cfsetospeed(&tio, DEC_Speed(baud));
+        }
+        tio.c_cflag |= CLOCAL | CREAD;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+static void DEC_Frame(const uint8_t *pCobs, uint16_t len, S_decStats *pStats,
+                      bool csv, bool *pSeqValid, uint16_t *pNextSeq)
+{
+    uint8_t raw[DEC_MAX_FRAME];
+    uint16_t chan[TFRM_MAX_CHAN];
+    S_tfrmHeader header;
+    S_tfrmReader reader;
+    uint32_t stampUs;
+    uint16_t rawLen;
+    uint8_t i;
+
+    rawLen = TFRM_CobsDecode(pCobs, len, raw);
+    if ((rawLen == 0) || !TFRM_Open(&reader, &header, raw, rawLen))
+    {
+        pStats->nbErrors++;
+        return;
+    }
+
+    if (*pSeqValid)
+    {
+        pStats->nbLost += (uint16_t)(header.seq - *pNextSeq);
+    }
+    *pSeqValid = true;
+    *pNextSeq = header.seq + 1;
+
+    while (TFRM_Next(&reader, &stampUs, chan))
+    {
+        if (pStats->nbSamples == 0)
+        {
+            pStats->firstStampUs = stampUs;
+        }
+        pStats->lastStampUs = stampUs;
+        pStats->nbSamples++;
+        if (csv)
+        {
+            printf("%u", stampUs);
+            for (i = 0; i < header.nbChan; i++)
+            {
+                printf(",%u", chan[i]);
+            }
+            printf("\n");
+        }
+    }
+
+    if (pStats->nbFrames == 0)
+    {
+        pStats->firstUs = DEC_NowUs();
+    }
+    pStats->lastUs = DEC_NowUs();
+    pStats->nbFrames++;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t baud = 115200;
+    uint32_t durationS = 0;
+    bool csv = false;
+    const char *port = NULL;
+    uint8_t rx[512];
+    uint8_t cobs[DEC_MAX_FRAME];
+    uint16_t cobsLen = 0;
+    bool overflow = false;
+    bool seqValid = false;
+    uint16_t nextSeq = 0;
+    S_decStats stats;
+    struct pollfd pfd;
+    uint64_t startUs;
+    double rxS, boardS;
+    ssize_t nb;
+    ssize_t k;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc))       baud = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))  durationS = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-c") == 0)                      csv = true;
+        else                                                      port = argv[i];
+    }
+    if (port == NULL)
+    {
+        fprintf(stderr, "utilisation : tlmDecode [-b baud] [-t s] [-c] port\n");
+        return 1;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    pfd.fd = DEC_Open(port, baud);
+    pfd.events = POLLIN;
+    startUs = DEC_NowUs();
+
+    while ((durationS == 0) || (DEC_NowUs() - startUs < (uint64_t)durationS * 1000000u))
+    {
+        if (poll(&pfd, 1, 100) <= 0)
+        {
+            continue;
+        }
+        nb = read(pfd.fd, rx, sizeof(rx));
+        if (nb <= 0)
+        {
+            break;      // port ferme (fin de simTelemetry)
+        }
+        stats.nbBytes += nb;
+
+        for (k = 0; k < nb; k++)
+        {
+            if (rx[k] == 0x00)
+            {
+                // Fin de trame ; une trame trop longue est une erreur
+                if (overflow)
+                {
+                    stats.nbErrors++;
+                }
+                else if (cobsLen > 0)
+                {
+                    DEC_Frame(cobs, cobsLen, &stats, csv, &seqValid, &nextSeq);
+                }
+                cobsLen = 0;
+                overflow = false;
+            }
+            else if (cobsLen < sizeof(cobs))
+            {
+                cobs[cobsLen++] = rx[k];
+            }
+            else
+            {
+                overflow = true;
+            }
+        }
+    }
+
+    rxS = (stats.lastUs - stats.firstUs) / 1e6;
+    boardS = (stats.lastStampUs - stats.firstStampUs) / 1e6;
+    fprintf(stderr, "%u trames, %u erreurs, %u perdues, %u echantillons, %llu octets\n",
+            stats.nbFrames, stats.nbErrors, stats.nbLost, stats.nbSamples,
+            (unsigned long long)stats.nbBytes);
+    if ((stats.nbFrames > 1) && (rxS > 0) && (boardS > 0))
+    {
+        fprintf(stderr, "reception %.0f echantillons/s, %.0f octets/s ; carte %.0f echantillons/s\n",
+                stats.nbSamples / rxS, stats.nbBytes / rxS, stats.nbSamples / boardS);
+    }
+    return (stats.nbErrors == 0) ? 0 : 2;
+}
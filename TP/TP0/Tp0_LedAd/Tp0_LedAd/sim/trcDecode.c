@@ -0,0 +1,436 @@
+/*--------------------------------------------------------*/
+// trcDecode.c
+/*--------------------------------------------------------*/
+//	Description :	Decodeur PC de la trace d'evenements du TP0
+//			        (eventTrace.h) : dump binaire de trcLog,
+//			        chronologie, statistiques par evenement,
+//			        latences, export pour ui.perfetto.dev.
+//
+//	Utilisation :	trcDecode [-t] [-j trace.json] [-l A:B]... dump
+//			        dump : export binaire de trcLog (debugger) ou
+//			               fichier ecrit par simTrace
+//			        -t   : chronologie sur stdout
+//			        -j   : evenements au format Trace Event (JSON)
+//			        -l   : latence de chaque evenement A au B suivant
+//			               (defaut TMR1_ISR:APP_SERVICE)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <math.h>
+#include "eventTrace.h"
+
+#define DEC_MAX_LATENCIES   8
+#define DEC_HEADER_SIZE     offsetof(S_traceLog, rec)
+
+typedef struct {
+    uint64_t tics;          // horodatage deroule (plus de rebouclage)
+    uint16_t id;
+    bool end;
+    uint16_t arg;
+} S_decEvent;
+
+// Min / moyenne / max d'une serie de durees en tics
+typedef struct {
+    uint32_t nb;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+} S_decSeries;
+
+typedef struct {
+    S_decSeries period;     // entre debuts (ou evenements ponctuels)
+    S_decSeries duration;   // intervalles BEGIN -> END
+    S_decSeries exclusive;  // idem, ISR deduites (contexte principal)
+    bool open;
+    uint64_t openTics;
+    uint64_t openIsrTics;
+    uint64_t lastTics;
+    bool seen;
+    uint32_t nbUnmatched;   // END sans BEGIN (debut de l'anneau) ou BEGIN double
+} S_decEventStats;
+
+typedef struct {
+    uint16_t from;
+    uint16_t to;
+    bool pending;
+    uint64_t fromTics;
+    S_decSeries series;
+} S_decLatency;
+
+#define TRC_EVT_NAME(name, ctx) #name,
+#define TRC_EVT_CTX(name, ctx)  ctx,
+static const char *eventNames[TRC_NB_EVENTS] = { TRC_EVENTS(TRC_EVT_NAME) };
+static const uint8_t eventCtx[TRC_NB_EVENTS] = { TRC_EVENTS(TRC_EVT_CTX) };
+
+static double ticsPerUs;
+
+static void DEC_SeriesAdd(S_decSeries *pSeries, uint64_t value)
+{
+    if ((pSeries->nb == 0) || (value < pSeries->min)) pSeries->min = value;
+    if ((pSeries->nb == 0) || (value > pSeries->max)) pSeries->max = value;
+    pSeries->sum += value;
+    pSeries->nb++;
+}
+
+static void DEC_SeriesPrint(const char *label, const S_decSeries *pSeries)
+{
+    if (pSeries->nb > 0)
+    {
+        printf("    %-10s %5u  min %10.3f  moy %10.3f  max %10.3f us\n", label, pSeries->nb,
+               pSeries->min / ticsPerUs, (double)pSeries->sum / pSeries->nb / ticsPerUs,
+               pSeries->max / ticsPerUs);
+    }
+}
+
+static int DEC_EventId(const char *name)
+{
+    int id;
+
+    for (id = 0; id < TRC_NB_EVENTS; id++)
+    {
+        if (strcmp(name, eventNames[id]) == 0)
+        {
+            return id;
+        }
+    }
+    return -1;
+}
+
+// "A:B" -> latence de A au B suivant
+static bool DEC_ParseLatency(char *spec, S_decLatency *pLat)
+{
+    char *sep = strchr(spec, ':');
+    int from, to;
+
+    if (sep == NULL)
+    {
+        return false;
+    }
+    *sep = '\0';
+    from = DEC_EventId(spec);
+    to = DEC_EventId(sep + 1);
+    *sep = ':';
+    if ((from < 0) || (to < 0))
+    {
+        return false;
+    }
+    memset(pLat, 0, sizeof(*pLat));
+    pLat->from = (uint16_t)from;
+    pLat->to = (uint16_t)to;
+    return true;
+}
+
+// Dump : en-tete de S_traceLog puis size enregistrements. Evenements
+// du plus ancien au plus recent, horodatages deroules et tries (une
+// ISR entre horodatage et reservation inverse deux enregistrements).
+// Avant un CLK_CHANGE, ecarts ramenes a coreClockHz (frequence du
+// plus recent) depuis l'ancienne frequence, son argument.
+static S_decEvent *DEC_Load(const char *path, S_traceLog *pHeader, uint32_t *pNb)
+{
+    FILE *f = fopen(path, "rb");
+    S_traceRecord *pRec;
+    S_decEvent *pEvt;
+    S_decEvent tmp;
+    uint32_t nb, first, i, j;
+    double scale = 1.0;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+    if ((fread(pHeader, 1, DEC_HEADER_SIZE, f) != DEC_HEADER_SIZE)
+        || (pHeader->magic != TRC_MAGIC) || (pHeader->recordSize != sizeof(S_traceRecord))
+        || (pHeader->size == 0) || ((pHeader->size & (pHeader->size - 1)) != 0)
+        || (pHeader->coreClockHz == 0))
+    {
+        fprintf(stderr, "%s : en-tete de trace invalide\n", path);
+        fclose(f);
+        return NULL;
+    }
+    pRec = malloc(pHeader->size * sizeof(S_traceRecord));
+    if ((pRec == NULL) || (fread(pRec, sizeof(S_traceRecord), pHeader->size, f) != pHeader->size))
+    {
+        fprintf(stderr, "%s : trace tronquee\n", path);
+        fclose(f);
+        free(pRec);
+        return NULL;
+    }
+    fclose(f);
+
+    nb = (pHeader->head < pHeader->size) ? pHeader->head : pHeader->size;
+    first = pHeader->head - nb;
+    pEvt = malloc((nb + 1) * sizeof(S_decEvent));
+    if (pEvt == NULL)
+    {
+        free(pRec);
+        return NULL;
+    }
+    for (i = 0; i < nb; i++)
+    {
+        const S_traceRecord *pR = &pRec[(first + i) & (pHeader->size - 1)];
+
+        pEvt[i].tics = (i == 0) ? pR->tics
+                       : pEvt[i - 1].tics + (int64_t)(int32_t)(pR->tics
+                                                               - (uint32_t)pEvt[i - 1].tics);
+        pEvt[i].id = pR->event & ~TRC_END_FLAG;
+        pEvt[i].end = (pR->event & TRC_END_FLAG) != 0;
+        pEvt[i].arg = pR->arg;
+    }
+    free(pRec);
+
+    // Ecarts mis a l'echelle du plus recent au plus ancien, puis cumules
+    for (i = nb; i-- > 1; )
+    {
+        if ((pEvt[i].id == TRC_EVT_CLK_CHANGE) && !pEvt[i].end && (pEvt[i].arg != 0))
+        {
+            scale = pHeader->coreClockHz / (pEvt[i].arg * 1000.0);
+        }
+        pEvt[i].tics = (uint64_t)llround((int64_t)(pEvt[i].tics - pEvt[i - 1].tics) * scale);
+    }
+    for (i = 1; i < nb; i++)
+    {
+        pEvt[i].tics += pEvt[i - 1].tics;
+    }
+
+    // Tri par insertion, stable : la trace est presque triee
+    for (i = 1; i < nb; i++)
+    {
+        tmp = pEvt[i];
+        for (j = i; (j > 0) && (pEvt[j - 1].tics > tmp.tics); j--)
+        {
+            pEvt[j] = pEvt[j - 1];
+        }
+        pEvt[j] = tmp;
+    }
+    *pNb = nb;
+    return pEvt;
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *freezeNames[] = { "non", "utilisateur", "watchdog", "exception" };
+    S_traceLog header;
+    S_decEvent *pEvt;
+    S_decEventStats stats[TRC_NB_EVENTS];
+    S_decLatency latencies[DEC_MAX_LATENCIES];
+    char defaultLatency[] = "TMR1_ISR:APP_SERVICE";
+    const char *dumpPath = NULL;
+    const char *jsonPath = NULL;
+    FILE *json = NULL;
+    bool timeline = false;
+    bool jsonFirst = true;
+    uint32_t nbLatencies = 0;
+    uint32_t nb = 0, nbErrors = 0, i, k;
+    uint64_t isrTics = 0;       // duree cumulee des ISR
+    uint64_t dur;
+    int depth = 0;
+    int argi;
+
+    for (argi = 1; argi < argc; argi++)
+    {
+        if (strcmp(argv[argi], "-t") == 0)
+        {
+            timeline = true;
+        }
+        else if ((strcmp(argv[argi], "-j") == 0) && (argi + 1 < argc))
+        {
+            jsonPath = argv[++argi];
+        }
+        else if ((strcmp(argv[argi], "-l") == 0) && (argi + 1 < argc)
+                 && (nbLatencies < DEC_MAX_LATENCIES))
+        {
+            if (!DEC_ParseLatency(argv[++argi], &latencies[nbLatencies++]))
+            {
+                fprintf(stderr, "latence %s : evenements inconnus\n", argv[argi]);
+                return 1;
+            }
+        }
+        else
+        {
+            dumpPath = argv[argi];
+        }
+    }
+    if (dumpPath == NULL)
+    {
+        fprintf(stderr, "trcDecode [-t] [-j trace.json] [-l A:B]... dump\n");
+        return 1;
+    }
+    if (nbLatencies == 0)
+    {
+        DEC_ParseLatency(defaultLatency, &latencies[nbLatencies++]);
+    }
+
+    pEvt = DEC_Load(dumpPath, &header, &nb);
+    if (pEvt == NULL)
+    {
+        return 1;
+    }
+    ticsPerUs = header.coreClockHz / 1e6;
+
+    if (jsonPath != NULL)
+    {
+        json = fopen(jsonPath, "w");
+        if (json == NULL)
+        {
+            perror(jsonPath);
+            return 1;
+        }
+        fprintf(json, "{\"traceEvents\":[\n");
+    }
+
+    memset(stats, 0, sizeof(stats));
+    for (i = 0; i < nb; i++)
+    {
+        const S_decEvent *pE = &pEvt[i];
+        S_decEventStats *pS;
+        bool matched = true;
+
+        if (pE->id >= TRC_NB_EVENTS)
+        {
+            nbErrors++;
+            continue;
+        }
+        pS = &stats[pE->id];
+
+        if (pE->end)
+        {
+            if (pS->open)
+            {
+                dur = pE->tics - pS->openTics;
+                DEC_SeriesAdd(&pS->duration, dur);
+                if (eventCtx[pE->id] == TRC_CTX_ISR)
+                {
+                    isrTics += dur;
+                }
+                else
+                {
+                    DEC_SeriesAdd(&pS->exclusive, dur - (isrTics - pS->openIsrTics));
+                }
+                pS->open = false;
+                depth--;
+            }
+            else
+            {
+                pS->nbUnmatched++;
+                matched = false;
+            }
+        }
+        else
+        {
+            if (pS->seen)
+            {
+                DEC_SeriesAdd(&pS->period, pE->tics - pS->lastTics);
+            }
+            pS->seen = true;
+            pS->lastTics = pE->tics;
+
+            for (k = 0; k < nbLatencies; k++)
+            {
+                if ((pE->id == latencies[k].to) && latencies[k].pending)
+                {
+                    DEC_SeriesAdd(&latencies[k].series, pE->tics - latencies[k].fromTics);
+                    latencies[k].pending = false;
+                }
+                if (pE->id == latencies[k].from)
+                {
+                    latencies[k].pending = true;
+                    latencies[k].fromTics = pE->tics;
+                }
+            }
+        }
+
+        if (timeline)
+        {
+            printf("%12.3f %+10.3f  %*s%-12s %-5s %u\n",
+                   (pE->tics - pEvt[0].tics) / ticsPerUs,
+                   (i > 0) ? (pE->tics - pEvt[i - 1].tics) / ticsPerUs : 0.0,
+                   2 * (depth + (pE->end ? 1 : 0)), "", eventNames[pE->id],
+                   pE->end ? "fin" : "", pE->arg);
+        }
+        if ((json != NULL) && matched)
+        {
+            fprintf(json, "%s{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":0,\"tid\":%u,"
+                    "\"args\":{\"arg\":%u}}", jsonFirst ? "" : ",\n",
+                    eventNames[pE->id], pE->end ? "E" : "B",
+                    (pE->tics - pEvt[0].tics) / ticsPerUs, eventCtx[pE->id], pE->arg);
+            jsonFirst = false;
+        }
+
+        // Debut d'intervalle ; un evenement ponctuel ne s'ouvre pas
+        if (!pE->end)
+        {
+            // Evenement ponctuel si aucun END ne suit avant le prochain debut
+            for (k = i + 1; (k < nb) && (pEvt[k].id != pE->id); k++)
+            {
+            }
+            if ((k < nb) && pEvt[k].end)
+            {
+                if (pS->open)
+                {
+                    pS->nbUnmatched++;
+                }
+                pS->open = true;
+                pS->openTics = pE->tics;
+                pS->openIsrTics = isrTics;
+                depth++;
+            }
+            else if (json != NULL)
+            {
+                // Ponctuel : "B" ecrit ci-dessus ferme aussitot
+                fprintf(json, ",\n{\"name\":\"%s\",\"ph\":\"E\",\"ts\":%.3f,\"pid\":0,\"tid\":%u}",
+                        eventNames[pE->id], (pE->tics - pEvt[0].tics) / ticsPerUs,
+                        eventCtx[pE->id]);
+            }
+        }
+    }
+    if (json != NULL)
+    {
+        fprintf(json, "\n]}\n");
+        fclose(json);
+    }
+
+    printf("Trace %s : %u enregistrements (%u ecrits, anneau de %u), %.3f ms, gel : %s\n",
+           dumpPath, nb, header.head, header.size,
+           (nb > 0) ? (pEvt[nb - 1].tics - pEvt[0].tics) / ticsPerUs / 1000.0 : 0.0,
+           (header.frozen < sizeof(freezeNames) / sizeof(freezeNames[0]))
+           ? freezeNames[header.frozen] : "?");
+    printf("Cout d'un enregistrement : %.2f tics (%.1f cycles CPU)\n",
+           header.costTics / 16.0, header.costTics / 8.0);
+    for (i = 0; i < TRC_NB_EVENTS; i++)
+    {
+        if (stats[i].seen || stats[i].nbUnmatched)
+        {
+            printf("  %s%s\n", eventNames[i],
+                   stats[i].nbUnmatched ? " (intervalles coupes par l'anneau)" : "");
+            DEC_SeriesPrint("periode", &stats[i].period);
+            DEC_SeriesPrint("duree", &stats[i].duration);
+            if (eventCtx[i] != TRC_CTX_ISR)
+            {
+                DEC_SeriesPrint("hors ISR", &stats[i].exclusive);
+            }
+        }
+    }
+    for (k = 0; k < nbLatencies; k++)
+    {
+        printf("  latence %s -> %s\n", eventNames[latencies[k].from], eventNames[latencies[k].to]);
+        DEC_SeriesPrint("", &latencies[k].series);
+    }
+
+    free(pEvt);
+    if (nbErrors > 0)
+    {
+        fprintf(stderr, "%u evenements inconnus\n", nbErrors);
+        return 1;
+    }
+    return 0;
+}
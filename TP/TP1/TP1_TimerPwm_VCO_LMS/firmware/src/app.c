@@ -54,6 +54,10 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 
 #include "app.h"
+#include "gestRegul.h"
+#include "gestInput.h"
+#include "gestUsbStream.h"
+#include "Mc32DriverLcd.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -97,6 +101,57 @@ APP_DATA appData;
 /* TODO:  Add any necessary local functions.
 */
 
+// Ligne 4 du LCD : exception qui a provoque le dernier reset
+// (enregistrement de sys_excep.c, valide par SYS_EXCEP_CrashRecordCheck)
+static void APP_ShowCrashReport(void)
+{
+    SYS_CRASH_RECORD crash;
+
+    if (SYS_EXCEP_CrashRecordGet(&crash))
+    {
+        lcd_gotoxy(1,4);
+        printf_lcd("Exc%2u EPC %08X", (unsigned)crash.cause, (unsigned)crash.epc);
+    }
+}
+
+// appData.buttonsDown : un bit par bouton
+typedef char APP_CheckButtons[(GINP_NB_BUTTONS <= 8) ? 1 : -1];
+
+// Vide la file des boutons : OK bascule la regulation (boucle
+// fermee / ouverte), un appui long sur ESC la coupe
+static void APP_ServiceInputs(void)
+{
+    S_inputEvent event;
+
+    while (GINP_GetEvent(&event))
+    {
+        switch (event.type)
+        {
+            case GINP_EV_PRESS:
+                appData.buttonsDown |= (uint8_t)(1u << event.button);
+                if (event.button == GINP_BTN_OK)
+                {
+                    GREG_SetClosedLoop(!GREG_IsClosedLoop());
+                }
+                break;
+
+            case GINP_EV_RELEASE:
+                appData.buttonsDown &= (uint8_t)~(1u << event.button);
+                break;
+
+            case GINP_EV_LONG_PRESS:
+                if (event.button == GINP_BTN_ESC)
+                {
+                    GREG_SetClosedLoop(false);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -116,7 +171,16 @@ void APP_Initialize ( void )
 {
     /* Place the App state machine in its initial state. */
     appData.state = APP_STATE_INIT;
+    appData.buttonsDown = 0;
 
+    // Tic 1 ms du Timer4 : anti-rebond des boutons
+    GREG_TickStart();
+
+    // Boutons : evenements lus par APP_ServiceInputs dans APP_Tasks
+    GINP_Initialize();
+
+    // Telemetrie USB CDC : ADC1 a 40 kech/s, flux des l'ouverture du port
+    GUSB_Initialize();
     
     /* TODO: Initialize your application's state machine and other
      * parameters.
@@ -142,8 +206,11 @@ void APP_Tasks ( void )
         case APP_STATE_INIT:
         {
             bool appInitialized = true;
-       
-        
+
+            lcd_init();
+            lcd_bl_on();
+            APP_ShowCrashReport();
+
             if (appInitialized)
             {
             
@@ -154,14 +221,8 @@ void APP_Tasks ( void )
 
         case APP_STATE_SERVICE_TASKS:
         {
-            // LMS_TP1
-            // Test sync
-=======
-        
-            if (static char car)
-            {
-              car++;
-            }
+            APP_ServiceInputs();
+            GUSB_Tasks();
             break;
         }
 
@@ -113,6 +113,9 @@ typedef struct
     /* The application's current state */
     APP_STATES state;
 
+    // Boutons appuyes (bit = E_InputButton), d'apres les evenements
+    uint8_t buttonsDown;
+
     /* TODO: Define any additional data used by the application. */
 
 } APP_DATA;
@@ -0,0 +1,245 @@
+/*--------------------------------------------------------*/
+// GestInput.c
+/*--------------------------------------------------------*/
+//	Description :	Boutons du kit sur interruption change notice (CN)
+//			        anti-rebond par integrateurs, file d'evenements
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include "gestInput.h"
+#include "hotPath.h"
+#include "system/ports/sys_ports_pins.h"
+#include "peripheral/ports/plib_ports.h"
+#include "peripheral/int/plib_int.h"
+
+#define GINP_CORE_TICS_PER_MS   (SYS_CLK_FREQ / 2000)
+#define GINP_LONG_PRESS_TICS    (GINP_LONG_PRESS_MS * GINP_CORE_TICS_PER_MS)
+#define GINP_QUEUE_MASK         (GINP_QUEUE_SIZE - 1)
+
+// Broche de chaque bouton, depuis la table des broches
+typedef struct {
+    uint8_t channel;
+    uint8_t bit;
+} S_inputPin;
+
+#define GINP_BUTTON_PIN(name, pin, cn) \
+    { SYS_PIN_##pin##_CHANNEL, SYS_PIN_##pin##_BIT },
+
+static const S_inputPin inputPins[GINP_NB_BUTTONS] = {
+    GINP_BUTTON_TABLE(GINP_BUTTON_PIN)
+};
+
+// Etat anti-rebond, 1 bit par bouton (1 = appuye)
+static volatile bool sampling = false;     // echantillonnage actif (ISR Timer4)
+static volatile uint32_t debounced = 0;    // etat valide
+static uint32_t pending = 0;               // flanc en cours de validation
+static uint32_t longDone = 0;              // appui long deja publie
+static uint8_t integ[GINP_NB_BUTTONS];     // 0 = relache, GINP_DEBOUNCE_MS = appuye
+static uint32_t edgeStamp[GINP_NB_BUTTONS];
+static uint32_t pressStamp[GINP_NB_BUTTONS];
+
+// File d'evenements : ecrite par l'ISR du Timer4, lue par la boucle principale
+static S_inputEvent queue[GINP_QUEUE_SIZE];
+static volatile uint8_t queueHead = 0;
+static volatile uint8_t queueTail = 0;
+
+static S_inputStats stats;
+
+// Lit les boutons (1 = appuye, actifs bas). La lecture des ports
+// acquitte aussi la condition de changement du module CN.
+static HOT_RAMFUNC uint32_t GINP_ReadRaw(void)
+{
+    uint32_t raw = 0;
+    uint8_t i;
+
+    for (i = 0; i < GINP_NB_BUTTONS; i++)
+    {
+        if (!PLIB_PORTS_PinGet(PORTS_ID_0, (PORTS_CHANNEL)inputPins[i].channel,
+                               (PORTS_BIT_POS)inputPins[i].bit))
+        {
+            raw |= (1u << i);
+        }
+    }
+    return raw;
+}
+
+// Note l'instant du 1er flanc de chaque bouton qui differe de l'etat valide
+static HOT_RAMFUNC void GINP_StampEdges(uint32_t raw, uint32_t now)
+{
+    uint32_t newEdges = (raw ^ debounced) & ~pending;
+    uint8_t i;
+
+    for (i = 0; (i < GINP_NB_BUTTONS) && (newEdges != 0); i++)
+    {
+        if (newEdges & (1u << i))
+        {
+            edgeStamp[i] = now;
+        }
+    }
+    pending |= newEdges;
+}
+
+static HOT_RAMFUNC void GINP_Publish(uint8_t button, E_InputEventType type,
+                                      uint32_t stamp, uint32_t now)
+{
+    uint8_t next = (queueHead + 1) & GINP_QUEUE_MASK;
+
+    if ((now - stamp) > stats.maxLatency)
+    {
+        stats.maxLatency = now - stamp;
+    }
+
+    if (next == queueTail)
+    {
+        stats.nbOverflows++;
+        return;
+    }
+    queue[queueHead].button = button;
+    queue[queueHead].type = type;
+    queue[queueHead].stamp = stamp;
+    queueHead = next;
+    stats.nbEvents++;
+}
+
+void GINP_Initialize(void)
+{
+    uint8_t i;
+
+    // Etat de depart sans evenement, y compris bouton tenu au demarrage
+    debounced = GINP_ReadRaw();
+    pending = 0;
+    longDone = debounced;
+    for (i = 0; i < GINP_NB_BUTTONS; i++)
+    {
+        integ[i] = (debounced & (1u << i)) ? GINP_DEBOUNCE_MS : 0;
+    }
+    queueHead = 0;
+    queueTail = 0;
+    sampling = false;
+
+    // Broches CN et pull-up : SYS_PORT_CNEN / SYS_PORT_CNPUE (SYS_PORTS_Initialize)
+    PLIB_INT_VectorPrioritySet(INT_ID_0, INT_VECTOR_CN, INT_PRIORITY_LEVEL2);
+    PLIB_INT_VectorSubPrioritySet(INT_ID_0, INT_VECTOR_CN, INT_SUBPRIORITY_LEVEL0);
+    PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_CHANGE_NOTICE);
+    PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_CHANGE_NOTICE);
+}
+
+// Lecture d'un evenement par la boucle principale
+bool GINP_GetEvent(S_inputEvent *pEvent)
+{
+    uint8_t tail = queueTail;
+
+    if (tail == queueHead)
+    {
+        return false;
+    }
+    *pEvent = queue[tail];
+    queueTail = (tail + 1) & GINP_QUEUE_MASK;
+    return true;
+}
+
+bool GINP_IsPressed(E_InputButton button)
+{
+    return (debounced & (1u << button)) != 0;
+}
+
+void GINP_GetStats(S_inputStats *pStats)
+{
+    *pStats = stats;
+}
+
+// 1er flanc : les rebonds suivants sont vus par l'echantillonnage,
+// l'interruption CN est masquee jusqu'a stabilisation
+HOT_RAMFUNC void GINP_ChangeCallback(void)
+{
+    uint32_t now = _CP0_GET_COUNT();
+
+    PLIB_INT_SourceDisable(INT_ID_0, INT_SOURCE_CHANGE_NOTICE);
+    GINP_StampEdges(GINP_ReadRaw(), now);
+    stats.nbWakeUps++;
+    sampling = true;
+}
+
+// Integrateurs, toutes les 1 ms tant qu'un bouton n'est pas stable
+HOT_RAMFUNC void GINP_SampleCallback(void)
+{
+    uint32_t now, raw, mask;
+    bool settled = true;
+    uint8_t i;
+
+    if (!sampling)
+    {
+        return;
+    }
+    now = _CP0_GET_COUNT();
+    raw = GINP_ReadRaw();
+    GINP_StampEdges(raw, now);
+    stats.nbSamples++;
+
+    for (i = 0; i < GINP_NB_BUTTONS; i++)
+    {
+        mask = 1u << i;
+
+        if (raw & mask)
+        {
+            if (integ[i] < GINP_DEBOUNCE_MS)
+            {
+                integ[i]++;
+            }
+        }
+        else if (integ[i] > 0)
+        {
+            integ[i]--;
+        }
+
+        if ((integ[i] == GINP_DEBOUNCE_MS) && !(debounced & mask))
+        {
+            debounced |= mask;
+            longDone &= ~mask;
+            pressStamp[i] = now;
+            GINP_Publish(i, GINP_EV_PRESS, edgeStamp[i], now);
+        }
+        else if ((integ[i] == 0) && (debounced & mask))
+        {
+            debounced &= ~mask;
+            GINP_Publish(i, GINP_EV_RELEASE, edgeStamp[i], now);
+        }
+        else if ((integ[i] != 0) && (integ[i] != GINP_DEBOUNCE_MS))
+        {
+            settled = false;
+            continue;
+        }
+
+        // Integrateur en butee : flanc valide ou rebond ecarte
+        pending &= ~mask;
+
+        // Appui long : echantillonnage maintenu jusqu'a la publication
+        if ((debounced & mask) && !(longDone & mask))
+        {
+            if ((now - pressStamp[i]) >= GINP_LONG_PRESS_TICS)
+            {
+                longDone |= mask;
+                GINP_Publish(i, GINP_EV_LONG_PRESS, now, now);
+            }
+            else
+            {
+                settled = false;
+            }
+        }
+    }
+
+    if (settled)
+    {
+        // Les ports viennent d'etre lus : un changement apres cette
+        // lecture maintient la condition CN et relevera le drapeau.
+        sampling = false;
+        PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_CHANGE_NOTICE);
+        PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_CHANGE_NOTICE);
+    }
+}
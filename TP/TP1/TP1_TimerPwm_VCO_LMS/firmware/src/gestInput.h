@@ -0,0 +1,90 @@
+#ifndef GestInput_H
+#define GestInput_H
+/*--------------------------------------------------------*/
+// GestInput.h
+/*--------------------------------------------------------*/
+//	Description :	Boutons du kit sur interruption change notice (CN)
+//			        anti-rebond par integrateurs, file d'evenements
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+//  Fonctionnement :
+//  - l'ISR CN se declenche au 1er flanc, masque l'interruption CN et
+//    active l'echantillonnage
+//  - GINP_SampleCallback (ISR du Timer4, 1 ms, tic lance par
+//    GREG_TickStart) integre chaque bouton ;
+//    l'etat change quand l'integrateur atteint 0 ou GINP_DEBOUNCE_MS
+//  - une fois les integrateurs stables, l'echantillonnage s'arrete
+//    et l'interruption CN est reactivee
+//  Sans changement des entrees, ni ISR ni boucle principale ne font
+//  de travail (GINP_GetEvent : file vide, retour immediat).
+//  Latence max. flanc -> evenement : fin des rebonds + GINP_DEBOUNCE_MS
+//  + 1 ms (phase du Timer4).
+//
+//  Les boutons sont decrits par GINP_BUTTON_TABLE (system_config.h).
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+#define GINP_DEBOUNCE_MS        5       // pleine echelle des integrateurs (tics de 1 ms)
+#define GINP_LONG_PRESS_MS      1000    // appui long
+#define GINP_QUEUE_SIZE         16      // puissance de 2
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+// Boutons, dans l'ordre de GINP_BUTTON_TABLE
+#define GINP_BUTTON_ID(name, pin, cn)   GINP_BTN_##name,
+typedef enum {
+    GINP_BUTTON_TABLE(GINP_BUTTON_ID)
+    GINP_NB_BUTTONS
+} E_InputButton;
+
+typedef enum {
+    GINP_EV_PRESS = 0,      // appui valide
+    GINP_EV_RELEASE,        // relachement valide
+    GINP_EV_LONG_PRESS,     // appui maintenu GINP_LONG_PRESS_MS
+} E_InputEventType;
+
+typedef struct {
+    uint8_t button;         // E_InputButton
+    uint8_t type;           // E_InputEventType
+    uint32_t stamp;         // core timer au 1er flanc (appui / relachement)
+} S_inputEvent;
+
+// Instrumentation (tics du core timer, SYS_CLK_FREQ / 2)
+typedef struct {
+    uint32_t nbWakeUps;     // reveils par l'ISR CN
+    uint32_t nbSamples;     // echantillonnages effectues
+    uint32_t nbEvents;      // evenements publies
+    uint32_t nbOverflows;   // evenements perdus, file pleine
+    uint32_t maxLatency;    // flanc -> evenement, maximum observe
+} S_inputStats;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+void GINP_Initialize(void);
+bool GINP_GetEvent(S_inputEvent *pEvent);  // false si aucun evenement
+bool GINP_IsPressed(E_InputButton button);
+void GINP_GetStats(S_inputStats *pStats);
+
+void GINP_ChangeCallback(void);     // appelee par l'ISR CN
+void GINP_SampleCallback(void);     // appelee par l'ISR du Timer4
+
+
+#endif
@@ -13,46 +13,331 @@
 
 
 
+#include <xc.h>
 #include "GestPWM.h"
+#include "gestRegul.h"
+#include "hotPath.h"
+#include "system_config.h"
+#include "bsp.h"
+#include "Mc32DriverLcd.h"
+#include "peripheral/oc/plib_oc.h"
+#include "peripheral/tmr/plib_tmr.h"
+#include "peripheral/int/plib_int.h"
 
 S_pwmSettings PWMData;      // pour les settings
 
+// Double tampon de publication des settings : l'ecrivain (boucle
+// principale) remplit le tampon inactif puis bascule l'index en une
+// seule ecriture ; un lecteur en ISR copie toujours un tampon complet.
+static S_pwmSettings pwmSnapshot[2];
+static volatile uint8_t pwmSnapshotIdx = 0;
+
+// Sequencement du pont en H (partage avec l'ISR du Timer5)
+static volatile E_BridgeState bridgeState = GPWM_BRIDGE_RUN;
+static volatile int8_t appliedDir = 0;      // sens applique : -1, 0, +1
+static volatile int8_t lastDrivenDir = 0;   // dernier sens non nul applique
+static volatile int8_t pendingDir = 0;      // sens demande pendant la sequence
+static volatile uint16_t pendingWidth = 0;  // largeur OC2 a appliquer en fin de sequence
+static uint16_t brakeTics = GPWM_BRAKE_TIME_US * GPWM_DT_TICS_PER_US;
+static uint16_t deadTics = GPWM_DEAD_TIME_US * GPWM_DT_TICS_PER_US;
+
+// Applique le sens sur les entrees du pont (0 = roue libre)
+static HOT_RAMFUNC void GPWM_ApplyDir(int8_t dir)
+{
+    if (dir > 0)
+    {
+        AIN1_HBRIDGE_W = 1;
+        AIN2_HBRIDGE_W = 0;
+    }
+    else if (dir < 0)
+    {
+        AIN1_HBRIDGE_W = 0;
+        AIN2_HBRIDGE_W = 1;
+    }
+    else
+    {
+        AIN1_HBRIDGE_W = 0;
+        AIN2_HBRIDGE_W = 0;
+    }
+}
+
+// Lance le Timer5 pour un evenement de comparaison unique apres nbTics
+static HOT_RAMFUNC void GPWM_StartSeqTimer(uint16_t nbTics)
+{
+    PLIB_TMR_Stop(TMR_ID_5);
+    PLIB_TMR_Counter16BitClear(TMR_ID_5);
+    PLIB_TMR_Period16BitSet(TMR_ID_5, (nbTics > 0) ? nbTics : 1);
+    PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_TIMER_5);
+    PLIB_TMR_Start(TMR_ID_5);
+}
+
 void GPWM_Initialize(S_pwmSettings *pData)
 {
-   // Init les data 
-    
+   // Init les data
+   pData->absSpeed = 0;
+   pData->absAngle = 90;
+   pData->SpeedSetting = 0;
+   pData->AngleSetting = 0;
+
    // Init tat du pont en H
-    
+   bridgeState = GPWM_BRIDGE_RUN;
+   appliedDir = 0;
+   lastDrivenDir = 0;
+   pendingDir = 0;
+   GPWM_ApplyDir(0);
+   BSP_EnableHbrige();
+
    // lance les timers et OC
-    
+   // Timer2 : base PWM moteur
+   PLIB_TMR_Stop(TMR_ID_2);
+   PLIB_TMR_ClockSourceSelect(TMR_ID_2, TMR_CLOCK_SOURCE_PERIPHERAL_CLOCK);
+   PLIB_TMR_PrescaleSelect(TMR_ID_2, TMR_PRESCALE_VALUE_1);
+   PLIB_TMR_Mode16BitEnable(TMR_ID_2);
+   PLIB_TMR_Counter16BitClear(TMR_ID_2);
+   PLIB_TMR_Period16BitSet(TMR_ID_2, GPWM_MOTOR_PERIOD);
+
+   // Timer3 : base PWM servo
+   PLIB_TMR_Stop(TMR_ID_3);
+   PLIB_TMR_ClockSourceSelect(TMR_ID_3, TMR_CLOCK_SOURCE_PERIPHERAL_CLOCK);
+   PLIB_TMR_PrescaleSelect(TMR_ID_3, TMR_PRESCALE_VALUE_64);
+   PLIB_TMR_Mode16BitEnable(TMR_ID_3);
+   PLIB_TMR_Counter16BitClear(TMR_ID_3);
+   PLIB_TMR_Period16BitSet(TMR_ID_3, GPWM_SERVO_PERIOD);
+
+   // OC2 : moteur, OC3 : servo
+   PLIB_OC_ModeSelect(OC_ID_2, OC_COMPARE_PWM_MODE_WITHOUT_FAULT_PROTECTION);
+   PLIB_OC_BufferSizeSelect(OC_ID_2, OC_BUFFER_SIZE_16BIT);
+   PLIB_OC_TimerSelect(OC_ID_2, OC_TIMER_16BIT_TMR2);
+   PLIB_OC_Buffer16BitSet(OC_ID_2, 0);
+   PLIB_OC_PulseWidth16BitSet(OC_ID_2, 0);
+
+   PLIB_OC_ModeSelect(OC_ID_3, OC_COMPARE_PWM_MODE_WITHOUT_FAULT_PROTECTION);
+   PLIB_OC_BufferSizeSelect(OC_ID_3, OC_BUFFER_SIZE_16BIT);
+   PLIB_OC_TimerSelect(OC_ID_3, OC_TIMER_16BIT_TMR3);
+   PLIB_OC_Buffer16BitSet(OC_ID_3, 0);
+   PLIB_OC_PulseWidth16BitSet(OC_ID_3,
+           (GPWM_SERVO_MIN_WIDTH + GPWM_SERVO_MAX_WIDTH) / 2);
+
+   // Timer5 : evenements de sequencement, pas de busy-wait
+   PLIB_TMR_Stop(TMR_ID_5);
+   PLIB_TMR_ClockSourceSelect(TMR_ID_5, TMR_CLOCK_SOURCE_PERIPHERAL_CLOCK);
+   PLIB_TMR_PrescaleSelect(TMR_ID_5, TMR_PRESCALE_VALUE_8);
+   PLIB_TMR_Mode16BitEnable(TMR_ID_5);
+   PLIB_INT_VectorPrioritySet(INT_ID_0, INT_VECTOR_T5, INT_PRIORITY_LEVEL4);
+   PLIB_INT_VectorSubPrioritySet(INT_ID_0, INT_VECTOR_T5, INT_SUBPRIORITY_LEVEL0);
+   PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_TIMER_5);
+   PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_TIMER_5);
+
+   PLIB_OC_Enable(OC_ID_2);
+   PLIB_OC_Enable(OC_ID_3);
+   PLIB_TMR_Start(TMR_ID_2);
+   PLIB_TMR_Start(TMR_ID_3);
 }
 
 // Obtention vitesse et angle (mise a jour des 4 champs de la structure)
-void GPWM_GetSettings(S_pwmSettings *pData)	
+void GPWM_GetSettings(S_pwmSettings *pData)
 {
     // Lecture du convertisseur AD
-    
+
     // conversion
-    
+
+    // Publication pour les lecteurs en interruption
+    GPWM_PublishSettings(pData);
+}
+
+// Publie une copie coherente des settings (appel depuis la boucle
+// principale uniquement : l'ecrivain ne doit pas preempter un lecteur)
+void GPWM_PublishSettings(const S_pwmSettings *pData)
+{
+    uint8_t next = pwmSnapshotIdx ^ 1;
+
+    pwmSnapshot[next] = *pData;
+    // La copie doit etre terminee avant la bascule de l'index
+    __asm__ volatile ("" ::: "memory");
+    pwmSnapshotIdx = next;
+}
+
+// Lit la derniere copie publiee, sans masquer les interruptions
+HOT_RAMFUNC void GPWM_GetSnapshot(S_pwmSettings *pData)
+{
+    *pData = pwmSnapshot[pwmSnapshotIdx];
 }
 
 
 // Affichage des information en exploitant la structure
+// Les libelles sont ecrits une seule fois, puis seuls les champs dont la
+// valeur a change sont redessines, au plus tous les GPWM_DISP_PERIOD_MS.
 void GPWM_DispSettings(S_pwmSettings *pData)
 {
-    
+    static bool labelsDone = false;
+    static uint32_t lastRefresh = 0;
+    static int16_t shownSpeed = GPWM_DISP_NO_VALUE;
+    static int16_t shownAbsSpeed = GPWM_DISP_NO_VALUE;
+    static int16_t shownAngle = GPWM_DISP_NO_VALUE;
+    static int16_t shownAbsAngle = GPWM_DISP_NO_VALUE;
+    uint32_t now;
+
+    // Limitation du rafraichissement (core timer a SYS_CLK_FREQ / 2)
+    now = _CP0_GET_COUNT();
+    if (labelsDone && ((now - lastRefresh) <
+            ((SYS_CLK_FREQ / 2 / 1000) * GPWM_DISP_PERIOD_MS)))
+    {
+        return;
+    }
+    lastRefresh = now;
+
+    if (labelsDone == false)
+    {
+        lcd_gotoxy(1,2);
+        printf_lcd("SpeedSetting");
+        lcd_gotoxy(1,3);
+        printf_lcd("absSpeed");
+        lcd_gotoxy(1,4);
+        printf_lcd("Angle       abs");
+        labelsDone = true;
+    }
+
+    if (pData->SpeedSetting != shownSpeed)
+    {
+        shownSpeed = pData->SpeedSetting;
+        lcd_gotoxy(14,2);
+        printf_lcd("%4d", shownSpeed);
+    }
+    if (pData->absSpeed != shownAbsSpeed)
+    {
+        shownAbsSpeed = pData->absSpeed;
+        lcd_gotoxy(14,3);
+        printf_lcd("%4d", shownAbsSpeed);
+    }
+    if (pData->AngleSetting != shownAngle)
+    {
+        shownAngle = pData->AngleSetting;
+        lcd_gotoxy(7,4);
+        printf_lcd("%4d", shownAngle);
+    }
+    if (pData->absAngle != shownAbsAngle)
+    {
+        shownAbsAngle = pData->absAngle;
+        lcd_gotoxy(17,4);
+        printf_lcd("%3d", shownAbsAngle);
+    }
 }
 
 // Execution PWM et gestion moteur  partir des info dans structure
 void GPWM_ExecPWM(S_pwmSettings *pData)
 {
-    
+    int8_t newDir;
+    uint16_t width;
+
+    // Consigne moteur (en boucle fermee, la regulation pilote OC2)
+    if (GREG_IsClosedLoop() == false)
+    {
+        newDir = (pData->SpeedSetting > 0) - (pData->SpeedSetting < 0);
+        width = ((uint32_t)pData->absSpeed * (GPWM_MOTOR_PERIOD + 1)) / 100;
+        GPWM_ExecMotor(newDir, width);
+    }
+
+    // Consigne servo (absAngle 0 a 180)
+    PLIB_OC_PulseWidth16BitSet(OC_ID_3, GPWM_SERVO_MIN_WIDTH +
+            ((uint32_t)pData->absAngle * (GPWM_SERVO_MAX_WIDTH - GPWM_SERVO_MIN_WIDTH)) / 180);
+}
+
+// Applique sens et largeur OC2 au moteur, avec sequence d'inversion.
+// Le sens est compare au dernier sens non nul : apres un passage par
+// 0 (roue libre), le moteur peut encore tourner dans l'ancien sens.
+HOT_RAMFUNC void GPWM_ExecMotor(int8_t newDir, uint16_t width)
+{
+    pendingWidth = width;
+
+    if (bridgeState == GPWM_BRIDGE_RUN)
+    {
+        if ((newDir != 0) && (lastDrivenDir != 0) && (newDir != lastDrivenDir))
+        {
+            // Changement de signe : frein -> temps mort -> reactivation
+            pendingDir = newDir;
+            PLIB_OC_PulseWidth16BitSet(OC_ID_2, 0);
+            AIN1_HBRIDGE_W = 1;
+            AIN2_HBRIDGE_W = 1;
+            bridgeState = GPWM_BRIDGE_BRAKE;
+            GPWM_StartSeqTimer(brakeTics);
+        }
+        else
+        {
+            GPWM_ApplyDir(newDir);
+            appliedDir = newDir;
+            if (newDir != 0)
+            {
+                lastDrivenDir = newDir;
+            }
+            PLIB_OC_PulseWidth16BitSet(OC_ID_2, width);
+        }
+    }
+    else
+    {
+        // Sequence en cours : PWM maintenue a 0, memorise le sens voulu
+        pendingDir = newDir;
+    }
 }
 
 // Execution PWM software
 void GPWM_ExecPWMSoft(S_pwmSettings *pData)
 {
-    
+
 }
 
+// Configure les durees de freinage et de temps mort (en us)
+void GPWM_SetDeadTime(uint16_t brakeTime_us, uint16_t deadTime_us)
+{
+    if (brakeTime_us > GPWM_DT_MAX_US)
+    {
+        brakeTime_us = GPWM_DT_MAX_US;
+    }
+    if (deadTime_us > GPWM_DT_MAX_US)
+    {
+        deadTime_us = GPWM_DT_MAX_US;
+    }
+    brakeTics = brakeTime_us * GPWM_DT_TICS_PER_US;
+    deadTics = deadTime_us * GPWM_DT_TICS_PER_US;
+}
 
+E_BridgeState GPWM_GetBridgeState(void)
+{
+    return bridgeState;
+}
+
+// Sens de rotation probable : garde en roue libre et pendant le frein
+HOT_RAMFUNC int8_t GPWM_GetDriveDir(void)
+{
+    return lastDrivenDir;
+}
+
+// Evenement Timer5 : avance la sequence d'inversion d'une etape
+HOT_RAMFUNC void GPWM_DeadTimeCallback(void)
+{
+    PLIB_TMR_Stop(TMR_ID_5);
+
+    switch (bridgeState)
+    {
+        case GPWM_BRIDGE_BRAKE:
+            // Fin du freinage : toutes les entrees au repos
+            GPWM_ApplyDir(0);
+            bridgeState = GPWM_BRIDGE_DEADTIME;
+            GPWM_StartSeqTimer(deadTics);
+            break;
+
+        case GPWM_BRIDGE_DEADTIME:
+            // Fin du temps mort : reactivation dans le nouveau sens
+            GPWM_ApplyDir(pendingDir);
+            appliedDir = pendingDir;
+            if (pendingDir != 0)
+            {
+                lastDrivenDir = pendingDir;
+            }
+            PLIB_OC_PulseWidth16BitSet(OC_ID_2, (pendingDir != 0) ? pendingWidth : 0);
+            bridgeState = GPWM_BRIDGE_RUN;
+            break;
+
+        default:
+            break;
+    }
+}
@@ -16,8 +16,31 @@
 /*--------------------------------------------------------*/
 
 #include <stdint.h>
+#include <stdbool.h>
 
 
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+// Timer2 / OC2 : PWM moteur 20 kHz (PBCLK 80 MHz, prescaler 1)
+#define GPWM_MOTOR_PERIOD       3999
+
+// Timer3 / OC3 : servo 20 ms (PBCLK 80 MHz, prescaler 64 -> 0.8 us/tic)
+#define GPWM_SERVO_PERIOD       24999
+#define GPWM_SERVO_MIN_WIDTH    750     // 0.6 ms
+#define GPWM_SERVO_MAX_WIDTH    3000    // 2.4 ms
+
+// Timer5 : sequencement inversion pont en H (prescaler 8 -> 10 tics/us)
+#define GPWM_DT_TICS_PER_US     10
+#define GPWM_DT_MAX_US          6500    // limite compteur 16 bits
+#define GPWM_BRAKE_TIME_US      500     // duree freinage par defaut
+#define GPWM_DEAD_TIME_US       100     // temps mort par defaut
+
+// Affichage : periode min. entre 2 rafraichissements LCD (independante du cycle)
+#define GPWM_DISP_PERIOD_MS     100
+#define GPWM_DISP_NO_VALUE      (-1000) // force le 1er affichage
+
 
 /*--------------------------------------------------------*/
 // Dfinition des fonctions prototypes
@@ -31,6 +54,13 @@ typedef struct {
     int8_t AngleSetting; // consigne angle  -90  +90
 } S_pwmSettings;
 
+// Etats de la sequence d'inversion du sens du pont en H
+typedef enum {
+    GPWM_BRIDGE_RUN = 0,    // pont actif, sens applique
+    GPWM_BRIDGE_BRAKE,      // freinage : PWM a 0, AIN1 = AIN2 = 1
+    GPWM_BRIDGE_DEADTIME,   // temps mort : AIN1 = AIN2 = 0
+} E_BridgeState;
+
 
 void GPWM_Initialize(S_pwmSettings *pData);
 
@@ -40,5 +70,19 @@ void GPWM_DispSettings(S_pwmSettings *pData);	// Affichage
 void GPWM_ExecPWM(S_pwmSettings *pData);		// Execution PWM et gestion moteur.
 void GPWM_ExecPWMSoft(S_pwmSettings *pData);		// Execution PWM software.
 
+// Passage des settings entre boucle principale (ecrivain) et ISR (lecteur)
+// Un lecteur en ISR fait GPWM_GetSnapshot(&copie) puis GPWM_ExecPWM(&copie).
+void GPWM_PublishSettings(const S_pwmSettings *pData);
+void GPWM_GetSnapshot(S_pwmSettings *pData);
+
+// Commande moteur directe (sens -1/0/+1, largeur OC2 0 a GPWM_MOTOR_PERIOD + 1)
+void GPWM_ExecMotor(int8_t newDir, uint16_t width);
+
+// Sequencement inversion de sens (temps en us, max GPWM_DT_MAX_US)
+void GPWM_SetDeadTime(uint16_t brakeTime_us, uint16_t deadTime_us);
+E_BridgeState GPWM_GetBridgeState(void);
+int8_t GPWM_GetDriveDir(void);          // dernier sens pilote (-1/+1, 0 au depart)
+void GPWM_DeadTimeCallback(void);              // appelee par l'ISR du Timer5
+
 
 #endif
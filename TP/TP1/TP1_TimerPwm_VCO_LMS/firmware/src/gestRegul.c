@@ -0,0 +1,272 @@
+/*--------------------------------------------------------*/
+// GestRegul.c
+/*--------------------------------------------------------*/
+//	Description :	Regulation de vitesse moteur en boucle fermee
+//			        (tachymetre input capture + PI virgule fixe)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+/*--------------------------------------------------------*/
+
+
+
+#include <xc.h>
+#include "gestRegul.h"
+#include "hotPath.h"
+#include "system_config.h"
+#include "peripheral/ic/plib_ic.h"
+#include "peripheral/tmr/plib_tmr.h"
+#include "peripheral/int/plib_int.h"
+
+// Core timer : SYS_CLK_FREQ / 2
+#define GREG_CORE_FREQ          (SYS_CLK_FREQ / 2)
+#define GREG_CORE_TICS_PER_LOOP (GREG_CORE_FREQ / GREG_LOOP_FREQ_HZ)
+#define GREG_OUT_MAX            (GPWM_MOTOR_PERIOD + 1)
+
+// Base de temps du tachymetre : IC1 ne peut capturer que le Timer2 ou
+// le Timer3, tous deux bases de PWM. Le Timer3 (servo, PBCLK / 64 =
+// 0.8 us, libre, periode GPWM_SERVO_PERIOD + 1) est etendu a 32 bits
+// par le compte de ses periodes.
+#define GREG_TACH_TMR_FREQ      (SYS_CLK_BUS_PERIPHERAL_1 / 64)
+#define GREG_TACH_TMR_SPAN      ((uint32_t)GPWM_SERVO_PERIOD + 1)
+
+static volatile bool closedLoop = false;
+
+// Tachymetre (ecrit par les ISR de IC1 et du Timer3, en tics Timer3)
+static volatile uint32_t tachWraps = 0;     // periodes du Timer3
+static volatile uint32_t tachLastEdge = 0;  // derniere capture etendue
+static volatile uint32_t tachPeriod = 0;
+static volatile uint32_t tachEdges = 0;     // flancs captures
+static volatile bool tachValid = false;
+static uint32_t tachSeenEdges = 0;          // boucle : flancs deja vus
+static uint16_t tachIdleMs = 0;             // boucle : ms sans flanc
+
+// Etat du PI
+static int32_t kp = GREG_KP_Q12;
+static int32_t ki = GREG_KI_Q12;
+static int32_t integQ = 0;                  // integrale, format Q12
+static volatile int32_t measuredHz = 0;    // signe du sens pilote
+
+// Instrumentation
+static S_regulStats stats;
+static uint32_t lastLoopStart = 0;
+
+void GREG_Initialize(void)
+{
+    closedLoop = false;
+    integQ = 0;
+    tachValid = false;
+    tachPeriod = 0;
+    tachIdleMs = GREG_TACH_TIMEOUT_MS;
+
+    // IC1 : une capture par flanc montant du tachymetre
+    PLIB_IC_Disable(IC_ID_1);
+    PLIB_IC_ModeSelect(IC_ID_1, IC_INPUT_CAPTURE_EVERY_RISING_EDGE_MODE);
+    PLIB_IC_BufferSizeSelect(IC_ID_1, IC_BUFFER_SIZE_16BIT);
+    PLIB_IC_TimerSelect(IC_ID_1, IC_TIMER_TMR3);
+    PLIB_IC_EventsPerInterruptSelect(IC_ID_1, IC_INTERRUPT_ON_EVERY_CAPTURE_EVENT);
+    PLIB_INT_VectorPrioritySet(INT_ID_0, INT_VECTOR_IC1, INT_PRIORITY_LEVEL5);
+    PLIB_INT_VectorSubPrioritySet(INT_ID_0, INT_VECTOR_IC1, INT_SUBPRIORITY_LEVEL1);
+    PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_INPUT_CAPTURE_1);
+    PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_INPUT_CAPTURE_1);
+
+    // Periodes du Timer3 : meme niveau que IC1, qui passe en premier
+    // (sous-priorite) : une capture est toujours traitee avant le
+    // compte d'une periode terminee apres elle
+    PLIB_INT_VectorPrioritySet(INT_ID_0, INT_VECTOR_T3, INT_PRIORITY_LEVEL5);
+    PLIB_INT_VectorSubPrioritySet(INT_ID_0, INT_VECTOR_T3, INT_SUBPRIORITY_LEVEL0);
+    PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_TIMER_3);
+    PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_TIMER_3);
+    PLIB_IC_Enable(IC_ID_1);
+
+    // Timer4 : boucle de regulation a cadence fixe
+    GREG_TickStart();
+}
+
+// Tic 1 ms du Timer4, partage par la boucle et les boutons
+// (GestInput) : l'application le lance meme sans regulation
+void GREG_TickStart(void)
+{
+    PLIB_TMR_Stop(TMR_ID_4);
+    PLIB_TMR_ClockSourceSelect(TMR_ID_4, TMR_CLOCK_SOURCE_PERIPHERAL_CLOCK);
+    PLIB_TMR_PrescaleSelect(TMR_ID_4, TMR_PRESCALE_VALUE_8);
+    PLIB_TMR_Mode16BitEnable(TMR_ID_4);
+    PLIB_TMR_Counter16BitClear(TMR_ID_4);
+    PLIB_TMR_Period16BitSet(TMR_ID_4, GREG_LOOP_PERIOD);
+    PLIB_INT_VectorPrioritySet(INT_ID_0, INT_VECTOR_T4, INT_PRIORITY_LEVEL3);
+    PLIB_INT_VectorSubPrioritySet(INT_ID_0, INT_VECTOR_T4, INT_SUBPRIORITY_LEVEL0);
+    PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_TIMER_4);
+    PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_TIMER_4);
+    PLIB_TMR_Start(TMR_ID_4);
+}
+
+void GREG_SetClosedLoop(bool enable)
+{
+    integQ = 0;
+    closedLoop = enable;
+}
+
+bool GREG_IsClosedLoop(void)
+{
+    return closedLoop;
+}
+
+void GREG_SetGains(int32_t kp_q12, int32_t ki_q12)
+{
+    kp = kp_q12;
+    ki = ki_q12;
+}
+
+int32_t GREG_GetMeasuredSpeedHz(void)
+{
+    return measuredHz;
+}
+
+// Copie avec l'IT du Timer4 masquee : la boucle ecrit stats
+void GREG_GetStats(S_regulStats *pStats)
+{
+    bool loopEnabled = PLIB_INT_SourceIsEnabled(INT_ID_0, INT_SOURCE_TIMER_4);
+
+    PLIB_INT_SourceDisable(INT_ID_0, INT_SOURCE_TIMER_4);
+    *pStats = stats;
+    if (loopEnabled)
+    {
+        PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_TIMER_4);
+    }
+}
+
+// Fin de periode du Timer3 : poids fort de la base du tachymetre
+HOT_RAMFUNC void GREG_TimebaseCallback(void)
+{
+    tachWraps++;
+}
+
+// Flanc tachymetre : valeurs du Timer3 capturees par le materiel (la
+// latence de l'ISR n'entre pas dans la periode), etendues a 32 bits
+HOT_RAMFUNC void GREG_TachCallback(void)
+{
+    uint32_t wraps = tachWraps;
+    bool wrapPending = PLIB_INT_SourceFlagGet(INT_ID_0, INT_SOURCE_TIMER_3);
+    uint32_t stamp;
+    uint16_t capture;
+
+    while (!PLIB_IC_BufferIsEmpty(IC_ID_1))
+    {
+        // Periode terminee mais pas encore comptee : une capture de la
+        // 1re moitie a eu lieu apres le retour a 0 (latence de l'ISR
+        // inferieure a une demi-periode, 10 ms)
+        capture = PLIB_IC_Buffer16BitGet(IC_ID_1);
+        stamp = wraps;
+        if (wrapPending && (capture < (GREG_TACH_TMR_SPAN / 2)))
+        {
+            stamp++;
+        }
+        stamp = (stamp * GREG_TACH_TMR_SPAN) + capture;
+
+        if (tachValid)
+        {
+            tachPeriod = stamp - tachLastEdge;
+        }
+        tachLastEdge = stamp;
+        tachValid = true;
+        tachEdges++;
+    }
+}
+
+// Boucle de regulation, executee toutes les 1 ms par l'ISR du Timer4
+HOT_RAMFUNC void GREG_LoopCallback(void)
+{
+    uint32_t start = _CP0_GET_COUNT();
+    uint32_t edges, period, delta, speedHz;
+    int32_t setpoint, err, out, integNext;
+    int8_t dir;
+    S_pwmSettings settings;
+
+    // Gigue de la periode
+    if (stats.nbLoops > 0)
+    {
+        delta = start - lastLoopStart;
+        delta = (delta > GREG_CORE_TICS_PER_LOOP) ?
+                (delta - GREG_CORE_TICS_PER_LOOP) : (GREG_CORE_TICS_PER_LOOP - delta);
+        if (delta > stats.maxJitter)
+        {
+            stats.maxJitter = delta;
+        }
+    }
+    lastLoopStart = start;
+
+    // Vitesse mesuree : nulle apres GREG_TACH_TIMEOUT_MS sans flanc
+    edges = tachEdges;
+    if (edges != tachSeenEdges)
+    {
+        tachSeenEdges = edges;
+        tachIdleMs = 0;
+    }
+    else if (tachIdleMs < GREG_TACH_TIMEOUT_MS)
+    {
+        tachIdleMs++;
+    }
+    period = tachPeriod;
+    speedHz = ((period == 0) || (tachIdleMs >= GREG_TACH_TIMEOUT_MS)) ? 0 : (GREG_TACH_TMR_FREQ / period);
+
+    // Le tachymetre ne donne pas le sens : celui du dernier sens pilote
+    // (le moteur tourne encore dans ce sens en roue libre ou au frein)
+    measuredHz = (GPWM_GetDriveDir() < 0) ? -(int32_t)speedHz : (int32_t)speedHz;
+
+    if (closedLoop)
+    {
+        // Copie coherente de la consigne publiee par GPWM_GetSettings
+        GPWM_GetSnapshot(&settings);
+        setpoint = ((int32_t)settings.absSpeed * GREG_TACH_FULL_SCALE_HZ) / 99;
+        dir = (settings.SpeedSetting > 0) - (settings.SpeedSetting < 0);
+
+        if (setpoint == 0)
+        {
+            integQ = 0;
+            out = 0;
+        }
+        else
+        {
+            // PI Q12, anti-windup par integration conditionnelle. Erreur
+            // dans le sens demande : une vitesse dans l'autre sens
+            // l'augmente.
+            err = setpoint - ((dir < 0) ? -measuredHz : measuredHz);
+            integNext = integQ + (ki * err);
+            out = ((kp * err) + integNext) >> GREG_Q;
+
+            if (out > GREG_OUT_MAX)
+            {
+                out = GREG_OUT_MAX;
+                if (err < 0)
+                {
+                    integQ = integNext;
+                }
+            }
+            else if (out < 0)
+            {
+                out = 0;
+                if (err > 0)
+                {
+                    integQ = integNext;
+                }
+            }
+            else
+            {
+                integQ = integNext;
+            }
+        }
+
+        GPWM_ExecMotor(dir, (uint16_t)out);
+    }
+
+    // Duree d'execution
+    stats.lastCycles = _CP0_GET_COUNT() - start;
+    if (stats.lastCycles > stats.maxCycles)
+    {
+        stats.maxCycles = stats.lastCycles;
+    }
+    stats.nbLoops++;
+}
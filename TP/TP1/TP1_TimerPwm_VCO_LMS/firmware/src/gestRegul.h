@@ -0,0 +1,69 @@
+#ifndef GestRegul_H
+#define GestRegul_H
+/*--------------------------------------------------------*/
+// GestRegul.h
+/*--------------------------------------------------------*/
+//	Description :	Regulation de vitesse moteur en boucle fermee
+//			        (tachymetre input capture + PI virgule fixe)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "GestPWM.h"
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+// Timer4 : cadence fixe de la boucle (PBCLK 80 MHz, prescaler 8 -> 1 ms)
+#define GREG_LOOP_PERIOD        9999
+#define GREG_LOOP_FREQ_HZ       1000
+
+// Tachymetre (IC1 sur le Timer3) : frequence des impulsions a vitesse 99
+#define GREG_TACH_FULL_SCALE_HZ 1000
+#define GREG_TACH_TIMEOUT_MS    100     // plus d'impulsion -> vitesse nulle
+
+// Gains PI par defaut, format Q12 (4096 = 1.0)
+#define GREG_KP_Q12             8192
+#define GREG_KI_Q12             205
+#define GREG_Q                  12
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+// Instrumentation de la boucle (en tics du core timer, SYS_CLK_FREQ / 2)
+typedef struct {
+    uint32_t nbLoops;       // nombre d'executions de la boucle
+    uint32_t lastCycles;    // duree de la derniere execution
+    uint32_t maxCycles;     // duree maximale observee
+    uint32_t maxJitter;     // ecart max. de periode par rapport a 1 ms
+} S_regulStats;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+void GREG_Initialize(void);            // lance aussi le tic du Timer4
+void GREG_TickStart(void);             // tic 1 ms seul (boutons)
+void GREG_SetClosedLoop(bool enable);
+bool GREG_IsClosedLoop(void);
+void GREG_SetGains(int32_t kp_q12, int32_t ki_q12);
+int32_t GREG_GetMeasuredSpeedHz(void);    // signee (dernier sens pilote)
+void GREG_GetStats(S_regulStats *pStats);
+
+void GREG_TachCallback(void);       // appelee par l'ISR de IC1
+void GREG_TimebaseCallback(void);   // appelee par l'ISR du Timer3
+void GREG_LoopCallback(void);       // appelee par l'ISR du Timer4
+
+
+#endif
@@ -0,0 +1,418 @@
+/*--------------------------------------------------------*/
+// GestUsbStream.c
+/*--------------------------------------------------------*/
+//	Description :	Flux de telemetrie par USB full speed, classe
+//			        CDC-ACM (port serie virtuel) de la pile Harmony
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+/*--------------------------------------------------------*/
+
+#include <xc.h>
+#include <stddef.h>
+#include "gestUsbStream.h"
+#include "GestPWM.h"
+#include "gestRegul.h"
+#include "hotPath.h"
+#include "system_config.h"
+#include "usb/usb_device.h"
+#include "usb/usb_device_cdc.h"
+#include "peripheral/adc/plib_adc.h"
+#include "peripheral/int/plib_int.h"
+
+#define GUSB_RING_MASK          (GUSB_RING_SAMPLES - 1)
+#define GUSB_SAMPLES_PER_PACKET (GUSB_PACKET_SIZE / sizeof(S_usbSample))
+#define GUSB_CDC_INDEX          USB_DEVICE_CDC_INDEX_0
+#define GUSB_ADC_CORE_TICS      ((SYS_CLK_FREQ / 2) / GUSB_ADC_RATE_HZ)
+
+// Une ecriture ne doit jamais couper un echantillon ni deborder l'anneau
+typedef char GUSB_CheckSampleSize[(sizeof(S_usbSample) == 16) ? 1 : -1];
+typedef char GUSB_CheckRingSize[((GUSB_RING_SAMPLES % GUSB_WRITE_MAX_SAMPLES) == 0) ? 1 : -1];
+typedef char GUSB_CheckWriteSize[((GUSB_WRITE_MAX_SAMPLES % GUSB_SAMPLES_PER_PACKET) == 0) ? 1 : -1];
+// Chaque demi-tampon ADC commence par AN0
+typedef char GUSB_CheckAdcScan[((GUSB_ADC_PER_IT % GUSB_ADC_NB_CHAN) == 0) ? 1 : -1];
+
+typedef enum {
+    GUSB_STATE_OPEN = 0,    // ouverture de la couche device
+    GUSB_STATE_WAIT_HOST,   // attente configuration + DTR
+    GUSB_STATE_STREAM,      // flux actif
+} E_UsbStreamState;
+
+// Anneau d'acquisition, lu par le DMA USB (RAM, pas de cache sur MX)
+static S_usbSample ring[GUSB_RING_SAMPLES] __attribute__((aligned(GUSB_PACKET_SIZE)));
+
+// Compteurs libres (modulo 2^32), un seul ecrivain chacun :
+// head producteur, tail fin d'ecriture (ISR USB), sendPos
+// lancement d'ecriture (ISR USB ou boucle principale, ISR USB masquee)
+static volatile uint32_t head = 0;
+static volatile uint32_t tail = 0;
+static volatile uint32_t sendPos = 0;
+static uint16_t seq = 0;
+
+// Ecritures en cours, dans l'ordre de lancement
+static uint32_t writeLen[GUSB_WRITES_IN_FLIGHT];
+static volatile uint8_t nbQueued = 0;
+static volatile uint8_t nbCompleted = 0;
+
+static E_UsbStreamState state = GUSB_STATE_OPEN;
+static USB_DEVICE_HANDLE deviceHandle = USB_DEVICE_HANDLE_INVALID;
+static volatile bool configured = false;
+static volatile bool dtr = false;
+static volatile bool streaming = false;
+static USB_CDC_LINE_CODING lineCoding = { 115200, 0, 0, 8 };
+
+static S_usbStreamStats stats;
+
+// Derniere conversion de chaque voie (ISR de l'ADC1)
+static volatile uint16_t adcLast[GUSB_ADC_NB_CHAN];
+
+// Lance les ecritures possibles : paquets complets tant qu'il reste
+// une place, paquet court seulement si plus rien n'est en cours.
+// Contexte : ISR USB, ou boucle principale avec l'ISR USB masquee.
+static void GUSB_QueueWrites(void)
+{
+    USB_DEVICE_CDC_TRANSFER_HANDLE transferHandle;
+    USB_DEVICE_CDC_TRANSFER_FLAGS flags;
+    uint32_t pos, idx, nb;
+    uint8_t slot;
+
+    while ((uint8_t)(nbQueued - nbCompleted) < GUSB_WRITES_IN_FLIGHT)
+    {
+        pos = sendPos;
+        idx = pos & GUSB_RING_MASK;
+        nb = head - pos;
+        if (nb > (GUSB_RING_SAMPLES - idx))
+        {
+            nb = GUSB_RING_SAMPLES - idx;   // pas de repli de l'anneau
+        }
+        if (nb > GUSB_WRITE_MAX_SAMPLES)
+        {
+            nb = GUSB_WRITE_MAX_SAMPLES;
+        }
+
+        if (nb >= GUSB_SAMPLES_PER_PACKET)
+        {
+            // Multiple de 64 octets : pas de paquet de longueur nulle
+            nb -= nb % GUSB_SAMPLES_PER_PACKET;
+            flags = USB_DEVICE_CDC_TRANSFER_FLAGS_MORE_DATA_PENDING;
+        }
+        else if ((nb > 0) && (nbQueued == nbCompleted))
+        {
+            flags = USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE;
+        }
+        else
+        {
+            break;
+        }
+
+        // Avant l'appel : la fin d'ecriture peut arriver pendant celui-ci
+        slot = nbQueued % GUSB_WRITES_IN_FLIGHT;
+        writeLen[slot] = nb;
+        sendPos = pos + nb;
+        nbQueued++;
+
+        if (USB_DEVICE_CDC_Write(GUSB_CDC_INDEX, &transferHandle, &ring[idx],
+                                 nb * sizeof(S_usbSample), flags) != USB_DEVICE_CDC_RESULT_OK)
+        {
+            nbQueued--;
+            sendPos = pos;
+            stats.nbWriteErrors++;
+            break;
+        }
+        stats.nbWrites++;
+    }
+}
+
+// Relance depuis la boucle principale
+static void GUSB_Kick(void)
+{
+    bool usbInt = PLIB_INT_SourceIsEnabled(INT_ID_0, INT_SOURCE_USB_1);
+
+    PLIB_INT_SourceDisable(INT_ID_0, INT_SOURCE_USB_1);
+    GUSB_QueueWrites();
+    if (usbInt)
+    {
+        PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_USB_1);
+    }
+}
+
+// Evenements de la fonction CDC (ISR USB)
+static USB_DEVICE_CDC_EVENT_RESPONSE GUSB_CdcEventHandler(USB_DEVICE_CDC_INDEX index,
+        USB_DEVICE_CDC_EVENT event, void *pData, uintptr_t context)
+{
+    (void)index;
+    (void)context;
+
+    switch (event)
+    {
+        case USB_DEVICE_CDC_EVENT_GET_LINE_CODING:
+            USB_DEVICE_ControlSend(deviceHandle, &lineCoding, sizeof(lineCoding));
+            break;
+
+        case USB_DEVICE_CDC_EVENT_SET_LINE_CODING:
+            // Sans effet sur le debit USB, memorise pour GET_LINE_CODING
+            USB_DEVICE_ControlReceive(deviceHandle, &lineCoding, sizeof(lineCoding));
+            break;
+
+        case USB_DEVICE_CDC_EVENT_SET_CONTROL_LINE_STATE:
+            dtr = ((USB_CDC_CONTROL_LINE_STATE *)pData)->dtr != 0;
+            USB_DEVICE_ControlStatus(deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
+            break;
+
+        case USB_DEVICE_CDC_EVENT_SEND_BREAK:
+        case USB_DEVICE_CDC_EVENT_CONTROL_TRANSFER_DATA_RECEIVED:
+            USB_DEVICE_ControlStatus(deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
+            break;
+
+        case USB_DEVICE_CDC_EVENT_WRITE_COMPLETE:
+        {
+            // Aussi a l'abandon (reset, deconfiguration) : la zone est rendue
+            USB_DEVICE_CDC_EVENT_DATA_WRITE_COMPLETE *pDone = pData;
+            uint8_t slot = nbCompleted % GUSB_WRITES_IN_FLIGHT;
+
+            tail += writeLen[slot];
+            nbCompleted++;
+            if (pDone->status == USB_DEVICE_CDC_RESULT_OK)
+            {
+                stats.nbBytes += pDone->length;
+                if (streaming)
+                {
+                    GUSB_QueueWrites();
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+    return USB_DEVICE_CDC_EVENT_RESPONSE_NONE;
+}
+
+// Evenements de la couche device
+static void GUSB_DeviceEventHandler(USB_DEVICE_EVENT event, void *pData, uintptr_t context)
+{
+    (void)context;
+
+    switch (event)
+    {
+        case USB_DEVICE_EVENT_POWER_DETECTED:
+            USB_DEVICE_Attach(deviceHandle);
+            break;
+
+        case USB_DEVICE_EVENT_POWER_REMOVED:
+            USB_DEVICE_Detach(deviceHandle);
+            configured = false;
+            dtr = false;
+            break;
+
+        case USB_DEVICE_EVENT_CONFIGURED:
+            if (((USB_DEVICE_EVENT_DATA_CONFIGURED *)pData)->configurationValue == 1)
+            {
+                USB_DEVICE_CDC_EventHandlerSet(GUSB_CDC_INDEX, GUSB_CdcEventHandler, 0);
+                configured = true;
+            }
+            break;
+
+        case USB_DEVICE_EVENT_RESET:
+        case USB_DEVICE_EVENT_DECONFIGURED:
+            configured = false;
+            dtr = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
+// ADC1 : balayage continu de AN0 / AN1 cadence par le compteur
+// interne, deux demi-tampons de 8 resultats alternes
+static void GUSB_AdcInitialize(void)
+{
+    PLIB_ADC_Disable(ADC_ID_1);
+    PLIB_ADC_ConversionClockSourceSelect(ADC_ID_1, ADC_CLOCK_SOURCE_PERIPHERAL_BUS_CLOCK);
+    PLIB_ADC_ConversionClockSet(ADC_ID_1, SYS_CLK_BUS_PERIPHERAL_1, GUSB_ADC_CLOCK_HZ);
+    PLIB_ADC_VoltageReferenceSelect(ADC_ID_1, ADC_REFERENCE_VDD_TO_AVSS);
+    PLIB_ADC_SamplingModeSelect(ADC_ID_1, ADC_SAMPLING_MODE_MUXA);
+    PLIB_ADC_ResultFormatSelect(ADC_ID_1, ADC_RESULT_FORMAT_INTEGER_16BIT);
+    PLIB_ADC_ResultBufferModeSelect(ADC_ID_1, ADC_BUFFER_MODE_TWO_8WORD_BUFFERS);
+    PLIB_ADC_SamplesPerInterruptSelect(ADC_ID_1, ADC_8SAMPLES_PER_INTERRUPT);
+    PLIB_ADC_MuxChannel0InputNegativeSelect(ADC_ID_1, ADC_MUX_A, ADC_INPUT_NEGATIVE_VREF_MINUS);
+    PLIB_ADC_MuxAInputScanEnable(ADC_ID_1);
+    PLIB_ADC_InputScanMaskAdd(ADC_ID_1, ADC_INPUT_SCAN_AN0 | ADC_INPUT_SCAN_AN1);
+    PLIB_ADC_ConversionTriggerSourceSelect(ADC_ID_1, ADC_CONVERSION_TRIGGER_INTERNAL_COUNT);
+    PLIB_ADC_SampleAcquisitionTimeSet(ADC_ID_1, GUSB_ADC_SAMPLE_TAD);
+    PLIB_ADC_SampleAutoStartEnable(ADC_ID_1);
+
+    // Meme niveau que le Timer4 : une ISR de 1 ms ne retarde pas la
+    // lecture au-dela des 8 conversions suivantes
+    PLIB_INT_VectorPrioritySet(INT_ID_0, INT_VECTOR_AD1, INT_PRIORITY_LEVEL3);
+    PLIB_INT_VectorSubPrioritySet(INT_ID_0, INT_VECTOR_AD1, INT_SUBPRIORITY_LEVEL1);
+    PLIB_INT_SourceFlagClear(INT_ID_0, INT_SOURCE_ADC_1);
+    PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_ADC_1);
+    PLIB_ADC_Enable(ADC_ID_1);
+}
+
+void GUSB_Initialize(void)
+{
+    state = GUSB_STATE_OPEN;
+    deviceHandle = USB_DEVICE_HANDLE_INVALID;
+    configured = false;
+    dtr = false;
+    streaming = false;
+    head = 0;
+    tail = 0;
+    sendPos = 0;
+    nbQueued = 0;
+    nbCompleted = 0;
+    adcLast[0] = 0;
+    adcLast[1] = 0;
+    GUSB_AdcInitialize();
+}
+
+void GUSB_Tasks(void)
+{
+    switch (state)
+    {
+        case GUSB_STATE_OPEN:
+            // La couche device n'est prete qu'apres quelques SYS_Tasks
+            deviceHandle = USB_DEVICE_Open(USB_DEVICE_INDEX_0, DRV_IO_INTENT_READWRITE);
+            if (deviceHandle != USB_DEVICE_HANDLE_INVALID)
+            {
+                USB_DEVICE_EventHandlerSet(deviceHandle, GUSB_DeviceEventHandler, 0);
+                state = GUSB_STATE_WAIT_HOST;
+            }
+            break;
+
+        case GUSB_STATE_WAIT_HOST:
+            // Depart sur un anneau vide, une fois les ecritures
+            // precedentes terminees ou abandonnees
+            if (configured && dtr && (nbQueued == nbCompleted))
+            {
+                tail = head;
+                sendPos = head;
+                streaming = true;
+                state = GUSB_STATE_STREAM;
+            }
+            break;
+
+        case GUSB_STATE_STREAM:
+            if (!configured || !dtr)
+            {
+                streaming = false;
+                state = GUSB_STATE_WAIT_HOST;
+            }
+            else if (nbQueued == nbCompleted)
+            {
+                // Flux au repos (debit faible ou reprise apres anneau vide)
+                GUSB_Kick();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool GUSB_IsStreaming(void)
+{
+    return streaming;
+}
+
+void GUSB_GetStats(S_usbStreamStats *pStats)
+{
+    *pStats = stats;
+}
+
+uint16_t GUSB_GetAdc(uint8_t chan)
+{
+    return (chan < GUSB_ADC_NB_CHAN) ? adcLast[chan] : 0;
+}
+
+// Place libre a la position head, hors des ecritures en cours
+HOT_RAMFUNC S_usbSample *GUSB_ReserveSample(void)
+{
+    uint32_t fill;
+
+    if (!streaming)
+    {
+        return NULL;
+    }
+    fill = head - tail;
+    if (fill >= GUSB_RING_SAMPLES)
+    {
+        // Numero consomme : la perte se voit cote hote
+        seq++;
+        stats.nbOverflows++;
+        return NULL;
+    }
+    if (fill > stats.maxFill)
+    {
+        stats.maxFill = fill;
+    }
+    return &ring[head & GUSB_RING_MASK];
+}
+
+// Complete l'echantillon reserve et le rend visible aux ecritures
+HOT_RAMFUNC void GUSB_CommitSample(void)
+{
+    S_usbSample *pSample = &ring[head & GUSB_RING_MASK];
+    const uint8_t *pByte = (const uint8_t *)pSample;
+    uint8_t sum = 0;
+    uint8_t i;
+
+    pSample->sync = GUSB_SYNC;
+    pSample->seq = seq++;
+    for (i = 0; i < offsetof(S_usbSample, check); i++)
+    {
+        sum += pByte[i];
+    }
+    pSample->check = (uint8_t)~sum;
+
+    // L'echantillon doit etre complet avant d'avancer head
+    __asm__ volatile ("" ::: "memory");
+    head++;
+    stats.nbSamples++;
+}
+
+// 8 conversions terminees : lit le demi-tampon que l'ADC ne remplit
+// pas (AN0, AN1, AN0...), un echantillon par conversion. Consignes et
+// regulation sont lues une fois pour les 8.
+HOT_RAMFUNC void GUSB_AdcCallback(void)
+{
+    uint32_t stamp = _CP0_GET_COUNT();
+    S_usbSample *pSample;
+    S_pwmSettings settings;
+    int16_t speedHz;
+    uint16_t value;
+    uint8_t base, status, i;
+
+    base = (PLIB_ADC_ResultBufferStatusGet(ADC_ID_1) == ADC_FILLING_BUF_8TOF) ? 0 : GUSB_ADC_PER_IT;
+
+    GPWM_GetSnapshot(&settings);
+    speedHz = (int16_t)GREG_GetMeasuredSpeedHz();
+    status = (GREG_IsClosedLoop() ? GUSB_STATUS_CLOSED_LOOP : 0) |
+             ((uint8_t)GPWM_GetBridgeState() << GUSB_STATUS_BRIDGE_SHIFT);
+
+    for (i = 0; i < GUSB_ADC_PER_IT; i++)
+    {
+        value = (uint16_t)PLIB_ADC_ResultGetByIndex(ADC_ID_1, base + i);
+        adcLast[i % GUSB_ADC_NB_CHAN] = value;
+
+        pSample = GUSB_ReserveSample();
+        if (pSample != NULL)
+        {
+            // La derniere conversion vient de finir
+            pSample->stamp = stamp - ((GUSB_ADC_PER_IT - 1 - i) * GUSB_ADC_CORE_TICS);
+            pSample->speedSetting = settings.SpeedSetting;
+            pSample->angleSetting = settings.AngleSetting;
+            pSample->adc = value;
+            pSample->measuredHz = speedHz;
+            pSample->status = status | ((i % GUSB_ADC_NB_CHAN) << GUSB_STATUS_CHAN_SHIFT);
+            GUSB_CommitSample();
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef GestUsbStream_H
+#define GestUsbStream_H
+/*--------------------------------------------------------*/
+// GestUsbStream.h
+/*--------------------------------------------------------*/
+//	Description :	Flux de telemetrie par USB full speed, classe
+//			        CDC-ACM (port serie virtuel) de la pile Harmony
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//	Compilateur	:	XC32 V2.50 + Harmony 2.06
+//
+//  Fonctionnement :
+//  - producteur : l'ADC1 balaye AN0 / AN1 en continu (compteur
+//    interne, GUSB_ADC_RATE_HZ conversions/s) ; l'ISR de l'ADC1
+//    (GUSB_AdcCallback) traite le demi-tampon ADC1BUF0-7 / 8-F que
+//    l'ADC ne remplit pas, un echantillon par conversion
+//  - les echantillons (S_usbSample, 16 octets) sont ecrits par le
+//    producteur directement dans l'anneau d'acquisition :
+//    GUSB_ReserveSample, remplissage, GUSB_CommitSample
+//  - les ecritures CDC pointent dans l'anneau (pas de copie), le
+//    driver USBFS y lit les paquets de 64 octets par DMA
+//  - GUSB_WRITES_IN_FLIGHT ecritures en cours : pendant que le
+//    driver vide l'une (BD ping-pong du endpoint bulk IN), la
+//    suivante est deja armee
+//  - l'ecriture suivante est lancee depuis l'evenement de fin
+//    d'ecriture (ISR USB), GUSB_Tasks ne fait que relancer le flux
+//  - une zone de l'anneau n'est rendue au producteur qu'a la fin
+//    de l'ecriture qui la contient
+//  Le flux demarre quand l'hote ouvre le port (DTR = 1) ; a chaque
+//  ouverture l'anneau est vide des echantillons anciens.
+//
+//  Format sur le bus : suite de S_usbSample, little endian, sans
+//  autre trame (sync + sequence + somme pour se resynchroniser).
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*--------------------------------------------------------*/
+// Constantes
+/*--------------------------------------------------------*/
+
+#define GUSB_SYNC                   0x55AA
+#define GUSB_PACKET_SIZE            64      // bulk IN full speed
+#define GUSB_RING_SAMPLES           512     // 8 ko, puissance de 2
+#define GUSB_WRITE_MAX_SAMPLES      64      // 1 ko par ecriture CDC
+#define GUSB_WRITES_IN_FLIGHT       2       // = queueSizeWrite (system_init.c)
+
+// Acquisition ADC1 : TAD = 1.25 us, 8 TAD d'acquisition + 12 de
+// conversion = 25 us -> 40000 echantillons/s, 640 ko/s sur le bus.
+// Interruption toutes les 8 conversions (200 us pour la servir).
+#define GUSB_ADC_CLOCK_HZ           800000
+#define GUSB_ADC_SAMPLE_TAD         8
+#define GUSB_ADC_RATE_HZ            (GUSB_ADC_CLOCK_HZ / (GUSB_ADC_SAMPLE_TAD + 12))
+#define GUSB_ADC_NB_CHAN            2       // AN0 vitesse, AN1 angle
+#define GUSB_ADC_PER_IT             8       // demi-tampon ADC1BUF
+
+// S_usbSample.status
+#define GUSB_STATUS_CLOSED_LOOP     0x01
+#define GUSB_STATUS_BRIDGE_SHIFT    1       // E_BridgeState, 2 bits
+#define GUSB_STATUS_CHAN_SHIFT      3       // voie ADC (0 = AN0), 1 bit
+
+
+/*--------------------------------------------------------*/
+// Types
+/*--------------------------------------------------------*/
+
+// Echantillon de telemetrie : une conversion ADC (potentiometres),
+// consignes PWM et regulation au moment de l'interruption
+typedef struct {
+    uint16_t sync;          // GUSB_SYNC
+    uint16_t seq;           // numero d'echantillon, trous = pertes
+    uint32_t stamp;         // fin de conversion, core timer (SYS_CLK_FREQ / 2)
+    int8_t speedSetting;    // consigne vitesse -99 a +99
+    int8_t angleSetting;    // consigne angle -90 a +90
+    uint16_t adc;           // conversion brute 10 bits, voie dans status
+    int16_t measuredHz;     // vitesse mesuree (tachymetre, signee)
+    uint8_t status;         // GUSB_STATUS_*
+    uint8_t check;          // complement de la somme des 15 octets precedents
+} S_usbSample;
+
+// Instrumentation
+typedef struct {
+    uint32_t nbSamples;     // echantillons mis dans l'anneau
+    uint32_t nbOverflows;   // echantillons perdus, anneau plein
+    uint32_t nbWrites;      // ecritures CDC lancees
+    uint32_t nbWriteErrors; // ecritures refusees par la pile
+    uint32_t nbBytes;       // octets acquittes par l'hote
+    uint32_t maxFill;       // remplissage max. de l'anneau (echantillons)
+} S_usbStreamStats;
+
+
+/*--------------------------------------------------------*/
+// Definition des fonctions prototypes
+/*--------------------------------------------------------*/
+
+void GUSB_Initialize(void);
+void GUSB_Tasks(void);                  // boucle principale
+bool GUSB_IsStreaming(void);
+void GUSB_GetStats(S_usbStreamStats *pStats);
+
+// Producteur (une seule ISR) : NULL si flux arrete ou anneau plein
+S_usbSample *GUSB_ReserveSample(void);
+void GUSB_CommitSample(void);
+
+// Derniere conversion d'une voie, aussi sans flux (GPWM_GetSettings)
+uint16_t GUSB_GetAdc(uint8_t chan);
+
+void GUSB_AdcCallback(void);            // appelee par l'ISR de l'ADC1
+
+
+#endif
@@ -52,7 +52,11 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "system/devcon/sys_devcon.h"
 #include "system/clk/sys_clk.h"
 #include "system/int/sys_int.h"
+#include "system/excep/sys_excep.h"
 #include "system/ports/sys_ports.h"
+#include "driver/usb/usbfs/drv_usbfs.h"
+#include "usb/usb_device.h"
+#include "usb/usb_device_cdc.h"
 #include "app.h"
 
 
@@ -87,7 +91,8 @@ extern "C" {
 
 typedef struct
 {
-
+    SYS_MODULE_OBJ  drvUSBObject;
+    SYS_MODULE_OBJ  usbDevObject0;
 
 } SYSTEM_OBJECTS;
 
@@ -62,6 +62,11 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "system/common/sys_common.h"
 #include "app.h"
 #include "system_definitions.h"
+#include "GestPWM.h"
+#include "gestRegul.h"
+#include "gestInput.h"
+#include "gestUsbStream.h"
+#include "hotPath.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -69,6 +74,69 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 // *****************************************************************************
 
+/* Mesures des ISR pour le choix des fonctions placees en RAM (hotPath.h) */
+S_hotProfile hotProfTmr5;
+S_hotProfile hotProfTmr4;
+S_hotProfile hotProfIc1;
+S_hotProfile hotProfCn;
+S_hotProfile hotProfUsb;
+S_hotProfile hotProfAdc;
+
+void __ISR(_TIMER_5_VECTOR, ipl4AUTO) IntHandlerHbridgeSeqTmr5(void)
+{
+    HOT_PROFILE_BEGIN();
+    PLIB_INT_SourceFlagClear(INT_ID_0,INT_SOURCE_TIMER_5);
+    GPWM_DeadTimeCallback();
+    HOT_PROFILE_END(hotProfTmr5);
+}
+
+void __ISR(_TIMER_4_VECTOR, ipl3AUTO) IntHandlerRegulTmr4(void)
+{
+    HOT_PROFILE_BEGIN();
+    PLIB_INT_SourceFlagClear(INT_ID_0,INT_SOURCE_TIMER_4);
+    GREG_LoopCallback();
+    GINP_SampleCallback();
+    HOT_PROFILE_END(hotProfTmr4);
+}
+
+/* ADC1 : 8 conversions par interruption, echantillons du flux USB */
+void __ISR(_ADC_VECTOR, ipl3AUTO) IntHandlerUsbAdc(void)
+{
+    HOT_PROFILE_BEGIN();
+    PLIB_INT_SourceFlagClear(INT_ID_0,INT_SOURCE_ADC_1);
+    GUSB_AdcCallback();
+    HOT_PROFILE_END(hotProfAdc);
+}
+
+void __ISR(_INPUT_CAPTURE_1_VECTOR, ipl5AUTO) IntHandlerTachIc1(void)
+{
+    HOT_PROFILE_BEGIN();
+    GREG_TachCallback();
+    PLIB_INT_SourceFlagClear(INT_ID_0,INT_SOURCE_INPUT_CAPTURE_1);
+    HOT_PROFILE_END(hotProfIc1);
+}
+
+void __ISR(_TIMER_3_VECTOR, ipl5AUTO) IntHandlerTachTmr3(void)
+{
+    PLIB_INT_SourceFlagClear(INT_ID_0,INT_SOURCE_TIMER_3);
+    GREG_TimebaseCallback();
+}
+
+void __ISR(_CHANGE_NOTICE_VECTOR, ipl2AUTO) IntHandlerButtonsCn(void)
+{
+    HOT_PROFILE_BEGIN();
+    GINP_ChangeCallback();
+    PLIB_INT_SourceFlagClear(INT_ID_0,INT_SOURCE_CHANGE_NOTICE);
+    HOT_PROFILE_END(hotProfCn);
+}
+
+/* Driver USBFS : les evenements CDC (fin d'ecriture) sont traites ici */
+void __ISR(_USB_1_VECTOR, ipl1AUTO) _IntHandlerUSBInstance0(void)
+{
+    HOT_PROFILE_BEGIN();
+    DRV_USBFS_Tasks_ISR(sysObj.drvUSBObject);
+    HOT_PROFILE_END(hotProfUsb);
+}
  
 /*******************************************************************************
  End of File
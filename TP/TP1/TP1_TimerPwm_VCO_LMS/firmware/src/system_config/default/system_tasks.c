@@ -74,8 +74,12 @@ void SYS_Tasks ( void )
     /* Maintain system services */
 
     /* Maintain Device Drivers */
+    /* USBFS Driver Task Routine */
+    DRV_USBFS_Tasks(sysObj.drvUSBObject);
 
     /* Maintain Middleware & Other Libraries */
+    /* USB Device layer tasks routine */
+    USB_DEVICE_Tasks(sysObj.usbDevObject0);
 
     /* Maintain the application's state machine. */
     APP_Tasks();
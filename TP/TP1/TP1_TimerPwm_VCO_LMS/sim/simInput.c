@@ -0,0 +1,175 @@
+/*--------------------------------------------------------*/
+// simInput.c
+/*--------------------------------------------------------*/
+//	Description :	Simulation sur PC de gestInput.c : boutons avec
+//			        rebonds aleatoires, module change notice (CN)
+//			        et Timer4 a 1 ms. Verifie les evenements publies,
+//			        la latence max. et l'absence de travail au repos.
+//
+//	Utilisation :	simInput [-s graine]
+//			        code de retour 0 si tous les controles passent
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "simPlib.h"
+#include "gestInput.h"
+
+#define SIM_STEP_US         10
+#define SIM_CORE_TICS_US    (SYS_CLK_FREQ / 2000000)
+#define SIM_DURATION_MS     2500
+#define SIM_MAX_BOUNCE_MS   4
+
+// Appui (pressed = 1) ou relachement a tUs, avec rebonds pendant bounceUs
+typedef struct {
+    uint32_t tUs;
+    uint8_t button;
+    uint8_t pressed;
+    uint32_t bounceUs;
+} S_simEdge;
+
+static const S_simEdge scenario[] = {
+    {   10000, GINP_BTN_OK,    1, 3000 },
+    {  200000, GINP_BTN_OK,    0, 2000 },
+    {  300000, GINP_BTN_PLUS,  1, 4000 },
+    { 1600000, GINP_BTN_PLUS,  0, 2000 },
+    { 1800000, GINP_BTN_MINUS, 1,    0 },   // parasite de 200 us
+    { 1800200, GINP_BTN_MINUS, 0,    0 },
+    { 2000000, GINP_BTN_OK,    1, 1500 },
+    { 2000000, GINP_BTN_ESC,   1, 2500 },
+    { 2100000, GINP_BTN_OK,    0, 1000 },
+    { 2100000, GINP_BTN_ESC,   0, 3000 },
+};
+#define SIM_NB_EDGES    (sizeof(scenario) / sizeof(scenario[0]))
+
+// Evenements attendus par bouton : P appui, L appui long, R relachement
+static const char *expected[GINP_NB_BUTTONS] = { "PRPR", "PR", "PLR", "" };
+static const char *names[GINP_NB_BUTTONS] = { "OK", "ESC", "PLUS", "MINUS" };
+
+// Niveau de la broche d'un bouton (actif bas)
+static void SIM_SetButton(uint8_t button, uint8_t pressed)
+{
+    uint16_t mask = (uint16_t)(1u << (2 + button));    // RB2..RB5
+
+    if (pressed)
+    {
+        simPort[PORT_CHANNEL_B] &= ~mask;
+    }
+    else
+    {
+        simPort[PORT_CHANNEL_B] |= mask;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned seed = 1;
+    uint32_t tUs, k, nbMs = 0;
+    uint32_t nextToggle[SIM_NB_EDGES];
+    uint8_t level[GINP_NB_BUTTONS] = { 0 };
+    char got[GINP_NB_BUTTONS][16];
+    size_t len[GINP_NB_BUTTONS] = { 0 };
+    S_inputEvent ev;
+    S_inputStats stats;
+    uint32_t boundUs;
+    int i, fail = 0;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc))
+        {
+            seed = (unsigned)strtoul(argv[++i], NULL, 0);
+        }
+    }
+    srand(seed);
+    memset(got, 0, sizeof(got));
+    memset(nextToggle, 0, sizeof(nextToggle));
+
+    simPort[PORT_CHANNEL_B] = 0xFFFF;   // pull-up, boutons relaches
+    GINP_Initialize();
+
+    for (tUs = 0; tUs < SIM_DURATION_MS * 1000; tUs += SIM_STEP_US)
+    {
+        simCoreCount += SIM_STEP_US * SIM_CORE_TICS_US;
+
+        // Broches : niveau final apres la phase de rebonds
+        for (k = 0; k < SIM_NB_EDGES; k++)
+        {
+            const S_simEdge *pEdge = &scenario[k];
+
+            if ((tUs < pEdge->tUs) || (tUs > pEdge->tUs + pEdge->bounceUs))
+            {
+                continue;
+            }
+            if (tUs == pEdge->tUs + pEdge->bounceUs)
+            {
+                level[pEdge->button] = pEdge->pressed;
+            }
+            else if (tUs >= nextToggle[k])
+            {
+                level[pEdge->button] ^= 1;
+                nextToggle[k] = tUs + 20 + (rand() % 300);
+            }
+            SIM_SetButton(pEdge->button, level[pEdge->button]);
+        }
+
+        // Module CN : interruption tant que les broches different
+        // de la derniere lecture
+        if (simIntEnabled[INT_SOURCE_CHANGE_NOTICE] &&
+            ((simPort[PORT_CHANNEL_B] ^ simPortRead[PORT_CHANNEL_B]) & 0x003C))
+        {
+            GINP_ChangeCallback();
+        }
+
+        // Timer4 : 1 ms
+        if ((tUs % 1000) == 0)
+        {
+            GINP_SampleCallback();
+            nbMs++;
+        }
+
+        // Boucle principale
+        while (GINP_GetEvent(&ev))
+        {
+            if (len[ev.button] < sizeof(got[0]) - 1)
+            {
+                got[ev.button][len[ev.button]++] =
+                    (ev.type == GINP_EV_PRESS) ? 'P' :
+                    (ev.type == GINP_EV_RELEASE) ? 'R' : 'L';
+            }
+            printf("%7.1f ms  %-5s %s\n", tUs / 1000.0, names[ev.button],
+                   (ev.type == GINP_EV_PRESS) ? "appui" :
+                   (ev.type == GINP_EV_RELEASE) ? "relachement" : "appui long");
+        }
+    }
+
+    GINP_GetStats(&stats);
+    boundUs = (SIM_MAX_BOUNCE_MS + GINP_DEBOUNCE_MS + 1) * 1000;
+
+    for (i = 0; i < GINP_NB_BUTTONS; i++)
+    {
+        if (strcmp(got[i], expected[i]) != 0)
+        {
+            printf("ECHEC %s : \"%s\" au lieu de \"%s\"\n", names[i], got[i], expected[i]);
+            fail = 1;
+        }
+    }
+    printf("reveils CN %u, echantillonnages %u / %u ms, evenements %u, perdus %u\n",
+           stats.nbWakeUps, stats.nbSamples, nbMs, stats.nbEvents, stats.nbOverflows);
+    printf("latence max. %u us (borne %u us)\n",
+           (unsigned)(stats.maxLatency / SIM_CORE_TICS_US), boundUs);
+    if ((stats.maxLatency / SIM_CORE_TICS_US) > boundUs)
+    {
+        printf("ECHEC latence\n");
+        fail = 1;
+    }
+    printf("%s\n", fail ? "ECHEC" : "OK");
+
+    return fail;
+}
@@ -0,0 +1,98 @@
+/*--------------------------------------------------------*/
+// simMoteur.c
+/*--------------------------------------------------------*/
+//	Description :	Modeles pont en H, moteur DC et servo
+//			        (Euler explicite, modele moyen sur la periode PWM)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <math.h>
+#include "simMoteur.h"
+
+#define SIMM_TWO_PI     6.283185307179586
+
+void SIMM_MotorInit(S_motorState *pState)
+{
+    pState->v = 0.0;
+    pState->i = 0.0;
+    pState->w = 0.0;
+    pState->theta = 0.0;
+    pState->tachPhase = 0.0;
+}
+
+// Pont en H type TB6612 : IN1/IN2 = 1/0 ou 0/1 -> +/- Vbus * duty,
+// 1/1 -> frein (induit en court-circuit), 0/0 ou STBY = 0 -> roue libre
+uint32_t SIMM_MotorStep(const S_motorParams *pParams, S_motorState *pState,
+        uint8_t ain1, uint8_t ain2, uint8_t stby, double duty, double dt)
+{
+    double torque, revs;
+    uint32_t edges;
+    int coast = 0;
+
+    if ((stby == 0) || ((ain1 == 0) && (ain2 == 0)))
+    {
+        coast = 1;
+        pState->v = 0.0;
+    }
+    else if (ain1 && ain2)
+    {
+        pState->v = 0.0;
+    }
+    else
+    {
+        pState->v = (ain1 ? 1.0 : -1.0) * pParams->vBus * duty;
+    }
+
+    // Electrique : L di/dt = V - R.i - Ke.w (courant nul en roue libre)
+    if (coast)
+    {
+        pState->i = 0.0;
+    }
+    else
+    {
+        pState->i += dt * (pState->v - pParams->r * pState->i - pParams->ke * pState->w) / pParams->l;
+    }
+
+    // Mecanique : J dw/dt = Kt.i - B.w - Tcharge
+    torque = pParams->kt * pState->i - pParams->b * pState->w;
+    if (pState->w > 0.0)
+    {
+        torque -= pParams->tLoad;
+    }
+    else if (pState->w < 0.0)
+    {
+        torque += pParams->tLoad;
+    }
+    pState->w += dt * torque / pParams->j;
+    pState->theta += dt * pState->w;
+
+    // Tachymetre : un flanc montant par 1/ppr de tour (sans signe)
+    revs = fabs(pState->w) * dt / SIMM_TWO_PI;
+    pState->tachPhase += revs * pParams->ppr;
+    edges = (uint32_t)pState->tachPhase;
+    pState->tachPhase -= edges;
+
+    return edges;
+}
+
+// Servo : 0.6 ms -> -90 deg, 2.4 ms -> +90 deg
+void SIMM_ServoStep(S_servoState *pState, double pulseMs, double dt)
+{
+    double target = (pulseMs - 1.5) * 100.0;
+    double maxStep = pState->rate * dt;
+    double delta = target - pState->angle;
+
+    if (delta > maxStep)
+    {
+        delta = maxStep;
+    }
+    else if (delta < -maxStep)
+    {
+        delta = -maxStep;
+    }
+    pState->angle += delta;
+}
@@ -0,0 +1,50 @@
+#ifndef SimMoteur_H
+#define SimMoteur_H
+/*--------------------------------------------------------*/
+// simMoteur.h
+/*--------------------------------------------------------*/
+//	Description :	Modeles pont en H, moteur DC et servo
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+// Parametres moteur DC (constantes de temps : Te = L/R, Tm = J.R/(Kt.Ke))
+typedef struct {
+    double vBus;        // tension pont en H [V]
+    double r;           // resistance induit [ohm]
+    double l;           // inductance induit [H]
+    double ke;          // constante de fcem [V/(rad/s)]
+    double kt;          // constante de couple [Nm/A]
+    double j;           // inertie [kg.m2]
+    double b;           // frottement visqueux [Nm/(rad/s)]
+    double tLoad;       // couple de charge [Nm]
+    uint16_t ppr;       // impulsions tachymetre par tour
+} S_motorParams;
+
+// Etat du moteur et du pont en H
+typedef struct {
+    double v;           // tension moyenne appliquee [V]
+    double i;           // courant [A]
+    double w;           // vitesse [rad/s]
+    double theta;       // position [rad]
+    double tachPhase;   // fraction d'impulsion tachymetre accumulee
+} S_motorState;
+
+// Etat du servo (suit la largeur d'impulsion avec une vitesse limitee)
+typedef struct {
+    double angle;       // angle [deg], -90 a +90
+    double rate;        // vitesse max [deg/s]
+} S_servoState;
+
+void SIMM_MotorInit(S_motorState *pState);
+// Avance de dt [s] ; retourne le nombre de flancs tachymetre produits
+uint32_t SIMM_MotorStep(const S_motorParams *pParams, S_motorState *pState,
+        uint8_t ain1, uint8_t ain2, uint8_t stby, double duty, double dt);
+void SIMM_ServoStep(S_servoState *pState, double pulseMs, double dt);
+
+#endif
@@ -0,0 +1,268 @@
+/*--------------------------------------------------------*/
+// simPlib.c
+/*--------------------------------------------------------*/
+//	Description :	Registres OC/TMR/IC/ADC/INT/ports simules pour executer
+//			        gestPWM.c et gestRegul.c sur PC.
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdarg.h>
+#include "simPlib.h"
+
+volatile uint32_t simCoreCount = 0;
+volatile uint8_t simAin1 = 0;
+volatile uint8_t simAin2 = 0;
+volatile uint8_t simStby = 0;
+uint32_t simLcdWrites = 0;
+
+SIM_TMR_REGS simTmr[TMR_NUMBER_OF_MODULES];
+SIM_OC_REGS simOc[OC_NUMBER_OF_MODULES];
+uint8_t simIcOn[IC_NUMBER_OF_MODULES];
+uint8_t simIntEnabled[INT_SOURCE_NUMBER];
+
+void BSP_EnableHbrige(void)
+{
+    simStby = 1;
+}
+
+void lcd_gotoxy(uint8_t x, uint8_t y)
+{
+    (void)x;
+    (void)y;
+    simLcdWrites++;
+}
+
+void printf_lcd(const char *fmt, ...)
+{
+    (void)fmt;
+    simLcdWrites++;
+}
+
+/*--------------------------------------------------------*/
+// Timers
+/*--------------------------------------------------------*/
+
+void PLIB_TMR_Stop(TMR_MODULE_ID index)                 { simTmr[index].on = 0; }
+void PLIB_TMR_Start(TMR_MODULE_ID index)                { simTmr[index].on = 1; }
+void PLIB_TMR_ClockSourceSelect(TMR_MODULE_ID index, TMR_CLOCK_SOURCE source) { (void)index; (void)source; }
+void PLIB_TMR_PrescaleSelect(TMR_MODULE_ID index, TMR_PRESCALE prescale) { simTmr[index].prescale = prescale; }
+void PLIB_TMR_Mode16BitEnable(TMR_MODULE_ID index)      { (void)index; }
+void PLIB_TMR_Counter16BitClear(TMR_MODULE_ID index)    { simTmr[index].counter = 0; }
+void PLIB_TMR_Period16BitSet(TMR_MODULE_ID index, uint16_t period) { simTmr[index].period = period; }
+
+/*--------------------------------------------------------*/
+// Output compare
+/*--------------------------------------------------------*/
+
+void PLIB_OC_ModeSelect(OC_MODULE_ID index, OC_COMPARE_MODES mode)     { (void)index; (void)mode; }
+void PLIB_OC_BufferSizeSelect(OC_MODULE_ID index, OC_BUFFER_SIZE size) { (void)index; (void)size; }
+void PLIB_OC_TimerSelect(OC_MODULE_ID index, OC_16BIT_TIMERS tmr)      { simOc[index].timer = tmr; }
+void PLIB_OC_Buffer16BitSet(OC_MODULE_ID index, uint16_t value)        { (void)index; (void)value; }
+void PLIB_OC_PulseWidth16BitSet(OC_MODULE_ID index, uint16_t width)   { simOc[index].pulseWidth = width; }
+void PLIB_OC_Enable(OC_MODULE_ID index)                                { simOc[index].on = 1; }
+
+/*--------------------------------------------------------*/
+// Input capture : FIFO de 4 captures comme le materiel, rempli par
+// SIM_IcCapture avec la valeur du timer choisi (fin du pas)
+/*--------------------------------------------------------*/
+
+#define SIM_IC_FIFO_SIZE    4
+
+IC_TIMERS simIcTimer[IC_NUMBER_OF_MODULES];
+static uint16_t simIcFifo[IC_NUMBER_OF_MODULES][SIM_IC_FIFO_SIZE];
+static uint8_t simIcCount[IC_NUMBER_OF_MODULES];
+
+void PLIB_IC_Disable(IC_MODULE_ID index)    { simIcOn[index] = 0; simIcCount[index] = 0; }
+void PLIB_IC_Enable(IC_MODULE_ID index)     { simIcOn[index] = 1; }
+void PLIB_IC_ModeSelect(IC_MODULE_ID index, IC_INPUT_CAPTURE_MODES mode) { (void)index; (void)mode; }
+void PLIB_IC_BufferSizeSelect(IC_MODULE_ID index, IC_BUFFER_SIZE size)   { (void)index; (void)size; }
+void PLIB_IC_TimerSelect(IC_MODULE_ID index, IC_TIMERS tmr)              { simIcTimer[index] = tmr; }
+void PLIB_IC_EventsPerInterruptSelect(IC_MODULE_ID index, IC_EVENTS_PER_INTERRUPT events) { (void)index; (void)events; }
+bool PLIB_IC_BufferIsEmpty(IC_MODULE_ID index) { return simIcCount[index] == 0; }
+
+uint16_t PLIB_IC_Buffer16BitGet(IC_MODULE_ID index)
+{
+    uint16_t value = simIcFifo[index][0];
+    uint8_t i;
+
+    if (simIcCount[index] == 0)
+    {
+        return 0;
+    }
+    simIcCount[index]--;
+    for (i = 0; i < simIcCount[index]; i++)
+    {
+        simIcFifo[index][i] = simIcFifo[index][i + 1];
+    }
+    return value;
+}
+
+// FIFO plein : capture perdue (ICOV sur la cible)
+void SIM_IcCapture(IC_MODULE_ID index)
+{
+    const SIM_TMR_REGS *pTmr = &simTmr[(simIcTimer[index] == IC_TIMER_TMR2) ? TMR_ID_2 : TMR_ID_3];
+
+    if (simIcOn[index] && (simIcCount[index] < SIM_IC_FIFO_SIZE) && (pTmr->prescale != 0))
+    {
+        simIcFifo[index][simIcCount[index]++] = (uint16_t)(pTmr->counter / pTmr->prescale);
+    }
+}
+
+/*--------------------------------------------------------*/
+// ADC : balayage des entrees du masque, deux demi-tampons de 8
+// resultats alternes (BUFS), flag toutes les SMPI conversions
+/*--------------------------------------------------------*/
+
+#define SIM_ADC_BUF_SIZE    16
+
+uint16_t simAdcInput[SIM_ADC_NB_INPUTS];
+static uint16_t simAdcBuf[SIM_ADC_BUF_SIZE];
+static uint16_t simAdcScanMask;
+static uint8_t simAdcScan;          // prochaine entree du balayage
+static uint8_t simAdcFill;          // prochain resultat ADC1BUFx
+static uint8_t simAdcPerIt = 1;
+static bool simAdcTwoBuffers;
+static bool simAdcOn;
+
+void PLIB_ADC_Enable(ADC_MODULE_ID index)   { (void)index; simAdcOn = true; simAdcFill = 0; simAdcScan = 0; }
+void PLIB_ADC_Disable(ADC_MODULE_ID index)  { (void)index; simAdcOn = false; }
+void PLIB_ADC_ConversionClockSourceSelect(ADC_MODULE_ID index, ADC_CLOCK_SOURCE source) { (void)index; (void)source; }
+void PLIB_ADC_ConversionClockSet(ADC_MODULE_ID index, uint32_t clockFrequency, uint32_t adcClock) { (void)index; (void)clockFrequency; (void)adcClock; }
+void PLIB_ADC_VoltageReferenceSelect(ADC_MODULE_ID index, ADC_VOLTAGE_REFERENCE configValue) { (void)index; (void)configValue; }
+void PLIB_ADC_SamplingModeSelect(ADC_MODULE_ID index, ADC_SAMPLING_MODE mode) { (void)index; (void)mode; }
+void PLIB_ADC_ResultFormatSelect(ADC_MODULE_ID index, ADC_RESULT_FORMAT format) { (void)index; (void)format; }
+void PLIB_ADC_ResultBufferModeSelect(ADC_MODULE_ID index, ADC_BUFFER_MODE mode) { (void)index; simAdcTwoBuffers = (mode == ADC_BUFFER_MODE_TWO_8WORD_BUFFERS); }
+void PLIB_ADC_SamplesPerInterruptSelect(ADC_MODULE_ID index, ADC_SAMPLES_PER_INTERRUPT value) { (void)index; simAdcPerIt = (uint8_t)value; }
+void PLIB_ADC_MuxChannel0InputNegativeSelect(ADC_MODULE_ID index, ADC_MUX muxType, ADC_INPUTS_NEGATIVE input) { (void)index; (void)muxType; (void)input; }
+void PLIB_ADC_MuxAInputScanEnable(ADC_MODULE_ID index) { (void)index; }
+void PLIB_ADC_InputScanMaskAdd(ADC_MODULE_ID index, ADC_INPUTS_SCAN scanInputs) { (void)index; simAdcScanMask |= (uint16_t)scanInputs; }
+void PLIB_ADC_ConversionTriggerSourceSelect(ADC_MODULE_ID index, ADC_CONVERSION_TRIGGER_SOURCE source) { (void)index; (void)source; }
+void PLIB_ADC_SampleAcquisitionTimeSet(ADC_MODULE_ID index, uint8_t acquisitionTime) { (void)index; (void)acquisitionTime; }
+void PLIB_ADC_SampleAutoStartEnable(ADC_MODULE_ID index) { (void)index; }
+
+ADC_RESULT_BUF_STATUS PLIB_ADC_ResultBufferStatusGet(ADC_MODULE_ID index)
+{
+    (void)index;
+    return (simAdcFill < SIM_ADC_BUF_SIZE / 2) ? ADC_FILLING_BUF_0TO7 : ADC_FILLING_BUF_8TOF;
+}
+
+ADC_SAMPLE PLIB_ADC_ResultGetByIndex(ADC_MODULE_ID index, uint8_t bufIndex)
+{
+    (void)index;
+    return simAdcBuf[bufIndex % SIM_ADC_BUF_SIZE];
+}
+
+bool SIM_AdcConvert(void)
+{
+    uint8_t start = (simAdcTwoBuffers && (simAdcFill >= SIM_ADC_BUF_SIZE / 2)) ? SIM_ADC_BUF_SIZE / 2 : 0;
+
+    if (!simAdcOn || (simAdcScanMask == 0))
+    {
+        return false;
+    }
+    while ((simAdcScanMask & (1u << simAdcScan)) == 0)
+    {
+        simAdcScan = (simAdcScan + 1) % SIM_ADC_NB_INPUTS;
+    }
+    simAdcBuf[simAdcFill++] = simAdcInput[simAdcScan];
+    simAdcScan = (simAdcScan + 1) % SIM_ADC_NB_INPUTS;
+    if (simAdcFill - start < simAdcPerIt)
+    {
+        return false;
+    }
+    // Fin de sequence : le balayage repart de la premiere entree et
+    // l'ADC bascule sur l'autre demi-tampon
+    simAdcScan = 0;
+    simAdcFill = (simAdcTwoBuffers && (start == 0)) ? SIM_ADC_BUF_SIZE / 2 : 0;
+    return true;
+}
+
+/*--------------------------------------------------------*/
+// Interruptions
+/*--------------------------------------------------------*/
+
+void PLIB_INT_VectorPrioritySet(INT_MODULE_ID index, INT_VECTOR vector, INT_PRIORITY_LEVEL priority)
+{
+    (void)index; (void)vector; (void)priority;
+}
+
+void PLIB_INT_VectorSubPrioritySet(INT_MODULE_ID index, INT_VECTOR vector, INT_SUBPRIORITY_LEVEL subPriority)
+{
+    (void)index; (void)vector; (void)subPriority;
+}
+
+void PLIB_INT_SourceFlagClear(INT_MODULE_ID index, INT_SOURCE source) { (void)index; (void)source; }
+
+// Seuls les flags de periode des timers sont simules
+bool PLIB_INT_SourceFlagGet(INT_MODULE_ID index, INT_SOURCE source)
+{
+    (void)index;
+    switch (source)
+    {
+        case INT_SOURCE_TIMER_3: return simTmr[TMR_ID_3].flag != 0;
+        case INT_SOURCE_TIMER_4: return simTmr[TMR_ID_4].flag != 0;
+        case INT_SOURCE_TIMER_5: return simTmr[TMR_ID_5].flag != 0;
+        default:                 return false;
+    }
+}
+void PLIB_INT_SourceEnable(INT_MODULE_ID index, INT_SOURCE source)    { (void)index; simIntEnabled[source] = 1; }
+void PLIB_INT_SourceDisable(INT_MODULE_ID index, INT_SOURCE source)   { (void)index; simIntEnabled[source] = 0; }
+bool PLIB_INT_SourceIsEnabled(INT_MODULE_ID index, INT_SOURCE source)  { (void)index; return simIntEnabled[source] != 0; }
+
+/*--------------------------------------------------------*/
+// Ports : simPortRead garde le dernier niveau lu, comme la
+// reference de comparaison du module change notice
+/*--------------------------------------------------------*/
+
+uint16_t simPort[PORT_NUMBER_OF_CHANNELS];
+uint16_t simPortRead[PORT_NUMBER_OF_CHANNELS];
+
+bool PLIB_PORTS_PinGet(PORTS_MODULE_ID index, PORTS_CHANNEL channel, PORTS_BIT_POS bitPos)
+{
+    uint16_t mask = (uint16_t)(1u << bitPos);
+
+    (void)index;
+    simPortRead[channel] = (simPortRead[channel] & ~mask) | (simPort[channel] & mask);
+    return (simPort[channel] & mask) != 0;
+}
+
+/*--------------------------------------------------------*/
+// Avance du temps
+/*--------------------------------------------------------*/
+
+// Avance les timers actifs de nbPbTics tics PBCLK ; leve le flag de
+// periode quand le compteur depasse PRx (comme TMRx == PRx)
+void SIM_AdvanceTimers(uint32_t nbPbTics)
+{
+    int i;
+    uint32_t limit;
+
+    simCoreCount += nbPbTics / 2;   // core timer a SYSCLK / 2, PBCLK = SYSCLK
+
+    for (i = 0; i < TMR_NUMBER_OF_MODULES; i++)
+    {
+        if (simTmr[i].on && (simTmr[i].prescale != 0))
+        {
+            simTmr[i].counter += nbPbTics;
+            limit = ((uint32_t)simTmr[i].period + 1) * simTmr[i].prescale;
+            if (simTmr[i].counter >= limit)
+            {
+                simTmr[i].counter -= limit;
+                simTmr[i].flag = 1;
+            }
+        }
+    }
+}
+
+// Lit et efface le flag de periode d'un timer
+bool SIM_TimerEvent(TMR_MODULE_ID index)
+{
+    bool event = simTmr[index].flag;
+
+    simTmr[index].flag = 0;
+    return event;
+}
@@ -0,0 +1,35 @@
+#ifndef SimPlib_H
+#define SimPlib_H
+/*--------------------------------------------------------*/
+// simPlib.h
+/*--------------------------------------------------------*/
+//	Description :	Registres OC/TMR/IC/ADC/INT/ports simules pour executer
+//			        gestPWM.c et gestRegul.c sur PC.
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <xc.h>
+#include "bsp.h"
+#include "Mc32DriverLcd.h"
+#include "peripheral/oc/plib_oc.h"
+#include "peripheral/tmr/plib_tmr.h"
+#include "peripheral/ic/plib_ic.h"
+#include "peripheral/adc/plib_adc.h"
+#include "peripheral/int/plib_int.h"
+#include "peripheral/ports/plib_ports.h"
+
+void SIM_AdvanceTimers(uint32_t nbPbTics);
+bool SIM_TimerEvent(TMR_MODULE_ID index);
+// Flanc sur l'entree de capture : valeur du timer choisi dans le FIFO
+void SIM_IcCapture(IC_MODULE_ID index);
+// Fin d'une conversion de la sequence de balayage : vrai quand le
+// demi-tampon est plein (flag d'interruption de l'ADC1)
+bool SIM_AdcConvert(void);
+
+#endif
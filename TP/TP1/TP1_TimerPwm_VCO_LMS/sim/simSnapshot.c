@@ -0,0 +1,134 @@
+/*--------------------------------------------------------*/
+// simSnapshot.c
+/*--------------------------------------------------------*/
+//	Description :	Stress du passage des settings entre ecrivain
+//			        (boucle principale) et lecteur (ISR). Un signal
+//			        SIGALRM periodique joue le role de l'ISR et
+//			        preempte l'ecrivain a des instants quelconques.
+//
+//	Utilisation :	simSnapshot [-n] [-t duree_s]
+//			        -n : lecture directe sans double tampon (reference)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+#include "gestPWM.h"
+
+static volatile S_pwmSettings shared;       // reference sans protection
+static volatile sig_atomic_t naive = 0;
+static volatile unsigned long nbReads = 0;
+static volatile unsigned long nbTorn = 0;
+
+// Les 4 champs doivent toujours decrire la meme consigne
+static int SIM_IsConsistent(const S_pwmSettings *pData)
+{
+    int absSpeed = (pData->SpeedSetting < 0) ? -pData->SpeedSetting : pData->SpeedSetting;
+
+    return (pData->absSpeed == absSpeed) &&
+           (pData->absAngle == pData->AngleSetting + 90);
+}
+
+// "ISR" lectrice
+static void SIM_ReaderIsr(int sig)
+{
+    S_pwmSettings copy;
+
+    (void)sig;
+    if (naive)
+    {
+        copy.absSpeed = shared.absSpeed;
+        copy.absAngle = shared.absAngle;
+        copy.SpeedSetting = shared.SpeedSetting;
+        copy.AngleSetting = shared.AngleSetting;
+    }
+    else
+    {
+        GPWM_GetSnapshot(&copy);
+    }
+    if (!SIM_IsConsistent(&copy))
+    {
+        nbTorn++;
+    }
+    nbReads++;
+}
+
+int main(int argc, char *argv[])
+{
+    struct sigaction sa;
+    struct itimerval it;
+    S_pwmSettings local;
+    double duration = 2.0;
+    unsigned long nbWrites = 0;
+    time_t end;
+    int a;
+    int8_t speed, angle;
+
+    for (a = 1; a < argc; a++)
+    {
+        if (strcmp(argv[a], "-n") == 0)
+        {
+            naive = 1;
+        }
+        else if ((strcmp(argv[a], "-t") == 0) && (a + 1 < argc))
+        {
+            duration = atof(argv[++a]);
+        }
+    }
+
+    // Etat initial coherent
+    memset(&local, 0, sizeof(local));
+    local.absAngle = 90;
+    GPWM_PublishSettings(&local);
+    shared.absAngle = 90;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = SIM_ReaderIsr;
+    sigaction(SIGALRM, &sa, NULL);
+    it.it_interval.tv_sec = 0;
+    it.it_interval.tv_usec = 20;
+    it.it_value = it.it_interval;
+    setitimer(ITIMER_REAL, &it, NULL);
+
+    // Ecrivain : consignes aleatoires, champ par champ comme GPWM_GetSettings
+    srand(1);
+    end = time(NULL) + (time_t)(duration + 0.5);
+    while (time(NULL) < end)
+    {
+        speed = (int8_t)((rand() % 199) - 99);
+        angle = (int8_t)((rand() % 181) - 90);
+        if (naive)
+        {
+            shared.SpeedSetting = speed;
+            shared.absSpeed = (speed < 0) ? -speed : speed;
+            shared.AngleSetting = angle;
+            shared.absAngle = angle + 90;
+        }
+        else
+        {
+            local.SpeedSetting = speed;
+            local.absSpeed = (speed < 0) ? -speed : speed;
+            local.AngleSetting = angle;
+            local.absAngle = angle + 90;
+            GPWM_PublishSettings(&local);
+        }
+        nbWrites++;
+    }
+
+    it.it_value.tv_usec = 0;
+    it.it_interval.tv_usec = 0;
+    setitimer(ITIMER_REAL, &it, NULL);
+
+    printf("%s : %lu ecritures, %lu lectures ISR, %lu lectures incoherentes\n",
+            naive ? "sans protection" : "double tampon", nbWrites, nbReads, nbTorn);
+
+    return ((nbTorn == 0) || naive) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,379 @@
+/*--------------------------------------------------------*/
+// simTP1.c
+/*--------------------------------------------------------*/
+//	Description :	Simulation sur PC du TP1 : execute gestPWM.c et
+//			        gestRegul.c contre les modeles pont en H / moteur /
+//			        servo et ecrit une trace CSV sur stdout.
+//
+//	Utilisation :	simTP1 [-c] [-t duree_s] > trace.csv
+//			        -c : regulation en boucle fermee
+//			        code de retour 0 si tous les controles passent
+//			        (resultats sur stderr)
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+//  Controles sur la trace des broches du pont en H (a chaque pas) :
+//  - AIN1 = AIN2 = 1 (frein) seulement avec la PWM a 0
+//  - tout demarrage dans le sens oppose au dernier sens pilote, meme
+//    apres une roue libre (+ -> 0 -> -), passe par frein puis temps
+//    mort, de durees GPWM_BRAKE_TIME_US / GPWM_DEAD_TIME_US (+ 2 pas)
+//  En boucle fermee (-c), pour chaque consigne non nulle, vitesse du
+//  modele (pas celle du tachymetre) :
+//  - dans +-SIM_SETTLE_BAND de la consigne apres SIM_SETTLE_MAX_S
+//  - erreur moyenne des SIM_FINAL_S dernieres s < SIM_FINAL_ERR_MAX
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "simPlib.h"
+#include "simMoteur.h"
+#include "gestPWM.h"
+#include "gestRegul.h"
+
+#define SIM_PBCLK_HZ        80000000.0
+#define SIM_DT_PB_TICS      800         // pas de simulation : 10 us
+#define SIM_DT_S            (SIM_DT_PB_TICS / SIM_PBCLK_HZ)
+#define SIM_CYCLE_STEPS     2000        // cycle applicatif : 20 ms
+#define SIM_TRACE_STEPS     100         // une ligne CSV par 1 ms
+
+// Tolerances de la boucle fermee
+#define SIM_SETTLE_BAND     0.05        // bande d'etablissement (relative)
+#define SIM_SETTLE_MAX_S    0.30
+#define SIM_FINAL_S         0.02
+#define SIM_FINAL_ERR_MAX   0.02
+
+// Consignes appliquees a partir de l'instant t [s]
+typedef struct {
+    double t;
+    int8_t speed;       // -99 a +99
+    int8_t angle;       // -90 a +90
+} S_simStep;
+
+static const S_simStep scenario[] = {
+    { 0.0,   50,   0 },
+    { 0.4,  -50,  45 },
+    { 0.8,   99, -90 },
+    { 1.2,    0,  90 },     // roue libre, puis sens oppose
+    { 1.4,  -99,  90 },
+    { 1.8,    0,   0 },
+};
+#define SIM_NB_STEPS    (sizeof(scenario) / sizeof(scenario[0]))
+
+// Moteur 12 V : Te = 0.5 ms, Tm ~ 31 ms, ~3000 t/min a vide
+static const S_motorParams motor = {
+    .vBus = 12.0, .r = 2.0, .l = 1.0e-3, .ke = 0.036, .kt = 0.036,
+    .j = 2.0e-5, .b = 1.0e-6, .tLoad = 2.0e-3, .ppr = 20,
+};
+
+// Etat des broches du pont en H
+typedef enum {
+    SIM_PINS_COAST = 0,     // AIN1 = AIN2 = 0
+    SIM_PINS_FWD,           // AIN1 = 1
+    SIM_PINS_REV,           // AIN2 = 1
+    SIM_PINS_BRAKE,         // AIN1 = AIN2 = 1
+} E_simPins;
+
+// Segments de la trace : courant et les 2 precedents
+typedef struct {
+    E_simPins pins;
+    double start;
+    E_simPins prev[2];          // prev[0] : le plus recent
+    double prevLen[2];
+    E_simPins lastDrive;        // dernier sens pilote (COAST : aucun)
+    uint32_t nbReversals;
+    uint32_t nbBadReversals;
+    uint32_t nbBrakeWithPwm;    // pas de simulation
+    double minBrake;
+    double maxBrake;
+    double minDead;
+    double maxDead;
+} S_simPinCheck;
+
+// Etablissement de la vitesse, par pas du scenario
+typedef struct {
+    double lastOut;             // dernier instant hors de la bande
+    double errSum;              // erreur relative, fin du pas
+    uint32_t errNb;
+} S_simSettle;
+
+static void SIM_PinCheckInit(S_simPinCheck *pChk)
+{
+    memset(pChk, 0, sizeof(*pChk));
+    pChk->minBrake = 1.0e9;
+    pChk->minDead = 1.0e9;
+}
+
+static void SIM_PinCheckStep(S_simPinCheck *pChk, double t, uint8_t ain1, uint8_t ain2, double duty)
+{
+    E_simPins pins = (E_simPins)((ain1 ? SIM_PINS_FWD : 0) | (ain2 ? SIM_PINS_REV : 0));
+    bool ok;
+
+    if ((pins == SIM_PINS_BRAKE) && (duty > 0.0))
+    {
+        pChk->nbBrakeWithPwm++;
+    }
+    if (pins == pChk->pins)
+    {
+        return;
+    }
+
+    // Fin du segment courant
+    pChk->prev[1] = pChk->prev[0];
+    pChk->prevLen[1] = pChk->prevLen[0];
+    pChk->prev[0] = pChk->pins;
+    pChk->prevLen[0] = t - pChk->start;
+    pChk->pins = pins;
+    pChk->start = t;
+
+    if ((pins != SIM_PINS_FWD) && (pins != SIM_PINS_REV))
+    {
+        return;
+    }
+    if ((pChk->lastDrive != SIM_PINS_COAST) && (pChk->lastDrive != pins))
+    {
+        // Inversion : ... -> frein -> temps mort -> nouveau sens
+        pChk->nbReversals++;
+        ok = (pChk->prev[1] == SIM_PINS_BRAKE) && (pChk->prev[0] == SIM_PINS_COAST)
+             && (pChk->prevLen[1] >= GPWM_BRAKE_TIME_US * 1.0e-6 - SIM_DT_S / 2)
+             && (pChk->prevLen[1] <= GPWM_BRAKE_TIME_US * 1.0e-6 + 2 * SIM_DT_S)
+             && (pChk->prevLen[0] >= GPWM_DEAD_TIME_US * 1.0e-6 - SIM_DT_S / 2)
+             && (pChk->prevLen[0] <= GPWM_DEAD_TIME_US * 1.0e-6 + 2 * SIM_DT_S);
+        if (!ok)
+        {
+            pChk->nbBadReversals++;
+            fprintf(stderr, "ECHEC inversion a %.4f s sans frein / temps mort\n", t);
+        }
+        else
+        {
+            pChk->minBrake = (pChk->prevLen[1] < pChk->minBrake) ? pChk->prevLen[1] : pChk->minBrake;
+            pChk->minDead = (pChk->prevLen[0] < pChk->minDead) ? pChk->prevLen[0] : pChk->minDead;
+            pChk->maxBrake = (pChk->prevLen[1] > pChk->maxBrake) ? pChk->prevLen[1] : pChk->maxBrake;
+            pChk->maxDead = (pChk->prevLen[0] > pChk->maxDead) ? pChk->prevLen[0] : pChk->maxDead;
+        }
+    }
+    pChk->lastDrive = pins;
+}
+
+// Pas du scenario en cours a l'instant t
+static size_t SIM_ScenarioIndex(double t)
+{
+    size_t k, index = 0;
+
+    for (k = 0; k < SIM_NB_STEPS; k++)
+    {
+        if (t >= scenario[k].t)
+        {
+            index = k;
+        }
+    }
+    return index;
+}
+
+// Fin du pas k (debut du suivant, ou fin de la simulation)
+static double SIM_ScenarioEnd(size_t k, double duration)
+{
+    return ((k + 1 < SIM_NB_STEPS) && (scenario[k + 1].t < duration)) ? scenario[k + 1].t : duration;
+}
+
+// Inversions attendues : changements de signe entre consignes non
+// nulles demarrees avant la fin
+static uint32_t SIM_ExpectedReversals(double duration)
+{
+    uint32_t nb = 0;
+    int8_t last = 0;
+    size_t k;
+
+    for (k = 0; (k < SIM_NB_STEPS) && (scenario[k].t < duration); k++)
+    {
+        if (scenario[k].speed != 0)
+        {
+            nb += ((last != 0) && ((last > 0) != (scenario[k].speed > 0)));
+            last = scenario[k].speed;
+        }
+    }
+    return nb;
+}
+
+// Vitesse du modele contre la consigne (boucle fermee)
+static void SIM_SettleStep(S_simSettle *pSettle, double t, double duration, double motorHz)
+{
+    size_t k = SIM_ScenarioIndex(t);
+    double target = scenario[k].speed * (double)GREG_TACH_FULL_SCALE_HZ / 99.0;
+    double err;
+
+    if (scenario[k].speed == 0)
+    {
+        return;
+    }
+    err = (motorHz - target) / target;
+    err = (err < 0.0) ? -err : err;
+    if (err > SIM_SETTLE_BAND)
+    {
+        pSettle[k].lastOut = t;
+    }
+    if (t >= SIM_ScenarioEnd(k, duration) - SIM_FINAL_S)
+    {
+        pSettle[k].errSum += err;
+        pSettle[k].errNb++;
+    }
+}
+
+static void SIM_ApplyScenario(S_pwmSettings *pData, double t)
+{
+    const S_simStep *pStep = &scenario[SIM_ScenarioIndex(t)];
+
+    pData->SpeedSetting = pStep->speed;
+    pData->absSpeed = (pStep->speed < 0) ? -pStep->speed : pStep->speed;
+    pData->AngleSetting = pStep->angle;
+    pData->absAngle = pStep->angle + 90;
+}
+
+int main(int argc, char *argv[])
+{
+    S_pwmSettings settings;
+    S_motorState motorState;
+    S_servoState servo = { 0.0, 600.0 };
+    S_regulStats stats;
+    S_simPinCheck pinCheck;
+    S_simSettle settle[SIM_NB_STEPS];
+    double settleTime, finalErr;
+    size_t k;
+    double duration = 2.0;
+    double t, duty, servoMs;
+    uint32_t nbSteps, step, edges, e;
+    int closed = 0;
+    int fail = 0;
+    int a;
+    clock_t wallStart;
+    double wall;
+
+    for (a = 1; a < argc; a++)
+    {
+        if (strcmp(argv[a], "-c") == 0)
+        {
+            closed = 1;
+        }
+        else if ((strcmp(argv[a], "-t") == 0) && (a + 1 < argc))
+        {
+            duration = atof(argv[++a]);
+        }
+    }
+
+    SIMM_MotorInit(&motorState);
+    SIM_PinCheckInit(&pinCheck);
+    memset(settle, 0, sizeof(settle));
+    GPWM_Initialize(&settings);
+    GREG_Initialize();
+    GREG_SetClosedLoop(closed != 0);
+
+    printf("t_s,speed_setting,angle_setting,ain1,ain2,bridge,duty,v,i,rpm,tach_hz,servo_deg\n");
+
+    wallStart = clock();
+    nbSteps = (uint32_t)(duration / SIM_DT_S);
+    for (step = 0; step < nbSteps; step++)
+    {
+        t = step * SIM_DT_S;
+
+        // Cycle applicatif (equivalent du tick 20 ms)
+        if ((step % SIM_CYCLE_STEPS) == 0)
+        {
+            SIM_ApplyScenario(&settings, t);
+            GPWM_PublishSettings(&settings);
+            GPWM_ExecPWM(&settings);
+            GPWM_DispSettings(&settings);
+        }
+
+        // Interruptions, par priorite decroissante
+        SIM_AdvanceTimers(SIM_DT_PB_TICS);
+        if (SIM_TimerEvent(TMR_ID_5) && simIntEnabled[INT_SOURCE_TIMER_5])
+        {
+            GPWM_DeadTimeCallback();
+        }
+        if (SIM_TimerEvent(TMR_ID_3) && simIntEnabled[INT_SOURCE_TIMER_3])
+        {
+            GREG_TimebaseCallback();
+        }
+        if (SIM_TimerEvent(TMR_ID_4) && simIntEnabled[INT_SOURCE_TIMER_4])
+        {
+            GREG_LoopCallback();
+        }
+
+        // Modeles
+        duty = (double)simOc[OC_ID_2].pulseWidth / (GPWM_MOTOR_PERIOD + 1);
+        if (duty > 1.0)
+        {
+            duty = 1.0;
+        }
+        SIM_PinCheckStep(&pinCheck, t, simAin1, simAin2, duty);
+        edges = SIMM_MotorStep(&motor, &motorState, simAin1, simAin2, simStby, duty, SIM_DT_S);
+        for (e = 0; e < edges; e++)
+        {
+            SIM_IcCapture(IC_ID_1);
+            if (simIcOn[IC_ID_1] && simIntEnabled[INT_SOURCE_INPUT_CAPTURE_1])
+            {
+                GREG_TachCallback();
+            }
+        }
+        if (closed)
+        {
+            SIM_SettleStep(settle, t, duration, motorState.w / 6.283185307179586 * motor.ppr);
+        }
+        servoMs = simOc[OC_ID_3].pulseWidth * 64.0 * 1000.0 / SIM_PBCLK_HZ;
+        SIMM_ServoStep(&servo, servoMs, SIM_DT_S);
+
+        if ((step % SIM_TRACE_STEPS) == 0)
+        {
+            printf("%.4f,%d,%d,%u,%u,%d,%.4f,%.3f,%.4f,%.1f,%d,%.2f\n",
+                    t, settings.SpeedSetting, settings.AngleSetting,
+                    simAin1, simAin2, (int)GPWM_GetBridgeState(), duty,
+                    motorState.v, motorState.i, motorState.w * 60.0 / 6.283185307179586,
+                    GREG_GetMeasuredSpeedHz(), servo.angle);
+        }
+    }
+    wall = (double)(clock() - wallStart) / CLOCKS_PER_SEC;
+
+    GREG_GetStats(&stats);
+    fprintf(stderr, "simule %.3f s en %.3f s (x%.0f temps reel), %u boucles PI, %u acces LCD\n",
+            duration, wall, (wall > 0.0) ? duration / wall : 0.0,
+            stats.nbLoops, simLcdWrites);
+
+    // Trace des broches du pont en H
+    fprintf(stderr, "%u inversions, frein %.0f a %.0f us, temps mort %.0f a %.0f us\n",
+            pinCheck.nbReversals, pinCheck.minBrake * 1.0e6, pinCheck.maxBrake * 1.0e6,
+            pinCheck.minDead * 1.0e6, pinCheck.maxDead * 1.0e6);
+    if ((pinCheck.nbReversals != SIM_ExpectedReversals(duration)) || (pinCheck.nbBadReversals != 0))
+    {
+        fprintf(stderr, "ECHEC sequence d'inversion\n");
+        fail = 1;
+    }
+    if (pinCheck.nbBrakeWithPwm != 0)
+    {
+        fprintf(stderr, "ECHEC frein avec PWM active (%u pas)\n", pinCheck.nbBrakeWithPwm);
+        fail = 1;
+    }
+
+    // Etablissement en boucle fermee (pas termines seulement)
+    for (k = 0; closed && (k < SIM_NB_STEPS) && (scenario[k].t < duration); k++)
+    {
+        if ((scenario[k].speed == 0) || (settle[k].errNb == 0))
+        {
+            continue;
+        }
+        settleTime = (settle[k].lastOut > scenario[k].t) ? (settle[k].lastOut - scenario[k].t) : 0.0;
+        finalErr = settle[k].errSum / settle[k].errNb;
+        fprintf(stderr, "consigne %+4d a %.1f s : etablie en %3.0f ms, erreur finale %.2f %%\n",
+                scenario[k].speed, scenario[k].t, settleTime * 1000.0, finalErr * 100.0);
+        if ((settleTime > SIM_SETTLE_MAX_S) || (finalErr > SIM_FINAL_ERR_MAX))
+        {
+            fprintf(stderr, "ECHEC regulation, consigne %+d\n", scenario[k].speed);
+            fail = 1;
+        }
+    }
+
+    fprintf(stderr, "%s\n", fail ? "ECHEC" : "OK");
+    return fail;
+}
@@ -0,0 +1,388 @@
+/*--------------------------------------------------------*/
+// simUsb.c
+/*--------------------------------------------------------*/
+//	Description :	Controleur USB full speed simule et hote CDC.
+//
+//	Le endpoint bulk IN a deux BD (ping-pong) comme le module USB
+//	du PIC32MX : le driver arme un BD avec l'adresse du paquet dans
+//	le tampon de l'ecriture, sans copie ; l'hote lit les octets au
+//	moment du jeton IN. Une zone du tampon modifiee entre l'ecriture
+//	et l'envoi du paquet arrive donc modifiee chez l'hote.
+//	L'interruption de fin de transaction (TRN) traite les paquets
+//	envoyes, signale WRITE_COMPLETE et arme les BD libres ; masquee
+//	(PLIB_INT_SourceDisable), elle est differee au jeton suivant.
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include "simUsb.h"
+#include "usb/usb_device.h"
+#include "usb/usb_device_cdc.h"
+#include "peripheral/int/plib_int.h"
+
+// Ecriture CDC en file
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    uint32_t nbPackets;         // paquet court ou nul final compris
+    uint32_t nbArmed;
+    uint32_t nbDone;
+} S_simTransfer;
+
+// Buffer descriptor du endpoint bulk IN
+typedef struct {
+    bool uown;                  // arme, propriete du SIE
+    const uint8_t *addr;
+    uint16_t cnt;
+} S_simBd;
+
+static USB_DEVICE_EVENT_HANDLER deviceHandler = NULL;
+static USB_DEVICE_CDC_EVENT_HANDLER cdcHandler = NULL;
+static SIM_USB_RX hostRx = NULL;
+static uint32_t nbOpen = 0;
+static bool attached = false;
+static bool configured = false;
+
+static S_simTransfer queue[SIM_USB_QUEUE_DEPTH];
+static uint32_t nbQueued = 0;       // compteurs libres, file circulaire
+static uint32_t nbFinished = 0;
+
+static S_simBd bd[2];
+static uint8_t bdFill = 0;          // prochain BD arme par le driver
+static uint8_t bdNext = 0;          // prochain BD lu par le SIE
+static uint32_t trnPending = 0;     // transactions non traitees (ISR masquee)
+
+// Dernier appel de controle de la fonction (S, R ou T)
+static char controlCall = 0;
+static void *controlBuffer = NULL;
+static size_t controlLength = 0;
+
+static S_simUsbStats stats;
+
+/*--------------------------------------------------------*/
+// Driver : armement des BD et interruption TRN
+/*--------------------------------------------------------*/
+
+static void SIM_UsbArm(void)
+{
+    uint32_t t;
+
+    for (t = nbFinished; t != nbQueued; t++)
+    {
+        S_simTransfer *pTr = &queue[t % SIM_USB_QUEUE_DEPTH];
+
+        while ((pTr->nbArmed < pTr->nbPackets) && !bd[bdFill].uown)
+        {
+            size_t offset = (size_t)pTr->nbArmed * SIM_USB_PACKET_SIZE;
+            size_t len = pTr->size - offset;
+
+            bd[bdFill].addr = pTr->data + offset;
+            bd[bdFill].cnt = (uint16_t)((len > SIM_USB_PACKET_SIZE) ? SIM_USB_PACKET_SIZE : len);
+            bd[bdFill].uown = true;
+            bdFill ^= 1;
+            pTr->nbArmed++;
+        }
+        if (bd[bdFill].uown)
+        {
+            break;
+        }
+    }
+}
+
+static void SIM_UsbComplete(USB_DEVICE_CDC_RESULT status, size_t length)
+{
+    USB_DEVICE_CDC_EVENT_DATA_WRITE_COMPLETE done;
+
+    done.handle = (USB_DEVICE_CDC_TRANSFER_HANDLE)nbFinished;
+    done.length = length;
+    done.status = status;
+    nbFinished++;
+    if (cdcHandler != NULL)
+    {
+        cdcHandler(USB_DEVICE_CDC_INDEX_0, USB_DEVICE_CDC_EVENT_WRITE_COMPLETE, &done, 0);
+    }
+}
+
+// ISR USB : une entree de la FIFO USTAT par paquet envoye
+static void SIM_UsbIsr(void)
+{
+    while (trnPending > 0)
+    {
+        S_simTransfer *pTr = &queue[nbFinished % SIM_USB_QUEUE_DEPTH];
+
+        trnPending--;
+        pTr->nbDone++;
+        if (pTr->nbDone == pTr->nbPackets)
+        {
+            SIM_UsbComplete(USB_DEVICE_CDC_RESULT_OK, pTr->size);
+        }
+    }
+    SIM_UsbArm();
+}
+
+/*--------------------------------------------------------*/
+// Couche device / CDC (sous-ensemble Harmony)
+/*--------------------------------------------------------*/
+
+USB_DEVICE_HANDLE USB_DEVICE_Open(unsigned instance, DRV_IO_INTENT intent)
+{
+    (void)instance;
+    (void)intent;
+
+    // Couche device pas encore prete au premier appel
+    return (nbOpen++ == 0) ? USB_DEVICE_HANDLE_INVALID : (USB_DEVICE_HANDLE)1;
+}
+
+void USB_DEVICE_EventHandlerSet(USB_DEVICE_HANDLE handle, USB_DEVICE_EVENT_HANDLER handler, uintptr_t context)
+{
+    (void)handle;
+    (void)context;
+    deviceHandler = handler;
+}
+
+void USB_DEVICE_Attach(USB_DEVICE_HANDLE handle)
+{
+    (void)handle;
+    attached = true;
+}
+
+void USB_DEVICE_Detach(USB_DEVICE_HANDLE handle)
+{
+    (void)handle;
+    attached = false;
+}
+
+int USB_DEVICE_ControlSend(USB_DEVICE_HANDLE handle, void *data, size_t length)
+{
+    (void)handle;
+    controlCall = 'S';
+    controlBuffer = data;
+    controlLength = length;
+    return 0;
+}
+
+int USB_DEVICE_ControlReceive(USB_DEVICE_HANDLE handle, void *data, size_t length)
+{
+    (void)handle;
+    controlCall = 'R';
+    controlBuffer = data;
+    controlLength = length;
+    return 0;
+}
+
+int USB_DEVICE_ControlStatus(USB_DEVICE_HANDLE handle, USB_DEVICE_CONTROL_STATUS status)
+{
+    (void)handle;
+    controlCall = (status == USB_DEVICE_CONTROL_STATUS_OK) ? 'T' : 'E';
+    return 0;
+}
+
+int USB_DEVICE_CDC_EventHandlerSet(USB_DEVICE_CDC_INDEX index, USB_DEVICE_CDC_EVENT_HANDLER handler,
+                                   uintptr_t context)
+{
+    (void)index;
+    (void)context;
+    cdcHandler = handler;
+    return 0;
+}
+
+USB_DEVICE_CDC_RESULT USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX index,
+        USB_DEVICE_CDC_TRANSFER_HANDLE *pHandle, const void *data, size_t size,
+        USB_DEVICE_CDC_TRANSFER_FLAGS flags)
+{
+    S_simTransfer *pTr;
+    bool zlp;
+
+    (void)index;
+    if (!configured)
+    {
+        stats.nbRejected++;
+        return USB_DEVICE_CDC_RESULT_ERROR_INSTANCE_NOT_CONFIGURED;
+    }
+    if ((nbQueued - nbFinished) >= SIM_USB_QUEUE_DEPTH)
+    {
+        stats.nbRejected++;
+        return USB_DEVICE_CDC_RESULT_ERROR_TRANSFER_QUEUE_FULL;
+    }
+    if ((size == 0) || ((flags == USB_DEVICE_CDC_TRANSFER_FLAGS_MORE_DATA_PENDING) &&
+                        ((size % SIM_USB_PACKET_SIZE) != 0)))
+    {
+        stats.nbRejected++;
+        return USB_DEVICE_CDC_RESULT_ERROR_TRANSFER_SIZE_INVALID;
+    }
+
+    // DATA_COMPLETE sur un multiple de 64 octets : paquet nul final
+    zlp = (flags == USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE) &&
+          ((size % SIM_USB_PACKET_SIZE) == 0);
+    pTr = &queue[nbQueued % SIM_USB_QUEUE_DEPTH];
+    pTr->data = data;
+    pTr->size = size;
+    pTr->nbPackets = (uint32_t)((size + SIM_USB_PACKET_SIZE - 1) / SIM_USB_PACKET_SIZE) + (zlp ? 1 : 0);
+    pTr->nbArmed = 0;
+    pTr->nbDone = 0;
+    *pHandle = (USB_DEVICE_CDC_TRANSFER_HANDLE)nbQueued;
+    nbQueued++;
+    stats.nbWrites++;
+
+    SIM_UsbArm();
+    return USB_DEVICE_CDC_RESULT_OK;
+}
+
+/*--------------------------------------------------------*/
+// Hote
+/*--------------------------------------------------------*/
+
+static void SIM_UsbDeviceEvent(USB_DEVICE_EVENT event, void *pData)
+{
+    if (deviceHandler != NULL)
+    {
+        deviceHandler(event, pData, 0);
+    }
+}
+
+// Requete de controle CDC, verifie la reponse attendue de la fonction
+static bool SIM_UsbCdcRequest(USB_DEVICE_CDC_EVENT event, void *pData, char expected)
+{
+    controlCall = 0;
+    if (cdcHandler != NULL)
+    {
+        cdcHandler(USB_DEVICE_CDC_INDEX_0, event, pData, 0);
+    }
+    if (controlCall != expected)
+    {
+        stats.nbControlErrors++;
+        return false;
+    }
+    return true;
+}
+
+void SIM_UsbSetReceiver(SIM_USB_RX rx)
+{
+    hostRx = rx;
+}
+
+bool SIM_UsbConnect(void)
+{
+    USB_DEVICE_EVENT_DATA_CONFIGURED config = { 1 };
+    USB_CDC_LINE_CODING coding = { 921600, 0, 0, 8 };
+    USB_CDC_LINE_CODING readBack;
+    bool ok = true;
+
+    // Driver USBFS : interruption du module validee
+    PLIB_INT_SourceEnable(INT_ID_0, INT_SOURCE_USB_1);
+
+    if (!attached)
+    {
+        SIM_UsbDeviceEvent(USB_DEVICE_EVENT_POWER_DETECTED, NULL);
+        if (!attached)
+        {
+            stats.nbControlErrors++;
+            return false;
+        }
+    }
+    SIM_UsbDeviceEvent(USB_DEVICE_EVENT_RESET, NULL);
+    configured = true;
+    SIM_UsbDeviceEvent(USB_DEVICE_EVENT_CONFIGURED, &config);
+
+    // SET_LINE_CODING : phase donnees puis statut
+    ok &= SIM_UsbCdcRequest(USB_DEVICE_CDC_EVENT_SET_LINE_CODING, NULL, 'R');
+    if (ok && (controlLength == sizeof(coding)))
+    {
+        memcpy(controlBuffer, &coding, sizeof(coding));
+        ok &= SIM_UsbCdcRequest(USB_DEVICE_CDC_EVENT_CONTROL_TRANSFER_DATA_RECEIVED, NULL, 'T');
+    }
+
+    // GET_LINE_CODING : relecture
+    ok &= SIM_UsbCdcRequest(USB_DEVICE_CDC_EVENT_GET_LINE_CODING, NULL, 'S');
+    if (ok && (controlLength == sizeof(readBack)))
+    {
+        memcpy(&readBack, controlBuffer, sizeof(readBack));
+        if (memcmp(&readBack, &coding, sizeof(coding)) != 0)
+        {
+            stats.nbControlErrors++;
+            ok = false;
+        }
+        if (cdcHandler != NULL)
+        {
+            cdcHandler(USB_DEVICE_CDC_INDEX_0, USB_DEVICE_CDC_EVENT_CONTROL_TRANSFER_DATA_SENT, NULL, 0);
+        }
+    }
+
+    return ok && SIM_UsbSetDtr(true);
+}
+
+bool SIM_UsbSetDtr(bool dtr)
+{
+    USB_CDC_CONTROL_LINE_STATE lineState = { 0, 0 };
+
+    lineState.dtr = dtr ? 1 : 0;
+    lineState.carrier = dtr ? 1 : 0;
+    return SIM_UsbCdcRequest(USB_DEVICE_CDC_EVENT_SET_CONTROL_LINE_STATE, &lineState, 'T');
+}
+
+void SIM_UsbReset(void)
+{
+    // Les IRP en cours sont abandonnes avant l'evenement RESET
+    configured = false;
+    bd[0].uown = false;
+    bd[1].uown = false;
+    bdFill = 0;
+    bdNext = 0;
+    trnPending = 0;
+    while (nbFinished != nbQueued)
+    {
+        stats.nbAborted++;
+        SIM_UsbComplete(USB_DEVICE_CDC_RESULT_ERROR_TERMINATED_BY_HOST, 0);
+    }
+    SIM_UsbDeviceEvent(USB_DEVICE_EVENT_RESET, NULL);
+    cdcHandler = NULL;
+}
+
+// Jeton IN de l'hote : le SIE envoie le BD courant s'il est arme
+void SIM_UsbSlot(void)
+{
+    S_simBd *pBd = &bd[bdNext];
+    bool usbInt = PLIB_INT_SourceIsEnabled(INT_ID_0, INT_SOURCE_USB_1);
+
+    // Transactions laissees en attente pendant le masquage
+    if (usbInt && (trnPending > 0))
+    {
+        SIM_UsbIsr();
+    }
+
+    if (!configured || !pBd->uown)
+    {
+        stats.nbNaks++;
+        return;
+    }
+
+    // Lecture DMA du tampon de l'application a cet instant
+    if ((hostRx != NULL) && (pBd->cnt > 0))
+    {
+        hostRx(pBd->addr, pBd->cnt);
+    }
+    stats.nbPackets++;
+    stats.nbBytes += pBd->cnt;
+    if (pBd->cnt == 0)
+    {
+        stats.nbZlp++;
+    }
+    pBd->uown = false;
+    bdNext ^= 1;
+
+    trnPending++;
+    if (usbInt)
+    {
+        SIM_UsbIsr();
+    }
+}
+
+void SIM_UsbGetStats(S_simUsbStats *pStats)
+{
+    *pStats = stats;
+}
@@ -0,0 +1,44 @@
+#ifndef SimUsb_H
+#define SimUsb_H
+/*--------------------------------------------------------*/
+// simUsb.h
+/*--------------------------------------------------------*/
+//	Description :	Controleur USB full speed simule (table de BD
+//			        ping-pong du endpoint bulk IN) et hote CDC,
+//			        sous la couche device / CDC Harmony (stubs/usb).
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define SIM_USB_PACKET_SIZE     64
+#define SIM_USB_QUEUE_DEPTH     2       // cdcInit0.queueSizeWrite
+
+typedef struct {
+    uint32_t nbPackets;         // paquets IN acquittes par l'hote
+    uint32_t nbZlp;             // dont paquets de longueur nulle
+    uint32_t nbNaks;            // jetons IN sans BD arme
+    uint32_t nbBytes;           // octets recus par l'hote
+    uint32_t nbWrites;          // ecritures CDC acceptees
+    uint32_t nbRejected;        // ecritures refusees (file pleine, non configure)
+    uint32_t nbAborted;         // ecritures abandonnees (reset)
+    uint32_t nbControlErrors;   // requetes de controle mal traitees
+} S_simUsbStats;
+
+// Reception cote hote, appelee a chaque paquet IN
+typedef void (*SIM_USB_RX)(const uint8_t *data, size_t len);
+
+void SIM_UsbSetReceiver(SIM_USB_RX rx);
+bool SIM_UsbConnect(void);          // VBUS, reset, configuration, line coding, DTR = 1
+bool SIM_UsbSetDtr(bool dtr);       // ouverture / fermeture du port par l'hote
+void SIM_UsbReset(void);            // reset du bus, reconfiguration par SIM_UsbConnect
+void SIM_UsbSlot(void);             // un jeton IN de l'hote sur le endpoint bulk
+void SIM_UsbGetStats(S_simUsbStats *pStats);
+
+#endif
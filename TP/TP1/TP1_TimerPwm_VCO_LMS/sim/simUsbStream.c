@@ -0,0 +1,345 @@
+/*--------------------------------------------------------*/
+// simUsbStream.c
+/*--------------------------------------------------------*/
+//	Description :	Simulation sur PC de gestUsbStream.c contre le
+//			        controleur USB simule (simUsb.c) :
+//			        1. enumeration, acquisition ADC1 (GUSB_AdcCallback,
+//			           GUSB_ADC_RATE_HZ) : debit >= 500 ko/s exige
+//			        2. producteur synthetique a debit fixe, sans perte
+//			        3. producteur sature : debit max. du canal
+//			        4. fermeture / reouverture du port, reset du bus
+//			        Chaque echantillon recu est verifie (sync, somme,
+//			        sequence, voie ADC) : une zone de l'anneau reecrite
+//			        avant son envoi serait detectee.
+//
+//	Utilisation :	simUsbStream [-p paquets/trame] [-r ech/s]
+//			                     [-m periode boucle us] [-t duree ms]
+//			        code de retour 0 si tous les controles passent
+//
+//	Auteur 		: 	LMS
+//
+//	Version		:	V1.0
+//
+/*--------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "system_config.h"
+#include "simPlib.h"
+#include "simUsb.h"
+#include "gestUsbStream.h"
+#include "GestPWM.h"
+
+#define SIM_CORE_TICS_US        (SYS_CLK_FREQ / 2000000)
+#define SIM_MIN_KBYTES_S        500     // objectif de debit soutenu
+#define SIM_ADC_AN1_OFFSET      512     // AN1 dans la moitie haute
+
+typedef enum {
+    SIM_PROD_NONE = 0,
+    SIM_PROD_ADC,           // conversions ADC1, GUSB_AdcCallback
+    SIM_PROD_RATE,          // echantillons synthetiques a debit fixe
+    SIM_PROD_SATURATE,      // anneau rempli a chaque us
+} E_simProducer;
+
+// Controle du flux recu par l'hote
+typedef struct {
+    uint8_t pending[sizeof(S_usbSample)];
+    size_t nbPending;
+    uint32_t nbSamples;
+    uint32_t nbLost;        // trous de sequence
+    uint32_t nbCorrupt;     // sync ou somme invalide
+    uint32_t nbBadChan;     // conversion hors de la plage de sa voie
+    uint32_t maxLatency;    // commit -> reception (tics core timer)
+    uint32_t nbBytes;
+    bool first;
+    uint16_t lastSeq;
+} S_simHost;
+
+static S_simHost host;
+static uint32_t nbSlotsPerFrame = 19;
+static uint32_t mainPeriodUs = 1000;
+static uint32_t simTimeUs = 0;
+
+static void SIM_HostClear(void)
+{
+    memset(&host, 0, sizeof(host));
+    host.first = true;
+}
+
+static void SIM_HostSample(const S_usbSample *pSample)
+{
+    const uint8_t *pByte = (const uint8_t *)pSample;
+    uint8_t sum = 0;
+    size_t i;
+
+    for (i = 0; i < sizeof(S_usbSample); i++)
+    {
+        sum += pByte[i];
+    }
+    if ((pSample->sync != GUSB_SYNC) || (sum != 0xFF))
+    {
+        host.nbCorrupt++;
+        return;
+    }
+    if (!host.first)
+    {
+        host.nbLost += (uint16_t)(pSample->seq - host.lastSeq - 1);
+    }
+    host.first = false;
+    host.lastSeq = pSample->seq;
+    host.nbSamples++;
+    if (((pSample->status >> GUSB_STATUS_CHAN_SHIFT) & 1) != (pSample->adc >= SIM_ADC_AN1_OFFSET))
+    {
+        host.nbBadChan++;
+    }
+    if ((simCoreCount - pSample->stamp) > host.maxLatency)
+    {
+        host.maxLatency = simCoreCount - pSample->stamp;
+    }
+}
+
+// Paquets IN : les ecritures commencent toujours sur un echantillon
+static void SIM_HostRx(const uint8_t *data, size_t len)
+{
+    S_usbSample sample;
+
+    host.nbBytes += (uint32_t)len;
+    while (len > 0)
+    {
+        size_t nb = sizeof(S_usbSample) - host.nbPending;
+
+        if (nb > len)
+        {
+            nb = len;
+        }
+        memcpy(&host.pending[host.nbPending], data, nb);
+        host.nbPending += nb;
+        data += nb;
+        len -= nb;
+        if (host.nbPending == sizeof(S_usbSample))
+        {
+            memcpy(&sample, host.pending, sizeof(sample));
+            SIM_HostSample(&sample);
+            host.nbPending = 0;
+        }
+    }
+}
+
+static void SIM_Produce(uint32_t index)
+{
+    S_usbSample *pSample = GUSB_ReserveSample();
+
+    if (pSample != NULL)
+    {
+        pSample->stamp = simCoreCount;
+        pSample->speedSetting = (int8_t)(index % 199 - 99);
+        pSample->angleSetting = (int8_t)(index % 181 - 90);
+        pSample->adc = (uint16_t)(index % SIM_ADC_AN1_OFFSET);
+        pSample->measuredHz = (int16_t)index;
+        pSample->status = 0;
+        GUSB_CommitSample();
+    }
+}
+
+// Avance de durationUs : jetons IN, boucle principale, producteur
+static void SIM_Run(uint32_t durationUs, E_simProducer producer, uint32_t rate)
+{
+    uint32_t t, frameUs, slot, lastSlot = ~0u;
+    uint64_t nbDue;
+    uint32_t nbProduced = 0;
+    uint32_t nbConversions = 0;
+
+    for (t = 0; t < durationUs; t++, simTimeUs++)
+    {
+        simCoreCount += SIM_CORE_TICS_US;
+
+        // Jetons IN repartis sur la trame de 1 ms
+        frameUs = simTimeUs % 1000;
+        slot = (frameUs * nbSlotsPerFrame) / 1000;
+        if (slot != lastSlot)
+        {
+            SIM_UsbSlot();
+            lastSlot = slot;
+        }
+
+        switch (producer)
+        {
+            case SIM_PROD_ADC:
+                // Potentiometres en rampe, une voie par moitie d'echelle
+                nbDue = ((uint64_t)t * GUSB_ADC_RATE_HZ) / 1000000u;
+                while (nbConversions < nbDue)
+                {
+                    simAdcInput[0] = (uint16_t)(nbConversions % SIM_ADC_AN1_OFFSET);
+                    simAdcInput[1] = (uint16_t)(SIM_ADC_AN1_OFFSET + nbConversions % SIM_ADC_AN1_OFFSET);
+                    nbConversions++;
+                    if (SIM_AdcConvert() && PLIB_INT_SourceIsEnabled(INT_ID_0, INT_SOURCE_ADC_1))
+                    {
+                        GUSB_AdcCallback();
+                    }
+                }
+                break;
+
+            case SIM_PROD_RATE:
+                nbDue = ((uint64_t)t * rate) / 1000000u;
+                while (nbProduced < nbDue)
+                {
+                    SIM_Produce(nbProduced++);
+                }
+                break;
+
+            case SIM_PROD_SATURATE:
+                while (GUSB_ReserveSample() != NULL)
+                {
+                    SIM_Produce(nbProduced++);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        if ((simTimeUs % mainPeriodUs) == 0)
+        {
+            GUSB_Tasks();
+        }
+    }
+}
+
+static int SIM_Check(bool cond, const char *what)
+{
+    if (!cond)
+    {
+        printf("ECHEC %s\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+static void SIM_Report(const char *phase, uint32_t durationUs)
+{
+    printf("%-10s %6u ech. recus, %4u perdus, %u corrompus, %7.1f ko/s, latence max. %u us\n",
+           phase, host.nbSamples, host.nbLost, host.nbCorrupt,
+           host.nbBytes * 1000.0 / durationUs,
+           (unsigned)(host.maxLatency / SIM_CORE_TICS_US));
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t rate = 40000;
+    uint32_t durationMs = 1000;
+    uint32_t durationUs, overflows;
+    S_usbStreamStats streamStats;
+    S_simUsbStats usbStats;
+    S_pwmSettings settings = { 40, 135, -40, 45 };
+    double kBytesPerS;
+    int i, fail = 0;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc))
+        {
+            nbSlotsPerFrame = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc))
+        {
+            rate = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc))
+        {
+            mainPeriodUs = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            durationMs = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+    }
+    if ((nbSlotsPerFrame == 0) || (nbSlotsPerFrame > 19) || (mainPeriodUs == 0))
+    {
+        printf("-p 1 a 19 paquets par trame, -m > 0\n");
+        return 2;
+    }
+    durationUs = durationMs * 1000;
+    printf("%u paquets/trame (max. %u ko/s), boucle principale %u us\n",
+           nbSlotsPerFrame, nbSlotsPerFrame * SIM_USB_PACKET_SIZE, mainPeriodUs);
+
+    GPWM_PublishSettings(&settings);
+    GUSB_Initialize();
+    SIM_UsbSetReceiver(SIM_HostRx);
+
+    // 1. Enumeration puis acquisition ADC1 : le seul producteur du firmware
+    SIM_Run(3 * mainPeriodUs, SIM_PROD_NONE, 0);
+    fail |= SIM_Check(SIM_UsbConnect(), "enumeration CDC");
+    SIM_Run(2 * mainPeriodUs, SIM_PROD_NONE, 0);
+    fail |= SIM_Check(GUSB_IsStreaming(), "flux non demarre apres DTR");
+    GUSB_GetStats(&streamStats);
+    overflows = streamStats.nbOverflows;
+    SIM_HostClear();
+    SIM_Run(durationUs, SIM_PROD_ADC, 0);
+    SIM_Report("ADC", durationUs);
+    kBytesPerS = host.nbBytes * 1000.0 / durationUs;
+    GUSB_GetStats(&streamStats);
+    fail |= SIM_Check((host.nbCorrupt == 0) && (host.nbBadChan == 0),
+                      "echantillons corrompus / voie ADC (ADC)");
+    fail |= SIM_Check(kBytesPerS >= SIM_MIN_KBYTES_S, "debit ADC < 500 ko/s");
+    if ((GUSB_ADC_RATE_HZ * sizeof(S_usbSample)) < (nbSlotsPerFrame * SIM_USB_PACKET_SIZE * 1000u))
+    {
+        fail |= SIM_Check((host.nbLost == 0) && (streamStats.nbOverflows == overflows),
+                          "pertes ADC sous le debit du canal");
+    }
+    SIM_Run(20000, SIM_PROD_NONE, 0);
+
+    // 2. Debit fixe
+    GUSB_GetStats(&streamStats);
+    overflows = streamStats.nbOverflows;
+    SIM_HostClear();
+    SIM_Run(durationUs, SIM_PROD_RATE, rate);
+    SIM_Run(20000, SIM_PROD_NONE, 0);   // vidange
+    SIM_Report("debit", durationUs);
+    GUSB_GetStats(&streamStats);
+    if ((rate * sizeof(S_usbSample)) <= (nbSlotsPerFrame * SIM_USB_PACKET_SIZE * 1000u))
+    {
+        fail |= SIM_Check((host.nbLost == 0) && (streamStats.nbOverflows == overflows),
+                          "pertes sous le debit du canal");
+    }
+    fail |= SIM_Check(host.nbCorrupt == 0, "echantillons corrompus (debit)");
+
+    // 3. Saturation : debit max. soutenu
+    SIM_HostClear();
+    SIM_Run(durationUs, SIM_PROD_SATURATE, 0);
+    SIM_Report("saturation", durationUs);
+    kBytesPerS = host.nbBytes * 1000.0 / durationUs;
+    fail |= SIM_Check(host.nbCorrupt == 0, "echantillons corrompus (saturation)");
+    fail |= SIM_Check(kBytesPerS >= SIM_MIN_KBYTES_S, "debit soutenu < 500 ko/s");
+    SIM_Run(20000, SIM_PROD_NONE, 0);
+
+    // 4. Fermeture du port, reouverture, reset du bus en plein flux
+    fail |= SIM_Check(SIM_UsbSetDtr(false), "fermeture du port");
+    SIM_Run(5 * mainPeriodUs, SIM_PROD_RATE, rate);
+    fail |= SIM_Check(!GUSB_IsStreaming(), "flux actif port ferme");
+    fail |= SIM_Check(SIM_UsbSetDtr(true), "reouverture du port");
+    SIM_Run(2 * mainPeriodUs, SIM_PROD_NONE, 0);
+    SIM_HostClear();
+    SIM_Run(100000, SIM_PROD_RATE, rate);
+    SIM_UsbReset();
+    SIM_Run(5 * mainPeriodUs, SIM_PROD_RATE, rate);
+    fail |= SIM_Check(!GUSB_IsStreaming(), "flux actif apres reset");
+    fail |= SIM_Check(SIM_UsbConnect(), "re-enumeration");
+    SIM_Run(100000, SIM_PROD_RATE, rate);
+    SIM_Report("reprise", 200000);
+    fail |= SIM_Check(GUSB_IsStreaming() && (host.nbCorrupt == 0) && (host.nbSamples > 0),
+                      "reprise apres reset");
+
+    GUSB_GetStats(&streamStats);
+    SIM_UsbGetStats(&usbStats);
+    printf("USB : %u paquets (%u nuls), %u NAK, %u ecritures, %u refusees, %u abandonnees\n",
+           usbStats.nbPackets, usbStats.nbZlp, usbStats.nbNaks, usbStats.nbWrites,
+           usbStats.nbRejected, usbStats.nbAborted);
+    printf("anneau : %u echantillons, %u perdus (plein), remplissage max. %u / %u\n",
+           streamStats.nbSamples, streamStats.nbOverflows, streamStats.maxFill, GUSB_RING_SAMPLES);
+    fail |= SIM_Check((usbStats.nbControlErrors == 0) && (streamStats.nbWriteErrors == 0),
+                      "requetes de controle / ecritures refusees");
+    printf("%s\n", fail ? "ECHEC" : "OK");
+
+    return fail;
+}
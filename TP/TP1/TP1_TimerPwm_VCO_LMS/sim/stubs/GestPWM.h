@@ -0,0 +1,9 @@
+/*--------------------------------------------------------*/
+// GestPWM.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	gestPWM.c inclut "GestPWM.h" ; redirige vers le
+//			        vrai fichier pour les systemes de fichiers sensibles
+//			        a la casse.
+/*--------------------------------------------------------*/
+
+#include "gestPWM.h"
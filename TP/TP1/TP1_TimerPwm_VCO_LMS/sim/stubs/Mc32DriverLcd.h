@@ -0,0 +1,16 @@
+#ifndef SIM_MC32DRIVERLCD_H
+#define SIM_MC32DRIVERLCD_H
+/*--------------------------------------------------------*/
+// Mc32DriverLcd.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	LCD sans effet, compte seulement les acces.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+extern uint32_t simLcdWrites;
+
+void lcd_gotoxy(uint8_t x, uint8_t y);
+void printf_lcd(const char *fmt, ...);
+
+#endif
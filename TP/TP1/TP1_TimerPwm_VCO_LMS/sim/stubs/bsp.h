@@ -0,0 +1,22 @@
+#ifndef SIM_BSP_H
+#define SIM_BSP_H
+/*--------------------------------------------------------*/
+// bsp.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Broches du kit remplacees par des variables
+//			        lues par le modele du pont en H.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+extern volatile uint8_t simAin1;
+extern volatile uint8_t simAin2;
+extern volatile uint8_t simStby;
+
+#define AIN1_HBRIDGE_W      simAin1
+#define AIN2_HBRIDGE_W      simAin2
+#define STBY_HBRIDGE_W      simStby
+
+void BSP_EnableHbrige(void);
+
+#endif
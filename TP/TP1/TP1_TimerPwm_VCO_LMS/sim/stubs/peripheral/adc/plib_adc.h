@@ -0,0 +1,47 @@
+#ifndef SIM_PLIB_ADC_H
+#define SIM_PLIB_ADC_H
+/*--------------------------------------------------------*/
+// plib_adc.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum { ADC_ID_1 = 0 } ADC_MODULE_ID;
+typedef enum { ADC_CLOCK_SOURCE_PERIPHERAL_BUS_CLOCK = 0 } ADC_CLOCK_SOURCE;
+typedef enum { ADC_REFERENCE_VDD_TO_AVSS = 0 } ADC_VOLTAGE_REFERENCE;
+typedef enum { ADC_SAMPLING_MODE_MUXA = 0 } ADC_SAMPLING_MODE;
+typedef enum { ADC_RESULT_FORMAT_INTEGER_16BIT = 0 } ADC_RESULT_FORMAT;
+typedef enum { ADC_BUFFER_MODE_ONE_16WORD_BUFFER = 0, ADC_BUFFER_MODE_TWO_8WORD_BUFFERS } ADC_BUFFER_MODE;
+typedef enum { ADC_8SAMPLES_PER_INTERRUPT = 8, ADC_16SAMPLES_PER_INTERRUPT = 16 } ADC_SAMPLES_PER_INTERRUPT;
+typedef enum { ADC_MUX_A = 0 } ADC_MUX;
+typedef enum { ADC_INPUT_NEGATIVE_VREF_MINUS = 0 } ADC_INPUTS_NEGATIVE;
+typedef enum { ADC_INPUT_SCAN_AN0 = 0x0001, ADC_INPUT_SCAN_AN1 = 0x0002 } ADC_INPUTS_SCAN;
+typedef enum { ADC_CONVERSION_TRIGGER_INTERNAL_COUNT = 7 } ADC_CONVERSION_TRIGGER_SOURCE;
+typedef enum { ADC_FILLING_BUF_0TO7 = 0, ADC_FILLING_BUF_8TOF } ADC_RESULT_BUF_STATUS;
+typedef uint32_t ADC_SAMPLE;
+
+#define SIM_ADC_NB_INPUTS   2
+
+// Tensions converties (AN0, AN1), ecrites par la simulation
+extern uint16_t simAdcInput[SIM_ADC_NB_INPUTS];
+
+void PLIB_ADC_Enable(ADC_MODULE_ID index);
+void PLIB_ADC_Disable(ADC_MODULE_ID index);
+void PLIB_ADC_ConversionClockSourceSelect(ADC_MODULE_ID index, ADC_CLOCK_SOURCE source);
+void PLIB_ADC_ConversionClockSet(ADC_MODULE_ID index, uint32_t clockFrequency, uint32_t adcClock);
+void PLIB_ADC_VoltageReferenceSelect(ADC_MODULE_ID index, ADC_VOLTAGE_REFERENCE configValue);
+void PLIB_ADC_SamplingModeSelect(ADC_MODULE_ID index, ADC_SAMPLING_MODE mode);
+void PLIB_ADC_ResultFormatSelect(ADC_MODULE_ID index, ADC_RESULT_FORMAT format);
+void PLIB_ADC_ResultBufferModeSelect(ADC_MODULE_ID index, ADC_BUFFER_MODE mode);
+void PLIB_ADC_SamplesPerInterruptSelect(ADC_MODULE_ID index, ADC_SAMPLES_PER_INTERRUPT value);
+void PLIB_ADC_MuxChannel0InputNegativeSelect(ADC_MODULE_ID index, ADC_MUX muxType, ADC_INPUTS_NEGATIVE input);
+void PLIB_ADC_MuxAInputScanEnable(ADC_MODULE_ID index);
+void PLIB_ADC_InputScanMaskAdd(ADC_MODULE_ID index, ADC_INPUTS_SCAN scanInputs);
+void PLIB_ADC_ConversionTriggerSourceSelect(ADC_MODULE_ID index, ADC_CONVERSION_TRIGGER_SOURCE source);
+void PLIB_ADC_SampleAcquisitionTimeSet(ADC_MODULE_ID index, uint8_t acquisitionTime);
+void PLIB_ADC_SampleAutoStartEnable(ADC_MODULE_ID index);
+ADC_RESULT_BUF_STATUS PLIB_ADC_ResultBufferStatusGet(ADC_MODULE_ID index);
+ADC_SAMPLE PLIB_ADC_ResultGetByIndex(ADC_MODULE_ID index, uint8_t bufIndex);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef SIM_PLIB_IC_H
+#define SIM_PLIB_IC_H
+/*--------------------------------------------------------*/
+// plib_ic.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum { IC_ID_1 = 0, IC_ID_2, IC_ID_3, IC_ID_4, IC_ID_5, IC_NUMBER_OF_MODULES } IC_MODULE_ID;
+typedef enum { IC_INPUT_CAPTURE_EVERY_RISING_EDGE_MODE = 3 } IC_INPUT_CAPTURE_MODES;
+typedef enum { IC_BUFFER_SIZE_16BIT = 0 } IC_BUFFER_SIZE;
+typedef enum { IC_TIMER_TMR2 = 0, IC_TIMER_TMR3 } IC_TIMERS;
+typedef enum { IC_INTERRUPT_ON_EVERY_CAPTURE_EVENT = 0 } IC_EVENTS_PER_INTERRUPT;
+
+extern uint8_t simIcOn[IC_NUMBER_OF_MODULES];
+extern IC_TIMERS simIcTimer[IC_NUMBER_OF_MODULES];
+
+void PLIB_IC_Disable(IC_MODULE_ID index);
+void PLIB_IC_Enable(IC_MODULE_ID index);
+void PLIB_IC_ModeSelect(IC_MODULE_ID index, IC_INPUT_CAPTURE_MODES mode);
+void PLIB_IC_BufferSizeSelect(IC_MODULE_ID index, IC_BUFFER_SIZE size);
+void PLIB_IC_TimerSelect(IC_MODULE_ID index, IC_TIMERS tmr);
+void PLIB_IC_EventsPerInterruptSelect(IC_MODULE_ID index, IC_EVENTS_PER_INTERRUPT events);
+bool PLIB_IC_BufferIsEmpty(IC_MODULE_ID index);
+uint16_t PLIB_IC_Buffer16BitGet(IC_MODULE_ID index);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SIM_PLIB_INT_H
+#define SIM_PLIB_INT_H
+/*--------------------------------------------------------*/
+// plib_int.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum { INT_ID_0 = 0 } INT_MODULE_ID;
+typedef enum {
+    INT_SOURCE_TIMER_3 = 0, INT_SOURCE_TIMER_4, INT_SOURCE_TIMER_5, INT_SOURCE_INPUT_CAPTURE_1,
+    INT_SOURCE_CHANGE_NOTICE, INT_SOURCE_USB_1, INT_SOURCE_ADC_1,
+    INT_SOURCE_NUMBER
+} INT_SOURCE;
+typedef enum { INT_VECTOR_T3 = 0, INT_VECTOR_T4, INT_VECTOR_T5, INT_VECTOR_IC1, INT_VECTOR_CN, INT_VECTOR_USB1, INT_VECTOR_AD1 } INT_VECTOR;
+typedef enum {
+    INT_PRIORITY_LEVEL1 = 1, INT_PRIORITY_LEVEL2 = 2, INT_PRIORITY_LEVEL3 = 3, INT_PRIORITY_LEVEL4 = 4, INT_PRIORITY_LEVEL5 = 5
+} INT_PRIORITY_LEVEL;
+typedef enum { INT_SUBPRIORITY_LEVEL0 = 0, INT_SUBPRIORITY_LEVEL1 } INT_SUBPRIORITY_LEVEL;
+
+extern uint8_t simIntEnabled[INT_SOURCE_NUMBER];
+
+void PLIB_INT_VectorPrioritySet(INT_MODULE_ID index, INT_VECTOR vector, INT_PRIORITY_LEVEL priority);
+void PLIB_INT_VectorSubPrioritySet(INT_MODULE_ID index, INT_VECTOR vector, INT_SUBPRIORITY_LEVEL subPriority);
+void PLIB_INT_SourceFlagClear(INT_MODULE_ID index, INT_SOURCE source);
+bool PLIB_INT_SourceFlagGet(INT_MODULE_ID index, INT_SOURCE source);
+void PLIB_INT_SourceEnable(INT_MODULE_ID index, INT_SOURCE source);
+void PLIB_INT_SourceDisable(INT_MODULE_ID index, INT_SOURCE source);
+bool PLIB_INT_SourceIsEnabled(INT_MODULE_ID index, INT_SOURCE source);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef SIM_PLIB_OC_H
+#define SIM_PLIB_OC_H
+/*--------------------------------------------------------*/
+// plib_oc.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+typedef enum { OC_ID_1 = 0, OC_ID_2, OC_ID_3, OC_ID_4, OC_ID_5, OC_NUMBER_OF_MODULES } OC_MODULE_ID;
+typedef enum { OC_COMPARE_PWM_MODE_WITHOUT_FAULT_PROTECTION = 6 } OC_COMPARE_MODES;
+typedef enum { OC_BUFFER_SIZE_16BIT = 0 } OC_BUFFER_SIZE;
+typedef enum { OC_TIMER_16BIT_TMR2 = 0, OC_TIMER_16BIT_TMR3 } OC_16BIT_TIMERS;
+
+// Registres simules
+typedef struct {
+    uint8_t on;
+    uint8_t timer;          // OC_TIMER_16BIT_TMRx
+    uint16_t pulseWidth;    // OCxRS
+} SIM_OC_REGS;
+
+extern SIM_OC_REGS simOc[OC_NUMBER_OF_MODULES];
+
+void PLIB_OC_ModeSelect(OC_MODULE_ID index, OC_COMPARE_MODES mode);
+void PLIB_OC_BufferSizeSelect(OC_MODULE_ID index, OC_BUFFER_SIZE size);
+void PLIB_OC_TimerSelect(OC_MODULE_ID index, OC_16BIT_TIMERS tmr);
+void PLIB_OC_Buffer16BitSet(OC_MODULE_ID index, uint16_t value);
+void PLIB_OC_PulseWidth16BitSet(OC_MODULE_ID index, uint16_t width);
+void PLIB_OC_Enable(OC_MODULE_ID index);
+
+#endif
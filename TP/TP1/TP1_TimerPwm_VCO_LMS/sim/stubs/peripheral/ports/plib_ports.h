@@ -0,0 +1,25 @@
+#ifndef SIM_PLIB_PORTS_H
+#define SIM_PLIB_PORTS_H
+/*--------------------------------------------------------*/
+// plib_ports.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Broches lues par le simulateur. Chaque lecture
+//			        memorise le niveau lu (reference du module CN).
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum { PORTS_ID_0 = 0 } PORTS_MODULE_ID;
+typedef enum {
+    PORT_CHANNEL_A = 0, PORT_CHANNEL_B, PORT_CHANNEL_C, PORT_CHANNEL_D,
+    PORT_CHANNEL_E, PORT_CHANNEL_F, PORT_CHANNEL_G, PORT_NUMBER_OF_CHANNELS
+} PORTS_CHANNEL;
+typedef enum { PORTS_BIT_POS_0 = 0 } PORTS_BIT_POS;
+
+extern uint16_t simPort[PORT_NUMBER_OF_CHANNELS];
+extern uint16_t simPortRead[PORT_NUMBER_OF_CHANNELS];
+
+bool PLIB_PORTS_PinGet(PORTS_MODULE_ID index, PORTS_CHANNEL channel, PORTS_BIT_POS bitPos);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef SIM_PLIB_TMR_H
+#define SIM_PLIB_TMR_H
+/*--------------------------------------------------------*/
+// plib_tmr.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+typedef enum { TMR_ID_1 = 0, TMR_ID_2, TMR_ID_3, TMR_ID_4, TMR_ID_5, TMR_NUMBER_OF_MODULES } TMR_MODULE_ID;
+typedef enum { TMR_CLOCK_SOURCE_PERIPHERAL_CLOCK = 0 } TMR_CLOCK_SOURCE;
+typedef enum {
+    TMR_PRESCALE_VALUE_1 = 1, TMR_PRESCALE_VALUE_2 = 2, TMR_PRESCALE_VALUE_4 = 4,
+    TMR_PRESCALE_VALUE_8 = 8, TMR_PRESCALE_VALUE_16 = 16, TMR_PRESCALE_VALUE_32 = 32,
+    TMR_PRESCALE_VALUE_64 = 64, TMR_PRESCALE_VALUE_256 = 256
+} TMR_PRESCALE;
+
+// Registres simules
+typedef struct {
+    uint8_t on;
+    uint16_t prescale;
+    uint16_t period;
+    uint32_t counter;       // en tics PBCLK pour le sous-comptage
+    uint8_t flag;           // evenement de periode
+} SIM_TMR_REGS;
+
+extern SIM_TMR_REGS simTmr[TMR_NUMBER_OF_MODULES];
+
+void PLIB_TMR_Stop(TMR_MODULE_ID index);
+void PLIB_TMR_Start(TMR_MODULE_ID index);
+void PLIB_TMR_ClockSourceSelect(TMR_MODULE_ID index, TMR_CLOCK_SOURCE source);
+void PLIB_TMR_PrescaleSelect(TMR_MODULE_ID index, TMR_PRESCALE prescale);
+void PLIB_TMR_Mode16BitEnable(TMR_MODULE_ID index);
+void PLIB_TMR_Counter16BitClear(TMR_MODULE_ID index);
+void PLIB_TMR_Period16BitSet(TMR_MODULE_ID index, uint16_t period);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef SIM_SYSTEM_CONFIG_H
+#define SIM_SYSTEM_CONFIG_H
+/*--------------------------------------------------------*/
+// system_config.h (simulation hote)
+/*--------------------------------------------------------*/
+
+#define SYS_CLK_FREQ                        80000000ul
+#define SYS_CLK_BUS_PERIPHERAL_1            80000000ul
+
+// Boutons du kit, comme le system_config.h du firmware
+#define GINP_BUTTON_TABLE(BTN) \
+    BTN(OK,     RB2, 4) \
+    BTN(ESC,    RB3, 5) \
+    BTN(PLUS,   RB4, 6) \
+    BTN(MINUS,  RB5, 7)
+
+#define SYS_PORTS_PIN_TABLE(PIN, arg) \
+    PIN(RB2,    B,  2, IN,  0, arg) \
+    PIN(RB3,    B,  3, IN,  0, arg) \
+    PIN(RB4,    B,  4, IN,  0, arg) \
+    PIN(RB5,    B,  5, IN,  0, arg)
+
+#endif
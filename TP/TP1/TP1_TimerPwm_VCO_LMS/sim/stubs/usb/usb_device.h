@@ -0,0 +1,52 @@
+#ifndef SIM_USB_DEVICE_H
+#define SIM_USB_DEVICE_H
+/*--------------------------------------------------------*/
+// usb/usb_device.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Sous-ensemble de la couche device USB Harmony
+//			        utilise par gestUsbStream.c, implemente par
+//			        simUsb.c au-dessus d'un controleur simule.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef uintptr_t USB_DEVICE_HANDLE;
+#define USB_DEVICE_HANDLE_INVALID   ((USB_DEVICE_HANDLE)(-1))
+#define USB_DEVICE_INDEX_0          0
+
+typedef enum { DRV_IO_INTENT_READWRITE = 3 } DRV_IO_INTENT;
+
+typedef enum {
+    USB_DEVICE_EVENT_ERROR = 1,
+    USB_DEVICE_EVENT_RESET,
+    USB_DEVICE_EVENT_SUSPENDED,
+    USB_DEVICE_EVENT_RESUMED,
+    USB_DEVICE_EVENT_SOF,
+    USB_DEVICE_EVENT_CONFIGURED,
+    USB_DEVICE_EVENT_DECONFIGURED,
+    USB_DEVICE_EVENT_POWER_DETECTED,
+    USB_DEVICE_EVENT_POWER_REMOVED,
+} USB_DEVICE_EVENT;
+
+typedef struct {
+    uint8_t configurationValue;
+} USB_DEVICE_EVENT_DATA_CONFIGURED;
+
+typedef enum {
+    USB_DEVICE_CONTROL_STATUS_OK = 0,
+    USB_DEVICE_CONTROL_STATUS_ERROR = -1,
+} USB_DEVICE_CONTROL_STATUS;
+
+typedef void (*USB_DEVICE_EVENT_HANDLER)(USB_DEVICE_EVENT event, void *eventData, uintptr_t context);
+
+USB_DEVICE_HANDLE USB_DEVICE_Open(unsigned instance, DRV_IO_INTENT intent);
+void USB_DEVICE_EventHandlerSet(USB_DEVICE_HANDLE handle, USB_DEVICE_EVENT_HANDLER handler, uintptr_t context);
+void USB_DEVICE_Attach(USB_DEVICE_HANDLE handle);
+void USB_DEVICE_Detach(USB_DEVICE_HANDLE handle);
+int USB_DEVICE_ControlSend(USB_DEVICE_HANDLE handle, void *data, size_t length);
+int USB_DEVICE_ControlReceive(USB_DEVICE_HANDLE handle, void *data, size_t length);
+int USB_DEVICE_ControlStatus(USB_DEVICE_HANDLE handle, USB_DEVICE_CONTROL_STATUS status);
+
+#endif
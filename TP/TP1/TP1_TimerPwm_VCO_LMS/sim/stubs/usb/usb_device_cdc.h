@@ -0,0 +1,71 @@
+#ifndef SIM_USB_DEVICE_CDC_H
+#define SIM_USB_DEVICE_CDC_H
+/*--------------------------------------------------------*/
+// usb/usb_device_cdc.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Sous-ensemble de la fonction CDC Harmony
+//			        utilise par gestUsbStream.c (voir simUsb.c).
+/*--------------------------------------------------------*/
+
+#include "usb/usb_device.h"
+
+typedef unsigned USB_DEVICE_CDC_INDEX;
+#define USB_DEVICE_CDC_INDEX_0      0
+
+typedef uintptr_t USB_DEVICE_CDC_TRANSFER_HANDLE;
+
+typedef struct __attribute__((packed)) {
+    uint32_t dwDTERate;
+    uint8_t bCharFormat;
+    uint8_t bParityType;
+    uint8_t bDataBits;
+} USB_CDC_LINE_CODING;
+
+typedef struct {
+    unsigned dtr : 1;
+    unsigned carrier : 1;
+} USB_CDC_CONTROL_LINE_STATE;
+
+typedef enum {
+    USB_DEVICE_CDC_RESULT_OK = 0,
+    USB_DEVICE_CDC_RESULT_ERROR_TRANSFER_QUEUE_FULL,
+    USB_DEVICE_CDC_RESULT_ERROR_TRANSFER_SIZE_INVALID,
+    USB_DEVICE_CDC_RESULT_ERROR_INSTANCE_NOT_CONFIGURED,
+    USB_DEVICE_CDC_RESULT_ERROR_TERMINATED_BY_HOST,
+} USB_DEVICE_CDC_RESULT;
+
+typedef enum {
+    USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE = 1,
+    USB_DEVICE_CDC_TRANSFER_FLAGS_MORE_DATA_PENDING = 2,
+} USB_DEVICE_CDC_TRANSFER_FLAGS;
+
+typedef enum {
+    USB_DEVICE_CDC_EVENT_SET_LINE_CODING = 1,
+    USB_DEVICE_CDC_EVENT_GET_LINE_CODING,
+    USB_DEVICE_CDC_EVENT_SET_CONTROL_LINE_STATE,
+    USB_DEVICE_CDC_EVENT_SEND_BREAK,
+    USB_DEVICE_CDC_EVENT_READ_COMPLETE,
+    USB_DEVICE_CDC_EVENT_WRITE_COMPLETE,
+    USB_DEVICE_CDC_EVENT_SERIAL_STATE_NOTIFICATION_COMPLETE,
+    USB_DEVICE_CDC_EVENT_CONTROL_TRANSFER_DATA_RECEIVED,
+    USB_DEVICE_CDC_EVENT_CONTROL_TRANSFER_DATA_SENT,
+} USB_DEVICE_CDC_EVENT;
+
+typedef enum { USB_DEVICE_CDC_EVENT_RESPONSE_NONE = 0 } USB_DEVICE_CDC_EVENT_RESPONSE;
+
+typedef struct {
+    USB_DEVICE_CDC_TRANSFER_HANDLE handle;
+    size_t length;
+    USB_DEVICE_CDC_RESULT status;
+} USB_DEVICE_CDC_EVENT_DATA_WRITE_COMPLETE;
+
+typedef USB_DEVICE_CDC_EVENT_RESPONSE (*USB_DEVICE_CDC_EVENT_HANDLER)(USB_DEVICE_CDC_INDEX index,
+        USB_DEVICE_CDC_EVENT event, void *pData, uintptr_t context);
+
+int USB_DEVICE_CDC_EventHandlerSet(USB_DEVICE_CDC_INDEX index, USB_DEVICE_CDC_EVENT_HANDLER handler,
+                                   uintptr_t context);
+USB_DEVICE_CDC_RESULT USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX index,
+        USB_DEVICE_CDC_TRANSFER_HANDLE *pHandle, const void *data, size_t size,
+        USB_DEVICE_CDC_TRANSFER_FLAGS flags);
+
+#endif
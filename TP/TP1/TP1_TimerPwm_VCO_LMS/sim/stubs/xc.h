@@ -0,0 +1,16 @@
+#ifndef SIM_XC_H
+#define SIM_XC_H
+/*--------------------------------------------------------*/
+// xc.h (simulation hote)
+/*--------------------------------------------------------*/
+//	Description :	Remplace <xc.h> pour la simulation sur PC.
+//			        Le core timer est un compteur avance par le simulateur.
+/*--------------------------------------------------------*/
+
+#include <stdint.h>
+
+extern volatile uint32_t simCoreCount;
+
+#define _CP0_GET_COUNT()    (simCoreCount)
+
+#endif